@@ -399,7 +399,8 @@ struct NCBI_XXCONNECT2_EXPORT SNgHttp2_Session
 
     void Del();
 
-    int32_t Submit(const nghttp2_nv *nva, size_t nvlen, nghttp2_data_provider* data_prd = nullptr);
+    int32_t Submit(const nghttp2_nv *nva, size_t nvlen, nghttp2_data_provider* data_prd = nullptr,
+            const nghttp2_priority_spec* pri_spec = nullptr);
     int Resume(int32_t stream_id);
 
     // Send() returns either an nghttp2 error or one of the special values below
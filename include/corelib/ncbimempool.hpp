@@ -95,11 +95,31 @@ public:
     /// and delete it correspondingly.
     static void Delete(const CObject* object);
 
+    /// Allocation statistics
+
+    /// Get number of memory blocks allocated from the pool.
+    size_t GetAllocatedCount(void) const;
+
+    /// Get total size of memory blocks allocated from the pool.
+    size_t GetAllocatedSize(void) const;
+
+    /// Get number of memory chunks allocated from system heap.
+    size_t GetChunkCount(void) const;
+
+    /// Get number of allocations left to system heap
+    /// because of their size exceeding malloc threshold.
+    size_t GetMallocCount(void) const;
+
 private:
     size_t m_ChunkSize;
     size_t m_MallocThreshold;
     CRef<CObjectMemoryPoolChunk> m_CurrentChunk;
 
+    size_t m_AllocatedCount;
+    size_t m_AllocatedSize;
+    size_t m_ChunkCount;
+    size_t m_MallocCount;
+
 private:
     // prevent copying
     CObjectMemoryPool(const CObjectMemoryPool&);
@@ -124,6 +144,34 @@ size_t CObjectMemoryPool::GetMallocThreshold(void) const
 }
 
 
+inline
+size_t CObjectMemoryPool::GetAllocatedCount(void) const
+{
+    return m_AllocatedCount;
+}
+
+
+inline
+size_t CObjectMemoryPool::GetAllocatedSize(void) const
+{
+    return m_AllocatedSize;
+}
+
+
+inline
+size_t CObjectMemoryPool::GetChunkCount(void) const
+{
+    return m_ChunkCount;
+}
+
+
+inline
+size_t CObjectMemoryPool::GetMallocCount(void) const
+{
+    return m_MallocCount;
+}
+
+
 END_NCBI_SCOPE
 
 /* @} */
@@ -296,6 +296,25 @@ public:
     void SetDefaultPriority(TPriority priority);
 
     static unsigned GetDefaultBlobCacheSizeLimit();
+    static size_t GetDefaultBlobCacheMemoryLimit();
+
+    // Cache of unlocked blobs.
+    // Memory is estimated from CTSE_Info::GetUsedMemory() of cached blobs,
+    // memory limit 0 means unlimited.
+    unsigned GetBlobCacheSize(void) const;
+    size_t GetBlobCacheMemory(void) const;
+    unsigned GetBlobCacheSizeLimit(void) const;
+    void SetBlobCacheSizeLimit(unsigned limit);
+    size_t GetBlobCacheMemoryLimit(void) const;
+    void SetBlobCacheMemoryLimit(size_t limit);
+
+    // Before dropping whole blobs over the memory limit, unload sequence
+    // data chunks of cached blobs. They are loaded again on demand.
+    bool GetUnloadChunks(void) const;
+    void SetUnloadChunks(bool unload);
+    // statistics of chunk unloading
+    size_t GetUnloadedChunksCount(void) const;
+    size_t GetUnloadedChunksMemory(void) const;
 
     // get locks
     enum FLockFlags {
@@ -406,6 +425,8 @@ private:
                        CTSE_Info& tse, CRef<CTSE_Info::CLoadMutex> load_mutex);
     void x_ReleaseLastLoadLock(CTSE_LoadLock& lock);
     void x_ReleaseLastTSELock(CRef<CTSE_Info> info);
+    void x_ShrinkBlobCache(vector<TTSE_Ref>& to_delete);
+    void x_UnloadCachedChunks(void);
 
     // attach, detach, index & unindex methods
     // TSE
@@ -541,6 +562,11 @@ private:
     mutable TBlob_Cache   m_Blob_Cache;     // unlocked blobs
     mutable unsigned      m_Blob_Cache_Size;// list<>::size() is slow
     unsigned              m_Blob_Cache_Size_Limit;
+    mutable size_t        m_Blob_Cache_Memory;
+    size_t                m_Blob_Cache_Memory_Limit;
+    bool                  m_UnloadChunks;
+    size_t                m_UnloadedChunksCount;
+    size_t                m_UnloadedChunksMemory;
 
     // Prefetching thread and lock, used when initializing the thread
     CRef<CPrefetchThreadOld> m_PrefetchThread;
@@ -51,12 +51,14 @@
 #include <objmgr/impl/scope_info.hpp>
 #include <util/mutex_pool.hpp>
 #include <objmgr/impl/data_source.hpp>
+#include <objmgr/bioseq_handle.hpp>
 
 
 #include <objects/seq/Seq_inst.hpp> // for enum EMol
 
 #include <set>
 #include <map>
+#include <atomic>
 
 BEGIN_NCBI_SCOPE
 BEGIN_SCOPE(objects)
@@ -127,6 +129,103 @@ struct SSeqMatch_Scope : public SSeqMatch_TSE
 };
 
 
+// Configuration lock of the scope.
+// After the scope is frozen its configuration cannot be changed anymore,
+// so the read guards do not touch the underlying RW lock at all, and
+// concurrent readers do not contend on it. The write guards throw
+// CObjMgrException if the scope is frozen.
+class NCBI_XOBJMGR_EXPORT CScopeConfLock
+{
+public:
+    CScopeConfLock(void)
+        : m_Frozen(false)
+        {
+        }
+
+    bool IsFrozen(void) const
+        {
+            return m_Frozen.load(memory_order_acquire);
+        }
+    // Must not be called while the current thread holds a read lock
+    void Freeze(void);
+    // Only for scope destruction when no other threads can use the scope
+    void x_Unfreeze(void)
+        {
+            m_Frozen.store(false, memory_order_release);
+        }
+
+    class CReadGuard
+    {
+    public:
+        explicit CReadGuard(CScopeConfLock& lock)
+            : m_Lock(0)
+            {
+                Guard(lock);
+            }
+        ~CReadGuard(void)
+            {
+                Release();
+            }
+
+        void Guard(CScopeConfLock& lock)
+            {
+                Release();
+                if ( !lock.IsFrozen() ) {
+                    lock.m_Lock.ReadLock();
+                    m_Lock = &lock;
+                }
+            }
+        void Release(void)
+            {
+                if ( m_Lock ) {
+                    m_Lock->m_Lock.Unlock();
+                    m_Lock = 0;
+                }
+            }
+
+    private:
+        CScopeConfLock* m_Lock;
+
+        CReadGuard(const CReadGuard&);
+        void operator=(const CReadGuard&);
+    };
+
+    class NCBI_XOBJMGR_EXPORT CWriteGuard
+    {
+    public:
+        explicit CWriteGuard(CScopeConfLock& lock);
+        ~CWriteGuard(void)
+            {
+                Release();
+            }
+
+        void Release(void)
+            {
+                if ( m_Lock ) {
+                    m_Lock->m_Lock.Unlock();
+                    m_Lock = 0;
+                }
+            }
+
+    private:
+        CScopeConfLock* m_Lock;
+
+        CWriteGuard(const CWriteGuard&);
+        void operator=(const CWriteGuard&);
+    };
+
+    typedef CReadGuard  TReadLockGuard;
+    typedef CWriteGuard TWriteLockGuard;
+
+private:
+    CRWLock      m_Lock;
+    atomic<bool> m_Frozen;
+
+    CScopeConfLock(const CScopeConfLock&);
+    void operator=(const CScopeConfLock&);
+};
+
+
 class NCBI_XOBJMGR_EXPORT CScope_Impl : public CObject
 {
 public:
@@ -403,6 +502,14 @@ public:
     typedef vector<int> TSequenceHashes;
     void GetSequenceHashes(TSequenceHashes& ret,
                            const TIds& idhs, TGetFlags flags);
+    // Get sequence data of a set of sequences
+    typedef vector<TSeqRange> TSeqRanges;
+    typedef vector<size_t> TSeqDataOffsets;
+    size_t GetSequencesData(TSeqDataOffsets& offsets,
+                            char* buffer, size_t buffer_size,
+                            const TIds& idhs, const TSeqRanges* ranges,
+                            CBioseq_Handle::EVectorCoding coding,
+                            TGetFlags flags);
 
 private:
     // constructor/destructor visible from CScope
@@ -553,6 +660,12 @@ public:
     }
     void SetKeepExternalAnnotsForEdit(bool keep = true);
 
+    void Freeze(void);
+    bool IsFrozen(void) const
+    {
+        return m_ConfLock.IsFrozen();
+    }
+
 private:
     // Get bioseq handles for sequences from the given TSE using the filter
     typedef vector<CBioseq_Handle> TBioseq_HandleSet;
@@ -641,10 +754,10 @@ private:
 
     CInitMutexPool       m_MutexPool;
 
-    typedef CRWLock                     TConfLock;
+    typedef CScopeConfLock              TConfLock;
     typedef TConfLock::TReadLockGuard   TConfReadLockGuard;
     typedef TConfLock::TWriteLockGuard  TConfWriteLockGuard;
-    typedef CFastMutex                  TSeq_idMapLock;
+    typedef CFastRWLock                 TSeq_idMapLock;
 
     mutable TConfLock       m_ConfLock;
 
@@ -38,6 +38,9 @@
 #else
 # include <objmgr/impl/seq_vector_cvt_gen.hpp>
 #endif
+#if defined(NCBI_SSE)  &&  NCBI_SSE >= 40
+# include <objmgr/impl/seq_vector_cvt_sse.hpp>
+#endif
 
 BEGIN_NCBI_SCOPE
 BEGIN_SCOPE(objects)
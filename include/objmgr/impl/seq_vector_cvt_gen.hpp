@@ -348,7 +348,7 @@ void copy_2bit_reverse(DstIter dst, size_t count,
             ++dst;
         }
         if ( first_byte_pos >= 2 ) {
-            *dst = (c >> 3) & 0x03;
+            *dst = (c >> 4) & 0x03;
             if ( --count == 0 ) return;
             ++dst;
         }
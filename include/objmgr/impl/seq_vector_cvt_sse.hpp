@@ -0,0 +1,417 @@
+#ifndef SEQ_VECTOR_CVT_SSE__HPP
+#define SEQ_VECTOR_CVT_SSE__HPP
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Author: agent
+*
+* File Description:
+*   Seq-vector conversion functions for CPUs with SSSE3.
+*   The functions are overloads of the generic ones for plain char buffer
+*   destination, they convert the bulk of data with 16-byte vectors
+*   and leave unaligned head and tail to the generic functions.
+*   Conversion tables (if any) are at least 16 bytes long, so the tables
+*   of 2- and 4-bit codings fit into one vector, and the lookup is done
+*   with a single byte shuffle.
+*
+*/
+
+#include <tmmintrin.h>
+#include <string.h>
+
+BEGIN_NCBI_SCOPE
+
+// The generic functions are called with explicit template arguments,
+// so that the overloads below are not viable and there is no recursion.
+
+inline
+__m128i x_sse_reverse_bytes(__m128i v)
+{
+    return _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                            8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+
+inline
+__m128i x_sse_load_table(const char* table)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+}
+
+
+inline
+void x_sse_store(char* dst, __m128i v)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+}
+
+
+// Unpack 16 bytes of 4-bit data into 32 codes (high nibble first)
+// and convert them with the table
+inline
+void x_sse_unpack_4bit(char* dst, __m128i v, __m128i table)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), mask);
+    __m128i lo = _mm_and_si128(v, mask);
+    x_sse_store(dst,    _mm_shuffle_epi8(table, _mm_unpacklo_epi8(hi, lo)));
+    x_sse_store(dst+16, _mm_shuffle_epi8(table, _mm_unpackhi_epi8(hi, lo)));
+}
+
+
+// Same in reverse order: the bytes are taken from the end,
+// low nibble first
+inline
+void x_sse_unpack_4bit_reverse(char* dst, __m128i v, __m128i table)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    v = x_sse_reverse_bytes(v);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), mask);
+    __m128i lo = _mm_and_si128(v, mask);
+    x_sse_store(dst,    _mm_shuffle_epi8(table, _mm_unpacklo_epi8(lo, hi)));
+    x_sse_store(dst+16, _mm_shuffle_epi8(table, _mm_unpackhi_epi8(lo, hi)));
+}
+
+
+// Unpack 16 bytes of 2-bit data into 64 codes and convert them
+// with the table. In direct order the codes of a byte go from
+// the highest bits, in reverse order the bytes are taken from the end
+// and the codes go from the lowest bits.
+inline
+void x_sse_unpack_2bit(char* dst, __m128i v, __m128i table, bool reverse)
+{
+    const __m128i mask = _mm_set1_epi8(0x03);
+    // select a shifted value depending on code position within the byte
+    const __m128i sel0 = _mm_set1_epi32(0x000000ff);
+    const __m128i sel1 = _mm_set1_epi32(0x0000ff00);
+    const __m128i sel2 = _mm_set1_epi32(0x00ff0000);
+    const __m128i sel3 = _mm_set1_epi32(int(0xff000000));
+    if ( reverse ) {
+        v = x_sse_reverse_bytes(v);
+    }
+    for ( int i = 0; i < 4; ++i, dst += 16 ) {
+        // replicate each of the 4 source bytes 4 times
+        char b = char(i*4);
+        __m128i x = _mm_shuffle_epi8(v, _mm_set_epi8(b+3, b+3, b+3, b+3,
+                                                     b+2, b+2, b+2, b+2,
+                                                     b+1, b+1, b+1, b+1,
+                                                     b, b, b, b));
+        __m128i s6 = _mm_srli_epi16(x, 6);
+        __m128i s4 = _mm_srli_epi16(x, 4);
+        __m128i s2 = _mm_srli_epi16(x, 2);
+        __m128i r;
+        if ( reverse ) {
+            r = _mm_or_si128(_mm_or_si128(_mm_and_si128(x, sel0),
+                                          _mm_and_si128(s2, sel1)),
+                             _mm_or_si128(_mm_and_si128(s4, sel2),
+                                          _mm_and_si128(s6, sel3)));
+        }
+        else {
+            r = _mm_or_si128(_mm_or_si128(_mm_and_si128(s6, sel0),
+                                          _mm_and_si128(s4, sel1)),
+                             _mm_or_si128(_mm_and_si128(s2, sel2),
+                                          _mm_and_si128(x, sel3)));
+        }
+        r = _mm_and_si128(r, mask);
+        x_sse_store(dst, _mm_shuffle_epi8(table, r));
+    }
+}
+
+
+inline
+__m128i x_sse_identity_table(void)
+{
+    return _mm_set_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                        7, 6, 5, 4, 3, 2, 1, 0);
+}
+
+
+template<class SrcCont>
+inline
+const __m128i* x_sse_src(const SrcCont& srcCont, size_t bytePos)
+{
+    return reinterpret_cast<const __m128i*>(srcCont.data() + bytePos);
+}
+
+
+template<class SrcCont>
+inline
+void copy_8bit(char* dst, size_t count,
+               const SrcCont& srcCont, size_t srcPos)
+{
+    if ( count ) {
+        memcpy(dst, srcCont.data() + srcPos, count);
+    }
+}
+
+
+template<class SrcCont>
+inline
+void copy_8bit_reverse(char* dst, size_t count,
+                       const SrcCont& srcCont, size_t srcPos)
+{
+    size_t endPos = srcPos + count;
+    for ( ; count >= 16; count -= 16, dst += 16 ) {
+        endPos -= 16;
+        __m128i v = _mm_loadu_si128(x_sse_src(srcCont, endPos));
+        x_sse_store(dst, x_sse_reverse_bytes(v));
+    }
+    if ( count ) {
+        copy_8bit_reverse<char*, SrcCont>(dst, count, srcCont, srcPos);
+    }
+}
+
+
+template<class SrcCont>
+void x_sse_copy_4bit(char* dst, size_t count,
+                     const SrcCont& srcCont, size_t srcPos,
+                     __m128i table, const char* scalar_table)
+{
+    if ( srcPos % 2 && count ) {
+        // odd char first
+        if ( scalar_table ) {
+            copy_4bit_table<char*, SrcCont>(dst, 1, srcCont, srcPos,
+                                            scalar_table);
+        }
+        else {
+            copy_4bit<char*, SrcCont>(dst, 1, srcCont, srcPos);
+        }
+        ++dst;
+        ++srcPos;
+        --count;
+    }
+    for ( ; count >= 32; count -= 32, srcPos += 32, dst += 32 ) {
+        __m128i v = _mm_loadu_si128(x_sse_src(srcCont, srcPos / 2));
+        x_sse_unpack_4bit(dst, v, table);
+    }
+    if ( !count ) {
+        return;
+    }
+    if ( scalar_table ) {
+        copy_4bit_table<char*, SrcCont>(dst, count, srcCont, srcPos,
+                                        scalar_table);
+    }
+    else {
+        copy_4bit<char*, SrcCont>(dst, count, srcCont, srcPos);
+    }
+}
+
+
+template<class SrcCont>
+void x_sse_copy_4bit_reverse(char* dst, size_t count,
+                             const SrcCont& srcCont, size_t srcPos,
+                             __m128i table, const char* scalar_table)
+{
+    size_t endPos = srcPos + count;
+    if ( endPos % 2 && count ) {
+        // odd char first
+        if ( scalar_table ) {
+            copy_4bit_table_reverse<char*, SrcCont>(dst, 1, srcCont,
+                                                    endPos - 1,
+                                                    scalar_table);
+        }
+        else {
+            copy_4bit_reverse<char*, SrcCont>(dst, 1, srcCont, endPos - 1);
+        }
+        ++dst;
+        --endPos;
+        --count;
+    }
+    for ( ; count >= 32; count -= 32, dst += 32 ) {
+        endPos -= 32;
+        __m128i v = _mm_loadu_si128(x_sse_src(srcCont, endPos / 2));
+        x_sse_unpack_4bit_reverse(dst, v, table);
+    }
+    if ( !count ) {
+        return;
+    }
+    if ( scalar_table ) {
+        copy_4bit_table_reverse<char*, SrcCont>(dst, count, srcCont, srcPos,
+                                                scalar_table);
+    }
+    else {
+        copy_4bit_reverse<char*, SrcCont>(dst, count, srcCont, srcPos);
+    }
+}
+
+
+template<class SrcCont>
+inline
+void copy_4bit(char* dst, size_t count,
+               const SrcCont& srcCont, size_t srcPos)
+{
+    x_sse_copy_4bit(dst, count, srcCont, srcPos, x_sse_identity_table(), 0);
+}
+
+
+template<class SrcCont>
+inline
+void copy_4bit_table(char* dst, size_t count,
+                     const SrcCont& srcCont, size_t srcPos,
+                     const char* table)
+{
+    x_sse_copy_4bit(dst, count, srcCont, srcPos,
+                    x_sse_load_table(table), table);
+}
+
+
+template<class SrcCont>
+inline
+void copy_4bit_reverse(char* dst, size_t count,
+                       const SrcCont& srcCont, size_t srcPos)
+{
+    x_sse_copy_4bit_reverse(dst, count, srcCont, srcPos,
+                            x_sse_identity_table(), 0);
+}
+
+
+template<class SrcCont>
+inline
+void copy_4bit_table_reverse(char* dst, size_t count,
+                             const SrcCont& srcCont, size_t srcPos,
+                             const char* table)
+{
+    x_sse_copy_4bit_reverse(dst, count, srcCont, srcPos,
+                            x_sse_load_table(table), table);
+}
+
+
+template<class SrcCont>
+void x_sse_copy_2bit(char* dst, size_t count,
+                     const SrcCont& srcCont, size_t srcPos,
+                     __m128i table, const char* scalar_table)
+{
+    size_t head = min(count, size_t(-srcPos % 4));
+    if ( head ) {
+        // odd chars first
+        if ( scalar_table ) {
+            copy_2bit_table<char*, SrcCont>(dst, head, srcCont, srcPos,
+                                            scalar_table);
+        }
+        else {
+            copy_2bit<char*, SrcCont>(dst, head, srcCont, srcPos);
+        }
+        dst += head;
+        srcPos += head;
+        count -= head;
+    }
+    for ( ; count >= 64; count -= 64, srcPos += 64, dst += 64 ) {
+        __m128i v = _mm_loadu_si128(x_sse_src(srcCont, srcPos / 4));
+        x_sse_unpack_2bit(dst, v, table, false);
+    }
+    if ( !count ) {
+        return;
+    }
+    if ( scalar_table ) {
+        copy_2bit_table<char*, SrcCont>(dst, count, srcCont, srcPos,
+                                        scalar_table);
+    }
+    else {
+        copy_2bit<char*, SrcCont>(dst, count, srcCont, srcPos);
+    }
+}
+
+
+template<class SrcCont>
+void x_sse_copy_2bit_reverse(char* dst, size_t count,
+                             const SrcCont& srcCont, size_t srcPos,
+                             __m128i table, const char* scalar_table)
+{
+    size_t endPos = srcPos + count;
+    size_t head = min(count, endPos % 4);
+    if ( head ) {
+        // odd chars first
+        endPos -= head;
+        if ( scalar_table ) {
+            copy_2bit_table_reverse<char*, SrcCont>(dst, head, srcCont,
+                                                    endPos, scalar_table);
+        }
+        else {
+            copy_2bit_reverse<char*, SrcCont>(dst, head, srcCont, endPos);
+        }
+        dst += head;
+        count -= head;
+    }
+    for ( ; count >= 64; count -= 64, dst += 64 ) {
+        endPos -= 64;
+        __m128i v = _mm_loadu_si128(x_sse_src(srcCont, endPos / 4));
+        x_sse_unpack_2bit(dst, v, table, true);
+    }
+    if ( !count ) {
+        return;
+    }
+    if ( scalar_table ) {
+        copy_2bit_table_reverse<char*, SrcCont>(dst, count, srcCont, srcPos,
+                                                scalar_table);
+    }
+    else {
+        copy_2bit_reverse<char*, SrcCont>(dst, count, srcCont, srcPos);
+    }
+}
+
+
+template<class SrcCont>
+inline
+void copy_2bit(char* dst, size_t count,
+               const SrcCont& srcCont, size_t srcPos)
+{
+    x_sse_copy_2bit(dst, count, srcCont, srcPos, x_sse_identity_table(), 0);
+}
+
+
+template<class SrcCont>
+inline
+void copy_2bit_table(char* dst, size_t count,
+                     const SrcCont& srcCont, size_t srcPos,
+                     const char* table)
+{
+    x_sse_copy_2bit(dst, count, srcCont, srcPos,
+                    x_sse_load_table(table), table);
+}
+
+
+template<class SrcCont>
+inline
+void copy_2bit_reverse(char* dst, size_t count,
+                       const SrcCont& srcCont, size_t srcPos)
+{
+    x_sse_copy_2bit_reverse(dst, count, srcCont, srcPos,
+                            x_sse_identity_table(), 0);
+}
+
+
+template<class SrcCont>
+inline
+void copy_2bit_table_reverse(char* dst, size_t count,
+                             const SrcCont& srcCont, size_t srcPos,
+                             const char* table)
+{
+    x_sse_copy_2bit_reverse(dst, count, srcCont, srcPos,
+                            x_sse_load_table(table), table);
+}
+
+END_NCBI_SCOPE
+
+#endif//SEQ_VECTOR_CVT_SSE__HPP
@@ -86,6 +86,10 @@ public:
     virtual void LoadSeq_entry(CTSE_Info&, CSeq_entry& entry, 
                                CTSE_SetObjectInfo* set_info) = 0;
 
+    // unloading of loaded chunk data, returns false if not supported
+    virtual bool UnloadSequence(CTSE_Info&, const TLocationSet& location,
+                                CTSE_Chunk_Info& chunk);
+
     // get attach points from CTSE_Info
     static CBioseq_Base_Info& x_GetBase(CTSE_Info& tse, const TPlace& place);
     static CBioseq_Info& x_GetBioseq(CTSE_Info& tse, const TPlace& place);
@@ -134,6 +138,9 @@ public:
     virtual void LoadSeq_entry(CTSE_Info&, CSeq_entry& entry, 
                                CTSE_SetObjectInfo* set_info);
 
+    virtual bool UnloadSequence(CTSE_Info&, const TLocationSet& location,
+                                CTSE_Chunk_Info& chunk);
+
 private:
     CTSE_Default_Assigner(const CTSE_Default_Assigner&);
     CTSE_Default_Assigner& operator=(const CTSE_Default_Assigner&);
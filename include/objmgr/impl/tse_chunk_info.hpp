@@ -223,6 +223,18 @@ public:
 
     // update in-memory size
     void x_AddUsedMemory(size_t size);
+    size_t GetUsedMemory(void) const
+        {
+            return m_UsedMemory;
+        }
+
+    // chunks with sequence data only can be unloaded and loaded again
+    bool x_CanUnload(void) const;
+    void x_SetUnloaded(void);
+    unsigned GetUnloadCount(void) const
+        {
+            return m_UnloadCount;
+        }
 
     //////////////////////////////////////////////////////////////////
     // methods to find out what information is needed to be loaded
@@ -314,6 +326,8 @@ private:
 
     Uint4            m_LoadBytes;
     float            m_LoadSeconds;
+    size_t           m_UsedMemory;
+    unsigned         m_UnloadCount;
 
     bool             m_ExplicitFeatIds;
 
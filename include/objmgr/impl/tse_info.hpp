@@ -714,6 +714,8 @@ private:
     
     typedef list< CRef<CTSE_Info> > TTSE_Cache;
     mutable TTSE_Cache::iterator   m_CachePosition;
+    // memory accounted in data source cache
+    mutable size_t         m_CacheMemory;
 
     // lock counter for garbage collector
     mutable CAtomicCounter_WithAutoInit m_LockCounter;
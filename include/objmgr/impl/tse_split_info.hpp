@@ -166,6 +166,10 @@ public:
     // update in-memory size
     void x_AddUsedMemory(size_t size);
 
+    // unload loaded chunks that can be loaded again,
+    // returns memory freed according to the chunks' used memory
+    size_t x_UnloadChunks(size_t& unloaded_count);
+
     void x_SetBioseqUpdater(CRef<CBioseqUpdater> updater);
 
 protected:
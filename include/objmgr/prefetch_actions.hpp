@@ -310,6 +310,116 @@ private:
 };
 
 
+/// Action executed by CPrefetchPlanner.
+/// Resolves bioseq handle and, depending on flags, loads the sequence data
+/// (with all the split chunks it's stored in) and collects features.
+class NCBI_XOBJMGR_EXPORT CPrefetchPlannerAction
+    : public CPrefetchBioseq
+{
+public:
+    enum EFlags {
+        fBioseq   = 0,      // resolve bioseq handle only
+        fSeqData  = 1 << 0, // load sequence data chunks
+        fFeatures = 1 << 1  // collect features with the selector
+    };
+    typedef int TFlags;
+
+    CPrefetchPlannerAction(const CScopeSource& scope,
+                           const CSeq_id_Handle& seq_id,
+                           TFlags flags,
+                           const SAnnotSelector* selector = 0);
+
+    virtual bool Execute(CRef<CPrefetchRequest> token);
+
+    TFlags GetFlags(void) const
+        {
+            return m_Flags;
+        }
+    // valid only if fFeatures flag is set
+    const CFeat_CI& GetFeat_CI(void) const
+        {
+            return m_Feat_CI;
+        }
+    // approximate amount of memory used by the loaded data
+    size_t GetEstimatedSize(void) const
+        {
+            return m_EstimatedSize;
+        }
+
+private:
+    TFlags          m_Flags;
+    SAnnotSelector  m_Selector;
+    CFeat_CI        m_Feat_CI;
+    size_t          m_EstimatedSize;
+};
+
+
+/// Prefetches bioseqs from an id source ahead of their consumption.
+/// The number of submitted but not consumed yet requests is limited by
+/// max_active, and the estimated size of the prefetched data waiting for
+/// the consumer is limited by memory_budget (0 means no limit).
+/// Requests that were not consumed are canceled by Cancel() or when the
+/// planner is destroyed.
+class NCBI_XOBJMGR_EXPORT CPrefetchPlanner : public CObject
+{
+public:
+    typedef CPrefetchPlannerAction::TFlags TFlags;
+
+    struct SStats
+    {
+        SStats(void)
+            : m_Submitted(0),
+              m_Hits(0),
+              m_Late(0),
+              m_Failed(0),
+              m_Canceled(0)
+            {
+            }
+
+        size_t m_Submitted; // requests added to the prefetch manager
+        size_t m_Hits;      // result was ready when requested
+        size_t m_Late;      // consumer had to wait for the result
+        size_t m_Failed;    // request failed or was canceled while running
+        size_t m_Canceled;  // request was still pending when canceled
+    };
+
+    CPrefetchPlanner(CPrefetchManager& manager,
+                     const CScopeSource& scope,
+                     ISeq_idSource* ids,
+                     TFlags flags = CPrefetchPlannerAction::fBioseq,
+                     const SAnnotSelector* selector = 0,
+                     size_t max_active = 10,
+                     size_t memory_budget = 0);
+    ~CPrefetchPlanner(void);
+
+    /// Returns next request waiting for its result if necessary,
+    /// or null if there are no more ids.
+    /// The action of the request is CPrefetchPlannerAction.
+    CRef<CPrefetchRequest> GetNextToken(void);
+
+    /// Cancels all requests that were not consumed yet.
+    void Cancel(void);
+
+    SStats GetStats(void) const;
+
+protected:
+    void x_EnqueueActions(void);
+    bool x_CanEnqueue(void) const;
+
+private:
+    CRef<CPrefetchManager>          m_Manager;
+    CScopeSource                    m_Scope;
+    CIRef<ISeq_idSource>            m_Ids;
+    TFlags                          m_Flags;
+    unique_ptr<SAnnotSelector>      m_Selector;
+    size_t                          m_MaxActive;
+    size_t                          m_MemoryBudget;
+    mutable CMutex                  m_Mutex;
+    list< CRef<CPrefetchRequest> >  m_ActiveTokens;
+    SStats                          m_Stats;
+};
+
+
 class NCBI_XOBJMGR_EXPORT CStdPrefetch
 {
 public:
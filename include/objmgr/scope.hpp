@@ -615,6 +615,31 @@ public:
                            const TSeq_id_Handles& idhs,
                            TGetFlags flags = 0);
 
+    /// Get sequence data of many sequences at once
+    /// The sequences are resolved and their sequence data is loaded with
+    /// batch requests to the data loaders. The residues of each sequence,
+    /// or of its range if ranges are given, are written in the requested
+    /// coding into the caller's buffer one after another, one byte per
+    /// residue, without terminating zeroes.
+    /// The data of the i-th sequence is in [offsets[i], offsets[i+1]),
+    /// it's empty for sequences that aren't found or don't have the data.
+    /// Returns total number of bytes written.
+    /// Throws CObjMgrException if the buffer is too small,
+    /// GetSequenceLengths() can be used to calculate the required size.
+    /// @sa GetSequenceLengths
+    /// @sa CSeqVector
+    /// @sa EGetflags
+    typedef vector<TSeqRange> TSeqRanges;
+    typedef vector<size_t> TSeqDataOffsets;
+    size_t GetSequencesData(TSeqDataOffsets* offsets,
+                            char* buffer,
+                            size_t buffer_size,
+                            const TSeq_id_Handles& idhs,
+                            const TSeqRanges* ranges = 0,
+                            CBioseq_Handle::EVectorCoding coding =
+                            CBioseq_Handle::eCoding_Iupac,
+                            TGetFlags flags = 0);
+
     /// Get bioseq synonyms, resolving to the bioseq in this scope.
     CConstRef<CSynonymsSet> GetSynonyms(const CSeq_id&        id);
 
@@ -689,6 +714,26 @@ public:
     ///   GetDefaultKeepExternalAnnotsForEdit(), GetKeepExternalAnnotsForEdit()
     void SetKeepExternalAnnotsForEdit(bool keep = true);
 
+    /// Make the scope configuration immutable.
+    ///
+    /// After the scope is frozen no data sources, loaders or entries can be
+    /// added or removed, its history cannot be reset, and no edit handles
+    /// can be obtained; such calls throw CObjMgrException.
+    /// In exchange, the lookups of bioseq handles, annotations and
+    /// sequence data from many threads do not contend on the scope
+    /// configuration lock. Data is still loaded on demand by the loaders.
+    /// The intended use is to populate and warm up the scope first and
+    /// then share it between the reader threads.
+    /// A frozen scope cannot be unfrozen.
+    /// @sa
+    ///   IsFrozen()
+    void Freeze(void);
+
+    /// Check whether the scope configuration is frozen.
+    /// @sa
+    ///   Freeze()
+    bool IsFrozen(void) const;
+
 protected:
     CScope_Impl& GetImpl(void);
 
@@ -172,6 +172,17 @@ public:
 
     // Methods used internally by other OM classes
 
+    typedef vector<CRef<CTSE_Chunk_Info> > TChunksToLoad;
+    // Collect not loaded chunks with sequence data of the top level
+    // segments in the range
+    void GetChunksToLoad(TChunksToLoad& chunks,
+                         CScope* scope,
+                         TSeqPos from,
+                         TSeqPos length) const;
+    // Load the chunks with one request per data loader.
+    // The chunks are removed from the vector.
+    static void LoadChunks(TChunksToLoad& chunks);
+
     static CRef<CSeqMap> CreateSeqMapForBioseq(const CBioseq& seq);
     static CRef<CSeqMap> CreateSeqMapForSeq_loc(const CSeq_loc& loc,
                                                 CScope* scope);
@@ -184,6 +195,9 @@ public:
 
     void SetRegionInChunk(CTSE_Chunk_Info& chunk, TSeqPos pos, TSeqPos length);
     void LoadSeq_data(TSeqPos pos, TSeqPos len, const CSeq_data& data);
+    // revert loaded data segments in the region back to the split chunk,
+    // returns false if there was nothing to unload
+    bool UnloadSeq_data(CTSE_Chunk_Info& chunk, TSeqPos pos, TSeqPos length);
 
     void SetSegmentGap(const CSeqMap_CI& seg,
                        TSeqPos length);
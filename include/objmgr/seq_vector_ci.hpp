@@ -131,6 +131,10 @@ public:
     /// Fill the buffer string with the count bytes of sequence data
     /// starting with current iterator position
     void GetSeqData(string& buffer, TSeqPos count);
+    /// Copy up to count bytes of sequence data starting with current
+    /// iterator position into the memory buffer.
+    /// Return number of copied bytes.
+    TSeqPos GetSeqData(char* buffer, TSeqPos count);
 
     /// Get number of chars from current position to the current buffer end
     TSeqPos GetBufferSize(void) const;
@@ -0,0 +1,181 @@
+#ifndef OBJTOOLS_ALIGN___ALN_COLUMNAR__HPP
+#define OBJTOOLS_ALIGN___ALN_COLUMNAR__HPP
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Author:  agent
+ *
+ * File Description:
+ *   Compact columnar container format for sets of Seq-aligns
+ *
+ */
+
+#include <corelib/ncbiobj.hpp>
+#include <corelib/ncbiexpt.hpp>
+#include <objects/seqalign/Seq_align.hpp>
+#include <objects/seqalign/Seq_align_set.hpp>
+
+BEGIN_NCBI_SCOPE
+
+class CObjectIStream;
+class CObjectOStream;
+
+BEGIN_SCOPE(objects)
+
+class CSeq_id;
+class CObject_id;
+
+/// Columnar alignment format.
+///
+/// Alignments are stored in blocks.  Each block keeps its alignments
+/// column by column: dictionary of Seq-ids, Dense-seg dimensions and
+/// segment counts, Seq-id references, starts (delta encoded by row),
+/// lengths, strands, and score ids and values as typed columns.
+/// Integers are stored as variable length numbers, and each column
+/// can be compressed by zstd separately.
+/// Seq-aligns which have no columnar representation (segments other than
+/// Dense-seg, bounds, ids, extensions, or per segment scores) are stored
+/// in the block as ASN.1 binary, so any Seq-align-set is converted
+/// without loss.
+
+
+class NCBI_XALNTOOL_EXPORT CAlnColumnarException : public CException
+{
+public:
+    enum EErrCode {
+        eFormatError,
+        eCompressionError,
+        eIOError
+    };
+
+    virtual const char* GetErrCodeString(void) const override;
+
+    NCBI_EXCEPTION_DEFAULT(CAlnColumnarException, CException);
+};
+
+
+class NCBI_XALNTOOL_EXPORT CAlnColumnarWriter
+{
+public:
+    enum EFlags {
+        /// Compress columns by zstd, if the library is available.
+        /// A column is stored compressed only if it makes it smaller.
+        fCompressZstd = 1 << 0
+    };
+    typedef int TFlags; ///< Bitwise OR of EFlags
+
+    explicit CAlnColumnarWriter(CNcbiOstream& out, TFlags flags = 0);
+    /// Flushes buffered alignments and writes end of data mark,
+    /// unless Close() was called already.
+    ~CAlnColumnarWriter(void);
+
+    /// Max number of alignments in one block.
+    /// Reader keeps the whole current block in memory.
+    void SetBlockSize(size_t block_size);
+    size_t GetBlockSize(void) const;
+
+    void Write(const CSeq_align& align);
+    void Write(const CSeq_align_set& aligns);
+
+    /// Read Seq-align-set from ASN.1 stream (in any format) one alignment
+    /// at a time and write it in columnar format.
+    void CopyFromAsn(CObjectIStream& in);
+
+    /// Write buffered alignments as a block.
+    void Flush(void);
+    /// Flush and write end of data mark.
+    void Close(void);
+
+private:
+    CAlnColumnarWriter(const CAlnColumnarWriter&);
+    CAlnColumnarWriter& operator=(const CAlnColumnarWriter&);
+
+    struct SBlock;
+
+    void x_WriteDenseSeg(const CSeq_align& align);
+    void x_WriteAsn(const CSeq_align& align);
+    size_t x_GetIdIndex(const CSeq_id& id);
+    size_t x_GetScoreIdIndex(const CObject_id* id);
+    void x_WriteColumn(int column, const string& data);
+
+    CNcbiOstream&     m_Out;
+    TFlags            m_Flags;
+    size_t            m_BlockSize;
+    bool              m_Closed;
+    unique_ptr<SBlock> m_Block;
+};
+
+
+class NCBI_XALNTOOL_EXPORT CAlnColumnarReader
+{
+public:
+    explicit CAlnColumnarReader(CNcbiIstream& in);
+    ~CAlnColumnarReader(void);
+
+    /// Read and decode columns of the next block.
+    /// Return false at the end of data.
+    bool ReadBlock(void);
+
+    /// Number of alignments in the current block.
+    size_t GetAlignCount(void) const;
+
+    /// Get alignment of the current block.
+    /// Seq-align object is created on the first request only,
+    /// with its own copies of Seq-ids.
+    CRef<CSeq_align> GetAlign(size_t index);
+
+    /// Columnar data access without creating Seq-align.
+    /// Return false if the alignment is stored as ASN.1 blob,
+    /// then only GetAlign() can be used.
+    bool IsDenseSeg(size_t index) const;
+    size_t GetDim(size_t index) const;
+    size_t GetNumseg(size_t index) const;
+    const CSeq_id& GetSeq_id(size_t index, size_t row) const;
+
+    /// Read all remaining alignments.
+    CRef<CSeq_align_set> ReadAll(void);
+
+    /// Write all remaining alignments to ASN.1 stream as Seq-align-set.
+    void CopyToAsn(CObjectOStream& out);
+
+private:
+    CAlnColumnarReader(const CAlnColumnarReader&);
+    CAlnColumnarReader& operator=(const CAlnColumnarReader&);
+
+    struct SBlock;
+
+    CRef<CSeq_align> x_CreateAlign(size_t index) const;
+    void x_DecodeColumns(void);
+
+    CNcbiIstream&      m_In;
+    bool               m_EndOfData;
+    unique_ptr<SBlock> m_Block;
+};
+
+
+END_SCOPE(objects)
+END_NCBI_SCOPE
+
+#endif  // OBJTOOLS_ALIGN___ALN_COLUMNAR__HPP
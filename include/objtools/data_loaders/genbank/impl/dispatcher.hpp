@@ -182,6 +182,10 @@ public:
                         CReaderRequestResultRecursion& recursion);
     static void LogStat(CReadDispatcherCommand& command,
                         CReaderRequestResultRecursion& recursion, double size);
+    // the time is measured by the caller, e.g. parsing in another thread
+    static void LogStat(CReadDispatcherCommand& command,
+                        CReaderRequestResultRecursion& recursion, double size,
+                        double time);
 
 private:
     typedef map< TLevel,       CRef<CReader> >    TReaders;
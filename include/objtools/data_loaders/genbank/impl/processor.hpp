@@ -181,6 +181,20 @@ protected:
                         CGBRequestStatistics::EStatType stat_type,
                         const char* descr,
                         double size);
+    // the time is measured by the caller, e.g. parsing in another thread
+    static void LogStat(CReaderRequestResultRecursion& recursion,
+                        const CBlob_id& blob_id,
+                        CGBRequestStatistics::EStatType stat_type,
+                        const char* descr,
+                        double size,
+                        double time);
+    static void LogStat(CReaderRequestResultRecursion& recursion,
+                        const CBlob_id& blob_id,
+                        int chunk_id,
+                        CGBRequestStatistics::EStatType stat_type,
+                        const char* descr,
+                        double size,
+                        double time);
     static void LogStat(CReaderRequestResultRecursion& recursion,
                         const CBlob_id& blob_id,
                         CGBRequestStatistics::EStatType stat_type,
@@ -227,6 +227,15 @@ public:
 
     typedef int TSplitVersion;
 
+    // Reply data decoded before processing (possibly in another thread)
+    class CDecodedData : public CObject
+    {
+    public:
+        CRef<CSerialObject> m_Object;
+        size_t m_DataSize;
+        double m_ParseTime;
+    };
+
     void ProcessObjStream(CReaderRequestResult& result,
                           const TBlobId& blob_id,
                           TChunkId chunk_id,
@@ -238,7 +247,13 @@ public:
                      TChunkId chunk_id,
                      const CID2_Reply_Data& data,
                      TSplitVersion split_version = 0,
-                     const CID2_Reply_Data* skel = 0) const;
+                     const CID2_Reply_Data* skel = 0,
+                     const CDecodedData* decoded = 0) const;
+
+    // Decode data which doesn't depend on other replies (Seq-entry or
+    // ID2S-Chunk) without attaching it; null for other data types.
+    // Doesn't use CReaderRequestResult so it can be called in any thread.
+    static CRef<CDecodedData> DecodeData(const CID2_Reply_Data& data);
 
     void SaveData(CReaderRequestResult& result,
                   const TBlobId& blob_id,
@@ -106,6 +106,7 @@ class CPSGAnnotCache;
 class CPSGCDDInfoCache;
 class CPSGBlobMap;
 class CPSGIpgTaxIdMap;
+class CPSGDiskCache;
 class CPSG_Blob_Task;
 class CPSG_PrefetchCDD_Task;
 
@@ -207,6 +208,7 @@ public:
     void GetSequenceHashesOnce(const TIds& ids, TLoaded& loaded, TSequenceHashes& ret, THashKnown& known);
 
     static CObjectIStream* GetBlobDataStream(const CPSG_BlobInfo& blob_info, const CPSG_BlobData& blob_data);
+    static CObjectIStream* GetBlobDataStream(const string& format, const string& compression, CNcbiIstream& data_stream);
 
     struct SReplyResult {
         CTSE_Lock lock;
@@ -283,6 +285,7 @@ private:
     TTaxId x_GetIpgTaxId(const CSeq_id_Handle& idh);
     void x_GetIpgTaxIds(const TIds& ids, TLoaded& loaded, TTaxIds& ret);
     void x_AdjustBlobState(SPsgBlobInfo& blob_info, const CSeq_id_Handle idh);
+    bool x_LoadChunkFromDiskCache(CDataLoader::TChunk chunk);
 
     CPSG_Request_Biodata::EIncludeData m_TSERequestMode = CPSG_Request_Biodata::eSmartTSE;
     CPSG_Request_Biodata::EIncludeData m_TSERequestModeBulk = CPSG_Request_Biodata::eWholeTSE;
@@ -294,6 +297,7 @@ private:
     unique_ptr<CPSGBioseqCache> m_BioseqCache;
     unique_ptr<CPSGAnnotCache> m_AnnotCache;
     unique_ptr<CPSGCDDInfoCache> m_CDDInfoCache;
+    unique_ptr<CPSGDiskCache> m_DiskCache;
     unique_ptr<CThreadPool> m_ThreadPool;
     CRef<CPSG_PrefetchCDD_Task> m_CDDPrefetchTask;
     int m_CacheLifespan;
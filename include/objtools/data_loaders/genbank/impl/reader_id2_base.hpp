@@ -35,6 +35,7 @@
 
 BEGIN_NCBI_SCOPE
 
+class CThreadPool;
 class CByteSourceReader;
 class CObjectIStream;
 class CObjectInfo;
@@ -323,6 +324,10 @@ private:
     };
     typedef vector<SProcessorInfo> TProcessors;
     TProcessors m_Processors;
+
+    // decoding of blob and chunk data in parallel with receiving replies
+    unique_ptr<CThreadPool> m_DecodePool;
+    unsigned m_DecodeThreads;
 };
 
 
@@ -318,6 +318,15 @@ using TPSG_MaxSessions = PSG_PARAM_TYPE(PSG, max_sessions);
 PSG_PARAM_VALUE_DECL_MIN(unsigned, PSG, max_concurrent_requests_per_server);
 using TPSG_MaxConcurrentRequestsPerServer = PSG_PARAM_VALUE_TYPE(PSG, max_concurrent_requests_per_server);
 
+NCBI_PARAM_DECL(bool, PSG, adaptive_concurrency);
+using TPSG_AdaptiveConcurrency = PSG_PARAM_VALUE_TYPE(PSG, adaptive_concurrency);
+
+NCBI_PARAM_DECL(double, PSG, adaptive_concurrency_latency_ratio);
+typedef NCBI_PARAM_TYPE(PSG, adaptive_concurrency_latency_ratio) TPSG_AdaptiveConcurrencyLatencyRatio;
+
+NCBI_PARAM_DECL(bool, PSG, prioritize_resolve);
+using TPSG_PrioritizeResolve = PSG_PARAM_VALUE_TYPE(PSG, prioritize_resolve);
+
 PSG_PARAM_VALUE_DECL_MIN(unsigned, PSG, num_io);
 using TPSG_NumIo = PSG_PARAM_TYPE(PSG, num_io);
 
@@ -0,0 +1,237 @@
+#ifndef ASSIGNHELPER__HPP
+#define ASSIGNHELPER__HPP
+
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Author: agent
+*
+* File Description:
+*   Member assignment and comparison used by datatool-generated
+*   Assign() and Equals() functions
+*/
+
+#include <corelib/ncbistd.hpp>
+#include <corelib/ncbiobj.hpp>
+#include <serial/typeinfo.hpp>
+#include <serial/impl/stdtypes.hpp>
+#include <list>
+#include <vector>
+#include <type_traits>
+
+
+/** @addtogroup GenClassSupport
+ *
+ * @{
+ */
+
+
+BEGIN_NCBI_SCOPE
+
+// Each method has the same semantics as Assign() and Equals() of
+// the corresponding CTypeInfo, so the generated code produces the same
+// results as the generic one.
+class CSerialAssignHelper
+{
+public:
+    // simple types and strings
+    template<class T>
+    static void AssignMember(T& dst, const T& src, ESerialRecursionMode)
+        {
+            dst = src;
+        }
+    template<class T>
+    static bool EqualsMember(const T& obj1, const T& obj2,
+                             ESerialRecursionMode)
+        {
+            return obj1 == obj2;
+        }
+    // floating point values are compared with tolerance
+    static bool EqualsMember(const double& obj1, const double& obj2,
+                             ESerialRecursionMode how)
+        {
+            return obj1 == obj2 ||
+                CStdTypeInfo<double>::GetTypeInfo()->Equals(&obj1, &obj2, how);
+        }
+    static bool EqualsMember(const float& obj1, const float& obj2,
+                             ESerialRecursionMode how)
+        {
+            return obj1 == obj2 ||
+                CStdTypeInfo<float>::GetTypeInfo()->Equals(&obj1, &obj2, how);
+        }
+
+    // class members stored by value
+    template<class T>
+    static void AssignObject(T& dst, const T& src, ESerialRecursionMode how)
+        {
+            T::GetTypeInfo()->Assign(&dst, &src, how);
+        }
+    template<class T>
+    static bool EqualsObject(const T& obj1, const T& obj2,
+                             ESerialRecursionMode how)
+        {
+            return T::GetTypeInfo()->Equals(&obj1, &obj2, how);
+        }
+
+    // CRef<> members and elements
+    template<class T, class L>
+    static void AssignMember(CRef<T, L>& dst, const CRef<T, L>& src,
+                             ESerialRecursionMode how)
+        {
+            const T* data = src.GetPointerOrNull();
+            if ( how != eRecursive ) {
+                dst.Reset(how == eShallow ? const_cast<T*>(data) : 0);
+            }
+            else if ( !data ) {
+                dst.Reset();
+            }
+            else {
+                TTypeInfo type = T::GetTypeInfo()->GetRealTypeInfo(data);
+                TObjectPtr object = type->Create();
+                type->Assign(object, data, how);
+                dst.Reset(static_cast<T*>(object));
+            }
+        }
+    template<class T, class L>
+    static bool EqualsMember(const CRef<T, L>& obj1, const CRef<T, L>& obj2,
+                             ESerialRecursionMode how)
+        {
+            const T* data1 = obj1.GetPointerOrNull();
+            const T* data2 = obj2.GetPointerOrNull();
+            if ( how != eRecursive ) {
+                return how == eShallow ?
+                    (data1 == data2) : (data1 == 0 || data2 == 0);
+            }
+            if ( !data1 ) {
+                return !data2;
+            }
+            if ( !data2 ) {
+                return false;
+            }
+            TTypeInfo type1 = T::GetTypeInfo()->GetRealTypeInfo(data1);
+            TTypeInfo type2 = T::GetTypeInfo()->GetRealTypeInfo(data2);
+            return type1 == type2 && type1->Equals(data1, data2, how);
+        }
+
+    // SEQUENCE OF and SET OF
+    template<class T, class A>
+    static void AssignMember(list<T, A>& dst, const list<T, A>& src,
+                             ESerialRecursionMode how)
+        {
+            if ( how == eShallowChildless ) {
+                dst.clear();
+                return;
+            }
+            if ( &dst == &src ) {
+                return;
+            }
+            typedef list<T, A> TList;
+            // reuse existing elements like CContainerTypeInfo::Assign()
+            typename TList::iterator idst = dst.begin();
+            ITERATE ( typename TList, isrc, src ) {
+                if ( idst != dst.end() ) {
+                    AssignMember(*idst, *isrc, how);
+                    ++idst;
+                }
+                else {
+                    dst.push_back(T());
+                    AssignMember(dst.back(), *isrc, how);
+                }
+            }
+            dst.erase(idst, dst.end());
+        }
+    template<class T, class A>
+    static bool EqualsMember(const list<T, A>& obj1, const list<T, A>& obj2,
+                             ESerialRecursionMode how)
+        {
+            if ( how == eShallowChildless ) {
+                return true;
+            }
+            if ( obj1.size() != obj2.size() ) {
+                return false;
+            }
+            typedef list<T, A> TList;
+            typename TList::const_iterator i2 = obj2.begin();
+            ITERATE ( typename TList, i1, obj1 ) {
+                if ( !EqualsMember(*i1, *i2, how) ) {
+                    return false;
+                }
+                ++i2;
+            }
+            return true;
+        }
+    template<class T, class A>
+    static void AssignMember(vector<T, A>& dst, const vector<T, A>& src,
+                             ESerialRecursionMode how)
+        {
+            if ( how == eShallowChildless ) {
+                dst.clear();
+                return;
+            }
+            if constexpr ( is_arithmetic<T>::value || is_enum<T>::value ) {
+                dst = src;
+            }
+            else {
+                if ( &dst == &src ) {
+                    return;
+                }
+                dst.resize(src.size());
+                for ( size_t i = 0; i < src.size(); ++i ) {
+                    AssignMember(dst[i], src[i], how);
+                }
+            }
+        }
+    template<class T, class A>
+    static bool EqualsMember(const vector<T, A>& obj1,
+                             const vector<T, A>& obj2,
+                             ESerialRecursionMode how)
+        {
+            if ( how == eShallowChildless ) {
+                return true;
+            }
+            if constexpr ( is_integral<T>::value || is_enum<T>::value ) {
+                return obj1 == obj2;
+            }
+            else {
+                if ( obj1.size() != obj2.size() ) {
+                    return false;
+                }
+                for ( size_t i = 0; i < obj1.size(); ++i ) {
+                    if ( !EqualsMember(obj1[i], obj2[i], how) ) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+};
+
+END_NCBI_SCOPE
+
+
+/* @} */
+
+
+#endif  /* ASSIGNHELPER__HPP */
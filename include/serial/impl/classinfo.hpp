@@ -116,6 +116,15 @@ public:
     void SetGlobalHook(const CTempString& member_names,
                        CReadClassMemberHook* hook);
 
+    /// Set direct (datatool-generated) ASN.1 binary member functions.
+    /// They are used by sequential classes for the members without hooks
+    /// on the member or on its type, when the data is read from or written
+    /// to ASN.1 binary stream.
+    CClassTypeInfo* SetDirectFunctions(TMemberDirectReadFunction read,
+                                       TMemberDirectWriteFunction write);
+    TMemberDirectReadFunction GetDirectReadFunction(void) const;
+    TMemberDirectWriteFunction GetDirectWriteFunction(void) const;
+
 public:
 
     // iterators interface
@@ -142,6 +151,9 @@ private:
 
     TGetTypeIdFunction m_GetTypeIdFunction;
 
+    TMemberDirectReadFunction m_DirectReadFunction;
+    TMemberDirectWriteFunction m_DirectWriteFunction;
+
     const CMemberInfo* GetImplicitMember(void) const;
 
 private:
@@ -153,6 +165,9 @@ private:
     static void ReadClassRandom(CObjectIStream& in,
                                 TTypeInfo objectType,
                                 TObjectPtr objectPtr);
+    static void ReadClassDirect(CObjectIStream& in,
+                                TTypeInfo objectType,
+                                TObjectPtr objectPtr);
     static void ReadImplicitMember(CObjectIStream& in,
                                    TTypeInfo objectType,
                                    TObjectPtr objectPtr);
@@ -162,6 +177,9 @@ private:
     static void WriteClassSequential(CObjectOStream& out,
                                      TTypeInfo objectType,
                                      TConstObjectPtr objectPtr);
+    static void WriteClassDirect(CObjectOStream& out,
+                                 TTypeInfo objectType,
+                                 TConstObjectPtr objectPtr);
     static void WriteImplicitMember(CObjectOStream& out,
                                     TTypeInfo objectType,
                                     TConstObjectPtr objectPtr);
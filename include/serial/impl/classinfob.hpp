@@ -96,6 +96,21 @@ public:
     void SetPreWriteFunction(TPreWriteFunction func);
     void SetPostWriteFunction(TPostWriteFunction func);
 
+    /// Set type-specific (datatool-generated) Assign() and Equals()
+    /// of the class data.  They replace the generic member by member
+    /// implementation; user defined CSerialUserOp methods are still called.
+    void SetAssignFunctions(TTypeAssignFunction assign,
+                            TTypeEqualsFunction equals);
+    /// Return null if not set or disabled.
+    TTypeAssignFunction GetAssignFunction(void) const;
+    TTypeEqualsFunction GetEqualsFunction(void) const;
+
+    /// Enable or disable generated Assign() and Equals() globally.
+    /// Default is taken from [SERIAL] GENERATED_ASSIGN parameter
+    /// (environment SERIAL_GENERATED_ASSIGN), and is true.
+    static void SetGeneratedAssignEnabled(bool enable);
+    static bool GetGeneratedAssignEnabled(void);
+
 public:
     // finds type info (throws runtime_error if absent)
     static TTypeInfo GetClassInfoByName(const string& name);
@@ -132,6 +147,9 @@ private:
 
     CItemsInfo m_Items;
 
+    TTypeAssignFunction m_AssignFunction;
+    TTypeEqualsFunction m_EqualsFunction;
+
     mutable unique_ptr<TContainedTypes> m_ContainedTypes;
 
     // class mapping
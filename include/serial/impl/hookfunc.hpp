@@ -47,6 +47,8 @@ BEGIN_NCBI_SCOPE
 class CObjectIStream;
 class CObjectOStream;
 class CObjectStreamCopier;
+class CObjectIStreamAsnBinary;
+class CObjectOStreamAsnBinary;
 class CTypeInfo;
 class CMemberInfo;
 class CVariantInfo;
@@ -72,6 +74,23 @@ typedef void (*TMemberCopyFunction)(CObjectStreamCopier& copier,
                                     const CMemberInfo* memberInfo);
 typedef void (*TMemberSkipFunction)(CObjectIStream& in,
                                     const CMemberInfo* memberInfo);
+
+// Direct (datatool-generated) ASN.1 binary member functions.
+// They return false if the member is left to the generic code.
+typedef bool (*TMemberDirectReadFunction)(CObjectIStreamAsnBinary& in,
+                                          const CMemberInfo* memberInfo,
+                                          TObjectPtr classPtr);
+typedef bool (*TMemberDirectWriteFunction)(CObjectOStreamAsnBinary& out,
+                                           const CMemberInfo* memberInfo,
+                                           TConstObjectPtr classPtr);
+
+// Type-specific (datatool-generated) Assign() and Equals() of class data.
+typedef void (*TTypeAssignFunction)(TObjectPtr dst,
+                                    TConstObjectPtr src,
+                                    ESerialRecursionMode how);
+typedef bool (*TTypeEqualsFunction)(TConstObjectPtr object1,
+                                    TConstObjectPtr object2,
+                                    ESerialRecursionMode how);
 /*
 struct SMemberReadFunctions
 {
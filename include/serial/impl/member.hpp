@@ -132,6 +132,11 @@ public:
 
     bool CanBeDelayed(void) const;
     CMemberInfo* SetDelayBuffer(CDelayBuffer* buffer);
+    /// Delay buffer which is filled only when input stream
+    /// delay buffer parsing policy is eDelayBufferPolicyNeverParse,
+    /// otherwise the member is parsed immediately
+    CMemberInfo* SetLazyDelayBuffer(CDelayBuffer* buffer);
+    bool LazyDelay(void) const;
     CDelayBuffer& GetDelayBuffer(TObjectPtr object) const;
     const CDelayBuffer& GetDelayBuffer(TConstObjectPtr object) const;
 
@@ -177,6 +182,10 @@ public:
     void SetPathCopyHook(CObjectStreamCopier* copier, const string& path,
                          CCopyClassMemberHook* hook);
 
+    /// true if any read (write) hooks are installed for the member
+    bool HaveReadHooks(void) const;
+    bool HaveWriteHooks(void) const;
+
     // default I/O (without hooks)
     void DefaultReadMember(CObjectIStream& in,
                            TObjectPtr classPtr) const;
@@ -205,6 +214,8 @@ private:
     Uint4 m_BitSetMask;
     // offset of delay buffer inside object
     TPointerOffsetType m_DelayOffset;
+    // delay buffer is used only on explicit request
+    bool m_LazyDelay;
 
     TMemberGetConst m_GetConstFunction;
     TMemberGet m_GetFunction;
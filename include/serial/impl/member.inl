@@ -67,12 +67,30 @@ bool CMemberInfo::HaveSetFlag(void) const
     return m_SetFlagOffset != eNoOffset;
 }
 
+inline
+bool CMemberInfo::HaveReadHooks(void) const
+{
+    return m_ReadHookData.HaveHooks();
+}
+
+inline
+bool CMemberInfo::HaveWriteHooks(void) const
+{
+    return m_WriteHookData.HaveHooks();
+}
+
 inline
 bool CMemberInfo::CanBeDelayed(void) const
 {
     return m_DelayOffset != eNoOffset;
 }
 
+inline
+bool CMemberInfo::LazyDelay(void) const
+{
+    return m_LazyDelay;
+}
+
 inline
 CDelayBuffer& CMemberInfo::GetDelayBuffer(TObjectPtr object) const
 {
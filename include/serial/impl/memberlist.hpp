@@ -58,7 +58,6 @@ class NCBI_XSERIAL_EXPORT CItemsInfo
 public:
     typedef CMemberId::TTag TTag;
     typedef vector< AutoPtr<CItemInfo> > TItems;
-    typedef map<CTempString, TMemberIndex, PQuickStringLess> TItemsByName;
     typedef pair< TTag, CAsnBinaryDefs::ETagClass> TTagAndClass;
     typedef map< TTagAndClass, TMemberIndex> TItemsByTag;
     typedef map<size_t, TMemberIndex> TItemsByOffset;
@@ -133,7 +132,17 @@ private:
     CItemsInfo(const CItemsInfo& ) = delete;
     void operator=(const CItemsInfo& ) = delete;
     
-    const TItemsByName& GetItemsByName(void) const;
+    // perfect hash of item names:
+    // bucket of a name selects displacement of its slot in the table
+    struct SItemsByName
+    {
+        size_t m_BucketMask;
+        size_t m_SlotMask;
+        vector<Uint4> m_Displacements;
+        vector<TMemberIndex> m_Slots;
+    };
+
+    const SItemsByName& GetItemsByName(void) const;
     const TItemsByOffset& GetItemsByOffset(void) const;
     TTagAndClass GetTagAndClass(const CIterator& i) const;
     pair<TMemberIndex, const TItemsByTag*> GetItemsByTagInfo(void) const;
@@ -143,7 +152,7 @@ private:
     TItems m_Items;
 
     // items by name
-    mutable atomic<TItemsByName*> m_ItemsByName;
+    mutable atomic<SItemsByName*> m_ItemsByName;
 
     // items by tag
     mutable atomic<TMemberIndex> m_ZeroTagIndex;
@@ -0,0 +1,99 @@
+#ifndef OBJSTRJSON__HPP
+#define OBJSTRJSON__HPP
+
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Author: agent
+*
+* File Description:
+*   Character scanning shared by JSON object streams
+*/
+
+#include <corelib/ncbistd.hpp>
+
+#if NCBI_SSE >= 20
+#  include <emmintrin.h>
+#endif
+
+
+/** @addtogroup ObjStreamSupport
+ *
+ * @{
+ */
+
+
+BEGIN_NCBI_SCOPE
+
+class CJsonDefs
+{
+public:
+    /// Find first char in [pos, end) which cannot be copied as is
+    /// between JSON text and string value: quote, backslash,
+    /// control char (including end of line), and, if stop_on_8bit is set,
+    /// any non-ASCII char.
+    /// Return end if there is no such char.
+    static const char* FindSpecialChar(const char* pos, const char* end,
+                                       bool stop_on_8bit);
+};
+
+
+inline
+const char* CJsonDefs::FindSpecialChar(const char* pos, const char* end,
+                                       bool stop_on_8bit)
+{
+#if NCBI_SSE >= 20
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i ctrl = _mm_set1_epi8(0x1f);
+    int high_mask = stop_on_8bit? 0xffff: 0;
+    for ( ; end - pos >= 16; pos += 16 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        // unsigned v <= 0x1f
+        __m128i special = _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl), ctrl);
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(v, quote));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(v, backslash));
+        int mask = _mm_movemask_epi8(special) | (_mm_movemask_epi8(v) & high_mask);
+        if ( mask ) {
+            // exact position is found by the loop below
+            break;
+        }
+    }
+#endif
+    for ( ; pos < end; ++pos ) {
+        unsigned char c = *pos;
+        if ( c < 0x20 || c == '"' || c == '\\' || (c >= 0x80 && stop_on_8bit) ) {
+            break;
+        }
+    }
+    return pos;
+}
+
+END_NCBI_SCOPE
+
+
+/* @} */
+
+#endif  /* OBJSTRJSON__HPP */
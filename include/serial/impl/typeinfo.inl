@@ -113,6 +113,18 @@ void CTypeInfo::DefaultSkipData(CObjectIStream& in) const
     m_SkipHookData.GetDefaultFunction()(in, this);
 }
 
+inline
+bool CTypeInfo::HaveReadHooks(void) const
+{
+    return m_ReadHookData.HaveHooks();
+}
+
+inline
+bool CTypeInfo::HaveWriteHooks(void) const
+{
+    return m_WriteHookData.HaveHooks();
+}
+
 inline
 bool CTypeInfo::IsCObject(void) const
 {
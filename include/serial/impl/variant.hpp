@@ -117,6 +117,11 @@ public:
 
     bool CanBeDelayed(void) const;
     CVariantInfo* SetDelayBuffer(CDelayBuffer* buffer);
+    /// Delay buffer which is filled only when input stream
+    /// delay buffer parsing policy is eDelayBufferPolicyNeverParse,
+    /// otherwise the variant is parsed immediately
+    CVariantInfo* SetLazyDelayBuffer(CDelayBuffer* buffer);
+    bool LazyDelay(void) const;
     CDelayBuffer& GetDelayBuffer(TObjectPtr object) const;
     const CDelayBuffer& GetDelayBuffer(TConstObjectPtr object) const;
 
@@ -159,6 +164,10 @@ public:
     void SetPathCopyHook(CObjectStreamCopier* copier, const string& path,
                          CCopyChoiceVariantHook* hook);
 
+    /// true if any read (write) hooks are installed for the variant
+    bool HaveReadHooks(void) const;
+    bool HaveWriteHooks(void) const;
+
     // default I/O (without hooks)
     void DefaultReadVariant(CObjectIStream& in,
                             TObjectPtr choicePtr) const;
@@ -180,6 +189,8 @@ private:
     EVariantType m_VariantType;
     // offset of delay buffer inside object
     TPointerOffsetType m_DelayOffset;
+    // delay buffer is used only on explicit request
+    bool m_LazyDelay;
 
     TVariantGetConst m_GetConstFunction;
     TVariantGet m_GetFunction;
@@ -80,6 +80,18 @@ CVariantInfo* CVariantInfo::SetNsQualified(bool qualified)
     return this;
 }
 
+inline
+bool CVariantInfo::HaveReadHooks(void) const
+{
+    return m_ReadHookData.HaveHooks();
+}
+
+inline
+bool CVariantInfo::HaveWriteHooks(void) const
+{
+    return m_WriteHookData.HaveHooks();
+}
+
 inline
 bool CVariantInfo::IsInline(void) const
 {
@@ -134,6 +146,12 @@ bool CVariantInfo::CanBeDelayed(void) const
     return m_DelayOffset != eNoOffset;
 }
 
+inline
+bool CVariantInfo::LazyDelay(void) const
+{
+    return m_LazyDelay;
+}
+
 inline
 CDelayBuffer& CVariantInfo::GetDelayBuffer(TObjectPtr object) const
 {
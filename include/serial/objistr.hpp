@@ -520,7 +520,10 @@ public:
         eDelayBufferPolicyNotSet,
         /// Parse always
         eDelayBufferPolicyAlwaysParse,
-        /// Never parse
+        /// Never parse.
+        /// Also delays SEQUENCE OF and SET OF members generated with
+        /// '_delay_containers' definition: they are kept as raw data
+        /// and parsed when the member is accessed for the first time.
         eDelayBufferPolicyNeverParse
     };
     void SetDelayBufferParsingPolicy(EDelayBufferParsing policy);
@@ -802,7 +805,10 @@ public:
 //---------------------------------------------------------------------------
 // Internals
 
-    // memory pool to use to create new objects when reading data
+    // memory pool to use to create new objects when reading data,
+    // the pool is not synchronized, so it can be shared only by streams
+    // used in the same thread; the pool memory is released in chunks
+    // when all objects are deleted
     void SetMemoryPool(CObjectMemoryPool* memory_pool)
         {
             m_MemoryPool = memory_pool;
@@ -811,7 +817,8 @@ public:
         {
             return m_MemoryPool;
         }
-    // create and set new memory pool
+    // create and set new memory pool,
+    // it's done automatically if [SERIAL] READ_MEMORY_POOL parameter is set
     void UseMemoryPool(void);
 
     // internal reader
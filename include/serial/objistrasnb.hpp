@@ -139,6 +139,22 @@ public:
     virtual void ReadBitString(CBitString& obj) override;
     virtual void SkipBitString(void) override;
 
+    /// Use direct (datatool-generated) class member decoders if available,
+    /// the default is taken from [SERIAL] READ_DIRECT_CODECS parameter
+    void SetUseDirectCodecs(bool set=true)
+    {
+        m_UseDirectCodecs = set;
+    }
+    bool GetUseDirectCodecs(void) const
+    {
+        return m_UseDirectCodecs;
+    }
+
+    /// Read class using its direct member decoder,
+    /// see CClassTypeInfo::SetDirectFunctions()
+    void ReadClassDirect(const CClassTypeInfo* classType,
+                         TObjectPtr classPtr);
+
 protected:
     virtual bool ReadBool(void) override;
     virtual char ReadChar(void) override;
@@ -263,6 +279,7 @@ private:
 #endif
     size_t m_CurrentTagLength;  // length of tag header (without length field)
     bool m_SkipNextTag;
+    bool m_UseDirectCodecs;
 #if USE_DEF_LEN
     Int8 m_CurrentDataLimit;
     vector<Int8> m_DataLimits;
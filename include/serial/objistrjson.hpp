@@ -222,7 +222,10 @@ private:
     int ReadEscapedChar(bool* encoded=0);
     char ReadEncodedChar(EStringType type, bool& encoded);
     TUnicodeSymbol ReadUtf8Char(char c);
+    bool x_ReadPlainChars(string& str, EStringType type);
     string x_ReadString(EStringType type);
+    bool x_PeekNumber(CTempString& str, bool allow_minus);
+    double x_ParseDouble(const CTempString& str);
     void x_ReadData(string& data, EStringType type = eStringTypeUTF8);
     bool x_ReadDataAndCheck(string& data, EStringType type = eStringTypeUTF8);
     void   x_SkipData(void);
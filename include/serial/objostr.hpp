@@ -209,6 +209,12 @@ public:
     void FixNonPrintSubst(char subst) {
         m_NonPrintSubst = subst;
     }
+    EFixNonPrint GetFixNonPrint(void) const {
+        return m_FixMethod;
+    }
+    char GetFixNonPrintSubst(void) const {
+        return m_NonPrintSubst;
+    }
 
     // Enforce explicit writing of values with default,
     // even when they were never set
@@ -411,6 +417,11 @@ public:
     void SetPathWriteObjectHook( const string& path, CWriteObjectHook*        hook);
     void SetPathWriteMemberHook( const string& path, CWriteClassMemberHook*   hook);
     void SetPathWriteVariantHook(const string& path, CWriteChoiceVariantHook* hook);
+
+    /// Check if writing of the type may call write hooks: local or path
+    /// hooks of this stream, or any hooks of the type, its members,
+    /// choice variants, and container elements
+    bool HaveWriteHooks(TTypeInfo type) const;
     
     /// DelayBuffer parsing policy
     enum EDelayBufferParsing {
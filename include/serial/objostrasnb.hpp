@@ -129,6 +129,25 @@ public:
         return m_CStyleBigInt;
     }
 
+    /// Use direct (datatool-generated) class member encoders if available,
+    /// the default is taken from [SERIAL] WRITE_DIRECT_CODECS parameter
+    void SetUseDirectCodecs(bool set=true)
+    {
+        m_UseDirectCodecs = set;
+    }
+    bool GetUseDirectCodecs(void) const
+    {
+        return m_UseDirectCodecs;
+    }
+
+    /// Write class using its direct member encoder,
+    /// see CClassTypeInfo::SetDirectFunctions()
+    void WriteClassDirect(const CClassTypeInfo* classType,
+                          TConstObjectPtr classPtr);
+    /// Begin and end the current member in direct member encoder
+    void BeginDirectMember(void);
+    void EndDirectMember(void);
+
 private:
     void WriteByte(Uint1 byte);
     template<typename T> void WriteBytesOf(const T& value, size_t count);
@@ -260,6 +279,7 @@ private:
     bool m_CStyleBigInt;
     bool m_SkipNextTag;
     bool m_AutomaticTagging;
+    bool m_UseDirectCodecs;
 };
 
 
@@ -239,7 +239,7 @@ private:
     void BeginValue(void);
     void WriteValue(const string& value,
                     EStringType type = eStringTypeVisible);
-    void WriteKeywordValue(const string& value);
+    void WriteKeywordValue(const CTempString& value);
     void StartBlock(void);
     void EndBlock(void);
     void NextElement(void);
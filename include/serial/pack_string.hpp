@@ -36,14 +36,95 @@
 
 #include <string>
 #include <set>
+#include <atomic>
+#include <memory>
 
 BEGIN_NCBI_SCOPE
 
+/// Interned strings table which can be used concurrently by many threads.
+/// Lookup and insertion are lock-free, the table is split in shards
+/// with open addressing.  Entries are never removed, so the table has
+/// fixed capacity and refuses new strings when it's full.
+class NCBI_XSERIAL_EXPORT CPackStringTable
+{
+public:
+    explicit CPackStringTable(size_t capacity);
+    ~CPackStringTable(void);
+
+    /// Process-wide table used by CPackString in shared mode.
+    /// Its capacity is set by [SERIAL] PACK_STRINGS_TABLE_SIZE parameter.
+    /// The table is never destroyed, so its strings stay valid
+    /// until the process exits.
+    static CPackStringTable& GetInstance(void);
+
+    /// Find string equal to [data, data+size), or insert new one.
+    /// Return the stored string and true if it was inserted by this call.
+    /// Return null pointer if the table has no room for the string.
+    pair<const string*, bool> Intern(const char* data, size_t size);
+    /// Find string equal to [data, data+size), return null if not found.
+    const string* Find(const char* data, size_t size) const;
+
+    size_t GetCapacity(void) const;
+    size_t GetCount(void) const;
+
+    CNcbiOstream& DumpStatistics(CNcbiOstream& out) const;
+
+private:
+    CPackStringTable(const CPackStringTable&);
+    CPackStringTable& operator=(const CPackStringTable&);
+
+    struct SEntry {
+        SEntry(size_t hash, const char* data, size_t size)
+            : m_Hash(hash), m_String(data, size)
+            {
+            }
+        bool Equals(size_t hash, const char* data, size_t size) const
+            {
+                return m_Hash == hash && m_String.size() == size &&
+                    memcmp(m_String.data(), data, size) == 0;
+            }
+
+        size_t m_Hash;
+        string m_String;
+    };
+    enum {
+        kShardBits = 6,
+        kShardCount = 1 << kShardBits,
+        kMaxProbes = 32
+    };
+    struct SShard {
+        SShard(void)
+            : m_Count(0)
+            {
+            }
+
+        unique_ptr<atomic<SEntry*>[]> m_Slots;
+        atomic<size_t> m_Count;
+        // keep shards on separate cache lines
+        char m_Padding[64-sizeof(unique_ptr<int[]>)-sizeof(atomic<size_t>)];
+    };
+
+    static size_t x_Hash(const char* data, size_t size);
+
+    size_t m_SlotMask;
+    size_t m_ShardLimit;
+    SShard m_Shards[kShardCount];
+};
+
+
 class NCBI_XSERIAL_EXPORT CPackString
 {
 public:
+    /// Shared mode: use process-wide CPackStringTable instead of
+    /// own set of strings
+    enum EShared {
+        eShared
+    };
+
     CPackString(void);
     CPackString(size_t length_limit, size_t count_limit);
+    explicit CPackString(EShared shared);
+    CPackString(EShared shared, size_t length_limit);
     ~CPackString(void);
 
     struct SNode {
@@ -117,6 +198,8 @@ public:
     size_t GetCountLimit(void) const;
     size_t GetCount(void) const;
 
+    bool IsShared(void) const;
+
     // return true if the string is new in cache
     bool Pack(string& s);
     bool Pack(string& s, const char* data, size_t size);
@@ -140,6 +223,9 @@ private:
     // return true if src was updated
     static bool x_Assign(string& s, const string& src);
 
+    bool x_PackShared(string& s, const char* data, size_t size);
+
+    CPackStringTable* m_SharedTable;
     size_t m_LengthLimit;
     size_t m_CountLimit;
     size_t m_Skipped;
@@ -154,6 +240,8 @@ class NCBI_XSERIAL_EXPORT CPackStringClassHook : public CReadClassMemberHook
 public:
     CPackStringClassHook(void);
     CPackStringClassHook(size_t length_limit, size_t count_limit);
+    explicit CPackStringClassHook(CPackString::EShared shared);
+    CPackStringClassHook(CPackString::EShared shared, size_t length_limit);
     ~CPackStringClassHook(void);
     
     void ReadClassMember(CObjectIStream& in, const CObjectInfoMI& member);
@@ -168,6 +256,8 @@ class NCBI_XSERIAL_EXPORT CPackStringChoiceHook : public CReadChoiceVariantHook
 public:
     CPackStringChoiceHook(void);
     CPackStringChoiceHook(size_t length_limit, size_t count_limit);
+    explicit CPackStringChoiceHook(CPackString::EShared shared);
+    CPackStringChoiceHook(CPackString::EShared shared, size_t length_limit);
     ~CPackStringChoiceHook(void);
 
     void ReadChoiceVariant(CObjectIStream& in, const CObjectInfoCV& variant);
@@ -177,6 +267,17 @@ private:
 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+// CPackStringTable
+/////////////////////////////////////////////////////////////////////////////
+
+inline
+size_t CPackStringTable::GetCapacity(void) const
+{
+    return m_ShardLimit*kShardCount;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // CPackString
 /////////////////////////////////////////////////////////////////////////////
@@ -202,6 +303,13 @@ size_t CPackString::GetCount(void) const
 }
 
 
+inline
+bool CPackString::IsShared(void) const
+{
+    return m_SharedTable != 0;
+}
+
+
 inline
 bool CPackString::Assign(string& s, const string& src)
 {
@@ -256,6 +364,7 @@ pair<CPackString::iterator, bool>
 CPackString::Locate(const char* data, size_t size)
 {
     pair<iterator, bool> ret;
+    _ASSERT(!IsShared());
     _ASSERT(size <= GetLengthLimit());
     SNode key(data, size);
     ret.first = m_Strings.lower_bound(key);
@@ -43,6 +43,7 @@
 #include <serial/impl/aliasinfo.hpp>
 #include <serial/impl/classinfohelper.hpp>
 #include <serial/impl/objstrasnb.hpp>
+#include <serial/impl/assignhelper.hpp>
 
 
 /** @addtogroup GenClassSupport
@@ -29,7 +29,7 @@
 * Authors: Andrei Gourianov, Alexander Astashyn
 *
 * File Description:
-*   Input stream iterators
+*   Input stream iterators, asynchronous output stream writer
 * Please note:
 *   This API requires multi-threading
 */
@@ -37,6 +37,7 @@
 #include <corelib/ncbistd.hpp>
 #include <corelib/ncbithr.hpp>
 #include <serial/objistr.hpp>
+#include <serial/objostrasnb.hpp>
 #include <serial/objectio.hpp>
 
 #include <queue>
@@ -44,6 +45,7 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 
 
 /** @addtogroup ObjStreamSupport
@@ -465,6 +467,174 @@ public:
 
 
 
+/////////////////////////////////////////////////////////////////////////////
+///   CObjectOStreamAsyncWriter
+///
+///  Asynchronously write multiple same-type data objects into an output
+///  stream as elements of a container (SET OF, SEQUENCE OF), preserving
+///  their order
+///  @sa CObjectIStreamAsyncIterator
+///
+///  Objects passed to Write() are encoded in separate threads, each batch
+///  into its own memory buffer, and the buffers are emitted into the output
+///  stream in the same order in which the objects were passed.
+///  Optionally, the objects are processed (modified) by a user function in
+///  the same threads right before encoding, which makes it possible to
+///  build read-process-write pipelines that use several cores:
+///  CObjectIStreamAsyncIterator parses the input in parallel, and the writer
+///  processes and encodes the objects in parallel.
+///
+///  Independent encoding is possible only if the encoded data of a container
+///  element do not depend on their position in the stream, which is true for
+///  ASN.1 binary format. With other formats the objects are still processed
+///  asynchronously, but they are written into the output stream in the thread
+///  which calls Write() and Flush().
+///
+///  Usage:
+///  @code
+///
+///  // read top-level Seq-entries and write them, cleaned up,
+///  // into the seq-set of a Bioseq-set
+///  CObjectOStreamAsyncWriter<CSeq_entry>::CParams params;
+///  params.Process([](CSeq_entry& entry) { CCleanup().BasicCleanup(entry); });
+///
+///  // ...write members of Bioseq-set preceding seq-set...
+///  {
+///      CObjectOStreamAsyncWriter<CSeq_entry> writer(ostr,
+///          CObjectTypeInfo(CType<CBioseq_set>()).FindMember("seq-set").GetMemberType(),
+///          params);
+///      for (CSeq_entry& entry : CObjectIStreamAsyncIterator<CSeq_entry>(istr)) {
+///          writer.Write(Ref(&entry));
+///      }
+///      writer.Flush();
+///  }
+///  // ...write members of Bioseq-set following seq-set...
+///
+///  @endcode
+///
+///  @attention
+///   An object must not be modified by the caller after it was passed to
+///   Write(). The writer keeps a reference to it until it is written.
+
+template<typename TObj>
+class CObjectOStreamAsyncWriter
+{
+public:
+    /// Object processing function
+    using FProcess = function<void(TObj&)>;
+
+    /// Asynchronous writing parameters
+    class CParams
+    {
+    public:
+        CParams(void)
+            : m_ThreadPolicy(launch::async)
+            , m_MaxEncoderThreads(16)
+            , m_ObjectsPerTask(1) {
+        }
+
+        /// Process objects before encoding
+        /// @note
+        ///   The function is called from different threads
+        CParams& Process(FProcess fn) {
+            m_FnProcess = fn;  return *this;
+        }
+
+        /// Encoding thread launch policy
+        CParams& LaunchPolicy(launch policy) {
+            m_ThreadPolicy = policy; return *this;
+        }
+
+        /// Maximum number of encoding threads.
+        /// Write() waits for the earliest task when this number is reached.
+        CParams& MaxEncoderThreads(unsigned max_encoder_threads) {
+            m_MaxEncoderThreads = max_encoder_threads;  return *this;
+        }
+
+        /// Number of objects processed and encoded by a single task
+        CParams& ObjectsPerTask(size_t objects_per_task) {
+            m_ObjectsPerTask = objects_per_task;  return *this;
+        }
+
+    private:
+        FProcess  m_FnProcess;
+        launch    m_ThreadPolicy;
+        unsigned  m_MaxEncoderThreads;
+        size_t    m_ObjectsPerTask;
+
+        friend class CObjectOStreamAsyncWriter;
+    };
+
+    /// Start writing a container into an object serialization stream
+    ///
+    /// @param ostr
+    ///   Serial object stream
+    /// @param containerType
+    ///   Type of the container (or of a class with a single container member)
+    /// @param params
+    ///   Processing and encoding parameters
+    CObjectOStreamAsyncWriter(CObjectOStream& ostr,
+                              const CObjectTypeInfo& containerType,
+                              const CParams& params = CParams());
+
+    /// Write elements of a container which has been started by the caller,
+    /// for example from a write hook
+    ///
+    /// @param ostr
+    ///   Serial object stream
+    /// @param params
+    ///   Processing and encoding parameters
+    CObjectOStreamAsyncWriter(CObjectOStream& ostr,
+                              const CParams& params = CParams());
+
+    /// Write pending objects, and end the container if it was started
+    /// by the writer
+    ~CObjectOStreamAsyncWriter();
+
+    /// Schedule writing of the next data object
+    void Write(CRef<TObj> object);
+
+    /// Wait for all scheduled objects and write them into the stream.
+    /// Exceptions thrown while processing or encoding objects are
+    /// rethrown here, and by Write().
+    void Flush(void);
+
+    /// Check whether objects are encoded in parallel: the stream is
+    /// ASN.1 binary and no write hooks may be called for the objects
+    bool IsParallelEncoding(void) const;
+
+private:
+    CObjectOStreamAsyncWriter(const CObjectOStreamAsyncWriter&) = delete;
+    CObjectOStreamAsyncWriter& operator=(const CObjectOStreamAsyncWriter&) = delete;
+
+    using TObjects = vector< CRef<TObj> >;
+    struct SEncoded {
+        TObjects m_Objects; // objects to be written by the output stream
+        string   m_Data;    // encoded objects
+    };
+
+    void x_Init(void);
+    SEncoded x_ProcessAndEncode(TObjects objects) const;
+    void x_Submit(void);
+    void x_Emit(bool all);
+
+    CObjectOStream&               m_Out;
+    size_t                        m_StackDepth;
+    bool                          m_OwnContainer;
+    TTypeInfo                     m_NamedType;
+    TTypeInfo                     m_ElementType;
+    CParams                       m_Params;
+    bool                          m_Encode;
+    ESerialVerifyData             m_VerifyData;
+    EFixNonPrint                  m_FixMethod;
+    char                          m_NonPrintSubst;
+    bool                          m_CStyleBigInt;
+    bool                          m_UseDirectCodecs;
+    TObjects                      m_Batch;
+    queue< future<SEncoded> >     m_Futures;
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 /// template specializations and implementation
@@ -1696,6 +1866,220 @@ CObjectIStreamAsyncIterator<TRoot, TChild>::sx_ClearGarbageAndParse(
 
 
 
+/////////////////////////////////////////////////////////////////////////////
+///  CObjectOStreamAsyncWriter implementation
+
+template<typename TObj>
+CObjectOStreamAsyncWriter<TObj>::CObjectOStreamAsyncWriter(
+        CObjectOStream& ostr, const CObjectTypeInfo& containerType,
+        const CParams& params)
+    : m_Out(ostr)
+    , m_StackDepth(ostr.GetStackDepth())
+    , m_OwnContainer(true)
+    , m_NamedType(nullptr)
+    , m_Params(params)
+{
+    // same frames as in COStreamContainer
+    const CContainerTypeInfo* containerTypeInfo;
+    if (containerType.GetTypeFamily() == eTypeFamilyClass) {
+        const CClassTypeInfo* classType = containerType.GetClassTypeInfo();
+        containerTypeInfo = CTypeConverter<CContainerTypeInfo>::SafeCast(
+            classType->GetItems().GetItemInfo(
+                classType->GetItems().FirstIndex())->GetTypeInfo());
+        m_NamedType = classType;
+        m_Out.PushFrame(CObjectStackFrame::eFrameNamed, m_NamedType);
+        m_Out.BeginNamedType(m_NamedType);
+    } else {
+        containerTypeInfo = containerType.GetContainerTypeInfo();
+    }
+    m_Out.PushFrame(CObjectStackFrame::eFrameArray, containerTypeInfo);
+    m_Out.BeginContainer(containerTypeInfo);
+    m_ElementType = containerTypeInfo->GetElementType();
+    m_Out.PushFrame(CObjectStackFrame::eFrameArrayElement, m_ElementType);
+    x_Init();
+}
+
+template<typename TObj>
+CObjectOStreamAsyncWriter<TObj>::CObjectOStreamAsyncWriter(
+        CObjectOStream& ostr, const CParams& params)
+    : m_Out(ostr)
+    , m_StackDepth(ostr.GetStackDepth())
+    , m_OwnContainer(false)
+    , m_NamedType(nullptr)
+    , m_ElementType(TObj::GetTypeInfo())
+    , m_Params(params)
+{
+    x_Init();
+}
+
+template<typename TObj>
+void CObjectOStreamAsyncWriter<TObj>::x_Init(void)
+{
+    if (m_Params.m_MaxEncoderThreads == 0) {
+        m_Params.m_MaxEncoderThreads = 16;
+    }
+    if (m_Params.m_ObjectsPerTask == 0) {
+        m_Params.m_ObjectsPerTask = 1;
+    }
+    // hooks of the output stream are not called by encoding streams,
+    // so with hooks the objects are written in the caller's thread
+    m_Encode = m_Out.GetDataFormat() == eSerial_AsnBinary &&
+        !m_Out.HaveWriteHooks(m_ElementType);
+    m_VerifyData = m_Out.GetVerifyData();
+    m_FixMethod = m_Out.GetFixNonPrint();
+    m_NonPrintSubst = m_Out.GetFixNonPrintSubst();
+    m_CStyleBigInt = false;
+    m_UseDirectCodecs = false;
+    if (m_Encode) {
+        const CObjectOStreamAsnBinary& bout =
+            dynamic_cast<const CObjectOStreamAsnBinary&>(m_Out);
+        m_CStyleBigInt = bout.GetCStyleBigInt();
+        m_UseDirectCodecs = bout.GetUseDirectCodecs();
+    }
+}
+
+template<typename TObj>
+CObjectOStreamAsyncWriter<TObj>::~CObjectOStreamAsyncWriter()
+{
+    try {
+        Flush();
+    }
+    catch (...) {
+        m_Out.SetFailFlags(CObjectOStream::fIllegalCall,
+            "async container write error");
+        // pending tasks are waited for, but nothing else is written
+        queue< future<SEncoded> > dummy;
+        swap(m_Futures, dummy);
+    }
+    if (!m_OwnContainer) {
+        return;
+    }
+    if (m_Out.InGoodState()) {
+        try {
+            m_Out.PopFrame();
+            m_Out.EndContainer();
+            m_Out.PopFrame();
+            if (m_NamedType) {
+                m_Out.EndNamedType();
+                m_Out.PopFrame();
+            }
+        }
+        catch (...) {
+            m_Out.SetFailFlags(CObjectOStream::fIllegalCall,
+                "container write error");
+        }
+    }
+    if (m_Out.GetStackDepth() != m_StackDepth) {
+        try {
+            m_Out.PopErrorFrame();
+        }
+        catch (...) {
+            m_Out.SetFailFlags(CObjectOStream::fIllegalCall,
+                "object stack frame error");
+        }
+    }
+}
+
+template<typename TObj>
+bool CObjectOStreamAsyncWriter<TObj>::IsParallelEncoding(void) const
+{
+    return m_Encode;
+}
+
+template<typename TObj>
+void CObjectOStreamAsyncWriter<TObj>::Write(CRef<TObj> object)
+{
+    m_Batch.push_back(object);
+    if (m_Batch.size() >= m_Params.m_ObjectsPerTask) {
+        x_Submit();
+    }
+    x_Emit(false);
+}
+
+template<typename TObj>
+void CObjectOStreamAsyncWriter<TObj>::Flush(void)
+{
+    if (!m_Batch.empty()) {
+        x_Submit();
+    }
+    x_Emit(true);
+}
+
+template<typename TObj>
+void CObjectOStreamAsyncWriter<TObj>::x_Submit(void)
+{
+    TObjects objects;
+    swap(objects, m_Batch);
+    m_Futures.push( async( m_Params.m_ThreadPolicy,
+        &CObjectOStreamAsyncWriter<TObj>::x_ProcessAndEncode, this,
+        std::move(objects)));
+}
+
+// Write results of finished tasks in the order of submission.
+// Unless 'all' is set, wait only while the number of pending tasks
+// exceeds the limit.
+template<typename TObj>
+void CObjectOStreamAsyncWriter<TObj>::x_Emit(bool all)
+{
+    while (!m_Futures.empty()) {
+        if (!all && m_Futures.size() < m_Params.m_MaxEncoderThreads &&
+            m_Futures.front().wait_for(chrono::seconds(0)) != future_status::ready) {
+            break;
+        }
+        // remove the task before get(), which rethrows its exception
+        future<SEncoded> front = std::move(m_Futures.front());
+        m_Futures.pop();
+        SEncoded encoded = front.get();
+        if (!encoded.m_Data.empty()) {
+            // ASN.1 binary elements are concatenated encodings of objects
+            m_Out.BeginContainerElement(m_ElementType);
+            m_Out.Write(encoded.m_Data.data(), encoded.m_Data.size());
+            m_Out.EndContainerElement();
+        }
+        for (const CRef<TObj>& object : encoded.m_Objects) {
+            m_Out.BeginContainerElement(m_ElementType);
+            m_Out.WriteSeparateObject(ConstObjectInfo(*object));
+            m_Out.EndContainerElement();
+        }
+    }
+}
+
+template<typename TObj>
+typename CObjectOStreamAsyncWriter<TObj>::SEncoded
+CObjectOStreamAsyncWriter<TObj>::x_ProcessAndEncode(TObjects objects) const
+{
+    if (m_Params.m_FnProcess) {
+        for (CRef<TObj>& object : objects) {
+            m_Params.m_FnProcess(*object);
+        }
+    }
+    SEncoded encoded;
+    if (!m_Encode) {
+        swap(encoded.m_Objects, objects);
+        return encoded;
+    }
+    CNcbiOstrstream ostrs;
+    {{
+        unique_ptr<CObjectOStream> ostr(
+            CObjectOStream::Open(eSerial_AsnBinary, ostrs));
+        ostr->SetVerifyData(m_VerifyData);
+        ostr->FixNonPrint(m_FixMethod);
+        ostr->FixNonPrintSubst(m_NonPrintSubst);
+        CObjectOStreamAsnBinary& bout =
+            static_cast<CObjectOStreamAsnBinary&>(*ostr);
+        bout.SetCStyleBigInt(m_CStyleBigInt);
+        bout.SetUseDirectCodecs(m_UseDirectCodecs);
+        for (const CRef<TObj>& object : objects) {
+            ostr->WriteObject(object.GetPointer(), object->GetThisTypeInfo());
+        }
+    }}
+    encoded.m_Data = CNcbiOstrstreamToString(ostrs);
+    // objects get destroyed here, if last-reference,
+    // offloading this from the writing thread
+    return encoded;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 // Iterate over objects in input stream
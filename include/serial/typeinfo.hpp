@@ -233,6 +233,10 @@ public:
     void SetPathCopyHook(CObjectStreamCopier* copier, const string& path,
                          CCopyObjectHook* hook);
 
+    /// true if any read (write) hooks are installed for the type
+    bool HaveReadHooks(void) const;
+    bool HaveWriteHooks(void) const;
+
     // default methods without checking hook
     void DefaultReadData(CObjectIStream& in, TObjectPtr object) const;
     void DefaultWriteData(CObjectOStream& out, TConstObjectPtr object) const;
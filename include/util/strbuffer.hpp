@@ -121,6 +121,9 @@ public:
     //     (limit if not found)
     size_t PeekFindChar(char c, size_t limit)
         THROWS1((CIOException));
+    // return number of chars available in buffer without extracting them,
+    // the buffer is filled if it's empty; zero means end of data
+    size_t PeekAvailableChars(void);
 
     const char* GetCurrentPos(void) const THROWS1_NONE;
     // returns true if succeeded
@@ -87,6 +87,14 @@ bool CIStreamBuffer::SkipExpectedChars(char c1, char c2, size_t offset)
     return SkipExpectedChar(c1, offset) && SkipExpectedChar(c2, 0);
 }
 
+inline
+size_t CIStreamBuffer::PeekAvailableChars(void)
+{
+    if ( m_CurrentPos >= m_DataEndPos && !TryToFillBuffer() )
+        return 0;
+    return m_DataEndPos - m_CurrentPos;
+}
+
 inline
 bool CIStreamBuffer::HasMore(void)
 {
@@ -206,7 +206,50 @@ CNSAffinityRegistry::ResolveAffinityToken(const string &     token,
         return 0;
 
     CMutexGuard                             guard(m_Lock);
+    return x_ResolveAffinityToken(token, job_id, client_id, cmd_group);
+}
+
+
+// Adds the batch jobs to their affinities under a single lock.
+// The jobs have sequential identifiers starting from first_job_id and
+// tokens[k] is the affinity of the k-th job (empty if no affinity).
+// The batch jobs often share the same affinity so the last resolved
+// token is remembered to avoid a dictionary search per job.
+void
+CNSAffinityRegistry::ResolveAffinityTokens(const vector<string> &  tokens,
+                                           unsigned int            first_job_id,
+                                           vector<unsigned int> &  aff_ids)
+{
+    aff_ids.assign(tokens.size(), 0);
+
+    CMutexGuard         guard(m_Lock);
+    const string *      last_token = NULL;
+    unsigned int        last_aff_id = 0;
+
+    for (size_t  k = 0; k < tokens.size(); ++k) {
+        const string &  token = tokens[k];
+        if (token.empty())
+            continue;
+
+        unsigned int    job_id = first_job_id + k;
+        if (last_token != NULL && *last_token == token) {
+            m_JobsAffinity[last_aff_id].AddJob(job_id);
+        } else {
+            last_aff_id = x_ResolveAffinityToken(token, job_id, 0, eUndefined);
+            last_token = &token;
+        }
+        aff_ids[k] = last_aff_id;
+    }
+}
+
 
+// Must be called under m_Lock
+unsigned int
+CNSAffinityRegistry::x_ResolveAffinityToken(const string &     token,
+                                            unsigned int       job_id,
+                                            unsigned int       client_id,
+                                            ECommandGroup      cmd_group)
+{
     // Search for this affinity token
     map< const string *,
          unsigned int,
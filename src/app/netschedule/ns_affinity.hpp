@@ -171,6 +171,9 @@ class CNSAffinityRegistry
                                            unsigned int    job_id,
                                            unsigned int    client_id,
                                            ECommandGroup   command_group);
+        void  ResolveAffinityTokens(const vector<string> &  tokens,
+                                    unsigned int            first_job_id,
+                                    vector<unsigned int> &  aff_ids);
         void  ResolveAffinities(const list< string > &  tokens,
                                 TNSBitVector &  resolved_affs,
                                 vector<unsigned int> &  aff_ids);
@@ -229,6 +232,11 @@ class CNSAffinityRegistry
                                      const TNSBitVector &  aff_ids,
                                      bool                  is_wait_client,
                                      ECommandGroup         cmd_group);
+        unsigned int
+        x_ResolveAffinityToken(const string &  token,
+                               unsigned int    job_id,
+                               unsigned int    client_id,
+                               ECommandGroup   command_group);
         void x_DeleteAffinity(unsigned int                   aff_id,
                               map<unsigned int,
                                   SNSJobsAffinity>::iterator found_aff);
@@ -56,7 +56,8 @@ const AlertToId     alertToIdMap[] = {
     { eMaxQueues,           "MaxQueues" },
     { eDumpLoadError,       "DumpLoadError" },
     { eDumpSpaceError,      "DumpSpaceError" },
-    { eDataDirRemoveError,  "DataDirRemoveError" } };
+    { eDataDirRemoveError,  "DataDirRemoveError" },
+    { eJournalError,        "JournalError" } };
 const size_t        alertToIdMapSize = sizeof(alertToIdMap) / sizeof(AlertToId);
 
 
@@ -57,7 +57,8 @@ enum EAlertType {
     eMaxQueues = 9,
     eDumpLoadError = 10,
     eDumpSpaceError = 11,
-    eDataDirRemoveError = 12
+    eDataDirRemoveError = 12,
+    eJournalError = 13
 };
 
 enum EAlertAckResult {
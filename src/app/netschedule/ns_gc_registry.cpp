@@ -65,6 +65,19 @@ void CJobGCRegistry::RegisterJob(unsigned int            job_id,
 }
 
 
+// Registers a batch of jobs in the GC registry under a single lock.
+// The batch job IDs are allocated sequentially and normally are greater
+// than any registered ID so the insertion is done with the end() hint.
+void CJobGCRegistry::RegisterBatch(
+                const vector< pair<unsigned int, SJobGCInfo> > &  jobs)
+{
+    CFastMutexGuard     guard(m_Lock);
+
+    for (const auto &  item : jobs)
+        m_JobsAttrs.insert(m_JobsAttrs.end(), item);
+}
+
+
 void CJobGCRegistry::ChangeAffinityAndGroup(unsigned int    job_id,
                                             unsigned int    aff_id,
                                             unsigned int    group_id)
@@ -41,6 +41,7 @@
 #include <corelib/ncbimtx.hpp>
 
 #include <map>
+#include <vector>
 
 #include "ns_precise_time.hpp"
 #include "ns_types.hpp"
@@ -85,6 +86,8 @@ class CJobGCRegistry
                          unsigned int            aff_id,
                          unsigned int            group_id,
                          const CNSPreciseTime &  life_time);
+        void RegisterBatch(
+                const vector< pair<unsigned int, SJobGCInfo> > &  jobs);
         void ChangeAffinityAndGroup(unsigned int    job_id,
                                     unsigned int    aff_id,
                                     unsigned int    group_id);
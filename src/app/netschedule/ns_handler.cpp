@@ -1530,6 +1530,7 @@ void CNetScheduleHandler::x_ProcessMsgBatchSubmit(BUF buffer)
                                                      m_BatchGroup,
                                                      x_NeedCmdLogging(),
                                                      m_RollbackAction);
+        x_SyncJournal(GetQueue());
         double      db_elapsed = sw.Elapsed();
 
         if (x_NeedCmdLogging())
@@ -1826,6 +1827,7 @@ void CNetScheduleHandler::x_ProcessSubmit(CQueue* q)
                                          m_CommandArguments.group,
                                          x_NeedCmdLogging(),
                                          m_RollbackAction);
+        x_SyncJournal(q);
 
         x_WriteMessage(kOKResponsePrefix + q->MakeJobKey(job_id) +
                        kEndOfResponse);
@@ -4499,6 +4501,20 @@ void CNetScheduleHandler::x_ExecuteRollbackAction(CQueue * q)
 }
 
 
+// A submit is acknowledged only when the submitted jobs are in the queue
+// journal on the disk. If they cannot be written the submit is rolled back.
+void CNetScheduleHandler::x_SyncJournal(CQueue * q)
+{
+    try {
+        q->SyncJournal();
+    } catch (const exception &  ex) {
+        x_ExecuteRollbackAction(q);
+        NCBI_THROW(CNetScheduleException, eInternalError,
+                   "Error writing the queue journal: " + string(ex.what()));
+    }
+}
+
+
 void CNetScheduleHandler::x_CreateConnContext(void)
 {
     CSocket &       socket = GetSocket();
@@ -4658,7 +4674,11 @@ string CNetScheduleHandler::x_GetServerSection(void) const
            m_Server->GetGroupRegistrySettings().Serialize("group", "", "\n") +
            m_Server->GetScopeRegistrySettings().Serialize("scope", "", "\n") +
            "reserve_dump_space=\"" +
-                to_string(m_Server->GetReserveDumpSpace()) + "\"\n";
+                to_string(m_Server->GetReserveDumpSpace()) + "\"\n"
+           "journal=\"" +
+                NStr::BoolToString(m_Server->GetJournal()) + "\"\n"
+           "journal_max_size=\"" +
+                to_string(m_Server->GetJournalMaxSize()) + "\"\n";
 }
 
 
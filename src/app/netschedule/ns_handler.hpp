@@ -258,6 +258,7 @@ private:
 
     void x_ClearRollbackAction(void);
     void x_ExecuteRollbackAction(CQueue * q);
+    void x_SyncJournal(CQueue * q);
 
     string x_GetServerSection(void) const;
     string x_GetStoredSectionValues(const string &  section_name,
@@ -97,6 +97,8 @@ const unsigned int      default_scope_dirt_percentage = 20;
 const unsigned int      default_reserve_dump_space = 1024 * 1024 * 1024; // 1GB
 const unsigned int      default_max_queues = 1000;
 const bool              default_diskless = false;
+const bool              default_journal = false;
+const unsigned int      default_journal_max_size = 256 * 1024 * 1024; // 256MB
 
 
 // Queue section values
@@ -0,0 +1,617 @@
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * File Description:
+ *   NetSchedule append only job journal.
+ *
+ */
+
+#include <ncbi_pch.hpp>
+
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <corelib/ncbifile.hpp>
+#include <util/checksum.hpp>
+
+#include "ns_journal.hpp"
+#include "ns_db_dump.hpp"
+
+
+BEGIN_NCBI_SCOPE
+
+
+SJournalRecordHeader::SJournalRecordHeader() :
+    magic(kJournalRecordMagic),
+    record_type(eJournalJob),
+    job_id(0),
+    aff_token_size(0),
+    group_token_size(0),
+    job_size(0),
+    checksum(0)
+{}
+
+
+static Uint4 s_Checksum(const char *  data, size_t  size)
+{
+    CChecksum       crc(CChecksum::eCRC32);
+    crc.AddChars(data, size);
+    return crc.GetChecksum();
+}
+
+
+static void s_Write(FILE *  f, const void *  data, size_t  size)
+{
+    if (size == 0)
+        return;
+
+    errno = 0;
+    if (fwrite(data, size, 1, f) != 1)
+        throw runtime_error("Journal writing error: " +
+                            string(strerror(errno)));
+}
+
+
+
+static const char *  kBaseSuffix = ".base";
+static const char *  kRotatedSuffix = ".rotated";
+
+
+// A journal file opened for reading
+struct SJournalInput
+{
+    FILE *          f;
+    SJobDumpHeader  header;
+
+    SJournalInput() : f(NULL)
+    {}
+
+    ~SJournalInput()
+    {
+        if (f != NULL)
+            fclose(f);
+    }
+
+    // Returns false if the file does not exist or is empty
+    bool Open(const string &  file_name)
+    {
+        if (!CFile(file_name).Exists())
+            return false;
+        f = fopen(file_name.c_str(), "rb");
+        if (f == NULL)
+            throw runtime_error("Cannot open journal " + file_name);
+        return header.Read(f) == 0;
+    }
+};
+
+
+CNSJobJournal::CNSJobJournal(const string &  file_name) :
+    m_FileName(file_name),
+    m_BaseFileName(file_name + kBaseSuffix),
+    m_RotatedFileName(file_name + kRotatedSuffix),
+    m_File(NULL), m_Size(0), m_BaseSize(0),
+    m_Closed(false), m_Removed(false)
+{
+    x_Open();
+
+    CFile       base_file(m_BaseFileName);
+    if (base_file.Exists())
+        m_BaseSize = base_file.GetLength();
+}
+
+
+CNSJobJournal::~CNSJobJournal()
+{
+    try {
+        Close(false);
+    } catch (...) {}
+}
+
+
+void CNSJobJournal::Commit(const vector<SJournalJob> &   jobs,
+                           const vector<unsigned int> &  deleted_jobs)
+{
+    if (jobs.empty() && deleted_jobs.empty())
+        return;
+
+    CFastMutexGuard     guard(m_Lock);
+    if (m_Closed)
+        return;     // The queue has been deleted
+    if (m_File == NULL) {
+        // The active log could not be re-created at rotation or restored
+        // after a failed commit
+        m_Size = 0;
+        x_Open();
+    }
+
+    Uint8       commit_start = m_Size;
+    try {
+        for (vector<SJournalJob>::const_iterator  k = jobs.begin();
+                k != jobs.end(); ++k)
+            m_Size += x_WriteRecord(m_File, *k);
+        for (vector<unsigned int>::const_iterator  k = deleted_jobs.begin();
+                k != deleted_jobs.end(); ++k)
+            m_Size += x_WriteDeleted(m_File, *k);
+
+        // One sync per commit regardless of the number of records
+        x_Sync(m_File);
+    } catch (...) {
+        // The caller reports the commit as failed so none of its records
+        // may be loaded, and the next commits must not follow torn bytes
+        x_Truncate(commit_start);
+        throw;
+    }
+}
+
+
+void CNSJobJournal::Compact(void)
+{
+    {{
+        CFastMutexGuard     guard(m_Lock);
+        if (m_Closed)
+            return;
+
+        // A rotated log left by a failed merge is merged first and the
+        // active log keeps growing till then
+        if (!CFile(m_RotatedFileName).Exists()) {
+            if (m_File != NULL) {
+                fclose(m_File);
+                m_File = NULL;
+            }
+            if (rename(m_FileName.c_str(), m_RotatedFileName.c_str()) != 0) {
+                string      err = strerror(errno);
+                x_Open();
+                throw runtime_error("Cannot rotate journal " + m_FileName +
+                                    ": " + err);
+            }
+            m_Size = 0;
+            x_Open();
+        }
+    }}
+
+    Uint8       base_size = x_Merge();
+
+    CFastMutexGuard     guard(m_Lock);
+    if (m_Removed) {
+        // The queue has been deleted while merging
+        remove(m_BaseFileName.c_str());
+        remove(m_RotatedFileName.c_str());
+        return;
+    }
+    m_BaseSize = base_size;
+}
+
+
+void CNSJobJournal::Reset(const vector<SJournalJob> &  jobs)
+{
+    CFastMutexGuard     guard(m_Lock);
+    if (m_Closed)
+        return;
+
+    x_WriteBase(m_BaseFileName, jobs);
+    remove(m_RotatedFileName.c_str());
+
+    // Restart the active log
+    if (m_File != NULL) {
+        fclose(m_File);
+        m_File = NULL;
+    }
+    if (remove(m_FileName.c_str()) != 0 && errno != ENOENT)
+        throw runtime_error("Cannot remove journal " + m_FileName + ": " +
+                            string(strerror(errno)));
+    m_Size = 0;
+    x_Open();
+    m_BaseSize = CFile(m_BaseFileName).GetLength();
+}
+
+
+void CNSJobJournal::Close(bool  remove_file)
+{
+    CFastMutexGuard     guard(m_Lock);
+
+    m_Closed = true;
+    if (m_File != NULL) {
+        fclose(m_File);
+        m_File = NULL;
+    }
+    if (remove_file) {
+        vector<string>      file_names = GetFileNames(m_FileName);
+        for (const auto &  name : file_names)
+            remove(name.c_str());
+        m_Removed = true;
+    }
+}
+
+
+Uint8 CNSJobJournal::GetSize(void) const
+{
+    return m_Size;
+}
+
+
+// The order is the order of loading
+vector<string> CNSJobJournal::GetFileNames(const string &  file_name)
+{
+    vector<string>      file_names;
+    file_names.push_back(file_name + kBaseSuffix);
+    file_names.push_back(file_name + kRotatedSuffix);
+    file_names.push_back(file_name);
+    return file_names;
+}
+
+
+bool CNSJobJournal::Exists(const string &  file_name)
+{
+    vector<string>      file_names = GetFileNames(file_name);
+    for (const auto &  name : file_names)
+        if (CFile(name).Exists())
+            return true;
+    return false;
+}
+
+
+unsigned int CNSJobJournal::Load(const string &         file_name,
+                                 IJournalJobConsumer &  consumer)
+{
+    vector<string>      file_names = GetFileNames(file_name);
+    SJournalInput       inputs[3];
+    TRecordIndex        index;
+
+    for (size_t  k = 0; k < file_names.size(); ++k)
+        if (inputs[k].Open(file_names[k]))
+            x_BuildIndex(inputs[k].f, k, index);
+
+    unsigned int        count = 0;
+    SJournalJob         journal_job;
+    AutoArray<char>     input_buf(new char[kNetScheduleMaxOverflowSize]);
+    AutoArray<char>     output_buf(new char[kNetScheduleMaxOverflowSize]);
+    for (TRecordIndex::const_iterator  k = index.begin();
+            k != index.end(); ++k) {
+        SJournalInput &         input = inputs[k->second.file_index];
+        SJournalRecordHeader    rec_header;
+
+        if (fseeko(input.f, k->second.offset, SEEK_SET) != 0 ||
+            fread(&rec_header, sizeof(rec_header), 1, input.f) != 1)
+            throw runtime_error("Journal reading error");
+
+        journal_job.aff_token.resize(rec_header.aff_token_size);
+        journal_job.group_token.resize(rec_header.group_token_size);
+        if (rec_header.aff_token_size > 0 &&
+            fread(&journal_job.aff_token[0],
+                  rec_header.aff_token_size, 1, input.f) != 1)
+            throw runtime_error("Journal reading error");
+        if (rec_header.group_token_size > 0 &&
+            fread(&journal_job.group_token[0],
+                  rec_header.group_token_size, 1, input.f) != 1)
+            throw runtime_error("Journal reading error");
+
+        if (!journal_job.job.LoadFromDump(input.f, input_buf.get(),
+                                          output_buf.get(), input.header))
+            throw runtime_error("Unexpected end of the journal");
+
+        consumer.OnJournalJob(journal_job);
+        ++count;
+    }
+    return count;
+}
+
+
+void CNSJobJournal::x_Open(void)
+{
+    CFile       journal_file(m_FileName);
+
+    if (journal_file.Exists()) {
+        // Cut off a possible torn write of the last commit
+        Uint8       valid_size = 0;
+        {{
+            SJournalInput   input;
+            if (input.Open(m_FileName)) {
+                TRecordIndex    index;
+                valid_size = x_BuildIndex(input.f, 0, index);
+            }
+        }}
+
+        if (valid_size == 0) {
+            // Not even a header; start from scratch
+            journal_file.Remove();
+        } else {
+            if (static_cast<Uint8>(journal_file.GetLength()) != valid_size) {
+                ERR_POST(Warning << "Journal " << m_FileName
+                                 << " has an incomplete last commit. "
+                                    "It is truncated to "
+                                 << valid_size << " bytes.");
+                if (truncate(m_FileName.c_str(), valid_size) != 0)
+                    throw runtime_error("Cannot truncate journal " +
+                                        m_FileName + ": " +
+                                        string(strerror(errno)));
+            }
+            m_Size = valid_size;
+        }
+    }
+
+    if (m_Size == 0) {
+        m_File = fopen(m_FileName.c_str(), "wb");
+        if (m_File == NULL)
+            throw runtime_error("Cannot create journal " + m_FileName);
+
+        SJobDumpHeader      header;
+        header.Write(m_File);
+        x_Sync(m_File);
+        m_Size = sizeof(header);
+    } else {
+        m_File = fopen(m_FileName.c_str(), "ab");
+        if (m_File == NULL)
+            throw runtime_error("Cannot open journal " + m_FileName);
+    }
+}
+
+
+// Cuts the active log back to the given size after a failed commit.
+// If the log cannot be cut, it is left closed and the next commit reopens
+// it the same way as at startup.
+void CNSJobJournal::x_Truncate(Uint8  size)
+{
+    // Buffered bytes of the failed commit are flushed or dropped by fclose;
+    // either way they are cut off below
+    fclose(m_File);
+    m_File = NULL;
+
+    if (truncate(m_FileName.c_str(), size) != 0) {
+        ERR_POST("Cannot truncate journal " << m_FileName << " to "
+                 << size << " bytes after a failed commit: "
+                 << strerror(errno));
+        return;
+    }
+    m_Size = size;
+    m_File = fopen(m_FileName.c_str(), "ab");
+    if (m_File == NULL)
+        ERR_POST("Cannot reopen journal " << m_FileName
+                 << " after a failed commit: " << strerror(errno));
+}
+
+
+void CNSJobJournal::x_Sync(FILE *  f)
+{
+    if (fflush(f) != 0 || fdatasync(fileno(f)) != 0)
+        throw runtime_error("Journal syncing error: " +
+                            string(strerror(errno)));
+}
+
+
+// Merges the rotated log into the snapshot and removes the rotated log.
+// The records are copied as they are; there is no need to parse the jobs.
+// Returns the size of the new snapshot.
+Uint8 CNSJobJournal::x_Merge(void)
+{
+    string              file_names[2] = { m_BaseFileName, m_RotatedFileName };
+    SJournalInput       inputs[2];
+    TRecordIndex        index;
+
+    for (size_t  k = 0; k < 2; ++k)
+        if (inputs[k].Open(file_names[k]))
+            x_BuildIndex(inputs[k].f, k, index);
+
+    string      tmp_file_name = m_BaseFileName + ".tmp";
+    FILE *      dst = fopen(tmp_file_name.c_str(), "wb");
+    if (dst == NULL)
+        throw runtime_error("Cannot create file " + tmp_file_name);
+
+    Uint8       size = 0;
+    char *      buffer = NULL;
+    try {
+        SJobDumpHeader      new_header;
+        new_header.Write(dst);
+        size = sizeof(new_header);
+
+        size_t      buffer_size = 0;
+        for (TRecordIndex::const_iterator  k = index.begin();
+                k != index.end(); ++k) {
+            FILE *      src = inputs[k->second.file_index].f;
+            if (k->second.size > buffer_size) {
+                free(buffer);
+                buffer_size = k->second.size;
+                buffer = (char *) malloc(buffer_size);
+                if (buffer == NULL)
+                    throw runtime_error("Memory allocation error while "
+                                        "compacting the journal");
+            }
+            if (fseeko(src, k->second.offset, SEEK_SET) != 0 ||
+                fread(buffer, k->second.size, 1, src) != 1)
+                throw runtime_error("Journal reading error while compacting");
+            s_Write(dst, buffer, k->second.size);
+            size += k->second.size;
+        }
+        free(buffer);
+        buffer = NULL;
+
+        x_Sync(dst);
+        fclose(dst);
+        dst = NULL;
+    } catch (...) {
+        free(buffer);
+        if (dst != NULL)
+            fclose(dst);
+        remove(tmp_file_name.c_str());
+        throw;
+    }
+
+    // The new snapshot has all the rotated log records so a crash between
+    // the rename and the removal only makes them loaded twice
+    if (rename(tmp_file_name.c_str(), m_BaseFileName.c_str()) != 0) {
+        string      err = strerror(errno);
+        remove(tmp_file_name.c_str());
+        throw runtime_error("Cannot replace journal " + m_BaseFileName +
+                            ": " + err);
+    }
+    remove(m_RotatedFileName.c_str());
+    return size;
+}
+
+
+// Atomically replaces the snapshot with the given jobs
+void CNSJobJournal::x_WriteBase(const string &  file_name,
+                                const vector<SJournalJob> &  jobs)
+{
+    string      tmp_file_name = file_name + ".tmp";
+    FILE *      dst = fopen(tmp_file_name.c_str(), "wb");
+    if (dst == NULL)
+        throw runtime_error("Cannot create file " + tmp_file_name);
+
+    try {
+        SJobDumpHeader      header;
+        header.Write(dst);
+
+        for (vector<SJournalJob>::const_iterator  k = jobs.begin();
+                k != jobs.end(); ++k)
+            x_WriteRecord(dst, *k);
+
+        if (fflush(dst) != 0 || fdatasync(fileno(dst)) != 0)
+            throw runtime_error("Journal syncing error: " +
+                                string(strerror(errno)));
+    } catch (...) {
+        fclose(dst);
+        remove(tmp_file_name.c_str());
+        throw;
+    }
+
+    fclose(dst);
+    if (rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+        string      err = strerror(errno);
+        remove(tmp_file_name.c_str());
+        throw runtime_error("Cannot replace journal " + file_name +
+                            ": " + err);
+    }
+}
+
+
+Uint8 CNSJobJournal::x_WriteRecord(FILE *  f, const SJournalJob &  journal_job)
+{
+    // The job is serialized into memory first because the record header
+    // needs its size and checksum
+    char *      job_buf = NULL;
+    size_t      job_size = 0;
+    FILE *      mem_file = open_memstream(&job_buf, &job_size);
+    if (mem_file == NULL)
+        throw runtime_error("Cannot create memory stream for a journal record");
+
+    try {
+        journal_job.job.Dump(mem_file);
+    } catch (...) {
+        fclose(mem_file);
+        free(job_buf);
+        throw;
+    }
+    fclose(mem_file);
+
+    SJournalRecordHeader    header;
+    header.record_type = eJournalJob;
+    header.job_id = journal_job.job.GetId();
+    header.aff_token_size = journal_job.aff_token.size();
+    header.group_token_size = journal_job.group_token.size();
+    header.job_size = job_size;
+
+    CChecksum       crc(CChecksum::eCRC32);
+    crc.AddChars(journal_job.aff_token.data(), journal_job.aff_token.size());
+    crc.AddChars(journal_job.group_token.data(),
+                 journal_job.group_token.size());
+    crc.AddChars(job_buf, job_size);
+    header.checksum = crc.GetChecksum();
+
+    try {
+        s_Write(f, &header, sizeof(header));
+        s_Write(f, journal_job.aff_token.data(), journal_job.aff_token.size());
+        s_Write(f, journal_job.group_token.data(),
+                journal_job.group_token.size());
+        s_Write(f, job_buf, job_size);
+    } catch (...) {
+        free(job_buf);
+        throw;
+    }
+
+    free(job_buf);
+    return sizeof(header) + header.aff_token_size +
+           header.group_token_size + job_size;
+}
+
+
+Uint8 CNSJobJournal::x_WriteDeleted(FILE *  f, unsigned int  job_id)
+{
+    SJournalRecordHeader    header;
+    header.record_type = eJournalJobDeleted;
+    header.job_id = job_id;
+    header.checksum = s_Checksum(NULL, 0);
+
+    s_Write(f, &header, sizeof(header));
+    return sizeof(header);
+}
+
+
+// Scans the records starting from the current position and updates the
+// job ID -> (file, offset, size) index of the latest records of the alive
+// jobs.
+// Returns the offset where the last valid record ends.
+Uint8 CNSJobJournal::x_BuildIndex(FILE *  f, size_t  file_index,
+                                  TRecordIndex &  index)
+{
+    Uint8       offset = ftello(f);
+    string      payload;
+
+    for (;;) {
+        SJournalRecordHeader    header;
+        if (fread(&header, sizeof(header), 1, f) != 1)
+            break;
+        if (header.magic != kJournalRecordMagic)
+            break;
+
+        size_t      payload_size = static_cast<size_t>(header.aff_token_size) +
+                                   header.group_token_size + header.job_size;
+        payload.resize(payload_size);
+        if (payload_size > 0 && fread(&payload[0], payload_size, 1, f) != 1)
+            break;
+        if (s_Checksum(payload.data(), payload_size) != header.checksum)
+            break;
+
+        Uint4       record_size = sizeof(header) + payload_size;
+        if (header.record_type == eJournalJob) {
+            SRecordPos &    pos = index[header.job_id];
+            pos.file_index = file_index;
+            pos.offset = offset;
+            pos.size = record_size;
+        }
+        else if (header.record_type == eJournalJobDeleted)
+            index.erase(header.job_id);
+        else
+            break;
+
+        offset += record_size;
+    }
+    return offset;
+}
+
+
+END_NCBI_SCOPE
+
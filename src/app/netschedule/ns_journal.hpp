@@ -0,0 +1,199 @@
+#ifndef NETSCHEDULE_JOURNAL__HPP
+#define NETSCHEDULE_JOURNAL__HPP
+
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * File Description:
+ *   NetSchedule append only job journal.
+ *
+ */
+
+#include "ns_types.hpp"
+#include "job.hpp"
+
+#include <corelib/ncbitype.h>
+#include <corelib/ncbimtx.hpp>
+
+#include <stdio.h>
+#include <vector>
+#include <map>
+
+
+// NB
+// A queue journal consists of up to three files:
+// - <name>.base: the compacted snapshot, i.e. the latest records of the jobs
+//   which existed at the last compaction
+// - <name>.rotated: the log which is being merged into the snapshot
+// - <name>: the active log the commits are appended to
+// Each file starts with the same header as the jobs dump file
+// (SJobDumpHeader). It is followed by a sequence of records. Each record
+// consists of a fixed size header, the job affinity and group tokens and
+// the job itself in the dump format (see CJob::Dump()).
+// The records are appended to the active log in groups (one group per
+// commit) and each commit is followed by fdatasync(). A record which does not
+// have all its bytes or which checksum does not match is considered as a torn
+// write of the last commit. Such a record and everything after it is
+// discarded when the journal is loaded.
+// The files are loaded in the order listed above and a later record of a job
+// overrides the earlier ones. Merging the rotated log into the snapshot is
+// idempotent so a crash at any step of a compaction loses nothing.
+
+
+BEGIN_NCBI_SCOPE
+
+
+enum EJournalRecordType {
+    eJournalJob        = 1,     // The job state follows the record header
+    eJournalJobDeleted = 2      // The job has been deleted
+};
+
+
+#pragma pack(push, 1)
+struct SJournalRecordHeader
+{
+    Uint4       magic;
+    Uint4       record_type;
+    Uint4       job_id;
+    Uint4       aff_token_size;
+    Uint4       group_token_size;
+    Uint4       job_size;
+    Uint4       checksum;           // CRC32 of the tokens and the job
+
+    SJournalRecordHeader();
+};
+#pragma pack(pop)
+
+
+// The job as it is saved in the journal. The affinity and group are saved as
+// tokens because their IDs are not persistent between the server restarts.
+struct SJournalJob
+{
+    CJob        job;
+    string      aff_token;
+    string      group_token;
+};
+
+
+// Interface to receive the loaded jobs
+class IJournalJobConsumer
+{
+    public:
+        virtual ~IJournalJobConsumer() {}
+        virtual void OnJournalJob(SJournalJob &  journal_job) = 0;
+};
+
+
+
+// The journal is appended to by the service thread and by the submitting
+// threads (see CQueue::SyncJournal()); the commits are serialized by the
+// queue. The lock protects the active log file which is also switched by
+// a compaction and closed when a queue is deleted.
+class CNSJobJournal
+{
+    public:
+        CNSJobJournal(const string &  file_name);
+        ~CNSJobJournal();
+
+        // Appends the records and makes them durable. If it throws, the
+        // records written so far are cut off the active log.
+        void Commit(const vector<SJournalJob> &   jobs,
+                    const vector<unsigned int> &  deleted_jobs);
+
+        // Rotates the active log and merges it into the snapshot. The lock
+        // is held only while the active log is switched, so the commits are
+        // not blocked by the merge. Must not be called concurrently with
+        // itself.
+        void Compact(void);
+
+        // Replaces the journal content with the given jobs
+        void Reset(const vector<SJournalJob> &  jobs);
+
+        // Closes the journal and optionally removes the files
+        void Close(bool  remove_file);
+
+        // The size of the active log
+        Uint8 GetSize(void) const;
+
+        // True if the active log exceeds the given size and the snapshot,
+        // so the merge cost is amortized by the appended records
+        bool NeedCompaction(Uint8  max_size) const
+        { return m_Size > max_size && m_Size > m_BaseSize; }
+        const string &  GetFileName(void) const
+        { return m_FileName; }
+
+        // All the files which may belong to the journal
+        static vector<string> GetFileNames(const string &  file_name);
+        // True if any of the journal files exists
+        static bool Exists(const string &  file_name);
+
+        // Reads the journal and provides the latest state of the jobs which
+        // have not been deleted in the order of the job IDs.
+        // Returns the number of the provided jobs.
+        static unsigned int Load(const string &         file_name,
+                                 IJournalJobConsumer &  consumer);
+
+    private:
+        struct SRecordPos
+        {
+            size_t      file_index;
+            Uint8       offset;
+            Uint4       size;
+        };
+        typedef map<unsigned int, SRecordPos>   TRecordIndex;
+
+        void x_Open(void);
+        void x_Truncate(Uint8  size);
+        void x_Sync(FILE *  f);
+        Uint8 x_Merge(void);
+        static void x_WriteBase(const string &  file_name,
+                                const vector<SJournalJob> &  jobs);
+
+        static Uint8 x_WriteRecord(FILE *  f, const SJournalJob &  journal_job);
+        static Uint8 x_WriteDeleted(FILE *  f, unsigned int  job_id);
+        static Uint8 x_BuildIndex(FILE *  f, size_t  file_index,
+                                  TRecordIndex &  index);
+
+    private:
+        string          m_FileName;
+        string          m_BaseFileName;
+        string          m_RotatedFileName;
+        FILE *          m_File;
+        Uint8           m_Size;
+        Uint8           m_BaseSize;
+        bool            m_Closed;
+        bool            m_Removed;
+        CFastMutex      m_Lock;
+
+    private:
+        CNSJobJournal(const CNSJobJournal &);
+        CNSJobJournal & operator=(const CNSJobJournal &);
+};
+
+
+END_NCBI_SCOPE
+
+#endif /* NETSCHEDULE_JOURNAL__HPP */
+
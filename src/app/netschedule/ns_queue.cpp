@@ -479,6 +479,7 @@ unsigned int  CQueue::Submit(const CNSClientId &        client,
         }
 
         m_Jobs[job_id] = job;
+        x_JournalJob(job_id);
 
         m_StatusTracker.AddPendingJob(job_id);
 
@@ -570,10 +571,21 @@ CQueue::SubmitBatch(const CNSClientId &             client,
         }
 
         group_id = m_GroupRegistry.ResolveGroup(group);
+
+        // Resolve all the batch affinities under one registry lock
+        vector<unsigned int>    aff_ids;
+        if (!aff_tokens.empty()) {
+            vector<string>      job_aff_tokens;
+            job_aff_tokens.reserve(batch_size);
+            for (size_t  k = 0; k < batch_size; ++k)
+                job_aff_tokens.push_back(batch[k].second);
+            m_AffinityRegistry.ResolveAffinityTokens(job_aff_tokens,
+                                                     job_id, aff_ids);
+        }
+
         for (size_t  k = 0; k < batch_size; ++k) {
 
             CJob &              job = batch[k].first;
-            const string &      aff_token = batch[k].second;
             CJobEvent &         event = job.AppendEvent();
 
             job.SetId(job_id_cnt);
@@ -588,23 +600,21 @@ CQueue::SubmitBatch(const CNSClientId &             client,
             event.SetClientNode(client.GetNode());
             event.SetClientSession(client.GetSession());
 
-            if (!aff_token.empty()) {
-                unsigned int    aff_id = m_AffinityRegistry.
-                                        ResolveAffinityToken(aff_token,
-                                                             job_id_cnt,
-                                                             0,
-                                                             eUndefined);
-
-                job.SetAffinityId(aff_id);
-                affinities.set_bit(aff_id);
+            if (!aff_ids.empty() && aff_ids[k] != 0) {
+                job.SetAffinityId(aff_ids[k]);
+                affinities.set_bit(aff_ids[k]);
             }
 
-            m_Jobs[job_id_cnt] = job;
+            // The batch IDs are normally the largest ones so the end()
+            // hint makes the insertion amortized constant
+            m_Jobs.emplace_hint(m_Jobs.end(), job_id_cnt, job);
             ++job_id_cnt;
         }
 
         m_GroupRegistry.AddJobs(group_id, job_id, batch_size);
         m_StatusTracker.AddPendingBatch(job_id, job_id + batch_size - 1);
+        if (m_Journal.get() != NULL)
+            m_JournalDirtyJobs.set_range(job_id, job_id + batch_size - 1);
         m_ClientsRegistry.AddToSubmitted(client, batch_size);
 
         if (!scope.empty())
@@ -625,16 +635,22 @@ CQueue::SubmitBatch(const CNSClientId &             client,
                                        m_HandicapTimeout,
                                        eGet);
 
+        // Register the whole batch in the GC registry at once to avoid
+        // taking the registry lock per job
+        vector< pair<unsigned int, SJobGCInfo> >    gc_jobs;
+        gc_jobs.reserve(batch_size);
         for (size_t  k = 0; k < batch_size; ++k) {
-            m_GCRegistry.RegisterJob(
-                        batch[k].first.GetId(), curr_time,
-                        batch[k].first.GetAffinityId(), group_id,
-                        batch[k].first.GetExpirationTime(m_Timeout,
+            SJobGCInfo      gc_info(batch[k].first.GetAffinityId(), group_id,
+                                    batch[k].first.GetExpirationTime(
+                                                         m_Timeout,
                                                          m_RunTimeout,
                                                          m_ReadTimeout,
                                                          m_PendingTimeout,
                                                          curr_time));
+            gc_info.m_SubmitTime = curr_time;
+            gc_jobs.push_back(make_pair(batch[k].first.GetId(), gc_info));
         }
+        m_GCRegistry.RegisterBatch(gc_jobs);
     }}
 
     m_StatisticsCounters.CountSubmit(batch_size);
@@ -684,6 +700,7 @@ TJobStatus  CQueue::PutResult(const CNSClientId &     client,
     m_StatisticsCounters.CountTransition(old_status,
                                          CNetScheduleAPI::eDone);
     g_DoPerfLogging(*this, job, 200);
+    x_JournalJob(job.GetId());
     m_ClientsRegistry.UnregisterJob(job_id, eGet);
 
     m_GCRegistry.UpdateLifetime(job_id,
@@ -873,6 +890,7 @@ CQueue::GetJobOrWait(const CNSClientId &       client,
                                         CNetScheduleAPI::ePending,
                                         CNetScheduleAPI::eRunning);
             g_DoPerfLogging(*this, *new_job, 200);
+            x_JournalJob(new_job->GetId());
             if (outdated_job)
                 m_StatisticsCounters.CountOutdatedPick(eGet);
 
@@ -1156,6 +1174,7 @@ TJobStatus  CQueue::JobDelayExpiration(unsigned int            job_id,
 
     job_iter->second.SetRunTimeout(curr + tm - time_start);
     job_iter->second.SetLastTouch(curr);
+    x_JournalJob(job_id);
 
     // No need to update the GC registry because the running (and reading)
     // jobs are skipped by GC
@@ -1204,6 +1223,7 @@ TJobStatus  CQueue::JobDelayReadExpiration(unsigned int            job_id,
 
     job_iter->second.SetReadTimeout(curr + tm - time_start);
     job_iter->second.SetLastTouch(curr);
+    x_JournalJob(job_id);
 
     // No need to update the GC registry because the running (and reading)
     // jobs are skipped by GC
@@ -1346,6 +1366,7 @@ bool CQueue::PutProgressMessage(unsigned int    job_id,
 
     job_iter->second.SetProgressMsg(msg);
     job_iter->second.SetLastTouch(curr);
+    x_JournalJob(job_id);
 
     m_GCRegistry.UpdateLifetime(
         job_id, job_iter->second.GetExpirationTime(m_Timeout, m_RunTimeout,
@@ -1445,6 +1466,7 @@ TJobStatus  CQueue::ReturnJob(const CNSClientId &     client,
             break;
     }
     g_DoPerfLogging(*this, job_iter->second, 200);
+    x_JournalJob(job_iter->second.GetId());
     TimeLineRemove(job_id);
     m_ClientsRegistry.UnregisterJob(job_id, eGet);
     if (how == eWithBlacklist)
@@ -1565,6 +1587,7 @@ TJobStatus  CQueue::RescheduleJob(const CNSClientId &     client,
     m_StatusTracker.SetStatus(job_id, CNetScheduleAPI::ePending);
     m_StatisticsCounters.CountToPendingRescheduled(1);
     g_DoPerfLogging(*this, job_iter->second, 200);
+    x_JournalJob(job_iter->second.GetId());
 
     TimeLineRemove(job_id);
     m_ClientsRegistry.UnregisterJob(job_id, eGet);
@@ -1626,6 +1649,7 @@ TJobStatus  CQueue::RedoJob(const CNSClientId &     client,
     m_StatusTracker.SetStatus(job_id, CNetScheduleAPI::ePending);
     m_StatisticsCounters.CountRedo(old_status);
     g_DoPerfLogging(*this, job_iter->second, 200);
+    x_JournalJob(job_iter->second.GetId());
 
     m_GCRegistry.UpdateLifetime(
         job_id, job_iter->second.GetExpirationTime(m_Timeout, m_RunTimeout,
@@ -1726,6 +1750,7 @@ TJobStatus  CQueue::Cancel(const CNSClientId &  client,
         m_StatisticsCounters.CountTransition(old_status,
                                              CNetScheduleAPI::eCanceled);
         g_DoPerfLogging(*this, job_iter->second, 200);
+        x_JournalJob(job_iter->second.GetId());
     }
 
     TimeLineRemove(job_id);
@@ -1826,6 +1851,7 @@ unsigned int CQueue::x_CancelJobs(const CNSClientId &   client,
         m_StatisticsCounters.CountTransition(old_status,
                                              CNetScheduleAPI::eCanceled);
         g_DoPerfLogging(*this, job_iter->second, 200);
+        x_JournalJob(job_iter->second.GetId());
 
         TimeLineRemove(job_id);
         if (old_status == CNetScheduleAPI::eRunning)
@@ -2171,6 +2197,7 @@ CQueue::GetJobForReadingOrWait(const CNSClientId &       client,
             m_StatisticsCounters.CountTransition(old_status,
                                                  CNetScheduleAPI::eReading);
             g_DoPerfLogging(*this, *job, 200);
+            x_JournalJob(job->GetId());
 
             if (outdated_job)
                 m_StatisticsCounters.CountOutdatedPick(eRead);
@@ -2311,6 +2338,7 @@ TJobStatus  CQueue::RereadJob(const CNSClientId &     client,
     m_StatusTracker.SetStatus(job_id, state_before_read);
     m_StatisticsCounters.CountReread(old_status, state_before_read);
     g_DoPerfLogging(*this, job_iter->second, 200);
+    x_JournalJob(job_iter->second.GetId());
 
     m_GCRegistry.UpdateLifetime(
         job_id, job_iter->second.GetExpirationTime(m_Timeout, m_RunTimeout,
@@ -2460,6 +2488,7 @@ TJobStatus  CQueue::x_ChangeReadingStatus(const CNSClientId &  client,
                                              target_status,
                                              path_option);
     g_DoPerfLogging(*this, job_iter->second, 200);
+    x_JournalJob(job_iter->second.GetId());
     x_NotifyJobChanges(job_iter->second, job_key, eStatusChanged, current_time);
 
     job = job_iter->second;
@@ -3113,6 +3142,7 @@ TJobStatus CQueue::FailJob(const CNSClientId &    client,
                                              new_status,
                                              CStatisticsCounters::eNone);
     g_DoPerfLogging(*this, job_iter->second, 200);
+    x_JournalJob(job_iter->second.GetId());
 
     TimeLineRemove(job_id);
 
@@ -3457,6 +3487,7 @@ void CQueue::x_CheckExecutionTimeout(const CNSPreciseTime &  queue_run_timeout,
             }
         }
         g_DoPerfLogging(*this, job_iter->second, 200);
+        x_JournalJob(job_iter->second.GetId());
 
         if (new_status == CNetScheduleAPI::ePending &&
             m_PauseStatus == eNoPause)
@@ -3664,6 +3695,7 @@ unsigned int  CQueue::DeleteBatch(unsigned int  max_deleted)
                 if (del_count > 0) {
                     ++del_rec;
                     deleted_jobs.set_bit(job_id);
+                    x_JournalJob(job_id);
                 }
 
                 // The job might be the one which was given for reading
@@ -4172,6 +4204,7 @@ TJobStatus  CQueue::x_ResetDueTo(const CNSClientId &     client,
         m_StatisticsCounters.CountTransition(status_from, new_status,
                                              CStatisticsCounters::eNewSession);
     g_DoPerfLogging(*this, job_iter->second, 200);
+    x_JournalJob(job_iter->second.GetId());
 
     m_GCRegistry.UpdateLifetime(
         job_id, job_iter->second.GetExpirationTime(m_Timeout, m_RunTimeout,
@@ -4637,6 +4670,14 @@ void CQueue::x_UpdateDB_ProvideJobNoLock(const CNSClientId &     client,
 // Dumps all the jobs into a flat file at the time of shutdown
 void CQueue::Dump(const string &  dump_dname)
 {
+    if (m_Journal.get() != NULL) {
+        // The journal already has all the jobs. Only the changes since the
+        // last commit need to be saved.
+        CommitJournal(0);
+        m_Journal->Close(false);
+        return;
+    }
+
     // Form a bit vector of all jobs to dump
     vector<TJobStatus>      statuses;
     TNSBitVector            jobs_to_dump;
@@ -4758,22 +4799,6 @@ unsigned int  CQueue::LoadFromDump(const string &  dump_dname)
             unsigned int    job_id = job.GetId();
             unsigned int    group_id = job.GetGroupId();
             unsigned int    aff_id = job.GetAffinityId();
-            TJobStatus      status = job.GetStatus();
-
-            m_Jobs[job_id] = job;
-            m_StatusTracker.SetExactStatusNoLock(job_id, status, true);
-
-            if ((status == CNetScheduleAPI::eRunning ||
-                 status == CNetScheduleAPI::eReading) &&
-                m_RunTimeLine) {
-                // Add object to the first available slot;
-                // it is going to be rescheduled or dropped
-                // in the background control thread
-                // We can use time line without lock here because
-                // the queue is still in single-use mode while
-                // being loaded.
-                m_RunTimeLine->AddObject(m_RunTimeLine->GetHead(), job_id);
-            }
 
             // Register the job for the affinity if so
             if (aff_id != 0)
@@ -4783,17 +4808,7 @@ unsigned int  CQueue::LoadFromDump(const string &  dump_dname)
             if (group_id != 0)
                 m_GroupRegistry.AddJobToGroup(group_id, job_id);
 
-            // Register the loaded job with the garbage collector
-            CNSPreciseTime  submit_time = job.GetSubmitTime();
-            CNSPreciseTime  expiration =
-                    GetJobExpirationTime(job.GetLastTouch(), status,
-                                         submit_time, job.GetTimeout(),
-                                         job.GetRunTimeout(),
-                                         job.GetReadTimeout(),
-                                         m_Timeout, m_RunTimeout, m_ReadTimeout,
-                                         m_PendingTimeout, kTimeZero);
-            m_GCRegistry.RegisterJob(job_id, job.GetSubmitTime(),
-                                     aff_id, group_id, expiration);
+            x_AddLoadedJob(job);
             ++recs;
         }
 
@@ -4825,6 +4840,232 @@ unsigned int  CQueue::LoadFromDump(const string &  dump_dname)
 }
 
 
+// Adds a job loaded from the dump or from the journal to the in-memory
+// structures. The affinity and group registries are updated by the caller.
+// The member does not grab the operational lock (see x_ClearQueue()).
+void CQueue::x_AddLoadedJob(CJob &  job)
+{
+    unsigned int    job_id = job.GetId();
+    unsigned int    group_id = job.GetGroupId();
+    unsigned int    aff_id = job.GetAffinityId();
+    TJobStatus      status = job.GetStatus();
+
+    m_Jobs[job_id] = job;
+    m_StatusTracker.SetExactStatusNoLock(job_id, status, true);
+
+    if ((status == CNetScheduleAPI::eRunning ||
+         status == CNetScheduleAPI::eReading) &&
+        m_RunTimeLine) {
+        // Add object to the first available slot;
+        // it is going to be rescheduled or dropped
+        // in the background control thread
+        // We can use time line without lock here because
+        // the queue is still in single-use mode while
+        // being loaded.
+        m_RunTimeLine->AddObject(m_RunTimeLine->GetHead(), job_id);
+    }
+
+    // Register the loaded job with the garbage collector
+    CNSPreciseTime  submit_time = job.GetSubmitTime();
+    CNSPreciseTime  expiration =
+            GetJobExpirationTime(job.GetLastTouch(), status,
+                                 submit_time, job.GetTimeout(),
+                                 job.GetRunTimeout(),
+                                 job.GetReadTimeout(),
+                                 m_Timeout, m_RunTimeout, m_ReadTimeout,
+                                 m_PendingTimeout, kTimeZero);
+    m_GCRegistry.RegisterJob(job_id, submit_time,
+                             aff_id, group_id, expiration);
+}
+
+
+// Registers the jobs provided by the journal in the queue
+class CJournalJobLoader : public IJournalJobConsumer
+{
+    public:
+        CJournalJobLoader(CQueue &  queue) : m_Queue(queue)
+        {}
+
+        virtual void OnJournalJob(SJournalJob &  journal_job)
+        {
+            // The affinity and group IDs are not persistent so they
+            // are resolved from the saved tokens
+            CJob &          job = journal_job.job;
+            unsigned int    job_id = job.GetId();
+            unsigned int    aff_id = 0;
+            unsigned int    group_id = 0;
+
+            if (!journal_job.aff_token.empty())
+                aff_id = m_Queue.m_AffinityRegistry.ResolveAffinityToken(
+                                    journal_job.aff_token, job_id, 0,
+                                    eUndefined);
+            if (!journal_job.group_token.empty())
+                group_id = m_Queue.m_GroupRegistry.AddJob(
+                                    journal_job.group_token, job_id);
+
+            job.SetAffinityId(aff_id);
+            job.SetGroupId(group_id);
+            m_Queue.x_AddLoadedJob(job);
+        }
+
+    private:
+        CQueue &    m_Queue;
+};
+
+
+string CQueue::GetJournalFileName(const string &  journal_dname) const
+{
+    string      upper_queue_name = m_QueueName;
+    NStr::ToUpper(upper_queue_name);
+    return journal_dname + kJournalFileName + "." + upper_queue_name;
+}
+
+
+unsigned int  CQueue::LoadFromJournal(const string &  journal_dname)
+{
+    string      journal_file_name = GetJournalFileName(journal_dname);
+
+    if (!CNSJobJournal::Exists(journal_file_name))
+        return 0;
+
+    try {
+        CJournalJobLoader   loader(*this);
+        return CNSJobJournal::Load(journal_file_name, loader);
+    } catch (const exception &  ex) {
+        x_ClearQueue();
+        throw runtime_error("Error loading queue " + m_QueueName +
+                            " from its journal: " + string(ex.what()));
+    } catch (...) {
+        x_ClearQueue();
+        throw runtime_error("Unknown error loading queue " + m_QueueName +
+                            " from its journal");
+    }
+}
+
+
+// If rebuild is true then the journal is re-created from the jobs in memory,
+// e.g. when the jobs were loaded from a dump. Otherwise the existing journal
+// is compacted.
+void CQueue::OpenJournal(const string &  journal_dname, bool  rebuild)
+{
+    unique_ptr<CNSJobJournal>   journal(
+                    new CNSJobJournal(GetJournalFileName(journal_dname)));
+
+    if (rebuild) {
+        vector<SJournalJob>     jobs;
+        TNSBitVector            scope_jobs =
+                                    m_ScopeRegistry.GetAllJobsInScopes();
+
+        jobs.reserve(m_Jobs.size());
+        for (auto &  k : m_Jobs) {
+            if (scope_jobs.get_bit(k.first))
+                continue;
+            jobs.push_back(SJournalJob());
+            jobs.back().job = k.second;
+            if (k.second.GetAffinityId() != 0)
+                jobs.back().aff_token = m_AffinityRegistry.GetTokenByID(
+                                                k.second.GetAffinityId());
+            if (k.second.GetGroupId() != 0)
+                jobs.back().group_token = m_GroupRegistry.ResolveGroup(
+                                                k.second.GetGroupId());
+        }
+        journal->Reset(jobs);
+    } else {
+        journal->Compact();
+    }
+
+    m_Journal.reset(journal.release());
+}
+
+
+// Called periodically from the service thread. It commits the changes which
+// have not been committed by SyncJournal() and compacts the journal if
+// needed.
+void CQueue::CommitJournal(Uint8  max_journal_size)
+{
+    if (m_Journal.get() == NULL)
+        return;
+
+    x_CommitJournal();
+
+    if (max_journal_size > 0 && m_Journal->NeedCompaction(max_journal_size))
+        m_Journal->Compact();
+}
+
+
+// Called by the submitting threads before the submit is acknowledged. The
+// submitted jobs are on the disk when it returns.
+void CQueue::SyncJournal(void)
+{
+    if (m_Journal.get() != NULL)
+        x_CommitJournal();
+}
+
+
+// The changed jobs are copied under the operation lock while writing and
+// syncing is done without it. The commits are serialized so a caller whose
+// changes have been taken by a commit in progress waits for that commit to
+// finish. This way all the changes made while a commit is in progress are
+// committed with a single sync by the next one.
+void CQueue::x_CommitJournal(void)
+{
+    CFastMutexGuard         commit_guard(m_JournalCommitLock);
+
+    vector<SJournalJob>     jobs;
+    vector<unsigned int>    deleted_jobs;
+    TNSBitVector            dirty_jobs;
+
+    {{
+        CFastMutexGuard     guard(m_OperationLock);
+
+        if (!m_JournalDirtyJobs.any())
+            return;
+
+        dirty_jobs.swap(m_JournalDirtyJobs);
+
+        // The scope jobs are not saved the same way as they are not dumped
+        dirty_jobs -= m_ScopeRegistry.GetAllJobsInScopes();
+
+        TNSBitVector::enumerator    en(dirty_jobs.first());
+        for ( ; en.valid(); ++en) {
+            auto        job_iter = m_Jobs.find(*en);
+            if (job_iter == m_Jobs.end()) {
+                deleted_jobs.push_back(*en);
+                continue;
+            }
+
+            // The tokens are resolved under the operation lock because
+            // a group or an affinity cannot be collected while a job
+            // refers to it
+            jobs.push_back(SJournalJob());
+            jobs.back().job = job_iter->second;
+            if (job_iter->second.GetAffinityId() != 0)
+                jobs.back().aff_token = m_AffinityRegistry.GetTokenByID(
+                                        job_iter->second.GetAffinityId());
+            if (job_iter->second.GetGroupId() != 0)
+                jobs.back().group_token = m_GroupRegistry.ResolveGroup(
+                                        job_iter->second.GetGroupId());
+        }
+    }}
+
+    try {
+        m_Journal->Commit(jobs, deleted_jobs);
+    } catch (...) {
+        // The changes will be tried again at the next commit
+        CFastMutexGuard     guard(m_OperationLock);
+        m_JournalDirtyJobs |= dirty_jobs;
+        throw;
+    }
+}
+
+
+void CQueue::CloseJournal(bool  remove_file)
+{
+    if (m_Journal.get() != NULL)
+        m_Journal->Close(remove_file);
+}
+
+
 // The member does not grab the operational lock.
 // The member is used at the time of loading jobs from dump and at that time
 // there is no concurrent access.
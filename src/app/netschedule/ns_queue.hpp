@@ -59,6 +59,7 @@
 #include "ns_precise_time.hpp"
 #include "ns_scope.hpp"
 #include "ns_server_params.hpp"
+#include "ns_journal.hpp"
 
 #include <map>
 
@@ -164,6 +165,9 @@ public:
 
     // Submit job batch
     // Returns ID of the first job, second is first_id+1 etc.
+    // Affinities, registries, the GC registry and notifications are updated
+    // once per batch. Reading the results back (READ2/CFRM) is still done
+    // one job per command; there is no batched read/confirm path.
     unsigned SubmitBatch(const CNSClientId &             client,
                          vector< pair<CJob, string> > &  batch,
                          const string &                  group,
@@ -467,6 +471,18 @@ public:
     void Dump(const string &  dump_dir_name);
     void RemoveDump(const string &  dump_dir_name);
     unsigned int LoadFromDump(const string &  dump_dir_name);
+
+    // Job journal support. The journal is opened after the jobs are loaded
+    // either from the journal or from the dump.
+    string GetJournalFileName(const string &  journal_dir_name) const;
+    unsigned int LoadFromJournal(const string &  journal_dir_name);
+    void OpenJournal(const string &  journal_dir_name, bool  rebuild);
+    void CommitJournal(Uint8  max_journal_size);
+    void SyncJournal(void);
+    void CloseJournal(bool  remove_file);
+    bool HasJournal(void) const
+    { return m_Journal.get() != NULL; }
+
     bool ShouldPerfLogTransitions(void) const
     { return m_ShouldPerfLogTransitions; }
     void UpdatePerfLoggingSettings(const string &  qclass);
@@ -621,7 +637,16 @@ private:
                           bool                  group_may_change);
 
     string x_GetJobsDumpFileName(const string &  dump_dname) const;
+    void x_AddLoadedJob(CJob &  job);
     void x_ClearQueue(void);
+    void x_CommitJournal(void);
+
+    // Must be called under the operation lock
+    void x_JournalJob(unsigned int  job_id)
+    {
+        if (m_Journal.get() != NULL)
+            m_JournalDirtyJobs.set_bit(job_id);
+    }
     void x_NotifyJobChanges(const CJob &            job,
                             const string &          job_key,
                             ENotificationReason     reason,
@@ -750,6 +775,14 @@ private:
     // States from which the jobs could be taken for the READ[2] commands
     vector<CNetScheduleAPI::EJobStatus>
                                 m_StatesForRead;
+
+    // The jobs changed since the last journal commit. Protected by the
+    // operation lock.
+    unique_ptr<CNSJobJournal>   m_Journal;
+    TNSBitVector                m_JournalDirtyJobs;
+    CFastMutex                  m_JournalCommitLock;
+
+    friend class CJournalJobLoader;
 };
 
 
@@ -76,7 +76,9 @@ CNetScheduleServer::CNetScheduleServer(const string &  dbpath,
       m_SessionID("s" + x_GenerateGUID()),
       m_StartIDs(dbpath, diskless),
       m_AnybodyCanReconfigure(false),
-      m_ReserveDumpSpace(default_reserve_dump_space)
+      m_ReserveDumpSpace(default_reserve_dump_space),
+      m_Journal(default_journal),
+      m_JournalMaxSize(default_journal_max_size)
 {
     m_CurrentSubmitsCounter.Set(kSubmitCounterInitialValue);
     sm_netschedule_server = this;
@@ -278,6 +280,10 @@ CJsonNode CNetScheduleServer::SetNSParameters(const SNS_Parameters &  params,
     m_GroupRegistrySettings = params.group_reg;
     m_ScopeRegistrySettings = params.scope_reg;
 
+    // The journal makes no sense if nothing is written to the disk
+    m_Journal = params.journal && !m_Diskless;
+    m_JournalMaxSize = params.journal_max_size;
+
     // The difference is required only at the stage of RECO.
     // RECO always calls the function with the limited flag so there is no need
     // to provide the difference here
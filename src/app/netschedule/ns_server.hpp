@@ -207,6 +207,10 @@ public:
     { return m_AnybodyCanReconfigure; }
     unsigned int GetReserveDumpSpace(void) const
     { return m_ReserveDumpSpace; }
+    bool GetJournal(void) const
+    { return m_Journal; }
+    unsigned int GetJournalMaxSize(void) const
+    { return m_JournalMaxSize; }
     map<string, int> GetPauseQueues(void) const;
     vector<string> GetRefuseSubmitQueues(void) const;
     string GetDataPath(void) const;
@@ -291,6 +295,10 @@ private:
 
     unsigned int                    m_ReserveDumpSpace;
 
+    // Startup only parameters
+    bool                            m_Journal;
+    unsigned int                    m_JournalMaxSize;
+
 private:
     string x_GenerateGUID(void) const;
     CJsonNode x_SetAdminClientNames(const string &  client_names);
@@ -262,6 +262,9 @@ void SNS_Parameters::Read(const IRegistry &  reg)
                             "state_transition_perf_log_classes", kEmptyStr);
 
     diskless = GetBoolNoErr("diskless", default_diskless);
+    journal = GetBoolNoErr("journal", default_journal);
+    journal_max_size = NS_GetDataSize(reg, "server", "journal_max_size",
+                                      default_journal_max_size);
 
     #if defined(_DEBUG) && !defined(NDEBUG)
     ReadErrorEmulatorSection(reg);
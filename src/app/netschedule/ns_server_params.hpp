@@ -163,6 +163,8 @@ struct SNS_Parameters : SServer_Parameters
     string          path;
     unsigned int    max_queues;
     bool            diskless;
+    bool            journal;
+    unsigned int    journal_max_size;
 
     void Read(const IRegistry &  reg);
 
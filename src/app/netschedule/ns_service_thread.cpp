@@ -43,7 +43,8 @@
 BEGIN_NCBI_SCOPE
 
 
-// The thread does 2 service things:
+// The thread does the following service things:
+// - commit the queue journals every second
 // - check for drained shutdown every 10 seconds
 // - logging statistics counters every 100 seconds if logging is on
 void  CServiceThread::DoJob(void)
@@ -53,6 +54,10 @@ void  CServiceThread::DoJob(void)
 
     time_t      current_time = time(0);
 
+    // The job changes accumulated during the last period are synced to the
+    // disk together
+    m_QueueDB.CommitJournals();
+
     // Check for shutdown is done every 10 seconds
     if (current_time - m_LastDrainCheck >= 10) {
         x_CheckDrainShutdown();
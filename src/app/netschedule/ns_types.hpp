@@ -77,10 +77,12 @@ typedef map<string, SQueueParameters, PNocase>  TQueueParams;
 
 
 const string    kDumpSubdirName("dump");
+const string    kJournalSubdirName("journal");
 const string    kDumpReservedSpaceFileName("space_keeper.dat");
 const string    kQClassDescriptionFileName("qclass_descr.dump");
 const string    kLinkedSectionsFileName("linked_sections.dump");
 const string    kJobsFileName("jobs.dump");
+const string    kJournalFileName("jobs.journal");
 const string    kDBStorageVersionFileName("DB_STORAGE_VER");
 const string    kStartJobIDsFileName("STARTJOBIDS");
 const string    kNodeIDFileName("NODE_ID");
@@ -99,6 +101,7 @@ static string   kNewLine("\n");
 // visible the same way everywhere.
 // See kOldDumpMagic as well in ns_db_dump.cpp
 const Uint4     kDumpMagic(0xF0F0F0F0);
+const Uint4     kJournalRecordMagic(0xA5A5A5A5);
 
 
 // An empty bit vector is returned in quite a few places
@@ -312,6 +312,7 @@ void NS_ValidateServerSection(const IRegistry &  reg,
     NS_ValidateBool(reg, section, "log_execution_watcher_thread", warnings);
     NS_ValidateBool(reg, section, "log_statistics_thread", warnings);
     NS_ValidateBool(reg, section, "diskless", warnings);
+    NS_ValidateBool(reg, section, "journal", warnings);
 
 
     ok = NS_ValidateInt(reg, section, "del_batch_size", warnings);
@@ -459,6 +460,7 @@ void NS_ValidateServerSection(const IRegistry &  reg,
     }
 
     NS_ValidateDataSize(reg, section, "reserve_dump_space", warnings);
+    NS_ValidateDataSize(reg, section, "journal_max_size", warnings);
 }
 
 
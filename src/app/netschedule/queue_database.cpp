@@ -64,6 +64,8 @@ CQueueDataBase::CQueueDataBase(CNetScheduleServer *  server,
 : m_Host(server->GetBackgroundHost()),
   m_MaxQueues(max_queues),
   m_Diskless(diskless),
+  m_Journal(server->GetJournal()),
+  m_JournalsReady(false),
   m_StopPurge(false),
   m_FreeStatusMemCnt(0),
   m_LastFreeMem(time(0)),
@@ -75,6 +77,8 @@ CQueueDataBase::CQueueDataBase(CNetScheduleServer *  server,
     m_DataPath = CDirEntry::AddTrailingPathSeparator(path);
     m_DumpPath = CDirEntry::AddTrailingPathSeparator(m_DataPath +
                                                      kDumpSubdirName);
+    m_JournalPath = CDirEntry::AddTrailingPathSeparator(m_DataPath +
+                                                        kJournalSubdirName);
 
     // First, load the previous session start job IDs if file existed
     // The diskless flag will be considered when IDs are loaded.
@@ -169,6 +173,7 @@ void  CQueueDataBase::x_Open(bool  reinit)
     set<string, PNocase>    config_static_queues = x_GetConfigQueues();
     string                  last_queue_load_error;
     size_t                  queue_load_error_count = 0;
+    set<string, PNocase>    loaded_from_journal;
 
     // Exclude number of queues will be the static queues from the config
     // plus the dumped dynamic queues
@@ -247,11 +252,36 @@ void  CQueueDataBase::x_Open(bool  reinit)
             x_CreateAndMountQueue(qname, params);
         }
 
-        // All the structures are ready to upload the jobs from the dump
+        // All the structures are ready to upload the jobs from the journal
+        // or from the dump. The journal has the most recent state if it
+        // exists because the jobs are not dumped when the journal is on.
         if (!m_Diskless) {
             for (TQueueInfo::iterator  k = m_Queues.begin();
                     k != m_Queues.end(); ++k) {
                 try {
+                    string  journal_file_name = k->second.second->
+                                            GetJournalFileName(m_JournalPath);
+                    if (m_Journal &&
+                        CNSJobJournal::Exists(journal_file_name)) {
+                        unsigned int   records = 0;
+                        try {
+                            records = k->second.second->
+                                            LoadFromJournal(m_JournalPath);
+                        } catch (...) {
+                            // The journal is going to be re-created so
+                            // the broken one is saved for analysis
+                            x_BackupJournal(journal_file_name);
+                            throw;
+                        }
+                        loaded_from_journal.insert(k->first);
+                        GetDiagContext().Extra()
+                            .Print("_type", "startup")
+                            .Print("_queue", k->first)
+                            .Print("info", "load_from_journal")
+                            .Print("records", records);
+                        continue;
+                    }
+
                     unsigned int   records =
                                         k->second.second->LoadFromDump(m_DumpPath);
                     GetDiagContext().Extra()
@@ -306,8 +336,143 @@ void  CQueueDataBase::x_Open(bool  reinit)
             x_RemoveDump();
     }
 
-    if (!m_Diskless)
+    if (!m_Diskless) {
+        if (m_Journal)
+            x_OpenJournals(loaded_from_journal);
+        else
+            x_RemoveJournals();
         x_CreateSpaceReserveFile();
+    }
+}
+
+
+// Opens the journals for all the queues and removes the journals of the
+// queues which do not exist anymore. The queues which were not loaded from
+// their journals get them rebuilt from the jobs in memory.
+void CQueueDataBase::x_OpenJournals(
+                        const set<string, PNocase> &  loaded_from_journal)
+{
+    CDir        journal_dir(m_JournalPath);
+    if (!journal_dir.Exists())
+        journal_dir.Create();
+
+    set<string>     journal_files;
+    for (TQueueInfo::iterator  k = m_Queues.begin();
+            k != m_Queues.end(); ++k) {
+        bool    rebuild = loaded_from_journal.find(k->first) ==
+                                            loaded_from_journal.end();
+        try {
+            k->second.second->OpenJournal(m_JournalPath, rebuild);
+        } catch (const exception &  ex) {
+            ERR_POST("Error opening the journal for queue " << k->first <<
+                     ": " << ex.what());
+            m_Server->RegisterAlert(eJournalError,
+                                    "Error opening the journal for queue " +
+                                    k->first + ": " + ex.what());
+        }
+        vector<string>  file_names = CNSJobJournal::GetFileNames(
+                        k->second.second->GetJournalFileName(m_JournalPath));
+        for (const auto &  name : file_names)
+            journal_files.insert(CFile(name).GetName());
+    }
+
+    CDir::TEntries      entries = journal_dir.GetEntries(
+                                    kEmptyStr, CDir::fIgnoreRecursive);
+    for (CDir::TEntries::const_iterator  k = entries.begin();
+            k != entries.end(); ++k) {
+        if ((*k)->IsDir())
+            continue;
+        if (journal_files.find((*k)->GetName()) != journal_files.end())
+            continue;
+
+        CFile   f(m_JournalPath + (*k)->GetName());
+        try {
+            f.Remove();
+        } catch (...) {}
+    }
+
+    m_JournalsReady = true;
+}
+
+
+void CQueueDataBase::x_BackupJournal(const string &  journal_file_name)
+{
+    string      backup_dir_name =
+                    CDirEntry::DeleteTrailingPathSeparator(m_JournalPath) +
+                    ".backup";
+    try {
+        CDir    backup_dir(backup_dir_name);
+        if (!backup_dir.Exists())
+            backup_dir.Create();
+
+        // All the journal files get the same backup number
+        vector<string>  file_names =
+                            CNSJobJournal::GetFileNames(journal_file_name);
+        size_t          backup_number = 0;
+        for (bool  taken = true; taken; ) {
+            taken = false;
+            for (const auto &  name : file_names)
+                if (CFile(CFile::MakePath(backup_dir_name,
+                                          CFile(name).GetName()) + "." +
+                          to_string(backup_number)).Exists())
+                    taken = true;
+            if (taken)
+                ++backup_number;
+        }
+
+        for (const auto &  name : file_names) {
+            CFile   journal_file(name);
+            if (!journal_file.Exists())
+                continue;
+            journal_file.Rename(CFile::MakePath(backup_dir_name,
+                                                journal_file.GetName()) +
+                                "." + to_string(backup_number));
+        }
+    } catch (const exception &  ex) {
+        ERR_POST("Error saving the journal " << journal_file_name <<
+                 ": " << ex.what());
+    } catch (...) {
+        ERR_POST("Unknown error saving the journal " << journal_file_name);
+    }
+}
+
+
+void CQueueDataBase::x_RemoveJournals(void)
+{
+    try {
+        CDir    journal_dir(m_JournalPath);
+        if (journal_dir.Exists())
+            journal_dir.Remove();
+    } catch (const exception &  ex) {
+        ERR_POST("Error removing the journal directory: " << ex.what());
+    } catch (...) {
+        ERR_POST("Unknown error removing the journal directory");
+    }
+}
+
+
+void CQueueDataBase::CommitJournals(void)
+{
+    if (!m_JournalsReady)
+        return;
+
+    Uint8       max_size = m_Server->GetJournalMaxSize();
+    for (unsigned int  index = 0; ; ++index) {
+        CRef<CQueue>  queue = x_GetQueueAt(index);
+        if (queue.IsNull())
+            break;
+
+        try {
+            queue->CommitJournal(max_size);
+        } catch (const exception &  ex) {
+            ERR_POST("Error committing the journal for queue " <<
+                     queue->GetQueueName() << ": " << ex.what());
+            m_Server->RegisterAlert(eJournalError,
+                                    "Error committing the journal for "
+                                    "queue " + queue->GetQueueName() +
+                                    ": " + ex.what());
+        }
+    }
 }
 
 
@@ -1007,6 +1172,11 @@ CQueueDataBase::x_CreateAndMountQueue(const string &            qname,
     q->Attach();
     q->SetParameters(params);
 
+    // The queues created after the start have no jobs so their journals
+    // are started from scratch
+    if (m_JournalsReady)
+        q->OpenJournal(m_JournalPath, true);
+
     m_Queues[qname] = make_pair(params, q.release());
 
     GetDiagContext().Extra()
@@ -1206,6 +1376,12 @@ void CQueueDataBase::Close(void)
         // need to dump anything
         LOG_POST("Drained shutdown: the DB has been successfully drained");
         x_RemoveDumpErrorFlagFile();
+        if (!m_Diskless) {
+            for (TQueueInfo::iterator  k = m_Queues.begin();
+                    k != m_Queues.end(); ++k)
+                k->second.second->CloseJournal(true);
+            x_RemoveJournals();
+        }
     } else {
         // That was either:
         // - hard shutdown
@@ -1513,6 +1689,7 @@ void  CQueueDataBase::x_DeleteQueuesAndClasses(void)
         // Deallocation of the DB block will be done later when the queue
         // is actually deleted
         // queue->second.second->MarkForTruncating();
+        queue->second.second->CloseJournal(true);
         m_Queues.erase(queue);
     }
 
@@ -2466,7 +2643,17 @@ void CQueueDataBase::x_RemoveDataFiles(void)
 // status.
 bool CQueueDataBase::x_CheckOpenPreconditions(bool  reinit)
 {
-    if (x_DoesCrashFlagFileExist()) {
+    if (x_DoesCrashFlagFileExist() && m_Journal && !reinit &&
+        CDir(m_JournalPath).Exists()) {
+        // The jobs are recovered from the journals so the data directory
+        // is kept
+        ERR_POST("The server did not stop gracefully last time. "
+                 "The jobs will be recovered from the journals in "
+                 << m_JournalPath);
+        m_Server->RegisterAlert(eStartAfterCrash, "The server did not stop "
+                                "gracefully last time. The jobs have been "
+                                "recovered from the journals");
+    } else if (x_DoesCrashFlagFileExist()) {
         ERR_POST("Reinitialization due to the server "
                  "did not stop gracefully last time. "
                  << m_DataPath << " removed.");
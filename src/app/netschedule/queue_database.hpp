@@ -125,6 +125,9 @@ public:
     void StopServiceThread(void);
 
     void CheckExecutionTimeout(bool  logging);
+
+    // Syncs the queue journals to the disk
+    void CommitJournals(void);
     void RunExecutionWatcherThread(const CNSPreciseTime &  run_delay);
     void StopExecutionWatcherThread(void);
 
@@ -161,6 +164,9 @@ private:
     void x_Open(bool  reinit);
     void x_CreateAndMountQueue(const string &            qname,
                                const SQueueParameters &  params);
+    void x_OpenJournals(const set<string, PNocase> &  loaded_from_journal);
+    void x_BackupJournal(const string &  journal_file_name);
+    void x_RemoveJournals(void);
 
     unsigned x_PurgeUnconditional(void);
     void     x_OptimizeStatusMatrix(const CNSPreciseTime &  current_time);
@@ -170,8 +176,12 @@ private:
     CBackgroundHost &    m_Host;
     string               m_DataPath;
     string               m_DumpPath;
+    string               m_JournalPath;
     unsigned int         m_MaxQueues;
     bool                 m_Diskless;
+    bool                 m_Journal;
+    bool                 m_JournalsReady;     // Queues created after the
+                                              // start need a new journal
 
     mutable CFastMutex   m_ConfigureLock;
 
@@ -12,6 +12,7 @@ from netschedule_tests_pack import TestBase
 from netschedule_tests_pack_4_10 import execAny
 
 from urllib.parse import parse_qs
+import os
 import socket
 import time
 
@@ -245,3 +246,98 @@ class Scenario2004(TestBase):
 
         return True
 
+
+class Scenario2005(TestBase):
+
+    """Scenario 2005"""
+
+    def __init__(self, netschedule):
+        TestBase.__init__(self, netschedule)
+
+    @staticmethod
+    def getScenario():
+        """Provides the scenario"""
+        return "With the journal on: submit jobs, cancel one, " \
+               "kill -9 NS right after the last submit, restart NS; " \
+               "all the acknowledged jobs must be restored"
+
+    def execute(self):
+        """Should return True if the execution completed successfully"""
+        self.fromScratch(1300)
+
+        jobID1 = self.ns.submitJob('TEST', 'blah1')
+        jobID2 = self.ns.submitJob('TEST', 'blah2')
+        self.ns.cancelJob('TEST', jobID2)
+
+        # The job changes other than submits are committed once a second
+        time.sleep(3)
+
+        # A submit is acknowledged after its job is on the disk
+        jobID3 = self.ns.submitJob('TEST', 'blah3')
+        self.ns.kill("SIGKILL")
+        time.sleep(1)
+        self.ns.start()
+        time.sleep(1)
+
+        expected = [(jobID1, 'Pending'), (jobID2, 'Canceled'),
+                    (jobID3, 'Pending')]
+        for jobID, status in expected:
+            received = self.ns.getJobStatus('TEST', jobID)
+            if received != status:
+                raise Exception("Unexpected job " + jobID +
+                                " status after restart. Expected: " +
+                                status + " Received: " + received)
+        return True
+
+
+class Scenario2006(TestBase):
+
+    """Scenario 2006"""
+
+    def __init__(self, netschedule):
+        TestBase.__init__(self, netschedule)
+
+    @staticmethod
+    def getScenario():
+        """Provides the scenario"""
+        return "With a small journal size limit: submit jobs, cancel " \
+               "half of them, wait for the journal compaction, " \
+               "submit one more job, kill -9 NS, restart NS; " \
+               "all the jobs must be restored"
+
+    def execute(self):
+        """Should return True if the execution completed successfully"""
+        self.fromScratch(1300)
+
+        jobIDs = []
+        for index in range(40):
+            jobIDs.append(self.ns.submitJob('TEST', 'blah' + str(index)))
+        for jobID in jobIDs[:20]:
+            self.ns.cancelJob('TEST', jobID)
+
+        # Let the service thread commit the changes and compact the journal
+        time.sleep(5)
+
+        baseFileName = os.path.join(self.ns.getDBPath(), 'journal',
+                                    'jobs.journal.TEST.base')
+        if not os.path.exists(baseFileName):
+            raise Exception("The journal has not been compacted: " +
+                            baseFileName + " does not exist")
+
+        jobIDs.append(self.ns.submitJob('TEST', 'blah_last'))
+        self.ns.kill("SIGKILL")
+        time.sleep(1)
+        self.ns.start()
+        time.sleep(1)
+
+        for index, jobID in enumerate(jobIDs):
+            if index < 20:
+                status = 'Canceled'
+            else:
+                status = 'Pending'
+            received = self.ns.getJobStatus('TEST', jobID)
+            if received != status:
+                raise Exception("Unexpected job " + jobID +
+                                " status after restart. Expected: " +
+                                status + " Received: " + received)
+        return True
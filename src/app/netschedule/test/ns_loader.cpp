@@ -38,6 +38,7 @@
 #include <corelib/ncbireg.hpp>
 #include <corelib/ncbi_system.hpp>
 #include <corelib/ncbimisc.hpp>
+#include <corelib/ncbitime.hpp>
 
 #include <connect/services/netschedule_api.hpp>
 #include <connect/services/netschedule_key.hpp>
@@ -77,6 +78,10 @@ class CNetScheduleLoader : public CNcbiApplication
         string  x_GetAffinity(void);
         CNetScheduleJob  x_SubmitJob(CNetScheduleSubmitter &  submitter,
                                      const string &  aff);
+        int  x_SubmitBatches(CNetScheduleSubmitter &  submitter,
+                             const string &  aff,
+                             unsigned int  total_jobs,
+                             unsigned int  batch_size);
 };
 
 
@@ -117,6 +122,12 @@ void CNetScheduleLoader::Init(void)
                              "Number of jobs to submit",
                              CArgDescriptions::eInteger);
 
+    arg_desc->AddOptionalKey("batch",
+                             "batch_size",
+                             "Only submit the jobs with BSUB in batches "
+                             "of the given size and print the submit rate",
+                             CArgDescriptions::eInteger);
+
     // Setup arg.descriptions for this application
     SetupArgDescriptions(arg_desc.release());
 }
@@ -164,6 +175,38 @@ CNetScheduleLoader::x_SubmitJob(CNetScheduleSubmitter &  submitter,
 }
 
 
+// Measures the batch submit throughput.
+// The jobs are left pending in the queue.
+int
+CNetScheduleLoader::x_SubmitBatches(CNetScheduleSubmitter &  submitter,
+                                    const string &           aff,
+                                    unsigned int             total_jobs,
+                                    unsigned int             batch_size)
+{
+    vector<CNetScheduleJob>     jobs;
+    unsigned int                submitted = 0;
+    CStopWatch                  sw(CStopWatch::eStart);
+
+    while (submitted < total_jobs) {
+        unsigned int    count = min(batch_size, total_jobs - submitted);
+
+        jobs.clear();
+        for (unsigned int  k = 0; k < count; ++k)
+            jobs.push_back(CNetScheduleJob("ns_loader input", aff));
+        submitter.SubmitJobBatch(jobs);
+        submitted += count;
+    }
+
+    double  elapsed = sw.Elapsed();
+    NcbiCout.setf(IOS_BASE::fixed, IOS_BASE::floatfield);
+    NcbiCout << "Submitted: " << submitted << " jobs in batches of "
+             << batch_size << NcbiEndl
+             << "Elapsed: " << elapsed << " sec." << NcbiEndl
+             << "Rate: " << submitted / elapsed << " jobs/sec." << NcbiEndl;
+    return 0;
+}
+
+
 int CNetScheduleLoader::Run(void)
 {
     const CArgs &           args = GetArgs();
@@ -176,6 +219,9 @@ int CNetScheduleLoader::Run(void)
 
     cl.GetAdmin().PrintServerVersion(NcbiCout);
 
+    if (args["batch"])
+        return x_SubmitBatches(submitter, aff, total_jobs,
+                               max(1, args["batch"].AsInteger()));
 
     CNetScheduleJob                 job;
     CNetScheduleAPI::EJobStatus     status;
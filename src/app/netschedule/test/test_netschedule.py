@@ -821,7 +821,9 @@ def main():
               pack_4_30.Scenario2002( netschedule ),
               pack_4_30.Scenario2003( netschedule ),
 
-              pack_4_30.Scenario2004( netschedule )
+              pack_4_30.Scenario2004( netschedule ),
+              pack_4_30.Scenario2005( netschedule ),
+              pack_4_30.Scenario2006( netschedule )
             ]
 
     # Calculate the start test index
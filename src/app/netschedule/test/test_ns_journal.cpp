@@ -0,0 +1,211 @@
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Authors:  agent
+ *
+ * File Description:
+ *   NetSchedule job journal test: commits, compaction and recovery
+ *   after failed writes.
+ *
+ */
+
+#include <ncbi_pch.hpp>
+
+#include <corelib/ncbifile.hpp>
+
+#include "../ns_journal.hpp"
+#include "../ns_affinity.hpp"
+#include "../ns_group.hpp"
+#include "../ns_queue.hpp"
+#include "../ns_server.hpp"
+
+#include <sys/resource.h>
+#include <signal.h>
+
+#include <corelib/test_boost.hpp>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+
+USING_NCBI_SCOPE;
+
+
+// The journal uses only the job serialization; the server parts the job
+// and the dump code refer to are not reached by the test
+BEGIN_NCBI_SCOPE
+string CNSAffinityRegistry::GetTokenByID(unsigned int) const
+{ return kEmptyStr; }
+string CNSGroupsRegistry::ResolveGroup(unsigned int) const
+{ return kEmptyStr; }
+CNetScheduleServer *  CNetScheduleServer::GetInstance(void)
+{ return NULL; }
+void CNetScheduleServer::RegisterAlert(EAlertType, const string &)
+{}
+string CQueue::MakeJobKey(unsigned int) const
+{ return kEmptyStr; }
+END_NCBI_SCOPE
+
+
+class CJobCollector : public IJournalJobConsumer
+{
+    public:
+        virtual void OnJournalJob(SJournalJob &  journal_job)
+        { m_Jobs[journal_job.job.GetId()] = journal_job.aff_token; }
+
+        map<unsigned int, string>   m_Jobs;
+};
+
+
+static vector<SJournalJob> s_MakeJobs(unsigned int  first_id,
+                                      unsigned int  count,
+                                      const string &  aff)
+{
+    vector<SJournalJob>     jobs(count);
+    for (unsigned int  k = 0; k < count; ++k) {
+        jobs[k].job.SetId(first_id + k);
+        jobs[k].job.SetInput(string(100, 'i'));
+        jobs[k].aff_token = aff;
+    }
+    return jobs;
+}
+
+
+static map<unsigned int, string> s_Load(const string &  file_name)
+{
+    CJobCollector       collector;
+    CNSJobJournal::Load(file_name, collector);
+    return collector.m_Jobs;
+}
+
+
+// Makes the writes past the given size fail with EFBIG
+class CFileSizeLimit
+{
+    public:
+        CFileSizeLimit(rlim_t  size)
+        {
+            signal(SIGXFSZ, SIG_IGN);
+            getrlimit(RLIMIT_FSIZE, &m_Saved);
+            struct rlimit   limit = m_Saved;
+            limit.rlim_cur = size;
+            BOOST_REQUIRE(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+        }
+        ~CFileSizeLimit()
+        {
+            setrlimit(RLIMIT_FSIZE, &m_Saved);
+        }
+
+    private:
+        struct rlimit   m_Saved;
+};
+
+
+struct SJournalDir
+{
+    SJournalDir() : m_Dir(CDirEntry::GetTmpName())
+    {
+        BOOST_REQUIRE(m_Dir.CreatePath());
+        m_FileName = CDirEntry::MakePath(m_Dir.GetPath(), "jobs.journal.Q");
+    }
+    ~SJournalDir()
+    {
+        m_Dir.Remove();
+    }
+
+    CDir        m_Dir;
+    string      m_FileName;
+};
+
+
+BOOST_AUTO_TEST_CASE(TestCommitAndCompact)
+{
+    SJournalDir     dir;
+    {
+        CNSJobJournal   journal(dir.m_FileName);
+        journal.Commit(s_MakeJobs(1, 3, "a"), vector<unsigned int>());
+        journal.Commit(s_MakeJobs(2, 1, "b"), vector<unsigned int>(1, 1));
+        journal.Compact();
+        journal.Commit(s_MakeJobs(4, 1, "c"), vector<unsigned int>(1, 3));
+    }
+
+    map<unsigned int, string>   jobs = s_Load(dir.m_FileName);
+    BOOST_REQUIRE_EQUAL(jobs.size(), 2U);
+    BOOST_CHECK_EQUAL(jobs[2], "b");
+    BOOST_CHECK_EQUAL(jobs[4], "c");
+}
+
+
+// A failed commit leaves nothing behind, so the next commit is loaded
+BOOST_AUTO_TEST_CASE(TestFailedCommit)
+{
+    SJournalDir     dir;
+    {
+        CNSJobJournal   journal(dir.m_FileName);
+        journal.Commit(s_MakeJobs(1, 3, "a"), vector<unsigned int>());
+        {
+            CFileSizeLimit  limit(journal.GetSize() + 300);
+            BOOST_CHECK_THROW(journal.Commit(s_MakeJobs(10, 50, "b"),
+                                             vector<unsigned int>(1, 1)),
+                              runtime_error);
+        }
+        journal.Commit(s_MakeJobs(100, 3, "c"), vector<unsigned int>(1, 2));
+        BOOST_CHECK_EQUAL(Uint8(CFile(dir.m_FileName).GetLength()),
+                          journal.GetSize());
+    }
+
+    map<unsigned int, string>   jobs = s_Load(dir.m_FileName);
+    BOOST_REQUIRE_EQUAL(jobs.size(), 5U);
+    BOOST_CHECK_EQUAL(jobs[1], "a");
+    BOOST_CHECK_EQUAL(jobs[3], "a");
+    for (unsigned int  id = 100; id < 103; ++id)
+        BOOST_CHECK_EQUAL(jobs[id], "c");
+}
+
+
+// A torn last commit found at startup is cut off
+BOOST_AUTO_TEST_CASE(TestTornTail)
+{
+    SJournalDir     dir;
+    Uint8           size = 0;
+    {
+        CNSJobJournal   journal(dir.m_FileName);
+        journal.Commit(s_MakeJobs(1, 2, "a"), vector<unsigned int>());
+        size = journal.GetSize();
+    }
+    {
+        CNcbiOfstream   out(dir.m_FileName.c_str(),
+                            IOS_BASE::app | IOS_BASE::binary);
+        out << string(50, '\x01');
+    }
+    {
+        CNSJobJournal   journal(dir.m_FileName);
+        BOOST_CHECK_EQUAL(journal.GetSize(), size);
+        journal.Commit(s_MakeJobs(5, 1, "b"), vector<unsigned int>());
+    }
+
+    map<unsigned int, string>   jobs = s_Load(dir.m_FileName);
+    BOOST_REQUIRE_EQUAL(jobs.size(), 3U);
+    BOOST_CHECK_EQUAL(jobs[5], "b");
+}
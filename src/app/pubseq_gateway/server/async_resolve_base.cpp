@@ -1084,6 +1084,17 @@ CPSGS_AsyncResolveBase::x_OnSeqIdAsyncResolutionFinished(
         m_FinishedCB(move(async_bioseq_resolution));
     } else {
         // Could not resolve by some reasons.
+        // The DB has been consulted so a plain 'not found' can be memorized
+        if (!async_bioseq_resolution.m_Error.HasError() ||
+            async_bioseq_resolution.m_Error.m_ErrorCode == CRequestStatus::e404_NotFound) {
+            auto    resolution_cache = app->GetResolutionCache();
+            if (resolution_cache)
+                resolution_cache->AddNotFound(
+                                    m_CurrentSeqIdToResolve->seq_id,
+                                    m_CurrentSeqIdToResolve->seq_id_type,
+                                    GetAccessionSubstitutionOption());
+        }
+
         // May be there is more seq_id/seq_id_type to try
         if (MoveToNextSeqId()) {
             m_ContinueResolveCB();      // Call resolution again
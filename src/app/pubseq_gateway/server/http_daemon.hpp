@@ -70,7 +70,8 @@ public:
     CHttpDaemon(const std::vector<CHttpHandler> &  handlers,
                 const std::string &  tcp_address, unsigned short  tcp_port,
                 unsigned short  tcp_workers, unsigned short  tcp_backlog,
-                unsigned short  tcp_max_connections);
+                unsigned short  tcp_max_connections,
+                bool  tcp_reuse_port = false);
     ~CHttpDaemon();
 
     void Run(std::function<void(CTcpDaemon &)> on_watch_dog = nullptr);
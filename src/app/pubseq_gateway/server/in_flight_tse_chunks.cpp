@@ -0,0 +1,207 @@
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Authors: agent
+ *
+ * File Description:
+ *   Coalescing of the identical TSE chunk retrievals which are in progress
+ *   at the same time
+ *
+ */
+
+#include <ncbi_pch.hpp>
+
+#include "pubseq_gateway.hpp"
+#include "in_flight_tse_chunks.hpp"
+#include "ipsgs_processor.hpp"
+
+
+// libuv glue: user data structure to do a callback and
+// the libuv callback implementation for the data case
+struct SInFlightChunkDataCBData
+{
+    shared_ptr<SPSGS_InFlightChunkData>     m_Data;
+    TInFlightChunkDataCB                    m_DataCB;
+};
+
+void in_flight_chunk_data_cb(void *  user_data)
+{
+    SInFlightChunkDataCBData *  cb_data = (SInFlightChunkDataCBData*)(user_data);
+    cb_data->m_DataCB(cb_data->m_Data);
+    delete cb_data;
+}
+
+// libuv glue: user data structure to do a callback and
+// the libuv callback implementation for the failure case
+struct SInFlightChunkFailCBData
+{
+    TInFlightChunkFailCB                    m_FailCB;
+};
+
+void in_flight_chunk_fail_cb(void *  user_data)
+{
+    SInFlightChunkFailCBData *  cb_data = (SInFlightChunkFailCBData*)(user_data);
+    cb_data->m_FailCB();
+    delete cb_data;
+}
+
+
+void SInFlightTSEChunk::x_OnFinished(void)
+{
+    // Schedule data callbacks in the waiters uv loops
+    for (const auto &  waiter : m_WaitList) {
+        // Delete is done in the callback
+        SInFlightChunkDataCBData *  user_data = new SInFlightChunkDataCBData();
+        user_data->m_Data = m_Data;
+        user_data->m_DataCB = waiter.m_DataCB;
+
+        waiter.m_Processor->PostponeInvoke(in_flight_chunk_data_cb,
+                                           (void*)(user_data));
+    }
+}
+
+
+void SInFlightTSEChunk::x_OnFailed(void)
+{
+    // Schedule fail callbacks in the waiters uv loops
+    for (const auto &  waiter : m_WaitList) {
+        // Delete is done in the callback
+        SInFlightChunkFailCBData *  user_data = new SInFlightChunkFailCBData();
+        user_data->m_FailCB = waiter.m_FailCB;
+
+        waiter.m_Processor->PostponeInvoke(in_flight_chunk_fail_cb,
+                                           (void*)(user_data));
+    }
+}
+
+
+void SInFlightTSEChunk::x_RemoveWaiter(IPSGS_Processor *  processor)
+{
+    for (auto it = m_WaitList.begin(); it != m_WaitList.end(); ++it) {
+        if (it->m_Processor == processor) {
+            m_WaitList.erase(it);
+            return;
+        }
+    }
+}
+
+
+CInFlightTSEChunks::EPSGS_JoinResult
+CInFlightTSEChunks::Join(const string &  key,
+                         IPSGS_Processor *  processor,
+                         TInFlightChunkDataCB  data_cb,
+                         TInFlightChunkFailCB  fail_cb)
+{
+    lock_guard<mutex>   guard(m_Lock);
+
+    auto    it = m_InFlight.find(key);
+    if (it == m_InFlight.end()) {
+        // Nobody retrieves the chunk; the caller must do it
+        m_InFlight[key] = SInFlightTSEChunk();
+        return ePSGS_Initiator;
+    }
+
+    it->second.m_WaitList.push_back(
+        SInFlightTSEChunk::SInFlightWaitListItem{processor, data_cb, fail_cb});
+    m_App->GetCounters().Increment(processor,
+                                   CPSGSCounters::ePSGS_InFlightTSEChunkWait);
+    return ePSGS_Waiter;
+}
+
+
+bool CInFlightTSEChunks::AddBlobChunk(const string &  key, int  chunk_no,
+                                      const unsigned char *  data,
+                                      unsigned int  size)
+{
+    lock_guard<mutex>   guard(m_Lock);
+
+    auto    it = m_InFlight.find(key);
+    if (it == m_InFlight.end())
+        return false;
+
+    if (it->second.m_WaitList.empty()) {
+        // Nobody waits so there is no need to buffer. The ones which come
+        // later would miss the chunks which are already gone so the key is
+        // released and they retrieve the chunk themselves.
+        m_InFlight.erase(it);
+        return false;
+    }
+
+    auto &  chunk_data = *it->second.m_Data;
+    if (chunk_data.m_Size + size > m_MaxSize) {
+        // Too large to be kept in memory; let the waiters retrieve it
+        // themselves
+        it->second.x_OnFailed();
+        m_InFlight.erase(it);
+        return false;
+    }
+
+    if (chunk_data.m_BlobChunks.size() <= static_cast<size_t>(chunk_no))
+        chunk_data.m_BlobChunks.resize(chunk_no + 1);
+    chunk_data.m_BlobChunks[chunk_no].assign(data, data + size);
+    chunk_data.m_Size += size;
+    return true;
+}
+
+
+void CInFlightTSEChunks::OnFinished(const string &  key)
+{
+    lock_guard<mutex>   guard(m_Lock);
+
+    auto    it = m_InFlight.find(key);
+    if (it != m_InFlight.end()) {
+        // Will schedule a notification for those who waits
+        it->second.x_OnFinished();
+
+        // Remove it because the next request must get the fresh data
+        m_InFlight.erase(it);
+    }
+}
+
+
+void CInFlightTSEChunks::OnFailed(const string &  key)
+{
+    lock_guard<mutex>   guard(m_Lock);
+
+    auto    it = m_InFlight.find(key);
+    if (it != m_InFlight.end()) {
+        // Will schedule a notification for those who waits
+        it->second.x_OnFailed();
+        m_InFlight.erase(it);
+    }
+}
+
+
+void CInFlightTSEChunks::ClearWaitingProcessor(const string &  key,
+                                               IPSGS_Processor *  processor)
+{
+    lock_guard<mutex>   guard(m_Lock);
+
+    auto    it = m_InFlight.find(key);
+    if (it != m_InFlight.end()) {
+        it->second.x_RemoveWaiter(processor);
+    }
+}
+
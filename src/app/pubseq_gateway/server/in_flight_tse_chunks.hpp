@@ -0,0 +1,162 @@
+#ifndef IN_FLIGHT_TSE_CHUNKS__HPP
+#define IN_FLIGHT_TSE_CHUNKS__HPP
+
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Authors: agent
+ *
+ * File Description:
+ *   Coalescing of the identical TSE chunk retrievals which are in progress
+ *   at the same time
+ *
+ */
+
+
+#include <mutex>
+#include <map>
+#include <list>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+using namespace std;
+
+#include <corelib/ncbistl.hpp>
+
+USING_NCBI_SCOPE;
+
+
+class CPubseqGatewayApp;
+class IPSGS_Processor;
+
+
+// The TSE chunk blob data accumulated by the processor which retrieves the
+// chunk from Cassandra. The blob chunks are indexed by the blob chunk number.
+struct SPSGS_InFlightChunkData
+{
+    SPSGS_InFlightChunkData() :
+        m_Size(0)
+    {}
+
+    vector<vector<unsigned char>>   m_BlobChunks;
+    size_t                          m_Size;
+};
+
+
+// The data callback is called when the retrieval has been completed
+// successfully. The fail callback is called when the processor which
+// retrieves the chunk could not complete it (error, cancel, too large blob).
+// In this case the waiting processors are supposed to retrieve the chunk
+// themselves.
+typedef function<void(shared_ptr<SPSGS_InFlightChunkData>)>     TInFlightChunkDataCB;
+typedef function<void(void)>                                    TInFlightChunkFailCB;
+
+
+struct SInFlightTSEChunk
+{
+    public:
+        struct SInFlightWaitListItem
+        {
+            IPSGS_Processor *       m_Processor;
+            TInFlightChunkDataCB    m_DataCB;
+            TInFlightChunkFailCB    m_FailCB;
+        };
+
+        SInFlightTSEChunk() :
+            m_Data(make_shared<SPSGS_InFlightChunkData>())
+        {}
+
+        void x_OnFinished(void);
+        void x_OnFailed(void);
+        void x_RemoveWaiter(IPSGS_Processor *  processor);
+
+    public:
+        shared_ptr<SPSGS_InFlightChunkData>     m_Data;
+        list<SInFlightWaitListItem>             m_WaitList;
+};
+
+
+// The first processor which asks for a chunk becomes the initiator of the
+// retrieval. The next ones which ask for the same chunk before the
+// retrieval is completed are added to the wait list. The wait list items
+// are removed under the same lock as the notifications are scheduled so a
+// processor which has left the list is never referred to. The initiator feeds the
+// retrieved blob chunks and then reports the completion or failure. The
+// waiters are notified in their own libuv loops.
+class CInFlightTSEChunks
+{
+    public:
+        enum EPSGS_JoinResult {
+            ePSGS_Initiator,    // The caller must retrieve the chunk
+            ePSGS_Waiter        // The caller has been added to the wait list
+        };
+
+    public:
+        CInFlightTSEChunks(CPubseqGatewayApp *  app, size_t  max_size) :
+            m_App(app), m_MaxSize(max_size)
+        {}
+
+        ~CInFlightTSEChunks()
+        {}
+
+    public:
+        EPSGS_JoinResult Join(const string &  key,
+                              IPSGS_Processor *  processor,
+                              TInFlightChunkDataCB  data_cb,
+                              TInFlightChunkFailCB  fail_cb);
+
+        // The data are buffered only when there are waiters. Returns false
+        // if the chunk is not going to be shared: nobody waits for it or the
+        // accumulated data exceeded the max size (the waiters are notified
+        // about the failure). In both cases the key is released and the
+        // initiator should not report anything else for it.
+        bool AddBlobChunk(const string &  key, int  chunk_no,
+                          const unsigned char *  data, unsigned int  size);
+        void OnFinished(const string &  key);
+        void OnFailed(const string &  key);
+
+        void ClearWaitingProcessor(const string &  key,
+                                   IPSGS_Processor *  processor);
+
+        size_t Size(void)
+        {
+            size_t              size = 0;
+            lock_guard<mutex>   guard(m_Lock);
+
+            size = m_InFlight.size();
+            return size;
+        }
+
+    private:
+        CPubseqGatewayApp *                 m_App;
+        size_t                              m_MaxSize;
+
+        map<string, SInFlightTSEChunk>      m_InFlight;
+        mutex                               m_Lock;
+};
+
+#endif /* IN_FLIGHT_TSE_CHUNKS__HPP */
+
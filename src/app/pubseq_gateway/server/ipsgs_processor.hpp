@@ -69,7 +69,9 @@ USING_NCBI_SCOPE;
 ///     PSG_WARNING("Something"); }
 /// - The ProcessEvents() method can be called periodically (in addition to
 ///   some events like Cassandra data ready)
-class IPSGS_Processor
+/// - The processors are owned by shared pointers so the postponed callbacks
+///   may hold a weak reference to the processor which has scheduled them
+class IPSGS_Processor : public enable_shared_from_this<IPSGS_Processor>
 {
 public:
     /// The GetStatus() method returns a processor current status.
@@ -67,6 +67,7 @@ USING_NCBI_SCOPE;
 const EDiagSev          kDefaultSeverity = eDiag_Critical;
 const bool              kDefaultTrace = false;
 const float             kSplitInfoBlobCacheSizeMultiplier = 0.8;    // Used to calculate low mark
+const float             kResolutionCacheSizeMultiplier = 0.8;       // Used to calculate low mark
 const float             kUserInfoCacheSizeMultiplier = 0.8;         // Used to calculate low mark
 
 static const string     kDaemonizeArgName = "daemonize";
@@ -102,6 +103,8 @@ CPubseqGatewayApp::CPubseqGatewayApp() :
     m_StartTime(GetFastLocalTime()),
     m_ExcludeBlobCache(nullptr),
     m_SplitInfoCache(nullptr),
+    m_ResolutionCache(nullptr),
+    m_InFlightTSEChunks(nullptr),
     m_StartupDataState(ePSGS_NoCassConnection),
     m_LogFields("http")
 {
@@ -372,6 +375,15 @@ int CPubseqGatewayApp::Run(void)
 
     m_SplitInfoCache.reset(new CSplitInfoCache(m_Settings.m_SplitInfoBlobCacheSize,
                                                m_Settings.m_SplitInfoBlobCacheSize * kSplitInfoBlobCacheSizeMultiplier));
+    if (m_Settings.m_ResolutionCacheSize > 0)
+        m_ResolutionCache.reset(
+            new CResolutionCache(m_Settings.m_ResolutionCacheSize,
+                                 m_Settings.m_ResolutionCacheSize * kResolutionCacheSizeMultiplier,
+                                 m_Settings.m_ResolutionCacheExpirationSec,
+                                 m_Settings.m_ResolutionCacheNotFoundExpirationSec));
+    if (m_Settings.m_InFlightTSEChunkMaxSize > 0)
+        m_InFlightTSEChunks.reset(
+            new CInFlightTSEChunks(this, m_Settings.m_InFlightTSEChunkMaxSize));
     m_MyNCBIOKCache.reset(new CMyNCBIOKCache(this, m_Settings.m_MyNCBIOKCacheSize,
                                              m_Settings.m_MyNCBIOKCacheSize * kUserInfoCacheSizeMultiplier));
     m_MyNCBINotFoundCache.reset(new CMyNCBINotFoundCache(this, m_Settings.m_MyNCBINotFoundCacheSize,
@@ -548,7 +560,8 @@ int CPubseqGatewayApp::Run(void)
                             m_Settings.m_HttpPort,
                             m_Settings.m_HttpWorkers,
                             m_Settings.m_ListenerBacklog,
-                            m_Settings.m_TcpMaxConn));
+                            m_Settings.m_TcpMaxConn,
+                            m_Settings.m_ReusePort));
 
     // Run the monitoring thread
     int             ret_code = 0;
@@ -54,6 +54,8 @@
 #include "exclude_blob_cache.hpp"
 #include "split_info_cache.hpp"
 #include "my_ncbi_cache.hpp"
+#include "resolution_cache.hpp"
+#include "in_flight_tse_chunks.hpp"
 #include "alerts.hpp"
 #include "timing.hpp"
 #include "psgs_dispatcher.hpp"
@@ -89,6 +91,10 @@ public:
         if (m_SplitInfoCache)
             m_SplitInfoCache->Maintain();
     }
+    void MaintainResolutionCache(void) {
+        if (m_ResolutionCache)
+            m_ResolutionCache->Maintain();
+    }
     void MaintainMyNCBICaches(void) {
         if (m_MyNCBIOKCache)
             m_MyNCBIOKCache->Maintain();
@@ -116,6 +122,14 @@ public:
     CSplitInfoCache *  GetSplitInfoCache(void)
     { return m_SplitInfoCache.get(); }
 
+    // nullptr if the cache is switched off
+    CResolutionCache *  GetResolutionCache(void)
+    { return m_ResolutionCache.get(); }
+
+    // nullptr if the TSE chunk retrievals are not coalesced
+    CInFlightTSEChunks *  GetInFlightTSEChunks(void)
+    { return m_InFlightTSEChunks.get(); }
+
     CMyNCBIOKCache *  GetMyNCBIOKCache(void)
     { return m_MyNCBIOKCache.get(); }
 
@@ -472,6 +486,8 @@ private:
 
     unique_ptr<CExcludeBlobCache>       m_ExcludeBlobCache;
     unique_ptr<CSplitInfoCache>         m_SplitInfoCache;
+    unique_ptr<CResolutionCache>        m_ResolutionCache;
+    unique_ptr<CInFlightTSEChunks>      m_InFlightTSEChunks;
     unique_ptr<CMyNCBIOKCache>          m_MyNCBIOKCache;
     unique_ptr<CMyNCBINotFoundCache>    m_MyNCBINotFoundCache;
     unique_ptr<CMyNCBIErrorCache>       m_MyNCBIErrorCache;
@@ -148,6 +148,10 @@ const char *  CPubseqGatewayUVException::GetErrCodeString(void) const
             return "eUvExportStartFailure";
         case eUvExportWaitFailure:
             return "eUvExportWaitFailure";
+        case eUvTcpInitFailure:
+            return "eUvTcpInitFailure";
+        case eUvBindFailure:
+            return "eUvBindFailure";
         default:
             return CException::GetErrCodeString();
     }
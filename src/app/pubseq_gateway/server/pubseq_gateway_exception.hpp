@@ -106,7 +106,9 @@ public:
         eUvTimerInitFailure,
         eUvKeyCreateFailure,
         eUvExportStartFailure,
-        eUvExportWaitFailure
+        eUvExportWaitFailure,
+        eUvTcpInitFailure,
+        eUvBindFailure
     };
 
     virtual const char *  GetErrCodeString(void) const;
@@ -1570,6 +1570,12 @@ int CPubseqGatewayApp::OnStatus(CHttpRequest &  http_req,
         m_Counters->AppendValueNode(
             status, CPSGSCounters::ePSGS_MyNCBIErrorCacheSize,
             static_cast<uint64_t>(m_MyNCBIErrorCache->Size()));
+        m_Counters->AppendValueNode(
+            status, CPSGSCounters::ePSGS_ResolutionCacheSize,
+            static_cast<uint64_t>(m_ResolutionCache ? m_ResolutionCache->Size() : 0));
+        m_Counters->AppendValueNode(
+            status, CPSGSCounters::ePSGS_InFlightTSEChunks,
+            static_cast<uint64_t>(m_InFlightTSEChunks ? m_InFlightTSEChunks->Size() : 0));
         m_Counters->AppendValueNode(
             status, CPSGSCounters::ePSGS_ShutdownRequested,
             g_ShutdownData.m_ShutdownRequested);
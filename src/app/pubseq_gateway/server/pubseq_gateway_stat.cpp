@@ -297,6 +297,26 @@ CPSGSCounters::CPSGSCounters(const map<string, size_t> &  proc_group_to_index) :
         new SCounterInfo(
             "IncludeHUPSetToNo", "Include HUP set to 'no' when a blob in a secure keyspace counter",
             "Number of times a secure blob was going to be retrieved when include HUP option is explicitly set to 'no'");
+    m_Counters[ePSGS_ResolutionCacheHit] =
+        new SCounterInfo(
+            "ResolutionCacheHitCount", "Resolution cache hit counter",
+            "Number of times a lookup in the seq_id resolution cache found a resolved record");
+    m_Counters[ePSGS_ResolutionCacheNotFoundHit] =
+        new SCounterInfo(
+            "ResolutionCacheNotFoundHitCount", "Resolution cache not found hit counter",
+            "Number of times a lookup in the seq_id resolution cache found a not found record");
+    m_Counters[ePSGS_ResolutionCacheMiss] =
+        new SCounterInfo(
+            "ResolutionCacheMissCount", "Resolution cache miss counter",
+            "Number of times a lookup in the seq_id resolution cache did not find a record");
+    m_Counters[ePSGS_InFlightTSEChunkWait] =
+        new SCounterInfo(
+            "InFlightTSEChunkWaitCount", "In-flight TSE chunk wait counter",
+            "Number of times a TSE chunk request waited for the same chunk retrieved for another request instead of retrieving it from Cassandra");
+    m_Counters[ePSGS_InFlightTSEChunkFallback] =
+        new SCounterInfo(
+            "InFlightTSEChunkFallbackCount", "In-flight TSE chunk fallback counter",
+            "Number of times a TSE chunk request which waited for the same chunk retrieved for another request had to retrieve it from Cassandra itself");
     m_Counters[ePSGS_100] =
         new SCounterInfo(
             "RequestStop100", "Request stop counter with status 100",
@@ -513,6 +533,16 @@ CPSGSCounters::CPSGSCounters(const map<string, size_t> &  proc_group_to_index) :
             "MyNCBIErrorCacheSize", "My NCBI error cache size",
             "Number of records in the my NCBI error cache",
             SCounterInfo::ePSGS_Arbitrary);
+    m_Counters[ePSGS_ResolutionCacheSize] =
+        new SCounterInfo(
+            "ResolutionCacheSize", "Resolution cache size",
+            "Number of records in the seq_id resolution cache",
+            SCounterInfo::ePSGS_Arbitrary);
+    m_Counters[ePSGS_InFlightTSEChunks] =
+        new SCounterInfo(
+            "InFlightTSEChunks", "In-flight TSE chunks",
+            "Number of TSE chunks which are being retrieved from Cassandra and can be shared between requests",
+            SCounterInfo::ePSGS_Arbitrary);
     m_Counters[ePSGS_ShutdownRequested] =
         new SCounterInfo(
             "ShutdownRequested", "Shutdown requested flag",
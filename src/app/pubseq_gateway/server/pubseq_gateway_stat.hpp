@@ -107,6 +107,11 @@ class CPSGSCounters
             ePSGS_MyNCBIErrorCacheHit,
             ePSGS_MyNCBIOKCacheWaitHit,
             ePSGS_IncludeHUPSetToNo,
+            ePSGS_ResolutionCacheHit,
+            ePSGS_ResolutionCacheNotFoundHit,
+            ePSGS_ResolutionCacheMiss,
+            ePSGS_InFlightTSEChunkWait,
+            ePSGS_InFlightTSEChunkFallback,
 
             // Request stop statuses
             ePSGS_100,
@@ -166,6 +171,8 @@ class CPSGSCounters
             ePSGS_MyNCBIOKCacheSize,
             ePSGS_MyNCBINotFoundCacheSize,
             ePSGS_MyNCBIErrorCacheSize,
+            ePSGS_ResolutionCacheSize,
+            ePSGS_InFlightTSEChunks,
 
             // Used to reserve an array for individual counters
             ePSGS_MaxIndividualCounter,
@@ -0,0 +1,172 @@
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Authors: agent
+ *
+ * File Description: in-memory cache of the final seq_id resolution results
+ *
+ */
+
+#include <ncbi_pch.hpp>
+
+#include "resolution_cache.hpp"
+
+
+CResolutionCache::CResolutionCache(size_t  high_mark, size_t  low_mark,
+                                   size_t  found_expiration_sec,
+                                   size_t  not_found_expiration_sec) :
+    m_HighMark(high_mark / kShards + 1),
+    m_LowMark(low_mark / kShards + 1),
+    m_FoundExpiration(found_expiration_sec),
+    m_NotFoundExpiration(not_found_expiration_sec)
+{}
+
+
+CResolutionCache::EPSGS_ResolutionCacheResult
+CResolutionCache::GetResolution(const string &  seq_id,
+                                int16_t  seq_id_type,
+                                TAccSubstOption  acc_subst_option,
+                                SBioseqResolution &  resolution)
+{
+    string              key = x_GetKey(seq_id, seq_id_type, acc_subst_option);
+    SShard &            shard = x_GetShard(key);
+    lock_guard<mutex>   guard(shard.m_Lock);
+
+    auto    it = shard.m_Cache.find(key);
+    if (it == shard.m_Cache.end())
+        return ePSGS_Miss;
+
+    if (it->second.m_Expiration <= psg_clock_t::now()) {
+        shard.m_LRU.erase(it->second.m_LRUIterator);
+        shard.m_Cache.erase(it);
+        return ePSGS_Miss;
+    }
+
+    shard.m_LRU.splice(shard.m_LRU.begin(), shard.m_LRU,
+                       it->second.m_LRUIterator);
+
+    if (it->second.m_NotFound)
+        return ePSGS_NotFound;
+
+    resolution = it->second.m_Resolution;
+    return ePSGS_Found;
+}
+
+
+void
+CResolutionCache::AddResolution(const string &  seq_id,
+                                int16_t  seq_id_type,
+                                TAccSubstOption  acc_subst_option,
+                                const SBioseqResolution &  resolution)
+{
+    if (m_FoundExpiration.count() > 0)
+        x_Add(x_GetKey(seq_id, seq_id_type, acc_subst_option),
+              false, &resolution);
+}
+
+
+void
+CResolutionCache::AddNotFound(const string &  seq_id,
+                              int16_t  seq_id_type,
+                              TAccSubstOption  acc_subst_option)
+{
+    if (m_NotFoundExpiration.count() > 0)
+        x_Add(x_GetKey(seq_id, seq_id_type, acc_subst_option),
+              true, nullptr);
+}
+
+
+void
+CResolutionCache::x_Add(const string &  key, bool  not_found,
+                        const SBioseqResolution *  resolution)
+{
+    SShard &            shard = x_GetShard(key);
+    lock_guard<mutex>   guard(shard.m_Lock);
+
+    auto    it = shard.m_Cache.find(key);
+    if (it == shard.m_Cache.end()) {
+        it = shard.m_Cache.emplace(key, SResolutionCacheItem()).first;
+        shard.m_LRU.push_front(key);
+    } else {
+        shard.m_LRU.splice(shard.m_LRU.begin(), shard.m_LRU,
+                           it->second.m_LRUIterator);
+    }
+
+    SResolutionCacheItem &  item = it->second;
+    item.m_LRUIterator = shard.m_LRU.begin();
+    item.m_NotFound = not_found;
+    if (not_found) {
+        item.m_Expiration = psg_clock_t::now() + m_NotFoundExpiration;
+        item.m_Resolution.Reset();
+    } else {
+        item.m_Expiration = psg_clock_t::now() + m_FoundExpiration;
+        item.m_Resolution = *resolution;
+    }
+
+    // The just added item is at the front of the LRU list so it survives
+    while (shard.m_Cache.size() > m_HighMark) {
+        shard.m_Cache.erase(shard.m_LRU.back());
+        shard.m_LRU.pop_back();
+    }
+}
+
+
+size_t CResolutionCache::Size(void)
+{
+    size_t      size = 0;
+    for (auto &  shard : m_Shards) {
+        lock_guard<mutex>   guard(shard.m_Lock);
+        size += shard.m_Cache.size();
+    }
+    return size;
+}
+
+
+void CResolutionCache::Maintain(void)
+{
+    auto    now = psg_clock_t::now();
+
+    for (auto &  shard : m_Shards) {
+        lock_guard<mutex>   guard(shard.m_Lock);
+
+        // The expired records are removed regardless of the size
+        for (auto  it = shard.m_Cache.begin(); it != shard.m_Cache.end(); ) {
+            if (it->second.m_Expiration <= now) {
+                shard.m_LRU.erase(it->second.m_LRUIterator);
+                it = shard.m_Cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (shard.m_Cache.size() <= m_HighMark)
+            continue;
+
+        while (shard.m_Cache.size() > m_LowMark) {
+            shard.m_Cache.erase(shard.m_LRU.back());
+            shard.m_LRU.pop_back();
+        }
+    }
+}
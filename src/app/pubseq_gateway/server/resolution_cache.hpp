@@ -0,0 +1,142 @@
+#ifndef RESOLUTION_CACHE__HPP
+#define RESOLUTION_CACHE__HPP
+
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Authors: agent
+ *
+ * File Description: in-memory cache of the final seq_id resolution results
+ *
+ */
+
+
+#include <mutex>
+#include <unordered_map>
+#include <list>
+#include <string>
+using namespace std;
+
+#include "pubseq_gateway_types.hpp"
+#include "pubseq_gateway_utils.hpp"
+
+USING_NCBI_SCOPE;
+
+
+struct SResolutionCacheItem
+{
+    public:
+        SResolutionCacheItem() :
+            m_NotFound(false)
+        {}
+
+        ~SResolutionCacheItem()
+        {}
+
+    public:
+        psg_time_point_t            m_Expiration;
+        bool                        m_NotFound;
+        SBioseqResolution           m_Resolution;
+        list<string>::iterator      m_LRUIterator;
+};
+
+
+
+// The cache keeps the resolutions of the individual seq_id/seq_id_type pairs
+// to the full bioseq info. The 'not found' results are cached as well but for
+// a shorter time. The cache is split into independently locked shards to
+// avoid the contention between the worker threads.
+// The cached resolutions have already passed the accession adjustment which
+// depends on the request acc_substitution option so the option is a part of
+// the key.
+class CResolutionCache
+{
+    public:
+        enum EPSGS_ResolutionCacheResult {
+            ePSGS_Miss,
+            ePSGS_Found,
+            ePSGS_NotFound
+        };
+
+        using TAccSubstOption = SPSGS_RequestBase::EPSGS_AccSubstitutioOption;
+
+    public:
+        CResolutionCache(size_t  high_mark, size_t  low_mark,
+                         size_t  found_expiration_sec,
+                         size_t  not_found_expiration_sec);
+
+        ~CResolutionCache()
+        {}
+
+    public:
+        EPSGS_ResolutionCacheResult
+                        GetResolution(const string &  seq_id,
+                                      int16_t  seq_id_type,
+                                      TAccSubstOption  acc_subst_option,
+                                      SBioseqResolution &  resolution);
+        void            AddResolution(const string &  seq_id,
+                                      int16_t  seq_id_type,
+                                      TAccSubstOption  acc_subst_option,
+                                      const SBioseqResolution &  resolution);
+        void            AddNotFound(const string &  seq_id,
+                                    int16_t  seq_id_type,
+                                    TAccSubstOption  acc_subst_option);
+
+        size_t Size(void);
+
+        // Removes the expired records and shrinks the cache to the low mark if
+        // the high mark is exceeded. The high mark is also enforced on each
+        // insertion so the cache never grows beyond it between the calls.
+        void Maintain(void);
+
+    private:
+        static constexpr size_t     kShards = 16;
+
+        struct SShard
+        {
+            unordered_map<string, SResolutionCacheItem>     m_Cache;
+            list<string>                                    m_LRU;
+            mutex                                           m_Lock;
+        };
+
+        static string x_GetKey(const string &  seq_id, int16_t  seq_id_type,
+                               TAccSubstOption  acc_subst_option)
+        { return seq_id + "|" + to_string(seq_id_type) + "|" +
+                 to_string(static_cast<int>(acc_subst_option)); }
+        SShard &  x_GetShard(const string &  key)
+        { return m_Shards[hash<string>()(key) % kShards]; }
+        void x_Add(const string &  key, bool  not_found,
+                   const SBioseqResolution *  resolution);
+
+    private:
+        size_t                  m_HighMark;
+        size_t                  m_LowMark;
+        chrono::seconds         m_FoundExpiration;
+        chrono::seconds         m_NotFoundExpiration;
+        SShard                  m_Shards[kShards];
+};
+
+
+#endif
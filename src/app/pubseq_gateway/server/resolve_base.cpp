@@ -78,7 +78,8 @@ CPSGS_ResolveBase::CPSGS_ResolveBase(shared_ptr<CPSGS_Request> request,
     m_FinalFinishedCB(finished_cb),
     m_FinalErrorCB(error_cb),
     m_FinalStartProcessingCB(resolution_start_processing_cb),
-    m_AsyncStarted(false)
+    m_AsyncStarted(false),
+    m_ResolvedViaResolutionCache(false)
 {}
 
 
@@ -324,8 +325,10 @@ void CPSGS_ResolveBase::ResolveInputSeqId(const string &  seq_id,
 
 void CPSGS_ResolveBase::x_ResolveSeqId(void)
 {
+    if (x_ResolveViaResolutionCache())
+        return;
+
     SBioseqResolution   bioseq_resolution;
-    auto                app = CPubseqGatewayApp::GetInstance();
     string              parse_err_msg;
     CSeq_id             oslt_seq_id;
     auto                parsing_result = ParseInputSeqId(oslt_seq_id,
@@ -426,6 +429,66 @@ void CPSGS_ResolveBase::x_ResolveSeqId(void)
     // - not found
     // - parsing error
     // - LMDB error
+    x_OnSeqIdNotResolved(bioseq_resolution, parse_err_msg);
+}
+
+
+// Provides true if the current seq_id was handled using the cached
+// resolution results: either found or known as not found
+bool CPSGS_ResolveBase::x_ResolveViaResolutionCache(void)
+{
+    m_ResolvedViaResolutionCache = false;
+
+    auto    app = CPubseqGatewayApp::GetInstance();
+    auto    resolution_cache = app->GetResolutionCache();
+    if (resolution_cache == nullptr)
+        return false;
+    if (x_GetRequestUseCache() == SPSGS_RequestBase::ePSGS_DbOnly)
+        return false;
+
+    SBioseqResolution   bioseq_resolution;
+    auto                cache_result = resolution_cache->GetResolution(
+                                        m_CurrentSeqIdToResolve->seq_id,
+                                        m_CurrentSeqIdToResolve->seq_id_type,
+                                        GetAccessionSubstitutionOption(),
+                                        bioseq_resolution);
+    switch (cache_result) {
+        case CResolutionCache::ePSGS_Found:
+            app->GetCounters().Increment(this,
+                                         CPSGSCounters::ePSGS_ResolutionCacheHit);
+            if (m_Request->NeedTrace())
+                m_Reply->SendTrace("Resolution cache hit for seq_id " +
+                                   m_CurrentSeqIdToResolve->seq_id,
+                                   m_Request->GetStartTimestamp());
+            m_ResolvedViaResolutionCache = true;
+            x_OnSeqIdResolveFinished(move(bioseq_resolution));
+            return true;
+        case CResolutionCache::ePSGS_NotFound:
+            app->GetCounters().Increment(this,
+                                         CPSGSCounters::ePSGS_ResolutionCacheNotFoundHit);
+            if (m_Request->NeedTrace())
+                m_Reply->SendTrace("Resolution cache not found hit for seq_id " +
+                                   m_CurrentSeqIdToResolve->seq_id,
+                                   m_Request->GetStartTimestamp());
+            m_ResolvedViaResolutionCache = true;
+            x_OnSeqIdNotResolved(bioseq_resolution, kEmptyStr);
+            return true;
+        default:
+            break;
+    }
+
+    app->GetCounters().Increment(this,
+                                 CPSGSCounters::ePSGS_ResolutionCacheMiss);
+    return false;
+}
+
+
+void
+CPSGS_ResolveBase::x_OnSeqIdNotResolved(
+                                const SBioseqResolution &  bioseq_resolution,
+                                const string &  parse_err_msg)
+{
+    auto    app = CPubseqGatewayApp::GetInstance();
     app->GetCounters().Increment(this,
                                  CPSGSCounters::ePSGS_InputSeqIdNotResolved);
 
@@ -610,6 +673,21 @@ void CPSGS_ResolveBase::x_OnSeqIdResolveFinished(
     }
 
     // All good
+    // The only full bioseq info records are memorized because the shortened
+    // si2csi ones are good only for some requests
+    if (!m_ResolvedViaResolutionCache &&
+        (bioseq_resolution.m_ResolutionResult == ePSGS_BioseqCache ||
+         bioseq_resolution.m_ResolutionResult == ePSGS_BioseqDB)) {
+        auto    resolution_cache = CPubseqGatewayApp::GetInstance()->
+                                                    GetResolutionCache();
+        if (resolution_cache)
+            resolution_cache->AddResolution(
+                                    m_CurrentSeqIdToResolve->seq_id,
+                                    m_CurrentSeqIdToResolve->seq_id_type,
+                                    GetAccessionSubstitutionOption(),
+                                    bioseq_resolution);
+    }
+
     x_OnResolutionGoodData();
     x_RegisterSuccessTiming(bioseq_resolution);
     m_FinalFinishedCB(move(bioseq_resolution));
@@ -93,6 +93,9 @@ private:
 
 private:
     void x_ResolveSeqId(void);
+    bool x_ResolveViaResolutionCache(void);
+    void x_OnSeqIdNotResolved(const SBioseqResolution &  bioseq_resolution,
+                              const string &  parse_err_msg);
     void x_OnResolutionGoodData(void);
     void x_OnSeqIdResolveError(
                         CRequestStatus::ECode  status,
@@ -123,6 +126,7 @@ private:
     TSeqIdResolutionStartProcessingCB   m_FinalStartProcessingCB;
 
     bool                                m_AsyncStarted;
+    bool                                m_ResolvedViaResolutionCache;
 };
 
 #endif  // PSGS_RESOLVEBASE__HPP
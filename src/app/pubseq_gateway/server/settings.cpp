@@ -59,6 +59,7 @@ const string            kCountersSection = "COUNTERS";
 
 const unsigned short    kWorkersDefault = 64;
 const unsigned int      kListenerBacklogDefault = 256;
+const bool              kReusePortDefault = false;
 const unsigned short    kTcpMaxConnDefault = 4096;
 const unsigned int      kTimeoutDefault = 30000;
 const unsigned int      kMaxRetriesDefault = 2;
@@ -82,6 +83,10 @@ const double            kDefaultResendTimeoutSec = 0.2;
 const double            kDefaultRequestTimeoutSec = 30.0;
 const size_t            kDefaultProcessorMaxConcurrency = 1200;
 const size_t            kDefaultSplitInfoBlobCacheSize = 1000;
+const size_t            kDefaultResolutionCacheSize = 100000;
+const size_t            kDefaultResolutionCacheExpirationSec = 60;
+const size_t            kDefaultResolutionCacheNotFoundExpirationSec = 5;
+const size_t            kDefaultInFlightTSEChunkMaxSize = 16 * 1024 * 1024;
 const size_t            kDefaultIPGPageSize = 1024;
 const bool              kDefaultEnableHugeIPG = true;
 const string            kDefaultAuthToken = "";
@@ -115,6 +120,7 @@ SPubseqGatewaySettings::SPubseqGatewaySettings() :
     m_HttpPort(0),
     m_HttpWorkers(kWorkersDefault),
     m_ListenerBacklog(kListenerBacklogDefault),
+    m_ReusePort(kReusePortDefault),
     m_TcpMaxConn(kTcpMaxConnDefault),
     m_TimeoutMs(kTimeoutDefault),
     m_MaxRetries(kMaxRetriesDefault),
@@ -125,6 +131,10 @@ SPubseqGatewaySettings::SPubseqGatewaySettings() :
     m_RequestTimeoutSec(kDefaultRequestTimeoutSec),
     m_ProcessorMaxConcurrency(kDefaultProcessorMaxConcurrency),
     m_SplitInfoBlobCacheSize(kDefaultSplitInfoBlobCacheSize),
+    m_ResolutionCacheSize(kDefaultResolutionCacheSize),
+    m_ResolutionCacheExpirationSec(kDefaultResolutionCacheExpirationSec),
+    m_ResolutionCacheNotFoundExpirationSec(kDefaultResolutionCacheNotFoundExpirationSec),
+    m_InFlightTSEChunkMaxSize(kDefaultInFlightTSEChunkMaxSize),
     m_ShutdownIfTooManyOpenFD(0),
     m_RootKeyspace(kDefaultRootKeyspace),
     m_ConfigurationDomain(kDefaultConfigurationDomain),
@@ -207,6 +217,8 @@ void SPubseqGatewaySettings::x_ReadServerSection(const CNcbiRegistry &   registr
                                     kWorkersDefault);
     m_ListenerBacklog = registry.GetInt(kServerSection, "backlog",
                                         kListenerBacklogDefault);
+    m_ReusePort = registry.GetBool(kServerSection, "reuse_port",
+                                   kReusePortDefault);
     m_TcpMaxConn = registry.GetInt(kServerSection, "maxconn",
                                    kTcpMaxConnDefault);
     m_TimeoutMs = registry.GetInt(kServerSection, "optimeout",
@@ -240,6 +252,21 @@ void SPubseqGatewaySettings::x_ReadServerSection(const CNcbiRegistry &   registr
     m_SplitInfoBlobCacheSize = registry.GetInt(kServerSection,
                                                "split_info_blob_cache_size",
                                                kDefaultSplitInfoBlobCacheSize);
+    m_ResolutionCacheSize = registry.GetInt(kServerSection,
+                                            "resolution_cache_size",
+                                            kDefaultResolutionCacheSize);
+    m_ResolutionCacheExpirationSec =
+            registry.GetInt(kServerSection,
+                            "resolution_cache_expiration_sec",
+                            kDefaultResolutionCacheExpirationSec);
+    m_ResolutionCacheNotFoundExpirationSec =
+            registry.GetInt(kServerSection,
+                            "resolution_cache_not_found_expiration_sec",
+                            kDefaultResolutionCacheNotFoundExpirationSec);
+    m_InFlightTSEChunkMaxSize =
+            registry.GetInt(kServerSection,
+                            "in_flight_tse_chunk_max_size",
+                            kDefaultInFlightTSEChunkMaxSize);
 
     if (m_SSLEnable) {
         m_ShutdownIfTooManyOpenFD =
@@ -55,6 +55,7 @@ struct SPubseqGatewaySettings
     unsigned short                      m_HttpPort;
     unsigned short                      m_HttpWorkers;
     unsigned int                        m_ListenerBacklog;
+    bool                                m_ReusePort;
     unsigned short                      m_TcpMaxConn;
     unsigned int                        m_TimeoutMs;
     unsigned int                        m_MaxRetries;
@@ -65,6 +66,10 @@ struct SPubseqGatewaySettings
     double                              m_RequestTimeoutSec;
     size_t                              m_ProcessorMaxConcurrency;
     size_t                              m_SplitInfoBlobCacheSize;
+    size_t                              m_ResolutionCacheSize;
+    size_t                              m_ResolutionCacheExpirationSec;
+    size_t                              m_ResolutionCacheNotFoundExpirationSec;
+    size_t                              m_InFlightTSEChunkMaxSize;
     size_t                              m_ShutdownIfTooManyOpenFD;
     string                              m_RootKeyspace;
     string                              m_ConfigurationDomain;
@@ -31,6 +31,9 @@
 
 #include <ncbi_pch.hpp>
 
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include "tcp_daemon.hpp"
 #include "pubseq_gateway.hpp"
 #include "pubseq_gateway_utils.hpp"
@@ -231,13 +234,20 @@ void CTcpWorker::Execute(void)
         uv_key_set(&CTcpWorkersList::s_thread_worker_key, this);
 
         m_protocol.BeforeStart();
-        err_code = uv_import(m_internal->m_loop.Handle(),
-                             reinterpret_cast<uv_stream_t*>(&m_internal->m_listener),
-                             m_exp);
-        // PSG_ERROR("worker " << worker->m_id << " uv_import: " << err_code);
-        if (err_code != 0)
-            NCBI_THROW2(CPubseqGatewayUVException, eUvImportFailure,
-                        "uv_import failed", err_code);
+        if (m_exp == nullptr) {
+            // SO_REUSEPORT mode: each worker has its own listener and the
+            // kernel balances the incoming connections between them
+            m_daemon->BindReusePort(m_internal->m_loop.Handle(),
+                                    &m_internal->m_listener);
+        } else {
+            err_code = uv_import(m_internal->m_loop.Handle(),
+                                 reinterpret_cast<uv_stream_t*>(&m_internal->m_listener),
+                                 m_exp);
+            // PSG_ERROR("worker " << worker->m_id << " uv_import: " << err_code);
+            if (err_code != 0)
+                NCBI_THROW2(CPubseqGatewayUVException, eUvImportFailure,
+                            "uv_import failed", err_code);
+        }
 
         m_internal->m_listener.data = this;
         err_code = uv_listen(reinterpret_cast<uv_stream_t*>(&m_internal->m_listener),
@@ -311,7 +321,10 @@ void CTcpWorker::Execute(void)
         try {
             int         err_code;
 
-            if (m_internal->m_listener.type != 0)
+            // The listener may have been closed already by a failed
+            // BindReusePort() call
+            if (m_internal->m_listener.type != 0 &&
+                !uv_is_closing(reinterpret_cast<uv_handle_t*>(&m_internal->m_listener)))
                 uv_close(reinterpret_cast<uv_handle_t*>(&m_internal->m_listener),
                          NULL);
 
@@ -678,12 +691,91 @@ bool CTcpDaemon::OnRequest(CHttpProto **  http_proto)
 }
 
 
+void CTcpDaemon::CheckReusePort(void)
+{
+    struct sockaddr_in  addr_in;
+    int                 err_code = uv_ip4_addr(m_address.c_str(), m_port,
+                                               &addr_in);
+    if (err_code != 0)
+        NCBI_THROW2(CPubseqGatewayUVException, eUvBindFailure,
+                    "uv_ip4_addr failed for " + m_address + ":" +
+                    to_string(m_port), err_code);
+
+    int         fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        NCBI_THROW2(CPubseqGatewayUVException, eUvTcpInitFailure,
+                    "socket() failed", uv_translate_sys_error(errno));
+
+    // No SO_REUSEPORT here: with it the bind would succeed next to a
+    // listener of another server started by the same user and the two
+    // servers would silently share the port. SO_REUSEADDR is set the same
+    // way as uv_tcp_bind() does so that connections in TIME_WAIT left by a
+    // previous run do not fail the start.
+    int         on = 1;
+    err_code = 0;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+        ::bind(fd, reinterpret_cast<struct sockaddr*>(&addr_in),
+               sizeof(addr_in)) != 0)
+        err_code = uv_translate_sys_error(errno);
+    close(fd);
+
+    if (err_code != 0)
+        NCBI_THROW2(CPubseqGatewayUVException, eUvBindFailure,
+                    "Failed to bind to " + m_address + ":" +
+                    to_string(m_port), err_code);
+}
+
+
 uint16_t CTcpDaemon::NumOfConnections(void) const
 {
     return m_connection_count;
 }
 
 
+void CTcpDaemon::BindReusePort(uv_loop_t *  loop, uv_tcp_t *  listener)
+{
+    struct sockaddr_in  addr_in;
+    int                 err_code = uv_ip4_addr(m_address.c_str(), m_port,
+                                               &addr_in);
+    if (err_code != 0)
+        NCBI_THROW2(CPubseqGatewayUVException, eUvBindFailure,
+                    "uv_ip4_addr failed for " + m_address + ":" +
+                    to_string(m_port), err_code);
+
+    // The socket needs to be created before binding to set the option
+    err_code = uv_tcp_init_ex(loop, listener, AF_INET);
+    if (err_code != 0)
+        NCBI_THROW2(CPubseqGatewayUVException, eUvTcpInitFailure,
+                    "uv_tcp_init_ex failed", err_code);
+
+    // From here on the handle is registered in the loop so it must be
+    // closed on any failure; otherwise the loop can never be closed
+    try {
+        uv_os_fd_t      fd;
+        err_code = uv_fileno(reinterpret_cast<uv_handle_t*>(listener), &fd);
+        if (err_code != 0)
+            NCBI_THROW2(CPubseqGatewayUVException, eUvBindFailure,
+                        "uv_fileno failed", err_code);
+
+        int             on = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0)
+            NCBI_THROW2(CPubseqGatewayUVException, eUvBindFailure,
+                        "setsockopt(SO_REUSEPORT) failed",
+                        uv_translate_sys_error(errno));
+
+        err_code = uv_tcp_bind(listener,
+                               reinterpret_cast<struct sockaddr*>(&addr_in), 0);
+        if (err_code != 0)
+            NCBI_THROW2(CPubseqGatewayUVException, eUvBindFailure,
+                        "uv_tcp_bind failed for " + m_address + ":" +
+                        to_string(m_port), err_code);
+    } catch (...) {
+        uv_close(reinterpret_cast<uv_handle_t*>(listener), NULL);
+        throw;
+    }
+}
+
+
 void CTcpDaemon::Run(CHttpDaemon &  http_daemon,
                      function<void(CTcpDaemon &  daemon)>  OnWatchDog)
 {
@@ -728,31 +820,39 @@ void CTcpDaemon::Run(CHttpDaemon &  http_daemon,
         sigwinch.Start(SIGWINCH, s_OnMainSigWinch);
 
 
-        CUvTcp          listener(loop.Handle());
-        listener.Bind(m_address.c_str(), m_port);
+        if (m_reuse_port) {
+            // Each worker binds its own listener. The workers report the
+            // errors asynchronously so the address is checked here to fail
+            // at the start if it cannot be used or is already listened on.
+            CheckReusePort();
+            workers.Start(nullptr, m_num_workers, http_daemon, OnWatchDog);
+        } else {
+            CUvTcp          listener(loop.Handle());
+            listener.Bind(m_address.c_str(), m_port);
+
+            struct uv_export_t *    exp = NULL;
+            rc = uv_export_start(loop.Handle(),
+                                 reinterpret_cast<uv_stream_t*>(listener.Handle()),
+                                 IPC_PIPE_NAME, m_num_workers, &exp);
+            if (rc)
+                NCBI_THROW2(CPubseqGatewayUVException, eUvExportStartFailure,
+                            "uv_export_start failed", rc);
+
+            try {
+                workers.Start(exp, m_num_workers, http_daemon, OnWatchDog);
+            } catch (const exception &  exc) {
+                uv_export_close(exp);
+                throw;
+            }
 
-        struct uv_export_t *    exp = NULL;
-        rc = uv_export_start(loop.Handle(),
-                             reinterpret_cast<uv_stream_t*>(listener.Handle()),
-                             IPC_PIPE_NAME, m_num_workers, &exp);
-        if (rc)
-            NCBI_THROW2(CPubseqGatewayUVException, eUvExportStartFailure,
-                        "uv_export_start failed", rc);
+            rc = uv_export_finish(exp);
+            if (rc)
+                NCBI_THROW2(CPubseqGatewayUVException, eUvExportWaitFailure,
+                            "uv_export_wait failed", rc);
 
-        try {
-            workers.Start(exp, m_num_workers, http_daemon, OnWatchDog);
-        } catch (const exception &  exc) {
-            uv_export_close(exp);
-            throw;
+            listener.Close(nullptr);
         }
 
-        rc = uv_export_finish(exp);
-        if (rc)
-            NCBI_THROW2(CPubseqGatewayUVException, eUvExportWaitFailure,
-                        "uv_export_wait failed", rc);
-
-        listener.Close(nullptr);
-
         CHttpProto::DaemonStarted();
 
         uv_timer_t      watch_dog;
@@ -175,6 +175,7 @@ private:
     unsigned short                  m_num_workers;
     unsigned short                  m_backlog;
     unsigned short                  m_max_connections;
+    bool                            m_reuse_port;
     CTcpWorkersList *               m_workers;
     std::atomic_uint_fast16_t       m_connection_count;
 
@@ -200,18 +201,26 @@ private:
     bool ClientConnected(void);
     bool ClientDisconnected(void);
 
+    // Binds a listener socket with the SO_REUSEPORT option set so that
+    // each worker could have its own listener on the same address/port
+    void BindReusePort(uv_loop_t *  loop, uv_tcp_t *  listener);
+    // Throws if the address cannot be bound or another server already
+    // listens on it; checked once before the workers bind their listeners
+    void CheckReusePort(void);
+
 protected:
     static constexpr const char IPC_PIPE_NAME[] = "tcp_daemon_startup_rpc";
 
 public:
     CTcpDaemon(const std::string &  Address, unsigned short  Port,
                unsigned short  NumWorkers, unsigned short  BackLog,
-               unsigned short  MaxConnections) :
+               unsigned short  MaxConnections, bool  ReusePort = false) :
         m_address(Address),
         m_port(Port),
         m_num_workers(NumWorkers),
         m_backlog(BackLog),
         m_max_connections(MaxConnections),
+        m_reuse_port(ReusePort),
         m_workers(nullptr),
         m_connection_count(0)
     {}
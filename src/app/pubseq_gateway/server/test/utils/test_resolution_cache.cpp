@@ -0,0 +1,152 @@
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Authors: agent
+ *
+ * File Description: unit test for the seq_id resolution cache
+ *
+ */
+
+#include <ncbi_pch.hpp>
+
+#include "../../resolution_cache.hpp"
+
+#include <corelib/test_boost.hpp>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+USING_NCBI_SCOPE;
+
+
+static const auto   kDefaultSubst = SPSGS_RequestBase::ePSGS_DefaultAccSubstitution;
+static const auto   kNeverSubst = SPSGS_RequestBase::ePSGS_NeverAccSubstitute;
+
+
+static SBioseqResolution s_MakeResolution(const string &  accession)
+{
+    SBioseqResolution   resolution;
+    resolution.m_ResolutionResult = ePSGS_BioseqDB;
+    resolution.GetBioseqInfo().SetAccession(accession);
+    return resolution;
+}
+
+
+BOOST_AUTO_TEST_CASE(FoundAndNotFound)
+{
+    CResolutionCache    cache(1000, 800, 60, 60);
+    SBioseqResolution   resolution;
+
+    BOOST_CHECK_EQUAL(cache.GetResolution("NC_000001", 10, kDefaultSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_Miss);
+
+    cache.AddResolution("NC_000001", 10, kDefaultSubst,
+                        s_MakeResolution("NC_000001"));
+    cache.AddNotFound("XX_123456", 10, kDefaultSubst);
+    BOOST_CHECK_EQUAL(cache.Size(), 2U);
+
+    BOOST_CHECK_EQUAL(cache.GetResolution("NC_000001", 10, kDefaultSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_Found);
+    BOOST_CHECK_EQUAL(resolution.GetBioseqInfo().GetAccession(), "NC_000001");
+    BOOST_CHECK(resolution.m_ResolutionResult == ePSGS_BioseqDB);
+
+    BOOST_CHECK_EQUAL(cache.GetResolution("XX_123456", 10, kDefaultSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_NotFound);
+
+    // The seq_id_type is a part of the key
+    BOOST_CHECK_EQUAL(cache.GetResolution("NC_000001", 11, kDefaultSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_Miss);
+
+    // A found record replaces a not found one
+    cache.AddResolution("XX_123456", 10, kDefaultSubst,
+                        s_MakeResolution("XX_123456"));
+    BOOST_CHECK_EQUAL(cache.GetResolution("XX_123456", 10, kDefaultSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_Found);
+    BOOST_CHECK_EQUAL(cache.Size(), 2U);
+}
+
+
+BOOST_AUTO_TEST_CASE(AccessionSubstitutionIsPartOfKey)
+{
+    // The cached resolutions are adjusted according to the request
+    // acc_substitution option so they must not leak to the requests with a
+    // different option
+    CResolutionCache    cache(1000, 800, 60, 60);
+    SBioseqResolution   resolution;
+
+    cache.AddResolution("12345", 12, kDefaultSubst,
+                        s_MakeResolution("NC_000001"));
+    BOOST_CHECK_EQUAL(cache.GetResolution("12345", 12, kNeverSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_Miss);
+
+    cache.AddResolution("12345", 12, kNeverSubst,
+                        s_MakeResolution("12345"));
+    BOOST_CHECK_EQUAL(cache.GetResolution("12345", 12, kDefaultSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_Found);
+    BOOST_CHECK_EQUAL(resolution.GetBioseqInfo().GetAccession(), "NC_000001");
+    BOOST_CHECK_EQUAL(cache.GetResolution("12345", 12, kNeverSubst,
+                                          resolution),
+                      CResolutionCache::ePSGS_Found);
+    BOOST_CHECK_EQUAL(resolution.GetBioseqInfo().GetAccession(), "12345");
+}
+
+
+BOOST_AUTO_TEST_CASE(ZeroExpirationDisablesCaching)
+{
+    CResolutionCache    cache(1000, 800, 0, 0);
+
+    cache.AddResolution("NC_000001", 10, kDefaultSubst,
+                        s_MakeResolution("NC_000001"));
+    cache.AddNotFound("XX_123456", 10, kDefaultSubst);
+    BOOST_CHECK_EQUAL(cache.Size(), 0U);
+}
+
+
+BOOST_AUTO_TEST_CASE(SizeLimitOnInsert)
+{
+    // 16 shards with (160 / 16 + 1) records each at most
+    const size_t        kHighMark = 160;
+    const size_t        kShardLimit = 16 * (kHighMark / 16 + 1);
+    CResolutionCache    cache(kHighMark, kHighMark / 2, 60, 60);
+    SBioseqResolution   resolution;
+
+    for (size_t  k = 0; k < 10000; ++k) {
+        string  seq_id = "NC_" + to_string(k);
+        cache.AddResolution(seq_id, 10, kDefaultSubst,
+                            s_MakeResolution(seq_id));
+        BOOST_REQUIRE(cache.Size() <= kShardLimit);
+
+        // The just inserted record is never the eviction victim
+        BOOST_REQUIRE_EQUAL(cache.GetResolution(seq_id, 10, kDefaultSubst,
+                                                resolution),
+                            CResolutionCache::ePSGS_Found);
+    }
+}
@@ -46,7 +46,9 @@ static const string   kTSEChunkProcessorName = "Cassandra-gettsechunk";
 
 
 CPSGS_TSEChunkProcessor::CPSGS_TSEChunkProcessor() :
-    m_TSEChunkRequest(nullptr)
+    m_TSEChunkRequest(nullptr),
+    m_InFlightRole(ePSGS_NotInFlight),
+    m_InFlightFetch(nullptr)
 {}
 
 
@@ -65,7 +67,9 @@ CPSGS_TSEChunkProcessor::CPSGS_TSEChunkProcessor(
                        bind(&CPSGS_TSEChunkProcessor::OnGetBlobError,
                             this, _1, _2, _3, _4, _5)),
     m_SatInfoChunkVerId2Info(sat_info_chunk_ver_id2info),
-    m_IdModVerId2Info(id_mod_ver_id2info)
+    m_IdModVerId2Info(id_mod_ver_id2info),
+    m_InFlightRole(ePSGS_NotInFlight),
+    m_InFlightFetch(nullptr)
 {
     // Convenience to avoid calling
     // m_Request->GetRequest<SPSGS_TSEChunkRequest>() everywhere
@@ -76,6 +80,10 @@ CPSGS_TSEChunkProcessor::CPSGS_TSEChunkProcessor(
 CPSGS_TSEChunkProcessor::~CPSGS_TSEChunkProcessor()
 {
     CleanupMyNCBICache();
+
+    // The processor may be destroyed abruptly (e.g. the connection is
+    // dropped) while it retrieves a chunk for the others or waits for it
+    x_LeaveInFlightChunk();
 }
 
 
@@ -431,6 +439,11 @@ void CPSGS_TSEChunkProcessor::x_ProcessIdModVerId2InfoFinalStage(void)
                                       vector<string>(), vector<string>(),
                                       psg_clock_t::now());
 
+            // The same chunk may be in retrieval already
+            if (x_JoinInFlightChunk(cass_connection, chunk_request,
+                                    chunk_blob_id, *blob_record.get()))
+                return;
+
             unique_ptr<CCassBlobFetch>  fetch_details;
             fetch_details.reset(new CCassBlobFetch(chunk_request, chunk_blob_id));
             CCassBlobTaskLoadBlob *         load_task =
@@ -676,6 +689,13 @@ void CPSGS_TSEChunkProcessor::x_ProcessSatInfoChunkVerId2InfoFinalStage(void)
                                       vector<string>(), vector<string>(),
                                       psg_clock_t::now());
 
+    if (tse_blob_prop_cache_lookup_result == ePSGS_CacheHit) {
+        // The same chunk may be in retrieval already
+        if (x_JoinInFlightChunk(cass_connection, chunk_request,
+                                m_SatInfoChunkVerBlobId, *blob_record.get()))
+            return;
+    }
+
     unique_ptr<CCassBlobFetch>  fetch_details;
     fetch_details.reset(new CCassBlobFetch(chunk_request, m_SatInfoChunkVerBlobId));
 
@@ -836,6 +856,7 @@ void CPSGS_TSEChunkProcessor::OnGetBlobError(CCassBlobFetch *  fetch_details,
         // If it is an error then regardless what stage it was, props or
         // chunks, there will be no more activity
         fetch_details->SetReadFinished();
+        x_FinishInFlightChunk(false);
     }
 
     if (IPSGS_Processor::m_Reply->IsOutputReady())
@@ -858,6 +879,7 @@ void CPSGS_TSEChunkProcessor::OnGetBlobChunk(CCassBlobFetch *  fetch_details,
         fetch_details->GetLoader()->Cancel();
         fetch_details->GetLoader()->ClearError();
         fetch_details->SetReadFinished();
+        x_FinishInFlightChunk(false);
         if (IPSGS_Processor::m_Reply->IsOutputReady())
             x_Peek(false);
 
@@ -888,6 +910,15 @@ void CPSGS_TSEChunkProcessor::OnGetBlobChunk(CCassBlobFetch *  fetch_details,
                 chunk_data, data_size, chunk_no,
                 m_TSEChunkRequest->m_Id2Chunk,
                 m_TSEChunkRequest->m_Id2Info);
+
+        if (m_InFlightRole == ePSGS_InFlightInitiator) {
+            auto *  in_flight = CPubseqGatewayApp::GetInstance()->GetInFlightTSEChunks();
+            if (!in_flight->AddBlobChunk(m_InFlightKey, chunk_no,
+                                         chunk_data, data_size)) {
+                // The waiters have been told to retrieve the chunk themselves
+                m_InFlightRole = ePSGS_NotInFlight;
+            }
+        }
     } else {
         if (IPSGS_Processor::m_Request->NeedTrace()) {
             IPSGS_Processor::m_Reply->SendTrace(
@@ -900,6 +931,7 @@ void CPSGS_TSEChunkProcessor::OnGetBlobChunk(CCassBlobFetch *  fetch_details,
                 fetch_details, kTSEChunkProcessorName);
         fetch_details->GetLoader()->ClearError();
         fetch_details->SetReadFinished();
+        x_FinishInFlightChunk(true);
 
         // Note: no need to set the blob completed in the exclude blob cache.
         // It will happen in Peek()
@@ -1110,6 +1142,13 @@ CPSGS_TSEChunkProcessor::x_RequestTSEChunk(
                       IPSGS_Processor::m_Request->NeedProcessorEvents(),
                       vector<string>(), vector<string>(),
                       psg_clock_t::now());
+    if (blob_prop_cache_lookup_result == ePSGS_CacheHit) {
+        // The same chunk may be in retrieval already
+        if (x_JoinInFlightChunk(cass_connection, chunk_request,
+                                chunk_blob_id, *blob_record.get()))
+            return;
+    }
+
     unique_ptr<CCassBlobFetch>  cass_blob_fetch;
     cass_blob_fetch.reset(new CCassBlobFetch(chunk_request, chunk_blob_id));
 
@@ -1368,6 +1407,7 @@ bool CPSGS_TSEChunkProcessor::x_Peek(unique_ptr<CCassFetch> &  fetch_details,
         UpdateOverallStatus(CRequestStatus::e500_InternalServerError);
         fetch_details->GetLoader()->ClearError();
         fetch_details->SetReadFinished();
+        x_FinishInFlightChunk(false);
         CPSGS_CassProcessorBase::SignalFinishProcessing();
     }
 
@@ -1410,3 +1450,242 @@ void CPSGS_TSEChunkProcessor::x_OnMyNCBIData(const string &  cookie,
     }
 }
 
+
+
+// The postponed callbacks hold a weak reference to the processor so that a
+// processor which has been destroyed in the meantime is not called
+void in_flight_chunk_canceled_cb(void *  user_data)
+{
+    weak_ptr<IPSGS_Processor> *     self =
+                            static_cast<weak_ptr<IPSGS_Processor> *>(user_data);
+    shared_ptr<IPSGS_Processor>     processor = self->lock();
+    delete self;
+
+    if (processor)
+        static_cast<CPSGS_TSEChunkProcessor *>(processor.get())->
+                                                x_OnInFlightChunkCanceled();
+}
+
+
+void CPSGS_TSEChunkProcessor::Cancel(void)
+{
+    EPSGS_InFlightRole  expected = ePSGS_InFlightWaiter;
+    if (m_InFlightRole.compare_exchange_strong(expected, ePSGS_NotInFlight)) {
+        // There is no cassandra loader for the chunk so the base class
+        // cannot wake up the processor. Do that in the processor's libuv loop
+        // because Cancel() may be called from another loop.
+        CPubseqGatewayApp::GetInstance()->GetInFlightTSEChunks()->
+                                ClearWaitingProcessor(m_InFlightKey, this);
+        PostponeInvoke(in_flight_chunk_canceled_cb,
+                       (void*)(new weak_ptr<IPSGS_Processor>(weak_from_this())));
+    }
+    CPSGS_CassProcessorBase::Cancel();
+}
+
+
+bool
+CPSGS_TSEChunkProcessor::x_JoinInFlightChunk(
+                        shared_ptr<CCassConnection>  cass_connection,
+                        const SPSGS_BlobBySatSatKeyRequest &  chunk_request,
+                        const SCass_BlobId &  chunk_blob_id,
+                        const CBlobRecord &  blob_record)
+{
+    auto *      in_flight = CPubseqGatewayApp::GetInstance()->GetInFlightTSEChunks();
+    if (in_flight == nullptr)
+        return false;   // Coalescing is switched off
+
+    // The last modified is a part of the key so that the different versions
+    // of the chunk blob are never mixed
+    m_InFlightKey = chunk_blob_id.ToString() + "." +
+                    to_string(blob_record.GetModified());
+
+    // The notifications are delivered asynchronously so they must not
+    // refer to the processor directly
+    weak_ptr<IPSGS_Processor>   self = weak_from_this();
+    if (self.expired())
+        return false;   // Not owned by the dispatcher; nothing to share with
+
+    auto    join_result = in_flight->Join(
+                m_InFlightKey, this,
+                [self](shared_ptr<SPSGS_InFlightChunkData>  data)
+                {
+                    auto    processor = self.lock();
+                    if (processor)
+                        static_cast<CPSGS_TSEChunkProcessor *>(processor.get())->
+                                                x_OnInFlightChunkData(data);
+                },
+                [self]()
+                {
+                    auto    processor = self.lock();
+                    if (processor)
+                        static_cast<CPSGS_TSEChunkProcessor *>(processor.get())->
+                                                x_OnInFlightChunkFailed();
+                });
+    if (join_result == CInFlightTSEChunks::ePSGS_Initiator) {
+        // The caller retrieves the chunk and shares it
+        m_InFlightRole = ePSGS_InFlightInitiator;
+        return false;
+    }
+
+    // Another processor retrieves the chunk. Here: the blob props are at
+    // hand so send them right away and wait for the chunk data.
+    m_InFlightRole = ePSGS_InFlightWaiter;
+    m_InFlightConnection = cass_connection;
+    m_InFlightBlobRecord = blob_record;
+
+    unique_ptr<CCassBlobFetch>  fetch_details;
+    fetch_details.reset(new CCassBlobFetch(chunk_request, chunk_blob_id));
+    m_InFlightFetch = fetch_details.get();
+    m_FetchDetails.push_back(move(fetch_details));
+
+    if (IPSGS_Processor::m_Request->NeedTrace()) {
+        IPSGS_Processor::m_Reply->SendTrace(
+                "Waiting for the TSE chunk blob " + chunk_blob_id.ToString() +
+                " which is being retrieved for another request",
+                IPSGS_Processor::m_Request->GetStartTimestamp());
+    }
+
+    OnGetBlobProp(m_InFlightFetch, m_InFlightBlobRecord, true);
+    return true;
+}
+
+
+void
+CPSGS_TSEChunkProcessor::x_OnInFlightChunkData(
+                                shared_ptr<SPSGS_InFlightChunkData>  data)
+{
+    // The cancel may have already taken over; it finishes the processing
+    EPSGS_InFlightRole          expected = ePSGS_InFlightWaiter;
+    if (!m_InFlightRole.compare_exchange_strong(expected, ePSGS_NotInFlight))
+        return;
+
+    CRequestContextResetter     context_resetter;
+    IPSGS_Processor::m_Request->SetRequestContext();
+
+    if (m_Canceled) {
+        m_InFlightFetch->SetReadFinished();
+        CPSGS_CassProcessorBase::SignalFinishProcessing();
+        return;
+    }
+
+    if (IPSGS_Processor::m_Request->NeedTrace()) {
+        IPSGS_Processor::m_Reply->SendTrace(
+                "Received " + to_string(data->m_BlobChunks.size()) +
+                " blob chunk(s) retrieved for another request",
+                IPSGS_Processor::m_Request->GetStartTimestamp());
+    }
+
+    int     chunk_no = 0;
+    for (const auto &  blob_chunk : data->m_BlobChunks) {
+        IPSGS_Processor::m_Reply->PrepareTSEBlobData(
+                m_InFlightFetch, kTSEChunkProcessorName,
+                blob_chunk.data(), blob_chunk.size(), chunk_no,
+                m_TSEChunkRequest->m_Id2Chunk,
+                m_TSEChunkRequest->m_Id2Info);
+        ++chunk_no;
+    }
+    IPSGS_Processor::m_Reply->PrepareTSEBlobCompletion(
+            m_InFlightFetch, kTSEChunkProcessorName);
+    m_InFlightFetch->SetReadFinished();
+
+    // There will be no more cassandra events for this processor
+    if (IPSGS_Processor::m_Reply->IsOutputReady())
+        x_Peek(false);
+    else
+        CPSGS_CassProcessorBase::SignalFinishProcessing();
+}
+
+
+void CPSGS_TSEChunkProcessor::x_OnInFlightChunkFailed(void)
+{
+    // The cancel may have already taken over; it finishes the processing
+    EPSGS_InFlightRole          expected = ePSGS_InFlightWaiter;
+    if (!m_InFlightRole.compare_exchange_strong(expected, ePSGS_NotInFlight))
+        return;
+
+    CRequestContextResetter     context_resetter;
+    IPSGS_Processor::m_Request->SetRequestContext();
+
+    if (m_Canceled) {
+        m_InFlightFetch->SetReadFinished();
+        CPSGS_CassProcessorBase::SignalFinishProcessing();
+        return;
+    }
+
+    // The other processor could not share the chunk. Retrieve it from
+    // cassandra; the blob props have already been sent.
+    auto *      app = CPubseqGatewayApp::GetInstance();
+    app->GetCounters().Increment(this,
+                                 CPSGSCounters::ePSGS_InFlightTSEChunkFallback);
+
+    unique_ptr<CBlobRecord>     blob_record(new CBlobRecord(m_InFlightBlobRecord));
+    SCass_BlobId                chunk_blob_id = m_InFlightFetch->GetBlobId();
+    CCassBlobTaskLoadBlob *     load_task =
+        new CCassBlobTaskLoadBlob(m_InFlightConnection,
+                                  chunk_blob_id.m_Keyspace->keyspace,
+                                  move(blob_record),
+                                  true, nullptr);
+    m_InFlightFetch->SetLoader(load_task);
+    load_task->SetDataReadyCB(IPSGS_Processor::m_Reply->GetDataReadyCB());
+    load_task->SetErrorCB(
+        CGetBlobErrorCallback(this,
+                              bind(&CPSGS_TSEChunkProcessor::OnGetBlobError,
+                                   this, _1, _2, _3, _4, _5),
+                              m_InFlightFetch,
+                              eTseChunkRetrieve));
+    load_task->SetChunkCallback(
+        CBlobChunkCallback(this,
+                           bind(&CPSGS_TSEChunkProcessor::OnGetBlobChunk,
+                                this, _1, _2, _3, _4, _5),
+                           m_InFlightFetch,
+                           eTseChunkRetrieve));
+
+    if (IPSGS_Processor::m_Request->NeedTrace()) {
+        IPSGS_Processor::m_Reply->SendTrace(
+                    "Cassandra request: " +
+                    ToJsonString(*load_task),
+                    IPSGS_Processor::m_Request->GetStartTimestamp());
+    }
+
+    load_task->Wait();  // Initiate cassandra request
+}
+
+
+void CPSGS_TSEChunkProcessor::x_OnInFlightChunkCanceled(void)
+{
+    if (m_InFlightFetch != nullptr && !m_InFlightFetch->GetLoader())
+        m_InFlightFetch->SetReadFinished();
+    CPSGS_CassProcessorBase::SignalFinishProcessing();
+}
+
+
+void CPSGS_TSEChunkProcessor::x_FinishInFlightChunk(bool  success)
+{
+    if (m_InFlightRole != ePSGS_InFlightInitiator)
+        return;
+
+    auto *      in_flight = CPubseqGatewayApp::GetInstance()->GetInFlightTSEChunks();
+    if (success)
+        in_flight->OnFinished(m_InFlightKey);
+    else
+        in_flight->OnFailed(m_InFlightKey);
+    m_InFlightRole = ePSGS_NotInFlight;
+}
+
+
+void CPSGS_TSEChunkProcessor::x_LeaveInFlightChunk(void)
+{
+    switch (m_InFlightRole.load()) {
+        case ePSGS_InFlightInitiator:
+            // The waiters will retrieve the chunk themselves
+            x_FinishInFlightChunk(false);
+            break;
+        case ePSGS_InFlightWaiter:
+            if (m_InFlightRole.exchange(ePSGS_NotInFlight) == ePSGS_InFlightWaiter)
+                CPubseqGatewayApp::GetInstance()->GetInFlightTSEChunks()->
+                                ClearWaitingProcessor(m_InFlightKey, this);
+            break;
+        default:
+            break;
+    }
+}
@@ -32,8 +32,11 @@
  *
  */
 
+#include <atomic>
+
 #include "cass_blob_base.hpp"
 #include "id2info.hpp"
+#include "in_flight_tse_chunks.hpp"
 
 USING_NCBI_SCOPE;
 USING_IDBLOB_SCOPE;
@@ -55,6 +58,7 @@ public:
     virtual string GetName(void) const;
     virtual string GetGroupName(void) const;
     virtual void ProcessEvent(void);
+    virtual void Cancel(void);
 
 public:
     CPSGS_TSEChunkProcessor();
@@ -125,6 +129,17 @@ private:
                         CPSG_MyNCBIRequest_WhoAmI::SUserInfo user_info);
     bool x_GetMyNCBIUser(void);
 
+private:
+    bool x_JoinInFlightChunk(shared_ptr<CCassConnection>  cass_connection,
+                             const SPSGS_BlobBySatSatKeyRequest &  chunk_request,
+                             const SCass_BlobId &  chunk_blob_id,
+                             const CBlobRecord &  blob_record);
+    void x_OnInFlightChunkData(shared_ptr<SPSGS_InFlightChunkData>  data);
+    void x_OnInFlightChunkFailed(void);
+    void x_OnInFlightChunkCanceled(void);
+    void x_FinishInFlightChunk(bool  success);
+    void x_LeaveInFlightChunk(void);
+
 private:
     SPSGS_TSEChunkRequest *                             m_TSEChunkRequest;
 
@@ -133,6 +148,25 @@ private:
     shared_ptr<CPSGS_IdModifiedVerFlavorId2Info>        m_IdModVerId2Info;
 
     SCass_BlobId                                        m_SatInfoChunkVerBlobId;
+
+    // Coalescing of the identical chunk retrievals
+    enum EPSGS_InFlightRole {
+        ePSGS_NotInFlight,
+        ePSGS_InFlightInitiator,
+        ePSGS_InFlightWaiter
+    };
+    // Cancel() may be called from another thread so the waiter role is
+    // switched off atomically by whoever comes first: the data/fail
+    // notification or the cancel
+    atomic<EPSGS_InFlightRole>                          m_InFlightRole;
+    string                                              m_InFlightKey;
+
+    // Populated for a waiter only
+    CCassBlobFetch *                                    m_InFlightFetch;
+    shared_ptr<CCassConnection>                         m_InFlightConnection;
+    CBlobRecord                                         m_InFlightBlobRecord;
+
+    friend void in_flight_chunk_canceled_cb(void *  user_data);
 };
 
 #endif  // PSGS_TSECHUNKPROCESSOR__HPP
@@ -508,11 +508,12 @@ void SNgHttp2_Session::Del()
     x_DelOnError(-1);
 }
 
-int32_t SNgHttp2_Session::Submit(const nghttp2_nv *nva, size_t nvlen, nghttp2_data_provider* data_prd)
+int32_t SNgHttp2_Session::Submit(const nghttp2_nv *nva, size_t nvlen, nghttp2_data_provider* data_prd,
+        const nghttp2_priority_spec* pri_spec)
 {
     if (auto rv = Init()) return rv;
 
-    auto rv = nghttp2_submit_request(m_Session, nullptr, nva, nvlen, data_prd, nullptr);
+    auto rv = nghttp2_submit_request(m_Session, pri_spec, nva, nvlen, data_prd, nullptr);
 
     if (rv < 0) {
         NCBI_NGHTTP2_SESSION_TRACE(this << " submit failed: " << SUvNgHttp2_Error::NgHttp2Str(rv));
@@ -212,6 +212,10 @@ void* CObjectMemoryPoolChunk::Allocate(size_t size)
 
 
 CObjectMemoryPool::CObjectMemoryPool(size_t chunk_size)
+    : m_AllocatedCount(0),
+      m_AllocatedSize(0),
+      m_ChunkCount(0),
+      m_MallocCount(0)
 {
     SetChunkSize(chunk_size);
 }
@@ -255,14 +259,18 @@ void CObjectMemoryPool::SetMallocThreshold(size_t malloc_threshold)
 void* CObjectMemoryPool::Allocate(size_t size)
 {
     if ( size > m_MallocThreshold ) {
+        ++m_MallocCount;
         return 0;
     }
     for ( int i = 0; i < 2; ++i ) {
         if ( !m_CurrentChunk ) {
             m_CurrentChunk = CObjectMemoryPoolChunk::CreateChunk(m_ChunkSize);
+            ++m_ChunkCount;
         }
         void* ptr = m_CurrentChunk->Allocate(size);
         if ( ptr ) {
+            ++m_AllocatedCount;
+            m_AllocatedSize += size;
             return ptr;
         }
         m_CurrentChunk.Reset();
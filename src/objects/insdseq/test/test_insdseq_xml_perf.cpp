@@ -0,0 +1,221 @@
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Authors:  agent
+*
+* File Description:
+*   Timing of XML INSDSet decoding, whole and by INSDSeq records,
+*   for the in-buffer scanning of tags, text and member names
+*
+* ===========================================================================
+*/
+#include <ncbi_pch.hpp>
+#include <corelib/ncbiapp.hpp>
+#include <corelib/ncbiargs.hpp>
+#include <corelib/ncbitime.hpp>
+#include <util/random_gen.hpp>
+#include <serial/objistr.hpp>
+#include <serial/objostrxml.hpp>
+#include <serial/streamiter.hpp>
+#include <serial/serial.hpp>
+
+#include <objects/insdseq/INSDSet.hpp>
+#include <objects/insdseq/INSDSeq.hpp>
+#include <objects/insdseq/INSDFeature.hpp>
+#include <objects/insdseq/INSDInterval.hpp>
+#include <objects/insdseq/INSDQualifier.hpp>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+
+BEGIN_NCBI_SCOPE
+using namespace objects;
+
+
+// long plain text runs with occasional entities and non-ASCII chars
+static CRef<CINSDSet> s_CreateSet(unsigned seq_count)
+{
+    const int kSeqLength = 5000;
+    const unsigned kFeatCount = 50;
+    CRandom r(1);
+    CRef<CINSDSet> insd_set(new CINSDSet);
+    for ( unsigned i = 0; i < seq_count; ++i ) {
+        string acc = "AB"+NStr::UIntToString(100000+i);
+        CRef<CINSDSeq> seq(new CINSDSeq);
+        seq->SetLocus(acc);
+        seq->SetLength(kSeqLength);
+        seq->SetMoltype("DNA");
+        seq->SetTopology("linear");
+        seq->SetDivision("BCT");
+        seq->SetUpdate_date("01-JAN-2020");
+        seq->SetCreate_date("01-JAN-2020");
+        seq->SetDefinition("Test sequence "+NStr::UIntToString(i+1)+
+                           " & <generated> data, caf\xC3\xA9 isolate");
+        seq->SetPrimary_accession(acc);
+        seq->SetAccession_version(acc+".1");
+        seq->SetOrganism("Escherichia coli");
+        seq->SetTaxonomy("Bacteria; Proteobacteria; Gammaproteobacteria; "
+                         "Enterobacterales; Enterobacteriaceae; Escherichia");
+        for ( unsigned j = 0; j < kFeatCount; ++j ) {
+            int len = r.GetRand(1, 1000);
+            int from = r.GetRand(1, kSeqLength-len+1);
+            int to = from+len-1;
+            CRef<CINSDFeature> feat(new CINSDFeature);
+            feat->SetKey(j % 2? "gene": "misc_feature");
+            feat->SetLocation(NStr::IntToString(from)+".."+
+                              NStr::IntToString(to));
+            CRef<CINSDInterval> interval(new CINSDInterval);
+            interval->SetFrom(from);
+            interval->SetTo(to);
+            interval->SetAccession(acc+".1");
+            feat->SetIntervals().push_back(interval);
+            CRef<CINSDQualifier> qual(new CINSDQualifier);
+            if ( j % 2 ) {
+                qual->SetName("gene");
+                qual->SetValue("gene"+NStr::UIntToString(j));
+            }
+            else {
+                qual->SetName("note");
+                qual->SetValue("feature "+NStr::UIntToString(j)+
+                               " of \"test\" sequence");
+            }
+            feat->SetQuals().push_back(qual);
+            seq->SetFeature_table().push_back(feat);
+        }
+        string& data = seq->SetSequence();
+        for ( int pos = 0; pos < kSeqLength; ++pos ) {
+            data += "acgt"[r.GetRand(0, 3)];
+        }
+        insd_set->Set().push_back(seq);
+    }
+    return insd_set;
+}
+
+
+template<class Func>
+static double s_BestTime(int runs, Func func)
+{
+    double best = 0;
+    for ( int i = 0; i < runs; ++i ) {
+        CStopWatch sw(CStopWatch::eStart);
+        func();
+        double time = sw.Elapsed();
+        if ( i == 0 || time < best ) {
+            best = time;
+        }
+    }
+    return best;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//  Test application
+//
+
+class CTestApp : public CNcbiApplication
+{
+public:
+    virtual void Init(void);
+    virtual int  Run(void);
+};
+
+
+void CTestApp::Init(void)
+{
+    unique_ptr<CArgDescriptions> arg_desc(new CArgDescriptions);
+    arg_desc->SetUsageContext(GetArguments().GetProgramBasename(),
+                              "XML INSDSet decoding timing");
+    arg_desc->AddDefaultKey("seqs", "SeqCount",
+                            "Number of generated sequences",
+                            CArgDescriptions::eInteger, "1000");
+    SetupArgDescriptions(arg_desc.release());
+}
+
+
+int CTestApp::Run(void)
+{
+    const int kRuns = 3;
+    CRef<CINSDSet> insd_set = s_CreateSet(GetArgs()["seqs"].AsInteger());
+    string data;
+    {
+        CNcbiOstrstream str;
+        {
+            CObjectOStreamXml out(str, eNoOwnership);
+            out << *insd_set;
+        }
+        data = CNcbiOstrstreamToString(str);
+    }
+
+    CINSDSet read_set;
+    double set_time = s_BestTime(kRuns, [&]() {
+            read_set.Reset();
+            unique_ptr<CObjectIStream> in
+                (CObjectIStream::CreateFromBuffer(eSerial_Xml,
+                                                  data.data(), data.size()));
+            *in >> read_set;
+        });
+    size_t seq_count = 0;
+    double stream_time = s_BestTime(kRuns, [&]() {
+            seq_count = 0;
+            unique_ptr<CObjectIStream> in
+                (CObjectIStream::CreateFromBuffer(eSerial_Xml,
+                                                  data.data(), data.size()));
+            CObjectIStreamIterator<CINSDSet, CINSDSeq> it(*in);
+            for ( CINSDSeq& seq : it ) {
+                seq_count += seq.IsSetSequence();
+            }
+        });
+
+    double mb = data.size()/(1024.*1024);
+    NcbiCout << setprecision(3) << fixed
+             << "XML size:      " << setw(8) << mb << " MB" << NcbiEndl
+             << "INSDSet read:  " << setw(8) << set_time << " s, "
+             << setw(8) << mb/set_time << " MB/s" << NcbiEndl
+             << "Stream read:   " << setw(8) << stream_time << " s, "
+             << setw(8) << mb/stream_time << " MB/s" << NcbiEndl;
+
+    if ( !read_set.Equals(*insd_set) ||
+         seq_count != insd_set->Get().size() ) {
+        ERR_POST("XML decoding gives different result");
+        return 1;
+    }
+    NcbiCout << "Passed" << NcbiEndl;
+    return 0;
+}
+
+
+END_NCBI_SCOPE
+
+
+/////////////////////////////////////////////////////////////////////////////
+//  MAIN
+
+USING_NCBI_SCOPE;
+
+int main(int argc, const char* argv[])
+{
+    return CTestApp().AppMain(argc, argv);
+}
@@ -0,0 +1,280 @@
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Authors:  agent
+*
+* File Description:
+*   Timing of Bioseq-set decoding: ASN.1 binary with generic and
+*   direct member codecs, into memory pool, and ASN.1 text
+*
+* ===========================================================================
+*/
+#include <ncbi_pch.hpp>
+#include <corelib/ncbiapp.hpp>
+#include <corelib/ncbiargs.hpp>
+#include <corelib/ncbitime.hpp>
+#include <corelib/ncbimempool.hpp>
+#include <serial/objistrasnb.hpp>
+#include <serial/objostrasnb.hpp>
+#include <serial/objistrasn.hpp>
+#include <serial/objostrasn.hpp>
+#include <serial/serial.hpp>
+
+#include <objects/seqloc/Seq_id.hpp>
+#include <objects/seqloc/Seq_loc.hpp>
+#include <objects/seqloc/Seq_interval.hpp>
+#include <objects/seq/Bioseq.hpp>
+#include <objects/seq/Seq_inst.hpp>
+#include <objects/seq/Seq_data.hpp>
+#include <objects/seq/IUPACna.hpp>
+#include <objects/seq/Seq_annot.hpp>
+#include <objects/seqset/Seq_entry.hpp>
+#include <objects/seqset/Bioseq_set.hpp>
+#include <objects/seqfeat/Seq_feat.hpp>
+#include <objects/seqfeat/SeqFeatData.hpp>
+#include <objects/seqfeat/Imp_feat.hpp>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+
+BEGIN_NCBI_SCOPE
+using namespace objects;
+
+
+// best time of several runs
+template<class Func>
+static double s_BestTime(int runs, Func func)
+{
+    double best = 0;
+    for ( int i = 0; i < runs; ++i ) {
+        CStopWatch sw(CStopWatch::eStart);
+        func();
+        double time = sw.Elapsed();
+        if ( i == 0 || time < best ) {
+            best = time;
+        }
+    }
+    return best;
+}
+
+
+static CRef<CBioseq_set> s_CreateSet(unsigned seq_count)
+{
+    const TSeqPos kSeqLength = 5000;
+    const unsigned kFeatCount = 50;
+    CRef<CBioseq_set> seqset(new CBioseq_set);
+    for ( unsigned i = 0; i < seq_count; ++i ) {
+        CRef<CSeq_id> id(new CSeq_id);
+        id->SetLocal().SetStr("seq"+NStr::UIntToString(i+1));
+        CRef<CSeq_entry> entry(new CSeq_entry);
+        CBioseq& seq = entry->SetSeq();
+        seq.SetId().push_back(id);
+        CSeq_inst& inst = seq.SetInst();
+        inst.SetRepr(CSeq_inst::eRepr_raw);
+        inst.SetMol(CSeq_inst::eMol_dna);
+        inst.SetLength(kSeqLength);
+        string& data = inst.SetSeq_data().SetIupacna().Set();
+        for ( TSeqPos pos = 0; pos < kSeqLength; ++pos ) {
+            data += "ACGT"[(pos*7+i)%4];
+        }
+        CRef<CSeq_annot> annot(new CSeq_annot);
+        for ( unsigned j = 0; j < kFeatCount; ++j ) {
+            CRef<CSeq_feat> feat(new CSeq_feat);
+            feat->SetData().SetImp().SetKey("misc_feature");
+            feat->SetComment("feature "+NStr::UIntToString(j));
+            CSeq_interval& interval = feat->SetLocation().SetInt();
+            interval.SetId(*id);
+            interval.SetFrom(j*50);
+            interval.SetTo(j*50+99);
+            annot->SetData().SetFtable().push_back(feat);
+        }
+        seq.SetAnnot().push_back(annot);
+        seqset->SetSeq_set().push_back(entry);
+    }
+    return seqset;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//  Test application
+//
+
+class CTestApp : public CNcbiApplication
+{
+public:
+    virtual void Init(void);
+    virtual int  Run(void);
+
+private:
+    void x_Report(const char* name, double time, size_t size);
+    void x_Check(const char* name, bool ok);
+
+    int m_Errors;
+};
+
+
+void CTestApp::Init(void)
+{
+    unique_ptr<CArgDescriptions> arg_desc(new CArgDescriptions);
+    arg_desc->SetUsageContext(GetArguments().GetProgramBasename(),
+                              "Bioseq-set decoding timing");
+    arg_desc->AddOptionalKey("file", "File",
+                             "ASN.1 binary Bioseq-set to decode "
+                             "instead of generated one",
+                             CArgDescriptions::eInputFile,
+                             CArgDescriptions::fBinary);
+    arg_desc->AddDefaultKey("seqs", "SeqCount",
+                            "Number of generated sequences",
+                            CArgDescriptions::eInteger, "1000");
+    SetupArgDescriptions(arg_desc.release());
+}
+
+
+void CTestApp::x_Report(const char* name, double time, size_t size)
+{
+    NcbiCout << setw(14) << left << name << right
+             << setprecision(3) << fixed
+             << setw(8) << time << " s, "
+             << setw(8) << size/(1024.*1024)/time << " MB/s" << NcbiEndl;
+}
+
+
+void CTestApp::x_Check(const char* name, bool ok)
+{
+    if ( !ok ) {
+        ERR_POST(name << " gives different result");
+        ++m_Errors;
+    }
+}
+
+
+int CTestApp::Run(void)
+{
+    const CArgs& args = GetArgs();
+    const int kRuns = 3;
+    m_Errors = 0;
+
+    string binary;
+    if ( args["file"] ) {
+        NcbiStreamToString(&binary,
+                           args["file"].AsInputFile(CArgValue::fBinary));
+    }
+    else {
+        CRef<CBioseq_set> seqset = s_CreateSet(args["seqs"].AsInteger());
+        CNcbiOstrstream str;
+        {
+            CObjectOStreamAsnBinary out(str);
+            out << *seqset;
+        }
+        binary = CNcbiOstrstreamToString(str);
+    }
+
+    // ASN.1 binary, generic and direct member codecs
+    CBioseq_set generic_set, direct_set;
+    x_Report("Generic read", s_BestTime(kRuns, [&]() {
+                CObjectIStreamAsnBinary in(binary.data(), binary.size());
+                in.SetUseDirectCodecs(false);
+                generic_set.Reset();
+                in >> generic_set;
+            }), binary.size());
+    x_Report("Direct read", s_BestTime(kRuns, [&]() {
+                CObjectIStreamAsnBinary in(binary.data(), binary.size());
+                in.SetUseDirectCodecs(true);
+                direct_set.Reset();
+                in >> direct_set;
+            }), binary.size());
+    x_Check("Direct decoding", direct_set.Equals(generic_set));
+
+    string generic_data, direct_data;
+    for ( int direct = 0; direct < 2; ++direct ) {
+        string& data = direct? direct_data: generic_data;
+        x_Report(direct? "Direct write": "Generic write",
+                 s_BestTime(kRuns, [&]() {
+                         CNcbiOstrstream str;
+                         {
+                             CObjectOStreamAsnBinary out(str);
+                             out.SetUseDirectCodecs(direct != 0);
+                             out << generic_set;
+                         }
+                         data = CNcbiOstrstreamToString(str);
+                     }), binary.size());
+    }
+    x_Check("Direct encoding", direct_data == generic_data);
+
+    // decoding into memory pool, pool is released with the objects
+    CRef<CBioseq_set> pool_set;
+    CRef<CObjectMemoryPool> pool;
+    x_Report("Pool read", s_BestTime(kRuns, [&]() {
+                pool_set.Reset();
+                pool.Reset(new CObjectMemoryPool);
+                CObjectIStreamAsnBinary in(binary.data(), binary.size());
+                in.SetMemoryPool(pool);
+                pool_set.Reset(new CBioseq_set);
+                in >> *pool_set;
+            }), binary.size());
+    x_Check("Memory pool decoding", pool_set->Equals(generic_set));
+    NcbiCout << "Pool objects:  " << pool->GetAllocatedCount()
+             << " in " << pool->GetChunkCount() << " chunks, "
+             << pool->GetMallocCount() << " left in heap" << NcbiEndl;
+
+    // ASN.1 text
+    string text;
+    {
+        CNcbiOstrstream str;
+        {
+            CObjectOStreamAsn out(str);
+            out << generic_set;
+        }
+        text = CNcbiOstrstreamToString(str);
+    }
+    CBioseq_set text_set;
+    x_Report("Text read", s_BestTime(kRuns, [&]() {
+                CObjectIStreamAsn in(text.data(), text.size());
+                text_set.Reset();
+                in >> text_set;
+            }), text.size());
+    x_Check("Text decoding", text_set.Equals(generic_set));
+
+    if ( m_Errors ) {
+        return 1;
+    }
+    NcbiCout << "Passed" << NcbiEndl;
+    return 0;
+}
+
+
+END_NCBI_SCOPE
+
+
+/////////////////////////////////////////////////////////////////////////////
+//  MAIN
+
+USING_NCBI_SCOPE;
+
+int main(int argc, const char* argv[])
+{
+    return CTestApp().AppMain(argc, argv);
+}
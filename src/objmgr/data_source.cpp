@@ -101,6 +101,40 @@ unsigned CDataSource::GetDefaultBlobCacheSizeLimit(void)
 }
 
 
+// memory limit of blob cache in megabytes, 0 - unlimited
+NCBI_PARAM_DECL(unsigned, OBJMGR, BLOB_CACHE_MEMORY);
+NCBI_PARAM_DEF_EX(unsigned, OBJMGR, BLOB_CACHE_MEMORY, 0,
+                  eParam_NoThread, OBJMGR_BLOB_CACHE_MEMORY);
+
+size_t CDataSource::GetDefaultBlobCacheMemoryLimit(void)
+{
+    static CSafeStatic<NCBI_PARAM_TYPE(OBJMGR, BLOB_CACHE_MEMORY)> sx_Value;
+    return size_t(sx_Value->Get())<<20;
+}
+
+
+NCBI_PARAM_DECL(bool, OBJMGR, UNLOAD_CHUNKS);
+NCBI_PARAM_DEF_EX(bool, OBJMGR, UNLOAD_CHUNKS, false,
+                  eParam_NoThread, OBJMGR_UNLOAD_CHUNKS);
+
+static bool s_GetUnloadChunks(void)
+{
+    static bool value = NCBI_PARAM_TYPE(OBJMGR, UNLOAD_CHUNKS)::GetDefault();
+    return value;
+}
+
+
+// memory estimation of a blob if its loader doesn't report it
+static const size_t kDefaultTSEMemory = 64*1024;
+
+static inline
+size_t sx_GetTSEMemory(const CTSE_Info& tse)
+{
+    size_t memory = tse.GetUsedMemory();
+    return memory? memory: kDefaultTSEMemory;
+}
+
+
 NCBI_PARAM_DECL(bool, OBJMGR, BULK_CHUNKS);
 NCBI_PARAM_DEF_EX(bool, OBJMGR, BULK_CHUNKS, true,
                   eParam_NoThread, OBJMGR_BULK_CHUNKS);
@@ -116,6 +150,11 @@ CDataSource::CDataSource(void)
     : m_DefaultPriority(CObjectManager::kPriority_Entry),
       m_Blob_Cache_Size(0),
       m_Blob_Cache_Size_Limit(GetDefaultBlobCacheSizeLimit()),
+      m_Blob_Cache_Memory(0),
+      m_Blob_Cache_Memory_Limit(GetDefaultBlobCacheMemoryLimit()),
+      m_UnloadChunks(s_GetUnloadChunks()),
+      m_UnloadedChunksCount(0),
+      m_UnloadedChunksMemory(0),
       m_StaticBlobCounter(0),
       m_TrackSplitSeq(false)
 {
@@ -128,6 +167,11 @@ CDataSource::CDataSource(CDataLoader& loader)
       m_Blob_Cache_Size(0),
       m_Blob_Cache_Size_Limit(min(GetDefaultBlobCacheSizeLimit(),
                                   loader.GetDefaultBlobCacheSizeLimit())),
+      m_Blob_Cache_Memory(0),
+      m_Blob_Cache_Memory_Limit(GetDefaultBlobCacheMemoryLimit()),
+      m_UnloadChunks(s_GetUnloadChunks()),
+      m_UnloadedChunksCount(0),
+      m_UnloadedChunksMemory(0),
       m_StaticBlobCounter(0),
       m_TrackSplitSeq(loader.GetTrackSplitSeq())
 {
@@ -140,6 +184,11 @@ CDataSource::CDataSource(const CObject& shared_object, const CSeq_entry& entry)
       m_DefaultPriority(CObjectManager::kPriority_Entry),
       m_Blob_Cache_Size(0),
       m_Blob_Cache_Size_Limit(GetDefaultBlobCacheSizeLimit()),
+      m_Blob_Cache_Memory(0),
+      m_Blob_Cache_Memory_Limit(GetDefaultBlobCacheMemoryLimit()),
+      m_UnloadChunks(s_GetUnloadChunks()),
+      m_UnloadedChunksCount(0),
+      m_UnloadedChunksMemory(0),
       m_StaticBlobCounter(0),
       m_TrackSplitSeq(false)
 {
@@ -208,6 +257,7 @@ void CDataSource::DropAllTSEs(void)
         m_Blob_Map.clear();
         m_Blob_Cache.clear();
         m_Blob_Cache_Size = 0;
+        m_Blob_Cache_Memory = 0;
         m_StaticBlobCounter = 0;
     }}
 }
@@ -2354,26 +2404,137 @@ void CDataSource::x_ReleaseLastTSELock(CRef<CTSE_Info> tse)
             tse->m_CachePosition = m_Blob_Cache.insert(m_Blob_Cache.end(),tse);
             m_Blob_Cache_Size += 1;
             _ASSERT(m_Blob_Cache_Size == m_Blob_Cache.size());
+            tse->m_CacheMemory = sx_GetTSEMemory(*tse);
+            m_Blob_Cache_Memory += tse->m_CacheMemory;
             tse->m_CacheState = CTSE_Info::eInCache;
         }
         _ASSERT(tse->m_CachePosition ==
                 find(m_Blob_Cache.begin(), m_Blob_Cache.end(), tse));
         _ASSERT(m_Blob_Cache_Size == m_Blob_Cache.size());
         
-        unsigned cache_size = m_Blob_Cache_Size_Limit;
-        while ( m_Blob_Cache_Size > cache_size ) {
-            CRef<CTSE_Info> del_tse = m_Blob_Cache.front();
-            m_Blob_Cache.pop_front();
-            m_Blob_Cache_Size -= 1;
-            _ASSERT(m_Blob_Cache_Size == m_Blob_Cache.size());
-            del_tse->m_CacheState = CTSE_Info::eNotInCache;
-            to_delete.push_back(del_tse);
-            _VERIFY(DropTSE(*del_tse));
-        }
+        x_ShrinkBlobCache(to_delete);
     }}
 }
 
 
+void CDataSource::x_UnloadCachedChunks(void)
+{
+    // unload chunks of least recently used blobs first
+    NON_CONST_ITERATE ( TBlob_Cache, it, m_Blob_Cache ) {
+        if ( m_Blob_Cache_Memory <= m_Blob_Cache_Memory_Limit ) {
+            break;
+        }
+        CTSE_Info& tse = **it;
+        _ASSERT(!tse.IsLocked());
+        if ( !tse.HasSplitInfo() ) {
+            continue;
+        }
+        size_t freed =
+            tse.GetSplitInfo().x_UnloadChunks(m_UnloadedChunksCount);
+        m_UnloadedChunksMemory += freed;
+        size_t memory = sx_GetTSEMemory(tse);
+        if ( memory < tse.m_CacheMemory ) {
+            m_Blob_Cache_Memory -= tse.m_CacheMemory - memory;
+            tse.m_CacheMemory = memory;
+        }
+    }
+}
+
+
+void CDataSource::x_ShrinkBlobCache(vector<TTSE_Ref>& to_delete)
+{
+    if ( m_UnloadChunks && m_Blob_Cache_Memory_Limit &&
+         m_Blob_Cache_Memory > m_Blob_Cache_Memory_Limit ) {
+        x_UnloadCachedChunks();
+    }
+    // drop least recently used blobs until both limits are satisfied
+    while ( m_Blob_Cache_Size > m_Blob_Cache_Size_Limit ||
+            (m_Blob_Cache_Memory_Limit &&
+             m_Blob_Cache_Memory > m_Blob_Cache_Memory_Limit) ) {
+        CRef<CTSE_Info> del_tse = m_Blob_Cache.front();
+        m_Blob_Cache.pop_front();
+        m_Blob_Cache_Size -= 1;
+        _ASSERT(m_Blob_Cache_Size == m_Blob_Cache.size());
+        m_Blob_Cache_Memory -= del_tse->m_CacheMemory;
+        del_tse->m_CacheMemory = 0;
+        del_tse->m_CacheState = CTSE_Info::eNotInCache;
+        to_delete.push_back(del_tse);
+        _VERIFY(DropTSE(*del_tse));
+    }
+}
+
+
+unsigned CDataSource::GetBlobCacheSize(void) const
+{
+    TCacheLock::TReadLockGuard guard(m_DSCacheLock);
+    return m_Blob_Cache_Size;
+}
+
+
+size_t CDataSource::GetBlobCacheMemory(void) const
+{
+    TCacheLock::TReadLockGuard guard(m_DSCacheLock);
+    return m_Blob_Cache_Memory;
+}
+
+
+unsigned CDataSource::GetBlobCacheSizeLimit(void) const
+{
+    return m_Blob_Cache_Size_Limit;
+}
+
+
+size_t CDataSource::GetBlobCacheMemoryLimit(void) const
+{
+    return m_Blob_Cache_Memory_Limit;
+}
+
+
+void CDataSource::SetBlobCacheSizeLimit(unsigned limit)
+{
+    vector<TTSE_Ref> to_delete;
+    TCacheLock::TWriteLockGuard guard(m_DSCacheLock);
+    m_Blob_Cache_Size_Limit = limit;
+    x_ShrinkBlobCache(to_delete);
+}
+
+
+void CDataSource::SetBlobCacheMemoryLimit(size_t limit)
+{
+    vector<TTSE_Ref> to_delete;
+    TCacheLock::TWriteLockGuard guard(m_DSCacheLock);
+    m_Blob_Cache_Memory_Limit = limit;
+    x_ShrinkBlobCache(to_delete);
+}
+
+
+bool CDataSource::GetUnloadChunks(void) const
+{
+    return m_UnloadChunks;
+}
+
+
+void CDataSource::SetUnloadChunks(bool unload)
+{
+    TCacheLock::TWriteLockGuard guard(m_DSCacheLock);
+    m_UnloadChunks = unload;
+}
+
+
+size_t CDataSource::GetUnloadedChunksCount(void) const
+{
+    TCacheLock::TReadLockGuard guard(m_DSCacheLock);
+    return m_UnloadedChunksCount;
+}
+
+
+size_t CDataSource::GetUnloadedChunksMemory(void) const
+{
+    TCacheLock::TReadLockGuard guard(m_DSCacheLock);
+    return m_UnloadedChunksMemory;
+}
+
+
 void CDataSource::x_SetLock(CTSE_Lock& lock, CConstRef<CTSE_Info> tse) const
 {
     _ASSERT(!lock);
@@ -2391,6 +2552,8 @@ void CDataSource::x_SetLock(CTSE_Lock& lock, CConstRef<CTSE_Info> tse) const
         tse->m_CacheState = CTSE_Info::eNotInCache;
         m_Blob_Cache.erase(tse->m_CachePosition);
         m_Blob_Cache_Size -= 1;
+        m_Blob_Cache_Memory -= tse->m_CacheMemory;
+        tse->m_CacheMemory = 0;
         _ASSERT(m_Blob_Cache_Size == m_Blob_Cache.size());
     }
     
@@ -35,6 +35,7 @@
 #include <objmgr/scope.hpp>
 #include <objmgr/impl/scope_impl.hpp>
 #include <objmgr/objmgr_exception.hpp>
+#include <objmgr/seq_vector.hpp>
 
 
 BEGIN_NCBI_SCOPE
@@ -379,5 +380,171 @@ CIRef<IPrefetchAction> CPrefetchFeat_CIActionSource::GetNextAction(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// CPrefetchPlannerAction
+
+// rough memory estimations of loaded objects
+static const size_t kBioseqSizeEstimate = 1024;
+static const size_t kFeatureSizeEstimate = 256;
+
+
+CPrefetchPlannerAction::CPrefetchPlannerAction(const CScopeSource& scope,
+                                               const CSeq_id_Handle& seq_id,
+                                               TFlags flags,
+                                               const SAnnotSelector* selector)
+    : CPrefetchBioseq(scope, seq_id),
+      m_Flags(flags),
+      m_EstimatedSize(0)
+{
+    if ( selector ) {
+        m_Selector = *selector;
+    }
+}
+
+
+bool CPrefetchPlannerAction::Execute(CRef<CPrefetchRequest> token)
+{
+    if ( !CPrefetchBioseq::Execute(token) ) {
+        return false;
+    }
+    m_EstimatedSize = kBioseqSizeEstimate;
+    if ( m_Flags & fSeqData ) {
+        CSeqVector sv(GetBioseqHandle(), CBioseq_Handle::eCoding_Iupac);
+        // load all the data chunks at once
+        if ( !sv.CanGetRange(0, sv.size()) ) {
+            return false;
+        }
+        m_EstimatedSize += sv.size();
+    }
+    if ( m_Flags & fFeatures ) {
+        m_Feat_CI = CFeat_CI(GetBioseqHandle(), m_Selector);
+        m_EstimatedSize += m_Feat_CI.GetSize()*kFeatureSizeEstimate;
+    }
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// CPrefetchPlanner
+
+CPrefetchPlanner::CPrefetchPlanner(CPrefetchManager& manager,
+                                   const CScopeSource& scope,
+                                   ISeq_idSource* ids,
+                                   TFlags flags,
+                                   const SAnnotSelector* selector,
+                                   size_t max_active,
+                                   size_t memory_budget)
+    : m_Manager(&manager),
+      m_Scope(scope),
+      m_Ids(ids),
+      m_Flags(flags),
+      m_MaxActive(max(max_active, size_t(1))),
+      m_MemoryBudget(memory_budget)
+{
+    if ( selector ) {
+        m_Selector.reset(new SAnnotSelector(*selector));
+    }
+    CMutexGuard guard(m_Mutex);
+    x_EnqueueActions();
+}
+
+
+CPrefetchPlanner::~CPrefetchPlanner(void)
+{
+    Cancel();
+}
+
+
+bool CPrefetchPlanner::x_CanEnqueue(void) const
+{
+    if ( !m_Ids || m_ActiveTokens.size() >= m_MaxActive ) {
+        return false;
+    }
+    if ( m_ActiveTokens.empty() || !m_MemoryBudget ) {
+        return true;
+    }
+    size_t size = 0;
+    ITERATE ( list< CRef<CPrefetchRequest> >, it, m_ActiveTokens ) {
+        if ( (*it)->GetState() == SPrefetchTypes::eCompleted ) {
+            const CPrefetchPlannerAction* action =
+                dynamic_cast<const CPrefetchPlannerAction*>((*it)->GetAction());
+            size += action->GetEstimatedSize();
+        }
+    }
+    return size < m_MemoryBudget;
+}
+
+
+void CPrefetchPlanner::x_EnqueueActions(void)
+{
+    while ( x_CanEnqueue() ) {
+        CSeq_id_Handle id = m_Ids->GetNextSeq_id();
+        if ( !id ) {
+            m_Ids.Reset();
+            break;
+        }
+        CIRef<IPrefetchAction> action
+            (new CPrefetchPlannerAction(m_Scope, id, m_Flags,
+                                        m_Selector.get()));
+        m_ActiveTokens.push_back(m_Manager->AddAction(action));
+        ++m_Stats.m_Submitted;
+    }
+}
+
+
+CRef<CPrefetchRequest> CPrefetchPlanner::GetNextToken(void)
+{
+    CRef<CPrefetchRequest> ret;
+    {{
+        CMutexGuard guard(m_Mutex);
+        x_EnqueueActions();
+        if ( m_ActiveTokens.empty() ) {
+            return ret;
+        }
+        ret = m_ActiveTokens.front();
+        m_ActiveTokens.pop_front();
+        if ( ret->IsDone() ) {
+            ++m_Stats.m_Hits;
+        }
+        else {
+            ++m_Stats.m_Late;
+        }
+        // the consumed slot can be used for the next id
+        x_EnqueueActions();
+    }}
+    try {
+        CStdPrefetch::Wait(ret);
+    }
+    catch ( CException& /*ignored*/ ) {
+        // the failure is visible in the request state
+        CMutexGuard guard(m_Mutex);
+        ++m_Stats.m_Failed;
+    }
+    return ret;
+}
+
+
+void CPrefetchPlanner::Cancel(void)
+{
+    CMutexGuard guard(m_Mutex);
+    ITERATE ( list< CRef<CPrefetchRequest> >, it, m_ActiveTokens ) {
+        // completed results are just dropped
+        if ( !(*it)->IsDone() ) {
+            it->GetNCPointer()->RequestToCancel();
+            ++m_Stats.m_Canceled;
+        }
+    }
+    m_ActiveTokens.clear();
+    m_Ids.Reset();
+}
+
+
+CPrefetchPlanner::SStats CPrefetchPlanner::GetStats(void) const
+{
+    CMutexGuard guard(m_Mutex);
+    return m_Stats;
+}
+
+
 END_SCOPE(objects)
 END_NCBI_SCOPE
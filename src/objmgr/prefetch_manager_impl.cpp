@@ -222,7 +222,7 @@ CPrefetchRequest::EStatus CPrefetchRequest::Execute(void)
 CPrefetchManager_Impl::CPrefetchManager_Impl(unsigned max_threads,
                                              CThread::TRunMode threads_mode)
     : m_StateMutex(new CObjectFor<CMutex>()),
-      m_ThreadPool(kMax_Int, max_threads, 2, threads_mode)
+      m_ThreadPool(kMax_Int, max_threads, min(max_threads, 2u), threads_mode)
 {
 }
 
@@ -660,6 +660,18 @@ void CScope::UpdateAnnotIndex(void)
 }
 
 
+void CScope::Freeze(void)
+{
+    m_Impl->Freeze();
+}
+
+
+bool CScope::IsFrozen(void) const
+{
+    return m_Impl->IsFrozen();
+}
+
+
 /// Bulk retrieval methods
 CScope::TBulkIds CScope::GetBulkIds(const TSeq_id_Handles& idhs,
                                     TGetFlags flags)
@@ -908,5 +920,22 @@ CScope::TSequenceHashes CScope::GetSequenceHashes(const TSeq_id_Handles& ids,
 }
 
 
+size_t CScope::GetSequencesData(TSeqDataOffsets* offsets,
+                                char* buffer,
+                                size_t buffer_size,
+                                const TSeq_id_Handles& ids,
+                                const TSeqRanges* ranges,
+                                CBioseq_Handle::EVectorCoding coding,
+                                TGetFlags flags)
+{
+    if ( !offsets ) {
+        NCBI_THROW(CCoreException, eNullPtr,
+                   "CScope::GetSequencesData: null offsets pointer");
+    }
+    return m_Impl->GetSequencesData(*offsets, buffer, buffer_size,
+                                    ids, ranges, coding, flags);
+}
+
+
 END_SCOPE(objects)
 END_NCBI_SCOPE
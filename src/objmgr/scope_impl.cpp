@@ -47,9 +47,12 @@
 #include <objmgr/objmgr_exception.hpp>
 #include <objmgr/prefetch_manager.hpp>
 #include <objmgr/seq_vector.hpp>
+#include <objmgr/seq_vector_ci.hpp>
+#include <objmgr/seq_map.hpp>
 
 #include <objmgr/impl/data_source.hpp>
 #include <objmgr/impl/tse_info.hpp>
+#include <objmgr/impl/tse_chunk_info.hpp>
 #include <objmgr/impl/scope_info.hpp>
 #include <objmgr/impl/bioseq_info.hpp>
 #include <objmgr/impl/bioseq_set_info.hpp>
@@ -92,6 +95,35 @@ NCBI_PARAM_DEF(bool, OBJMGR, KEEP_EXTERNAL_FOR_EDIT, false);
 
 //#define EXCLUDE_EDITED_BIOSEQ_ANNOT_SET
 
+/////////////////////////////////////////////////////////////////////////////
+//
+//  CScopeConfLock
+//
+/////////////////////////////////////////////////////////////////////////////
+
+
+void CScopeConfLock::Freeze(void)
+{
+    // wait for current readers and writers to finish
+    m_Lock.WriteLock();
+    m_Frozen.store(true, memory_order_release);
+    m_Lock.Unlock();
+}
+
+
+CScopeConfLock::CWriteGuard::CWriteGuard(CScopeConfLock& lock)
+    : m_Lock(0)
+{
+    lock.m_Lock.WriteLock();
+    m_Lock = &lock;
+    if ( lock.IsFrozen() ) {
+        Release();
+        NCBI_THROW(CObjMgrException, eModifyDataError,
+                   "CScope is frozen and cannot be modified");
+    }
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //
 //  CScope_Impl
@@ -114,6 +146,7 @@ CScope_Impl::CScope_Impl(CObjectManager& objmgr)
 
 CScope_Impl::~CScope_Impl(void)
 {
+    m_ConfLock.x_Unfreeze();
     TConfWriteLockGuard guard(m_ConfLock);
     x_DetachFromOM();
 }
@@ -176,6 +209,12 @@ void CScope_Impl::SetKeepExternalAnnotsForEdit(bool keep)
 }
 
 
+void CScope_Impl::Freeze(void)
+{
+    m_ConfLock.Freeze();
+}
+
+
 void CScope_Impl::AddDefaults(TPriority priority)
 {
     CObjectManager::TDataSourcesLock ds_set;
@@ -1291,7 +1330,11 @@ CSeq_feat_Handle CScope_Impl::GetSeq_featHandle(const CSeq_feat& feat,
                    "Seq-feat location is empty");
     }
     
-    TConfWriteLockGuard guard(m_ConfLock);
+    // the data sources cannot change in a frozen scope
+    unique_ptr<TConfWriteLockGuard> guard;
+    if ( !m_ConfLock.IsFrozen() ) {
+        guard.reset(new TConfWriteLockGuard(m_ConfLock));
+    }
     for (CPriority_I it(m_setDataSrc); it; ++it) {
         CDataSource_ScopeInfo::TSeq_feat_Lock lock =
             it->FindSeq_feat_Lock(loc_id, loc_pos, feat);
@@ -1706,6 +1749,14 @@ void CScope_Impl::RemoveTopLevelAnnot(const CSeq_annot_Handle& annot)
 CScope_Impl::TSeq_idMapValue&
 CScope_Impl::x_GetSeq_id_Info(const CSeq_id_Handle& id)
 {
+    {{
+        // most lookups find an existing entry, so they can run in parallel
+        TSeq_idMapLock::TReadLockGuard guard(m_Seq_idMapLock);
+        TSeq_idMap::iterator it = m_Seq_idMap.find(id);
+        if ( it != m_Seq_idMap.end() ) {
+            return *it;
+        }
+    }}
     TSeq_idMapLock::TWriteLockGuard guard(m_Seq_idMapLock);
     TSeq_idMap::iterator it = m_Seq_idMap.lower_bound(id);
     if ( it == m_Seq_idMap.end() || it->first != id ) {
@@ -3945,5 +3996,93 @@ void CScope_Impl::GetSequenceHashes(TSequenceStates& ret,
 }
 
 
+size_t CScope_Impl::GetSequencesData(TSeqDataOffsets& offsets,
+                                     char* buffer, size_t buffer_size,
+                                     const TIds& ids,
+                                     const TSeqRanges* ranges,
+                                     CBioseq_Handle::EVectorCoding coding,
+                                     TGetFlags flags)
+{
+    size_t count = ids.size();
+    if ( ranges && ranges->size() != count ) {
+        NCBI_THROW(CObjMgrException, eOtherError,
+                   "CScope::GetSequencesData(): "
+                   "number of ranges doesn't match number of ids");
+    }
+    // resolve all sequences with bulk requests
+    TBioseqHandles bhs = GetBioseqHandles(ids);
+    if ( (flags & CScope::fThrowOnMissingSequence) ) {
+        for ( size_t i = 0; i < count; ++i ) {
+            if ( !bhs[i] ) {
+                NCBI_THROW_FMT(CObjMgrException, eFindFailed,
+                               "CScope::GetSequencesData("<<ids[i]<<"): "
+                               "sequence not found");
+            }
+        }
+    }
+
+    // load sequence data chunks of all sequences with batch requests
+    CSeqMap::TChunksToLoad chunks;
+    for ( size_t i = 0; i < count; ++i ) {
+        if ( !bhs[i] ) {
+            continue;
+        }
+        TSeqPos from = 0, length = kInvalidSeqPos;
+        if ( ranges ) {
+            const TSeqRange& range = (*ranges)[i];
+            if ( range.Empty() ) {
+                continue;
+            }
+            from = range.GetFrom();
+            if ( !range.IsWholeTo() ) {
+                length = range.GetLength();
+            }
+        }
+        bhs[i].GetSeqMap().GetChunksToLoad(chunks, &GetScope(),
+                                           from, length);
+    }
+    CSeqMap::LoadChunks(chunks);
+
+    offsets.assign(count+1, 0);
+    size_t pos = 0;
+    for ( size_t i = 0; i < count; ++i ) {
+        offsets[i] = pos;
+        if ( !bhs[i] ) {
+            continue;
+        }
+        CSeqVector vec(bhs[i], coding);
+        TSeqPos from = 0, to = vec.size();
+        if ( ranges ) {
+            const TSeqRange& range = (*ranges)[i];
+            if ( range.Empty() ) {
+                continue;
+            }
+            from = range.GetFrom();
+            to = min(to, range.GetToOpen());
+        }
+        if ( from >= to ) {
+            continue;
+        }
+        if ( buffer_size - pos < to - from ) {
+            NCBI_THROW_FMT(CObjMgrException, eOtherError,
+                           "CScope::GetSequencesData("<<ids[i]<<"): "
+                           "buffer is too small");
+        }
+        try {
+            CSeqVector_CI it(vec, from);
+            pos += it.GetSeqData(buffer + pos, to - from);
+        }
+        catch ( CException& /*ignored*/ ) {
+            if ( (flags & CScope::fThrowOnMissingData) ) {
+                throw;
+            }
+            pos = offsets[i];
+        }
+    }
+    offsets[count] = pos;
+    return pos;
+}
+
+
 END_SCOPE(objects)
 END_NCBI_SCOPE
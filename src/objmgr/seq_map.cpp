@@ -774,6 +774,40 @@ void CSeqMap::LoadSeq_data(TSeqPos pos, TSeqPos len,
 }
 
 
+bool CSeqMap::UnloadSeq_data(CTSE_Chunk_Info& chunk,
+                             TSeqPos pos, TSeqPos length)
+{
+    if ( length == kInvalidSeqPos ) {
+        _ASSERT(pos == 0);
+        _ASSERT(m_SeqLength != kInvalidSeqPos);
+        length = m_SeqLength;
+    }
+    bool unloaded = false;
+    size_t index = x_FindSegment(pos, 0);
+    CMutexGuard guard(m_SeqMap_Mtx);
+    while ( length ) {
+        if ( index > x_GetLastEndSegmentIndex() ) {
+            x_GetSegmentException(index);
+        }
+        CSegment& seg = x_SetSegment(index);
+        if ( seg.m_Position != pos || seg.m_Length > length ) {
+            NCBI_THROW(CSeqMapException, eDataError,
+                       "SeqMap segment crosses split chunk boundary");
+        }
+        // gap segments loaded from the chunk stay as they are
+        if ( seg.m_SegType == eSeqData && seg.m_ObjType == eSeqData ) {
+            seg.m_RefObject.Reset(&chunk);
+            seg.m_ObjType = eSeqChunk;
+            unloaded = true;
+        }
+        pos += seg.m_Length;
+        length -= seg.m_Length;
+        ++index;
+    }
+    return unloaded;
+}
+
+
 const CSeq_id& CSeqMap::x_GetRefSeqid(const CSegment& seg) const
 {
     if ( seg.m_SegType == eSeqRef ) {
@@ -983,6 +1017,61 @@ namespace {
 }
 
 
+void CSeqMap::LoadChunks(TChunksToLoad& chunks)
+{
+    sort(chunks.begin(), chunks.end(), PByLoader());
+    chunks.erase(unique(chunks.begin(), chunks.end()), chunks.end());
+    CDataLoader::TChunkSet load_chunks;
+    vector< AutoPtr<CInitGuard> > guards;
+    while ( !chunks.empty() ) {
+        // Collect and lock chunks from one loader to be loaded
+        CDataLoader* loader = PByLoader::Get(chunks.back());
+        load_chunks.clear();
+        guards.clear();
+        // find start index of chunks from this loader
+        size_t s = chunks.size();
+        while ( s > 0 && PByLoader::Get(chunks[s-1]) == loader ) {
+            --s;
+        }
+        // lock chunks to be loaded
+        for ( size_t i = s; i < chunks.size(); ++i ) {
+            AutoPtr<CInitGuard> guard = chunks[i]->GetLoadInitGuard();
+            if ( guard.get() && *guard.get() ) {
+                load_chunks.push_back(chunks[i]);
+                guards.push_back(guard);
+            }
+        }
+        // load the chunks
+        if ( !load_chunks.empty() ) {
+            loader->GetChunks(load_chunks);
+            guards.clear();
+        }
+        // done with this loader
+        chunks.resize(s);
+    }
+}
+
+
+void CSeqMap::GetChunksToLoad(TChunksToLoad& chunks,
+                              CScope* scope,
+                              TSeqPos from,
+                              TSeqPos length) const
+{
+    SSeqMapSelector sel;
+    sel.SetFlags(fFindAnyLeaf).SetResolveCount(0);
+    sel.SetRange(from, length);
+    for ( CSeqMap_CI it(ConstRef(this), scope, sel); it; ++it ) {
+        if ( it.GetType() != eSeqRef ) {
+            CRef<CTSE_Chunk_Info> chunk =
+                it.x_GetSeqMap().x_GetChunkToLoad(it.x_GetSegment());
+            if ( chunk ) {
+                chunks.push_back(chunk);
+            }
+        }
+    }
+}
+
+
 bool CSeqMap::CanResolveRange(CScope* scope, const SSeqMapSelector& sel) const
 {
     try {
@@ -1013,8 +1102,7 @@ bool CSeqMap::CanResolveRange(CScope* scope, const SSeqMapSelector& sel) const
             vector<CTSE_Handle> all_tse;
             vector<CTSE_Handle> parent_tse;
             vector<CSeq_id_Handle> next_ids;
-            CDataLoader::TChunkSet load_chunks, chunks;
-            vector< AutoPtr<CInitGuard> > guards;
+            TChunksToLoad chunks;
 
             SSeqMapSelector next_sel(sel);
             while ( deeper ) {
@@ -1052,34 +1140,7 @@ bool CSeqMap::CanResolveRange(CScope* scope, const SSeqMapSelector& sel) const
                         return false;
                     }
                 }}
-                sort(chunks.begin(), chunks.end(), PByLoader());
-                chunks.erase(unique(chunks.begin(), chunks.end()), chunks.end());
-                while ( !chunks.empty() ) {
-                    // Collect and lock chunks from one loader to be loaded
-                    CDataLoader* loader = PByLoader::Get(chunks.back());
-                    load_chunks.clear();
-                    guards.clear();
-                    // find start index of chunks from this loader
-                    size_t s = chunks.size();
-                    while ( s > 0 && PByLoader::Get(chunks[s-1]) == loader ) {
-                        --s;
-                    }
-                    // lock chunks to be loaded
-                    for ( size_t i = s; i < chunks.size(); ++i ) {
-                        AutoPtr<CInitGuard> guard = chunks[i]->GetLoadInitGuard();
-                        if ( guard.get() && *guard.get() ) {
-                            load_chunks.push_back(chunks[i]);
-                            guards.push_back(guard);
-                        }
-                    }
-                    // load the chunks
-                    if ( !load_chunks.empty() ) {
-                        loader->GetChunks(load_chunks);
-                        guards.clear();
-                    }
-                    // done with this loader
-                    chunks.resize(s);
-                }
+                LoadChunks(chunks);
                 if ( !next_ids.empty() ) {
                     deeper = true;
                     vector<CBioseq_Handle> seqs =
@@ -48,12 +48,26 @@
 #include <objmgr/impl/seq_vector_cvt.hpp>
 #include <objmgr/objmgr_exception.hpp>
 #include <util/random_gen.hpp>
+#include <corelib/ncbi_param.hpp>
 
 BEGIN_NCBI_SCOPE
 BEGIN_SCOPE(objects)
 
 
-static const TSeqPos kCacheSize = 1024;
+// size of the iterator's data cache window in residues
+NCBI_PARAM_DECL(unsigned, OBJMGR, SEQ_VECTOR_CACHE_SIZE);
+NCBI_PARAM_DEF_EX(unsigned, OBJMGR, SEQ_VECTOR_CACHE_SIZE, 1024,
+                  eParam_NoThread, OBJMGR_SEQ_VECTOR_CACHE_SIZE);
+
+static const TSeqPos kMinCacheSize = 64;
+static const TSeqPos kMaxCacheSize = 1<<20;
+
+static TSeqPos sx_GetCacheSize(void)
+{
+    static TSeqPos value = min(kMaxCacheSize, max(kMinCacheSize, TSeqPos(
+        NCBI_PARAM_TYPE(OBJMGR, SEQ_VECTOR_CACHE_SIZE)::GetDefault())));
+    return value;
+}
 
 void ThrowOutOfRangeSeq_inst(size_t pos)
 {
@@ -458,8 +472,8 @@ CSeqVector_CI& CSeqVector_CI::operator=(const CSeqVector_CI& sv_it)
 void CSeqVector_CI::x_InitializeCache(void)
 {
     if ( !m_Cache ) {
-        m_CacheData.reset(new char[kCacheSize]);
-        m_BackupData.reset(new char[kCacheSize]);
+        m_CacheData.reset(new char[sx_GetCacheSize()]);
+        m_BackupData.reset(new char[sx_GetCacheSize()]);
         m_BackupEnd = m_BackupData.get();
         m_Cache = m_CacheEnd = m_CacheData.get();
     }
@@ -472,7 +486,7 @@ void CSeqVector_CI::x_InitializeCache(void)
 inline
 void CSeqVector_CI::x_ResizeCache(size_t size)
 {
-    _ASSERT(size <= kCacheSize);
+    _ASSERT(size <= sx_GetCacheSize());
     if ( !m_CacheData.get() ) {
         x_InitializeCache();
     }
@@ -488,7 +502,7 @@ void CSeqVector_CI::x_UpdateCacheUp(TSeqPos pos)
     TSeqPos segEnd = m_Seg.GetEndPosition();
     _ASSERT(pos >= m_Seg.GetPosition() && pos < segEnd);
 
-    TSeqPos cache_size = min(kCacheSize, segEnd - pos);
+    TSeqPos cache_size = min(sx_GetCacheSize(), segEnd - pos);
     x_FillCache(pos, cache_size);
     m_Cache = m_CacheData.get();
     _ASSERT(GetPos() == pos);
@@ -502,7 +516,7 @@ void CSeqVector_CI::x_UpdateCacheDown(TSeqPos pos)
     TSeqPos segStart = m_Seg.GetPosition();
     _ASSERT(pos >= segStart && pos < m_Seg.GetEndPosition());
 
-    TSeqPos cache_offset = min(kCacheSize - 1, pos - segStart);
+    TSeqPos cache_offset = min(sx_GetCacheSize() - 1, pos - segStart);
     x_FillCache(pos - cache_offset, cache_offset + 1);
     m_Cache = m_CacheData.get() + cache_offset;
     _ASSERT(GetPos() == pos);
@@ -665,7 +679,7 @@ void CSeqVector_CI::x_SetPos(TSeqPos pos)
         // cannot use backup
         x_InitializeCache();
         TSeqPos old_pos = x_BackupPos();
-        if ( pos < old_pos && pos >= old_pos - kCacheSize &&
+        if ( pos < old_pos && pos >= old_pos - sx_GetCacheSize() &&
              m_Seg.GetEndPosition() >= old_pos ) {
             x_UpdateCacheDown(old_pos - 1);
             cache_offset = pos - x_CachePos();
@@ -754,6 +768,43 @@ void CSeqVector_CI::GetSeqData(string& buffer, TSeqPos count)
 }
 
 
+TSeqPos CSeqVector_CI::GetSeqData(char* buffer, TSeqPos count)
+{
+    TSeqPos pos = GetPos();
+    _ASSERT(pos <= x_GetSize());
+    count = min(count, x_GetSize() - pos);
+    if ( !count ) {
+        return 0;
+    }
+
+    if ( m_TSE && !CanGetRange(pos, pos+count) ) {
+        NCBI_THROW_FMT(CSeqVectorException, eDataError,
+                       "CSeqVector_CI::GetSeqData: "
+                       "cannot get seq-data in range: "
+                       <<pos<<"-"<<pos+count);
+    }
+
+    TSeqPos ret = count;
+    while ( count ) {
+        TCache_I cache = m_Cache;
+        TCache_I cache_end = m_CacheEnd;
+        TSeqPos chunk_count = min(count, TSeqPos(cache_end - cache));
+        _ASSERT(chunk_count > 0);
+        TCache_I chunk_end = cache + chunk_count;
+        memcpy(buffer, cache, chunk_count);
+        buffer += chunk_count;
+        count -= chunk_count;
+        if ( chunk_end == cache_end ) {
+            x_NextCacheSeg();
+        }
+        else {
+            m_Cache = chunk_end;
+        }
+    }
+    return ret;
+}
+
+
 void CSeqVector_CI::x_NextCacheSeg()
 {
     _ASSERT(m_SeqMap);
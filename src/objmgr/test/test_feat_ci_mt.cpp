@@ -0,0 +1,292 @@
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Authors:  agent
+*
+* File Description:
+*   Scaling of CFeat_CI with the number of threads sharing one scope,
+*   regular scope vs. frozen one
+*
+* ===========================================================================
+*/
+#include <ncbi_pch.hpp>
+#include <corelib/ncbistd.hpp>
+#include <corelib/ncbiapp.hpp>
+#include <corelib/ncbiargs.hpp>
+#include <corelib/ncbitime.hpp>
+#include <corelib/ncbithr.hpp>
+#include <util/random_gen.hpp>
+
+#include <objects/general/Object_id.hpp>
+#include <objects/seqloc/Seq_id.hpp>
+#include <objects/seqloc/Seq_loc.hpp>
+#include <objects/seqloc/Seq_interval.hpp>
+#include <objects/seq/Bioseq.hpp>
+#include <objects/seq/Seq_inst.hpp>
+#include <objects/seq/Seq_annot.hpp>
+#include <objects/seqset/Seq_entry.hpp>
+#include <objects/seqset/Bioseq_set.hpp>
+#include <objects/seqfeat/Seq_feat.hpp>
+#include <objects/seqfeat/SeqFeatData.hpp>
+#include <objects/seqfeat/Imp_feat.hpp>
+
+#include <objmgr/object_manager.hpp>
+#include <objmgr/scope.hpp>
+#include <objmgr/bioseq_handle.hpp>
+#include <objmgr/feat_ci.hpp>
+
+#include <atomic>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+
+BEGIN_NCBI_SCOPE
+using namespace objects;
+
+
+static const TSeqPos kSeqLength = 1000000;
+
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//  Test thread
+//
+
+class CFeatThread : public CThread
+{
+public:
+    CFeatThread(CScope& scope,
+                const vector<CSeq_id_Handle>& ids,
+                size_t feat_count,
+                int iterations,
+                int seed,
+                atomic<int>& errors)
+        : m_Scope(scope),
+          m_Ids(ids),
+          m_FeatCount(feat_count),
+          m_Iterations(iterations),
+          m_Seed(seed),
+          m_Errors(errors)
+        {
+        }
+
+protected:
+    virtual void* Main(void);
+
+private:
+    CScope&                       m_Scope;
+    const vector<CSeq_id_Handle>& m_Ids;
+    size_t                        m_FeatCount;
+    int                           m_Iterations;
+    int                           m_Seed;
+    atomic<int>&                  m_Errors;
+};
+
+
+void* CFeatThread::Main(void)
+{
+    CRandom r(m_Seed);
+    for ( int i = 0; i < m_Iterations; ++i ) {
+        const CSeq_id_Handle& idh = m_Ids[r.GetRandIndex(CRandom::TValue(m_Ids.size()))];
+        CBioseq_Handle bh = m_Scope.GetBioseqHandle(idh);
+        if ( !bh ) {
+            ERR_POST("Bioseq not found: "<<idh);
+            ++m_Errors;
+            continue;
+        }
+        size_t count = 0;
+        for ( CFeat_CI it(bh); it; ++it ) {
+            ++count;
+        }
+        if ( count != m_FeatCount ) {
+            ERR_POST("Wrong feature count on "<<idh<<": "<<count);
+            ++m_Errors;
+        }
+    }
+    return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//  Test application
+//
+
+class CTestApp : public CNcbiApplication
+{
+public:
+    virtual void Init(void);
+    virtual int  Run(void);
+
+private:
+    CRef<CSeq_entry> x_CreateEntry(unsigned seq_count);
+    double x_GetRate(CScope& scope, unsigned threads);
+
+    unsigned               m_FeatCount;
+    int                    m_Iterations;
+    vector<CSeq_id_Handle> m_Ids;
+    atomic<int>            m_Errors;
+};
+
+
+void CTestApp::Init(void)
+{
+    unique_ptr<CArgDescriptions> arg_desc(new CArgDescriptions);
+    arg_desc->SetUsageContext(GetArguments().GetProgramBasename(),
+                              "CFeat_CI scaling in regular and frozen scope");
+
+    arg_desc->AddDefaultKey("seqs", "SeqCount",
+                            "Number of sequences in the scope",
+                            CArgDescriptions::eInteger, "100");
+    arg_desc->AddDefaultKey("feats", "FeatCount",
+                            "Number of features on each sequence",
+                            CArgDescriptions::eInteger, "1000");
+    arg_desc->AddDefaultKey("iterations", "Iterations",
+                            "Number of CFeat_CI runs in each thread",
+                            CArgDescriptions::eInteger, "200");
+    arg_desc->AddDefaultKey("threads", "Threads",
+                            "Maximal number of threads, "
+                            "the benchmark runs with 1, 2, 4... threads",
+                            CArgDescriptions::eInteger, "32");
+
+    SetupArgDescriptions(arg_desc.release());
+}
+
+
+// virtual sequences, only features matter for CFeat_CI
+CRef<CSeq_entry> CTestApp::x_CreateEntry(unsigned seq_count)
+{
+    CRandom r(1);
+    CRef<CSeq_entry> entry(new CSeq_entry);
+    CBioseq_set& seqset = entry->SetSet();
+    for ( unsigned i = 0; i < seq_count; ++i ) {
+        CRef<CSeq_id> id(new CSeq_id);
+        id->SetLocal().SetId(i+1);
+        m_Ids.push_back(CSeq_id_Handle::GetHandle(*id));
+
+        CRef<CSeq_entry> seq_entry(new CSeq_entry);
+        CBioseq& seq = seq_entry->SetSeq();
+        seq.SetId().push_back(id);
+        seq.SetInst().SetRepr(CSeq_inst::eRepr_virtual);
+        seq.SetInst().SetMol(CSeq_inst::eMol_dna);
+        seq.SetInst().SetLength(kSeqLength);
+
+        CRef<CSeq_annot> annot(new CSeq_annot);
+        for ( unsigned j = 0; j < m_FeatCount; ++j ) {
+            CRef<CSeq_feat> feat(new CSeq_feat);
+            feat->SetData().SetImp().SetKey("misc_feature");
+            TSeqPos from = r.GetRandIndex(kSeqLength-1000);
+            CSeq_interval& interval = feat->SetLocation().SetInt();
+            interval.SetId(*id);
+            interval.SetFrom(from);
+            interval.SetTo(from+r.GetRandIndex(1000));
+            annot->SetData().SetFtable().push_back(feat);
+        }
+        seq.SetAnnot().push_back(annot);
+        seqset.SetSeq_set().push_back(seq_entry);
+    }
+    return entry;
+}
+
+
+// CFeat_CI runs per second in all threads together
+double CTestApp::x_GetRate(CScope& scope, unsigned threads)
+{
+    vector<CRef<CFeatThread> > thr;
+    CStopWatch sw(CStopWatch::eStart);
+    for ( unsigned i = 0; i < threads; ++i ) {
+        thr.push_back(Ref(new CFeatThread(scope, m_Ids, m_FeatCount,
+                                          m_Iterations, i+1, m_Errors)));
+        thr.back()->Run(CThread::fRunAllowST);
+    }
+    for ( unsigned i = 0; i < threads; ++i ) {
+        thr[i]->Join();
+    }
+    return threads*m_Iterations/sw.Elapsed();
+}
+
+
+int CTestApp::Run(void)
+{
+    const CArgs& args = GetArgs();
+    m_FeatCount = args["feats"].AsInteger();
+    m_Iterations = args["iterations"].AsInteger();
+    m_Errors = 0;
+    unsigned max_threads = max(1, args["threads"].AsInteger());
+
+    CRef<CObjectManager> om = CObjectManager::GetInstance();
+    CRef<CSeq_entry> entry = x_CreateEntry(args["seqs"].AsInteger());
+
+    // both scopes have all handles and annotation indexes created,
+    // so the only difference is locking
+    CScope regular(*om), frozen(*om);
+    regular.AddTopLevelSeqEntry(*entry);
+    frozen.AddTopLevelSeqEntry(*entry);
+    ITERATE ( vector<CSeq_id_Handle>, it, m_Ids ) {
+        CFeat_CI regular_it(regular.GetBioseqHandle(*it));
+        CFeat_CI frozen_it(frozen.GetBioseqHandle(*it));
+    }
+    frozen.Freeze();
+
+    double regular_base = 0, frozen_base = 0;
+    for ( unsigned threads = 1; ; threads = min(threads*2, max_threads) ) {
+        double regular_rate = x_GetRate(regular, threads);
+        double frozen_rate = x_GetRate(frozen, threads);
+        if ( threads == 1 ) {
+            regular_base = regular_rate;
+            frozen_base = frozen_rate;
+        }
+        NcbiCout << setw(4) << threads << " threads: " << fixed
+                 << "regular " << setw(8) << setprecision(0) << regular_rate
+                 << "/s (x" << setprecision(1) << regular_rate/regular_base
+                 << "), frozen " << setw(8) << setprecision(0) << frozen_rate
+                 << "/s (x" << setprecision(1) << frozen_rate/frozen_base
+                 << ")" << NcbiEndl;
+        if ( threads == max_threads ) {
+            break;
+        }
+    }
+
+    if ( m_Errors ) {
+        ERR_POST("Errors: "<<m_Errors);
+        return 1;
+    }
+    NcbiCout << "Passed" << NcbiEndl;
+    return 0;
+}
+
+
+END_NCBI_SCOPE
+
+
+/////////////////////////////////////////////////////////////////////////////
+//  MAIN
+
+USING_NCBI_SCOPE;
+
+int main(int argc, const char* argv[])
+{
+    return CTestApp().AppMain(argc, argv);
+}
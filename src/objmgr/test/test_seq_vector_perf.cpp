@@ -0,0 +1,277 @@
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Authors:  agent
+*
+* File Description:
+*   Throughput and correctness of CSeqVector_CI data conversion
+*   for each source coding, destination coding and strand,
+*   on a long chromosome-size sequence
+*
+* ===========================================================================
+*/
+#include <ncbi_pch.hpp>
+#include <corelib/ncbistd.hpp>
+#include <corelib/ncbiapp.hpp>
+#include <corelib/ncbiargs.hpp>
+#include <corelib/ncbitime.hpp>
+#include <util/random_gen.hpp>
+
+#include <objects/general/Object_id.hpp>
+#include <objects/seqloc/Seq_id.hpp>
+#include <objects/seq/Bioseq.hpp>
+#include <objects/seq/Seq_inst.hpp>
+#include <objects/seq/Seq_data.hpp>
+#include <objects/seq/NCBI2na.hpp>
+#include <objects/seq/NCBI4na.hpp>
+#include <objects/seq/IUPACna.hpp>
+#include <objects/seqset/Seq_entry.hpp>
+
+#include <objmgr/object_manager.hpp>
+#include <objmgr/scope.hpp>
+#include <objmgr/bioseq_handle.hpp>
+#include <objmgr/seq_vector.hpp>
+#include <objmgr/seq_vector_ci.hpp>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+
+BEGIN_NCBI_SCOPE
+using namespace objects;
+
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//  Test application
+//
+
+class CTestApp : public CNcbiApplication
+{
+public:
+    virtual void Init(void);
+    virtual int  Run(void);
+
+private:
+    // each source coding goes through a different conversion function:
+    // 2-bit and 4-bit unpacking, and 8-bit copy
+    enum ESource {
+        eNcbi2na,
+        eNcbi4na,
+        eIupacna
+    };
+    CRef<CSeq_entry> x_CreateEntry(ESource source);
+    // residue computed directly from the Seq-data,
+    // native coding is the coding of the Seq-data
+    char x_GetResidue(ESource source, TSeqPos pos,
+                      bool native, bool minus) const;
+    int x_Check(const CSeqVector& sv, ESource source,
+                bool native, bool minus) const;
+
+    TSeqPos      m_SeqLength;
+    TSeqPos      m_BlockSize;
+    vector<char> m_Data;
+};
+
+
+void CTestApp::Init(void)
+{
+    unique_ptr<CArgDescriptions> arg_desc(new CArgDescriptions);
+    arg_desc->SetUsageContext(GetArguments().GetProgramBasename(),
+                              "CSeqVector_CI conversion benchmark");
+
+    arg_desc->AddDefaultKey("length", "SeqLength",
+                            "Length of the sequence",
+                            CArgDescriptions::eInteger, "250000000");
+    arg_desc->AddDefaultKey("block", "BlockSize",
+                            "Size of data block retrieved by GetSeqData()",
+                            CArgDescriptions::eInteger, "65536");
+
+    SetupArgDescriptions(arg_desc.release());
+}
+
+
+CRef<CSeq_entry> CTestApp::x_CreateEntry(ESource source)
+{
+    CRandom r(1);
+    CRef<CSeq_entry> entry(new CSeq_entry);
+    CBioseq& seq = entry->SetSeq();
+    CRef<CSeq_id> id(new CSeq_id);
+    id->SetLocal().SetStr("chr");
+    seq.SetId().push_back(id);
+    CSeq_inst& inst = seq.SetInst();
+    inst.SetRepr(CSeq_inst::eRepr_raw);
+    inst.SetMol(CSeq_inst::eMol_dna);
+    inst.SetLength(m_SeqLength);
+    switch ( source ) {
+    case eNcbi2na:
+        m_Data.resize((m_SeqLength+3)/4);
+        NON_CONST_ITERATE ( vector<char>, it, m_Data ) {
+            *it = char(r.GetRandIndex(256));
+        }
+        inst.SetSeq_data().SetNcbi2na().Set() = m_Data;
+        break;
+    case eNcbi4na:
+        m_Data.resize((m_SeqLength+1)/2);
+        NON_CONST_ITERATE ( vector<char>, it, m_Data ) {
+            // only unambiguous bases: A=1, C=2, G=4, T=8
+            *it = char((1<<r.GetRandIndex(4))<<4 | (1<<r.GetRandIndex(4)));
+        }
+        inst.SetSeq_data().SetNcbi4na().Set() = m_Data;
+        break;
+    case eIupacna:
+        m_Data.resize(m_SeqLength);
+        NON_CONST_ITERATE ( vector<char>, it, m_Data ) {
+            *it = "ACGT"[r.GetRandIndex(4)];
+        }
+        inst.SetSeq_data().SetIupacna().Set().assign(m_Data.begin(),
+                                                     m_Data.end());
+        break;
+    }
+    return entry;
+}
+
+
+char CTestApp::x_GetResidue(ESource source, TSeqPos pos,
+                            bool native, bool minus) const
+{
+    if ( minus ) {
+        pos = m_SeqLength-1-pos;
+    }
+    // index of the base in "ACGT"
+    int base = 0;
+    switch ( source ) {
+    case eNcbi2na:
+        base = (m_Data[pos/4] >> (6-2*(pos%4))) & 3;
+        break;
+    case eNcbi4na:
+        switch ( (m_Data[pos/2] >> (pos%2? 0: 4)) & 15 ) {
+        case 1: base = 0; break;
+        case 2: base = 1; break;
+        case 4: base = 2; break;
+        case 8: base = 3; break;
+        }
+        break;
+    case eIupacna:
+        base = int(strchr("ACGT", m_Data[pos])-"ACGT");
+        break;
+    }
+    if ( minus ) {
+        base = 3-base;
+    }
+    if ( !native || source == eIupacna ) {
+        return "ACGT"[base];
+    }
+    return char(source == eNcbi2na? base: 1<<base);
+}
+
+
+// compare randomly placed blocks, so that conversions start and end
+// at any offset in the source bytes
+int CTestApp::x_Check(const CSeqVector& sv, ESource source,
+                      bool native, bool minus) const
+{
+    CRandom r(2);
+    string buffer;
+    for ( int k = 0; k < 100; ++k ) {
+        TSeqPos pos = r.GetRandIndex(m_SeqLength);
+        TSeqPos end = min(m_SeqLength, pos+r.GetRandIndex(m_BlockSize)+1);
+        sv.GetSeqData(pos, end, buffer);
+        for ( TSeqPos i = pos; i < end; ++i ) {
+            if ( buffer[i-pos] != x_GetResidue(source, i, native, minus) ) {
+                ERR_POST("Wrong residue at "<<i);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+
+int CTestApp::Run(void)
+{
+    const CArgs& args = GetArgs();
+    m_SeqLength = args["length"].AsInteger();
+    m_BlockSize = args["block"].AsInteger();
+
+    CRef<CObjectManager> om = CObjectManager::GetInstance();
+
+    static const char* const kSourceNames[] = {
+        "ncbi2na", "ncbi4na", "iupacna"
+    };
+    static const CSeq_data::E_Choice kSourceCodings[] = {
+        CSeq_data::e_Ncbi2na, CSeq_data::e_Ncbi4na, CSeq_data::e_Iupacna
+    };
+    int errors = 0;
+    for ( int source = eNcbi2na; source <= eIupacna; ++source ) {
+        CScope scope(*om);
+        CBioseq_Handle bh =
+            scope.AddTopLevelSeqEntry(*x_CreateEntry(ESource(source)))
+            .GetSeq();
+        NcbiCout << kSourceNames[source] << ":" << NcbiEndl;
+        for ( int native = 0; native < 2; ++native ) {
+            for ( int minus = 0; minus < 2; ++minus ) {
+                CSeqVector sv =
+                    bh.GetSeqVector(CBioseq_Handle::eCoding_Iupac,
+                                    minus? eNa_strand_minus: eNa_strand_plus);
+                if ( native ) {
+                    // unpacking without conversion table on plus strand
+                    sv.SetCoding(kSourceCodings[source]);
+                }
+                CStopWatch sw(CStopWatch::eStart);
+                string buffer;
+                for ( CSeqVector_CI it(sv); it; ) {
+                    it.GetSeqData(buffer, m_BlockSize);
+                }
+                double time = sw.Elapsed();
+                NcbiCout << "  to " << (native? "native": "iupac ")
+                         << (minus? " minus": " plus ") << ": "
+                         << setw(8) << setprecision(1) << fixed
+                         << m_SeqLength/time/1e6 << " Mbp/s" << NcbiEndl;
+                errors += x_Check(sv, ESource(source),
+                                  native != 0, minus != 0);
+            }
+        }
+    }
+
+    if ( errors ) {
+        return 1;
+    }
+    NcbiCout << "Passed" << NcbiEndl;
+    return 0;
+}
+
+
+END_NCBI_SCOPE
+
+
+/////////////////////////////////////////////////////////////////////////////
+//  MAIN
+
+USING_NCBI_SCOPE;
+
+int main(int argc, const char* argv[])
+{
+    return CTestApp().AppMain(argc, argv);
+}
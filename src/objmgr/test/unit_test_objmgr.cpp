@@ -46,6 +46,14 @@
 #include <objmgr/seq_table_ci.hpp>
 #include <objmgr/annot_ci.hpp>
 #include <objmgr/impl/synonyms.hpp>
+#include <objmgr/prefetch_manager.hpp>
+#include <objmgr/prefetch_actions.hpp>
+#include <objmgr/data_loader.hpp>
+#include <objmgr/impl/data_source.hpp>
+#include <objmgr/impl/tse_info.hpp>
+#include <objmgr/impl/tse_split_info.hpp>
+#include <objmgr/impl/tse_chunk_info.hpp>
+#include <objmgr/impl/tse_loadlock.hpp>
 
 #include <objects/general/general__.hpp>
 #include <objects/seqfeat/seqfeat__.hpp>
@@ -893,8 +901,372 @@ BOOST_AUTO_TEST_CASE(TestReResolveMT4)
         BOOST_REQUIRE_EQUAL(c, total_feats);
     }
 }
+
+
+// occupies the only prefetch thread until released
+class CBlockingPrefetchAction : public CObject, public IPrefetchAction
+{
+public:
+    CBlockingPrefetchAction(void)
+        : m_Started(0, 1), m_Release(0, 1)
+        {
+        }
+
+    virtual bool Execute(CRef<CPrefetchRequest> /*token*/)
+        {
+            m_Started.Post();
+            m_Release.Wait();
+            return true;
+        }
+
+    CSemaphore m_Started;
+    CSemaphore m_Release;
+};
+
+
+BOOST_AUTO_TEST_CASE(TestPrefetchPlanner)
+{
+    const size_t COUNT = 20;
+    const TSeqPos LENGTH = 10;
+    CScope scope(*CObjectManager::GetInstance());
+    vector<CSeq_id_Handle> ids;
+    for ( size_t i = 0; i < COUNT; ++i ) {
+        scope.AddTopLevelSeqEntry(*s_GetEntry(i, LENGTH));
+        ids.push_back(CSeq_id_Handle::GetHandle(*s_GetId(i)));
+    }
+    ids.push_back(CSeq_id_Handle::GetHandle(*s_GetId(COUNT)));
+    typedef CStdSeq_idSource< vector<CSeq_id_Handle> > TIds;
+
+    CRef<CPrefetchManager> manager(new CPrefetchManager(2));
+    CPrefetchPlanner planner(*manager, CScopeSource::New(scope),
+                             new TIds(ids),
+                             CPrefetchPlannerAction::fSeqData, 0, 4);
+    size_t found = 0;
+    while ( CRef<CPrefetchRequest> token = planner.GetNextToken() ) {
+        const CPrefetchPlannerAction* action =
+            dynamic_cast<const CPrefetchPlannerAction*>(token->GetAction());
+        BOOST_REQUIRE(action);
+        if ( action->GetSeq_id() == ids.back() ) {
+            // unknown id
+            BOOST_CHECK(!action->GetBioseqHandle());
+            continue;
+        }
+        BOOST_CHECK_EQUAL(token->GetState(), SPrefetchTypes::eCompleted);
+        BOOST_REQUIRE(action->GetBioseqHandle());
+        BOOST_CHECK(action->GetEstimatedSize() > LENGTH);
+        ++found;
+    }
+    BOOST_CHECK_EQUAL(found, COUNT);
+    CPrefetchPlanner::SStats stats = planner.GetStats();
+    BOOST_CHECK_EQUAL(stats.m_Submitted, COUNT+1);
+    BOOST_CHECK_EQUAL(stats.m_Hits+stats.m_Late, COUNT+1);
+    BOOST_CHECK_EQUAL(stats.m_Failed, 1u);
+    BOOST_CHECK_EQUAL(stats.m_Canceled, 0u);
+}
+
+
+BOOST_AUTO_TEST_CASE(TestPrefetchPlannerCancel)
+{
+    const size_t COUNT = 3;
+    CScope scope(*CObjectManager::GetInstance());
+    vector<CSeq_id_Handle> ids;
+    for ( size_t i = 0; i < COUNT; ++i ) {
+        scope.AddTopLevelSeqEntry(*s_GetEntry(i));
+        ids.push_back(CSeq_id_Handle::GetHandle(*s_GetId(i)));
+    }
+    typedef CStdSeq_idSource< vector<CSeq_id_Handle> > TIds;
+    CRef<CPrefetchManager> manager(new CPrefetchManager(1));
+
+    // requests still waiting in the queue are counted as canceled
+    {{
+        CRef<CBlockingPrefetchAction> blocker(new CBlockingPrefetchAction);
+        CRef<CPrefetchRequest> blocker_token = manager->AddAction(blocker);
+        blocker->m_Started.Wait();
+        CPrefetchPlanner planner(*manager, CScopeSource::New(scope),
+                                 new TIds(ids),
+                                 CPrefetchPlannerAction::fBioseq, 0, COUNT);
+        planner.Cancel();
+        BOOST_CHECK_EQUAL(planner.GetStats().m_Submitted, COUNT);
+        BOOST_CHECK_EQUAL(planner.GetStats().m_Canceled, COUNT);
+        BOOST_CHECK(!planner.GetNextToken());
+        blocker->m_Release.Post();
+        CStdPrefetch::Wait(blocker_token);
+    }}
+
+    // completed but not consumed requests are not
+    {{
+        CPrefetchPlanner planner(*manager, CScopeSource::New(scope),
+                                 new TIds(ids),
+                                 CPrefetchPlannerAction::fBioseq, 0, COUNT);
+        // the single thread executes the queue in order
+        CRef<CBlockingPrefetchAction> marker(new CBlockingPrefetchAction);
+        CRef<CPrefetchRequest> marker_token = manager->AddAction(marker);
+        marker->m_Started.Wait();
+        planner.Cancel();
+        BOOST_CHECK_EQUAL(planner.GetStats().m_Submitted, COUNT);
+        BOOST_CHECK_EQUAL(planner.GetStats().m_Canceled, 0u);
+        marker->m_Release.Post();
+        CStdPrefetch::Wait(marker_token);
+    }}
+}
 #endif // NCBI_THREADS
 
+// loads one entry per gi and reports a fixed memory size for each blob,
+// optionally with sequence data split into a separate chunk
+class CUsedMemoryDataLoader : public CDataLoader
+{
+public:
+    typedef SRegisterLoaderInfo<CUsedMemoryDataLoader> TRegisterLoaderInfo;
+    static TRegisterLoaderInfo RegisterInObjectManager(CObjectManager& om,
+                                                       const string& name,
+                                                       size_t blob_memory,
+                                                       size_t chunk_memory = 0);
+
+    virtual TTSE_LockSet GetRecords(const CSeq_id_Handle& idh,
+                                    EChoice /*choice*/)
+        {
+            TTSE_LockSet locks;
+            if ( !idh.IsGi() ) {
+                return locks;
+            }
+            int index = int(GI_TO(TIntId, idh.GetGi()))-1;
+            TBlobId blob_id(new CBlobIdInt(index));
+            CTSE_LoadLock lock = GetDataSource()->GetTSE_LoadLock(blob_id);
+            if ( !lock.IsLoaded() ) {
+                CRef<CSeq_entry> entry = s_GetEntry(index, kSeqLength);
+                if ( m_ChunkMemory ) {
+                    // sequence data is loaded by GetChunk()
+                    entry->SetSeq().SetInst().ResetSeq_data();
+                    CTSE_Chunk_Info::TLocationSet location;
+                    location.push_back(CTSE_Chunk_Info::TLocation(
+                        idh, CTSE_Chunk_Info::TLocationRange(0, kSeqLength-1)));
+                    CRef<CTSE_Chunk_Info> chunk(new CTSE_Chunk_Info(index));
+                    chunk->x_AddSeq_data(location);
+                    lock->SetSeq_entry(*entry);
+                    lock->GetSplitInfo().AddChunk(*chunk);
+                }
+                else {
+                    lock->SetSeq_entry(*entry);
+                }
+                lock->AddUsedMemory(m_BlobMemory);
+                lock.SetLoaded();
+                ++m_LoadCount;
+            }
+            locks.insert(lock);
+            return locks;
+        }
+
+    virtual void GetChunk(TChunk chunk)
+        {
+            if ( chunk->IsLoaded() ) {
+                return;
+            }
+            CRef<CSeq_entry> entry = s_GetEntry(chunk->GetChunkId(), kSeqLength);
+            CRef<CSeq_literal> literal(new CSeq_literal);
+            literal->SetLength(kSeqLength);
+            literal->SetSeq_data(entry->SetSeq().SetInst().SetSeq_data());
+            CTSE_Chunk_Info::TSequence sequence;
+            sequence.push_back(literal);
+            CTSE_Chunk_Info::TPlace place(
+                CSeq_id_Handle::GetHandle(*s_GetId(chunk->GetChunkId())), 0);
+            chunk->x_LoadSequence(place, 0, sequence);
+            chunk->x_AddUsedMemory(m_ChunkMemory);
+            chunk->SetLoaded();
+            ++m_ChunkLoadCount;
+        }
+
+    using CDataLoader::GetDataSource;
+
+    static const TSeqPos kSeqLength = 100;
+
+    size_t m_BlobMemory;
+    size_t m_ChunkMemory;
+    size_t m_LoadCount;
+    size_t m_ChunkLoadCount;
+
+private:
+    friend class CUsedMemoryLoaderMaker;
+
+    CUsedMemoryDataLoader(const string& name,
+                          size_t blob_memory,
+                          size_t chunk_memory)
+        : CDataLoader(name),
+          m_BlobMemory(blob_memory),
+          m_ChunkMemory(chunk_memory),
+          m_LoadCount(0),
+          m_ChunkLoadCount(0)
+        {
+        }
+};
+
+
+class CUsedMemoryLoaderMaker : public CLoaderMaker_Base
+{
+public:
+    CUsedMemoryLoaderMaker(const string& name,
+                           size_t blob_memory,
+                           size_t chunk_memory)
+        : m_BlobMemory(blob_memory),
+          m_ChunkMemory(chunk_memory)
+        {
+            m_Name = name;
+        }
+
+    virtual CDataLoader* CreateLoader(void) const
+        {
+            return new CUsedMemoryDataLoader(m_Name,
+                                             m_BlobMemory, m_ChunkMemory);
+        }
+    typedef CUsedMemoryDataLoader::TRegisterLoaderInfo TRegisterInfo;
+    TRegisterInfo GetRegisterInfo(void)
+        {
+            TRegisterInfo info;
+            info.Set(m_RegisterInfo.GetLoader(), m_RegisterInfo.IsCreated());
+            return info;
+        }
+
+private:
+    size_t m_BlobMemory;
+    size_t m_ChunkMemory;
+};
+
+
+CUsedMemoryDataLoader::TRegisterLoaderInfo
+CUsedMemoryDataLoader::RegisterInObjectManager(CObjectManager& om,
+                                               const string& name,
+                                               size_t blob_memory,
+                                               size_t chunk_memory)
+{
+    CUsedMemoryLoaderMaker maker(name, blob_memory, chunk_memory);
+    CDataLoader::RegisterInObjectManager(om, maker,
+                                         CObjectManager::eNonDefault,
+                                         CObjectManager::kPriority_Default);
+    return maker.GetRegisterInfo();
+}
+
+
+BOOST_AUTO_TEST_CASE(TestBlobCacheMemoryLimit)
+{
+    const size_t BLOB_MEMORY = 1<<20;
+    const size_t CACHED = 3;
+    const size_t COUNT = 6;
+    const string name = "UsedMemoryLoader";
+    CRef<CObjectManager> om = CObjectManager::GetInstance();
+    CUsedMemoryDataLoader* loader =
+        CUsedMemoryDataLoader::RegisterInObjectManager(*om, name, BLOB_MEMORY)
+        .GetLoader();
+    BOOST_REQUIRE(loader);
+    CDataSource& ds = *loader->GetDataSource();
+    // the count limit alone would keep all blobs
+    ds.SetBlobCacheSizeLimit(unsigned(COUNT*2));
+    ds.SetBlobCacheMemoryLimit(CACHED*BLOB_MEMORY+BLOB_MEMORY/2);
+
+    for ( size_t i = 0; i < COUNT; ++i ) {
+        {{
+            CScope scope(*om);
+            scope.AddDataLoader(name);
+            BOOST_REQUIRE(scope.GetBioseqHandle(*s_GetId(i)));
+        }}
+        // the released blob is now in the cache
+        size_t cached = min(i+1, CACHED);
+        BOOST_CHECK_EQUAL(ds.GetBlobCacheSize(), cached);
+        BOOST_CHECK_EQUAL(ds.GetBlobCacheMemory(), cached*BLOB_MEMORY);
+    }
+    BOOST_CHECK_EQUAL(loader->m_LoadCount, COUNT);
+
+    {{
+        CScope scope(*om);
+        scope.AddDataLoader(name);
+        // recently used blob is still cached
+        BOOST_CHECK(scope.GetBioseqHandle(*s_GetId(COUNT-1)));
+        BOOST_CHECK_EQUAL(loader->m_LoadCount, COUNT);
+        // least recently used blob was evicted and is loaded again
+        BOOST_CHECK(scope.GetBioseqHandle(*s_GetId(0)));
+        BOOST_CHECK_EQUAL(loader->m_LoadCount, COUNT+1);
+    }}
+
+    // lowering the limit evicts immediately
+    ds.SetBlobCacheMemoryLimit(BLOB_MEMORY);
+    BOOST_CHECK_EQUAL(ds.GetBlobCacheSize(), 1u);
+    BOOST_CHECK_EQUAL(ds.GetBlobCacheMemory(), BLOB_MEMORY);
+
+    om->RevokeDataLoader(name);
+}
+
+
+static string s_GetSeqData(CScope& scope, size_t index)
+{
+    CBioseq_Handle bh = scope.GetBioseqHandle(*s_GetId(index));
+    BOOST_REQUIRE(bh);
+    string data;
+    bh.GetSeqVector(CBioseq_Handle::eCoding_Iupac).GetSeqData(0, kInvalidSeqPos, data);
+    return data;
+}
+
+
+BOOST_AUTO_TEST_CASE(TestUnloadSeqDataChunk)
+{
+    const size_t BLOB_MEMORY = 1<<20;
+    const size_t CHUNK_MEMORY = 4<<20;
+    const string name = "UnloadSeqDataLoader";
+    CRef<CObjectManager> om = CObjectManager::GetInstance();
+    CUsedMemoryDataLoader* loader =
+        CUsedMemoryDataLoader::RegisterInObjectManager(*om, name,
+                                                       BLOB_MEMORY,
+                                                       CHUNK_MEMORY)
+        .GetLoader();
+    BOOST_REQUIRE(loader);
+    CDataSource& ds = *loader->GetDataSource();
+    ds.SetUnloadChunks(true);
+    ds.SetBlobCacheMemoryLimit(0);
+    const string seq_data(CUsedMemoryDataLoader::kSeqLength, 'A');
+
+    {{
+        CScope scope(*om);
+        scope.AddDataLoader(name);
+        BOOST_CHECK_EQUAL(s_GetSeqData(scope, 0), seq_data);
+    }}
+    BOOST_CHECK_EQUAL(loader->m_ChunkLoadCount, 1u);
+    BOOST_CHECK_EQUAL(ds.GetBlobCacheMemory(), BLOB_MEMORY+CHUNK_MEMORY);
+
+    // over the limit the chunk is unloaded, the blob stays cached
+    ds.SetBlobCacheMemoryLimit(BLOB_MEMORY+CHUNK_MEMORY/2);
+    BOOST_CHECK_EQUAL(ds.GetUnloadedChunksCount(), 1u);
+    BOOST_CHECK_EQUAL(ds.GetUnloadedChunksMemory(), CHUNK_MEMORY);
+    BOOST_CHECK_EQUAL(ds.GetBlobCacheSize(), 1u);
+    BOOST_CHECK_EQUAL(ds.GetBlobCacheMemory(), BLOB_MEMORY);
+
+    // the data is loaded again on the next access
+    {{
+        CScope scope(*om);
+        scope.AddDataLoader(name);
+        BOOST_CHECK_EQUAL(s_GetSeqData(scope, 0), seq_data);
+    }}
+    BOOST_CHECK_EQUAL(loader->m_LoadCount, 1u);
+    BOOST_CHECK_EQUAL(loader->m_ChunkLoadCount, 2u);
+    BOOST_CHECK_EQUAL(ds.GetUnloadedChunksCount(), 2u);
+
+    // once the Seq-inst got the data the chunk cannot be unloaded
+    ds.SetBlobCacheMemoryLimit(0);
+    {{
+        CScope scope(*om);
+        scope.AddDataLoader(name);
+        CBioseq_Handle bh = scope.GetBioseqHandle(*s_GetId(0));
+        BOOST_REQUIRE(bh);
+        BOOST_CHECK(bh.GetCompleteBioseq()->GetInst().IsSetSeq_data());
+    }}
+    BOOST_CHECK_EQUAL(loader->m_ChunkLoadCount, 3u);
+    ds.SetBlobCacheMemoryLimit(BLOB_MEMORY+CHUNK_MEMORY/2);
+    BOOST_CHECK_EQUAL(ds.GetUnloadedChunksCount(), 2u);
+    BOOST_CHECK_EQUAL(ds.GetUnloadedChunksMemory(), 2*CHUNK_MEMORY);
+    // so the whole blob is dropped instead
+    BOOST_CHECK_EQUAL(ds.GetBlobCacheSize(), 0u);
+    BOOST_CHECK_EQUAL(ds.GetBlobCacheMemory(), 0u);
+
+    om->RevokeDataLoader(name);
+}
+
+
 BOOST_AUTO_TEST_CASE(CppIterFeat)
 {
     // check for C++-11 style feature iteration
@@ -1259,3 +1631,48 @@ BOOST_AUTO_TEST_CASE(AddSeqIdHistory)
     }}
     SetDiagPostLevel(old_level);
 }
+
+
+BOOST_AUTO_TEST_CASE(GetSequencesData)
+{
+    CScope scope(*CObjectManager::GetInstance());
+    CScope::TSeq_id_Handles ids;
+    for ( size_t i = 0; i < 3; ++i ) {
+        scope.AddTopLevelSeqEntry(*s_GetEntry(i, TSeqPos(i+2)));
+        ids.push_back(CSeq_id_Handle::GetHandle(*s_GetId(i)));
+    }
+    ids.push_back(CSeq_id_Handle::GetHandle(*s_GetId(10)));
+
+    CScope::TSeqDataOffsets offsets;
+    vector<char> buffer(100);
+    size_t size = scope.GetSequencesData(&offsets, buffer.data(), buffer.size(),
+                                         ids);
+    BOOST_CHECK_EQUAL(size, 2u+3u+4u);
+    BOOST_REQUIRE_EQUAL(offsets.size(), ids.size()+1);
+    BOOST_CHECK_EQUAL(offsets[0], 0u);
+    BOOST_CHECK_EQUAL(offsets[1], 2u);
+    BOOST_CHECK_EQUAL(offsets[2], 5u);
+    BOOST_CHECK_EQUAL(offsets[3], 9u);
+    BOOST_CHECK_EQUAL(offsets[4], 9u);
+    BOOST_CHECK_EQUAL(string(buffer.data(), size), string(size, 'A'));
+
+    CScope::TSeqRanges ranges;
+    ranges.push_back(TSeqRange(1, 1));
+    ranges.push_back(TSeqRange::GetEmpty());
+    ranges.push_back(TSeqRange(1, 10));
+    ranges.push_back(TSeqRange::GetWhole());
+    size = scope.GetSequencesData(&offsets, buffer.data(), buffer.size(),
+                                  ids, &ranges);
+    BOOST_CHECK_EQUAL(size, 1u+3u);
+    BOOST_CHECK_EQUAL(offsets[1], 1u);
+    BOOST_CHECK_EQUAL(offsets[2], 1u);
+    BOOST_CHECK_EQUAL(offsets[3], 4u);
+
+    BOOST_CHECK_THROW(scope.GetSequencesData(&offsets, buffer.data(), 4, ids),
+                      CObjMgrException);
+    BOOST_CHECK_THROW(scope.GetSequencesData(&offsets, buffer.data(),
+                                             buffer.size(), ids, 0,
+                                             CBioseq_Handle::eCoding_Iupac,
+                                             CScope::fThrowOnMissing),
+                      CObjMgrException);
+}
@@ -100,6 +100,14 @@ CBioseq_set_Info& ITSE_Assigner::x_GetBioseq_set(CTSE_Info& tse_info,
         return x_GetBioseq_set(tse_info, place.second);
     }
 }
+
+
+bool ITSE_Assigner::UnloadSequence(CTSE_Info& /*tse*/,
+                                   const TLocationSet& /*location*/,
+                                   CTSE_Chunk_Info& /*chunk*/)
+{
+    return false;
+}
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
@@ -262,6 +270,31 @@ void CTSE_Default_Assigner::LoadSequence(CTSE_Info& tse,
     }
 }
 
+bool CTSE_Default_Assigner::UnloadSequence(CTSE_Info& tse,
+                                           const TLocationSet& locations,
+                                           CTSE_Chunk_Info& chunk)
+{
+    ITERATE ( TLocationSet, it, locations ) {
+        // once the Bioseq is updated its Seq-inst holds the loaded data too,
+        // so unloading from CSeqMap alone would free nothing
+        if ( !x_GetBioseq(tse, it->first).x_NeedUpdate(
+                 CTSE_Info_Object::fNeedUpdate_seq_data) ) {
+            return false;
+        }
+    }
+    bool unloaded = false;
+    ITERATE ( TLocationSet, it, locations ) {
+        CSeqMap& seq_map =
+            const_cast<CSeqMap&>(x_GetBioseq(tse, it->first).GetSeqMap());
+        if ( seq_map.UnloadSeq_data(chunk,
+                                    it->second.GetFrom(),
+                                    it->second.GetLength()) ) {
+            unloaded = true;
+        }
+    }
+    return unloaded;
+}
+
 void CTSE_Default_Assigner::LoadAssembly(CTSE_Info& tse,
                                          const TBioseqId& seq_id,
                                          const TAssembly& assembly)
@@ -68,6 +68,8 @@ CTSE_Chunk_Info::CTSE_Chunk_Info(TChunkId id)
       m_ChunkId(id),
       m_LoadBytes(0),
       m_LoadSeconds(0),
+      m_UsedMemory(0),
+      m_UnloadCount(0),
       m_ExplicitFeatIds(false)
 {
 }
@@ -788,10 +790,38 @@ void CTSE_Chunk_Info::x_LoadSeq_entry(CSeq_entry& entry,
 void CTSE_Chunk_Info::x_AddUsedMemory(size_t size)
 {
     _ASSERT(x_Attached());
+    m_UsedMemory += size;
     m_SplitInfo->x_AddUsedMemory(size);
 }
 
 
+bool CTSE_Chunk_Info::x_CanUnload(void) const
+{
+    if ( m_ChunkId == kMain_ChunkId ||
+         m_ChunkId == kMasterWGS_ChunkId ||
+         m_ChunkId == kDelayedMain_ChunkId ) {
+        return false;
+    }
+    return !m_Seq_data.empty() &&
+        m_DescInfos.empty() &&
+        m_AnnotPlaces.empty() &&
+        m_BioseqPlaces.empty() &&
+        m_BioseqIds.empty() &&
+        m_AnnotContents.empty() &&
+        m_AssemblyInfos.empty() &&
+        m_ObjectIndexList.empty();
+}
+
+
+void CTSE_Chunk_Info::x_SetUnloaded(void)
+{
+    _ASSERT(IsLoaded());
+    m_LoadLock.Reset();
+    m_UsedMemory = 0;
+    ++m_UnloadCount;
+}
+
+
 void CTSE_Chunk_Info::x_SetLoadBytes(Uint4 bytes)
 {
     m_LoadBytes = bytes;
@@ -295,6 +295,7 @@ void CTSE_Info::x_Initialize(void)
     m_UsedMemory = 0;
     m_LoadState = eNotLoaded;
     m_CacheState = eNotInCache;
+    m_CacheMemory = 0;
     m_AnnotIdsFlags = 0;
 }
 
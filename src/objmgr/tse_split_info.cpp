@@ -744,6 +744,35 @@ void CTSE_Split_Info::x_AddUsedMemory(size_t size)
 }
 
 
+size_t CTSE_Split_Info::x_UnloadChunks(size_t& unloaded_count)
+{
+    CMutexGuard guard(m_AttachMutex);
+    if ( m_TSE_Set.size() != 1 ) {
+        // the chunk data is shared with other TSEs
+        return 0;
+    }
+    CTSE_Info& tse = *m_TSE_Set.begin()->first;
+    ITSE_Assigner& listener = *m_TSE_Set.begin()->second;
+    size_t freed = 0;
+    CMutexGuard guard2(m_ChunksMutex);
+    NON_CONST_ITERATE ( TChunks, it, m_Chunks ) {
+        CTSE_Chunk_Info& chunk = *it->second;
+        if ( !chunk.IsLoaded() || !chunk.x_CanUnload() ) {
+            continue;
+        }
+        if ( !listener.UnloadSequence(tse, chunk.GetSeq_dataInfos(), chunk) ) {
+            continue;
+        }
+        size_t memory = min(chunk.GetUsedMemory(), tse.GetUsedMemory());
+        tse.SetUsedMemory(tse.GetUsedMemory() - memory);
+        chunk.x_SetUnloaded();
+        freed += memory;
+        ++unloaded_count;
+    }
+    return freed;
+}
+
+
 void CTSE_Split_Info::x_SetBioseqUpdater(CRef<CBioseqUpdater> updater)
 {
     NON_CONST_ITERATE ( TTSE_Set, it, m_TSE_Set ) {
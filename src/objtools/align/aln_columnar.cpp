@@ -0,0 +1,1110 @@
+/*  $Id$
+ * ===========================================================================
+ *
+ *                            PUBLIC DOMAIN NOTICE
+ *               National Center for Biotechnology Information
+ *
+ *  This software/database is a "United States Government Work" under the
+ *  terms of the United States Copyright Act.  It was written as part of
+ *  the author's official duties as a United States Government employee and
+ *  thus cannot be copyrighted.  This software/database is freely available
+ *  to the public for use. The National Library of Medicine and the U.S.
+ *  Government have not placed any restriction on its use or reproduction.
+ *
+ *  Although all reasonable efforts have been taken to ensure the accuracy
+ *  and reliability of the software and data, the NLM and the U.S.
+ *  Government do not and cannot warrant the performance or results that
+ *  may be obtained by using this software or data. The NLM and the U.S.
+ *  Government disclaim all warranties, express or implied, including
+ *  warranties of performance, merchantability or fitness for any particular
+ *  purpose.
+ *
+ *  Please cite the author in any work or product based on this material.
+ *
+ * ===========================================================================
+ *
+ * Author:  agent
+ *
+ * File Description:
+ *   Compact columnar container format for sets of Seq-aligns
+ *
+ */
+
+#include <ncbi_pch.hpp>
+#include <objtools/align/aln_columnar.hpp>
+#include <serial/serial.hpp>
+#include <serial/objistr.hpp>
+#include <serial/objostr.hpp>
+#include <serial/objectio.hpp>
+#include <objects/seqalign/Dense_seg.hpp>
+#include <objects/seqalign/Score.hpp>
+#include <objects/seqloc/Seq_id.hpp>
+#include <objects/general/Object_id.hpp>
+#include <util/compress/zstd.hpp>
+
+BEGIN_NCBI_SCOPE
+BEGIN_SCOPE(objects)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Format
+//
+// File header: kMagic.
+// Block: align count, column count, columns; block with zero align count
+// marks end of data.
+// Column: column id, compression, raw size, stored size, data.
+// Numbers are unsigned variable length (7 bits per byte, low bits first),
+// signed numbers are zigzag encoded.
+
+static const char kMagic[8] = { 'N', 'C', 'B', 'I', 'A', 'L', 'C', '1' };
+
+// sanity limit of column size, checked before allocating memory for it
+static const Uint8 kMaxColumnSize = 1 << 30;
+// stored column data is read in chunks of this size,
+// so that truncated data fails before allocating the whole column
+static const size_t kReadChunkSize = 1 << 20;
+
+enum EColumn {
+    eColumn_Kind,        // EAlignKind of each alignment
+    eColumn_Flags,       // EAlignFlags of each Dense-seg alignment
+    eColumn_Type,        // Seq-align.type
+    eColumn_AlignDim,    // Seq-align.dim, if fAlignDim
+    eColumn_Dim,         // Dense-seg.dim
+    eColumn_Numseg,      // Dense-seg.numseg
+    eColumn_IdRefs,      // Seq-id dictionary index for each row
+    eColumn_Starts,      // by row: 0 for gap, or delta from row's
+                         // previous start, zigzag encoded, plus 1
+    eColumn_Lens,        // Dense-seg.lens
+    eColumn_Strands,     // Dense-seg.strands as bytes, if fStrands
+    eColumn_ScoreCount,  // number of scores, if fScore
+    eColumn_ScoreRefs,   // score id dictionary index * 2 + (value is real)
+    eColumn_ScoreInts,   // integer score values
+    eColumn_ScoreReals,  // real score values, 8 bytes little endian
+    eColumn_IdDict,      // count, then ASN.1 binary Seq-ids
+    eColumn_ScoreIdDict, // EScoreIdKind, then integer or length and chars
+    eColumn_AsnSizes,    // ASN.1 binary size of each ASN.1 alignment
+    eColumn_AsnAligns,   // ASN.1 binary Seq-aligns
+    eColumn_Count
+};
+
+enum ECompression {
+    eCompression_None,
+    eCompression_Zstd
+};
+
+enum EAlignKind {
+    eAlignKind_DenseSeg,
+    eAlignKind_Asn
+};
+
+enum EAlignFlags {
+    fAlignDim = 1 << 0, // Seq-align.dim is set
+    fDenseDim = 1 << 1, // Dense-seg.dim is set
+    fStrands  = 1 << 2, // Dense-seg.strands is set
+    fScore    = 1 << 3  // Seq-align.score is set
+};
+
+enum EScoreIdKind {
+    eScoreId_None,
+    eScoreId_Id,
+    eScoreId_Str
+};
+
+// Minimal column size to try compression
+static const size_t kMinCompressSize = 64;
+
+
+static inline
+void s_PutUint(string& dst, Uint8 value)
+{
+    while ( value >= 0x80 ) {
+        dst += char(value | 0x80);
+        value >>= 7;
+    }
+    dst += char(value);
+}
+
+
+static inline
+Uint8 s_EncodeInt(Int8 value)
+{
+    return (Uint8(value) << 1) ^ Uint8(value >> 63);
+}
+
+
+static inline
+void s_PutInt(string& dst, Int8 value)
+{
+    s_PutUint(dst, s_EncodeInt(value));
+}
+
+
+static inline
+Int8 s_DecodeInt(Uint8 value)
+{
+    return Int8(value >> 1) ^ -Int8(value & 1);
+}
+
+
+static inline
+void s_PutDouble(string& dst, double value)
+{
+    Uint8 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for ( int i = 0; i < 8; ++i ) {
+        dst += char(bits >> (8*i));
+    }
+}
+
+
+static void s_WriteUint(CNcbiOstream& out, Uint8 value)
+{
+    string s;
+    s_PutUint(s, value);
+    out.write(s.data(), s.size());
+}
+
+
+static Uint8 s_ReadUint(CNcbiIstream& in)
+{
+    Uint8 value = 0;
+    for ( int shift = 0; shift < 64; shift += 7 ) {
+        int c = in.get();
+        if ( c == EOF ) {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "unexpected end of columnar data");
+        }
+        value |= Uint8(c & 0x7f) << shift;
+        if ( !(c & 0x80) ) {
+            return value;
+        }
+    }
+    NCBI_THROW(CAlnColumnarException, eFormatError,
+               "bad number in columnar data");
+}
+
+
+static void s_AppendAsn(string& dst, const CSerialObject& obj)
+{
+    CNcbiOstrstream str;
+    {{
+        unique_ptr<CObjectOStream> out
+            (CObjectOStream::Open(eSerial_AsnBinary, str));
+        *out << obj;
+    }}
+    dst += CNcbiOstrstreamToString(str);
+}
+
+
+// Sequential reader of decoded column data
+class CAlnColumnReader
+{
+public:
+    CAlnColumnReader(const string& data)
+        : m_Ptr(data.data()), m_End(data.data()+data.size())
+        {
+        }
+
+    bool AtEnd(void) const
+        {
+            return m_Ptr == m_End;
+        }
+    size_t GetRemaining(void) const
+        {
+            return m_End - m_Ptr;
+        }
+    const char* GetBytes(size_t size)
+        {
+            if ( size > GetRemaining() ) {
+                x_Error();
+            }
+            const char* ret = m_Ptr;
+            m_Ptr += size;
+            return ret;
+        }
+    Uint1 GetByte(void)
+        {
+            if ( m_Ptr == m_End ) {
+                x_Error();
+            }
+            return Uint1(*m_Ptr++);
+        }
+    Uint8 GetUint(void)
+        {
+            Uint8 value = 0;
+            for ( int shift = 0; shift < 64; shift += 7 ) {
+                Uint1 c = GetByte();
+                value |= Uint8(c & 0x7f) << shift;
+                if ( !(c & 0x80) ) {
+                    return value;
+                }
+            }
+            x_Error();
+            return 0;
+        }
+    Int8 GetInt(void)
+        {
+            return s_DecodeInt(GetUint());
+        }
+    double GetDouble(void)
+        {
+            const char* ptr = GetBytes(8);
+            Uint8 bits = 0;
+            for ( int i = 0; i < 8; ++i ) {
+                bits |= Uint8(Uint1(ptr[i])) << (8*i);
+            }
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    // check that column has at least 'count' more values, each of them
+    // occupies at least one byte
+    void CheckCount(Uint8 count) const
+        {
+            if ( count > GetRemaining() ) {
+                x_Error();
+            }
+        }
+
+private:
+    NCBI_NORETURN static void x_Error(void)
+        {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "truncated column in columnar data");
+        }
+
+    const char* m_Ptr;
+    const char* m_End;
+};
+
+
+const char* CAlnColumnarException::GetErrCodeString(void) const
+{
+    switch ( GetErrCode() ) {
+    case eFormatError:      return "eFormatError";
+    case eCompressionError: return "eCompressionError";
+    case eIOError:          return "eIOError";
+    default:                return CException::GetErrCodeString();
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// CAlnColumnarWriter
+/////////////////////////////////////////////////////////////////////////////
+
+struct CAlnColumnarWriter::SBlock
+{
+    SBlock(void)
+        : m_AlignCount(0)
+        {
+        }
+
+    size_t m_AlignCount;
+    string m_Columns[eColumn_Count];
+    // Seq-id dictionary, indexed by FASTA string for lookup
+    vector< CConstRef<CSeq_id> > m_Ids;
+    multimap<string, size_t> m_IdIndex;
+    // score id dictionary, indexed by encoded entry
+    map<string, size_t> m_ScoreIdIndex;
+};
+
+
+CAlnColumnarWriter::CAlnColumnarWriter(CNcbiOstream& out, TFlags flags)
+    : m_Out(out),
+      m_Flags(flags),
+      m_BlockSize(10000),
+      m_Closed(false),
+      m_Block(new SBlock)
+{
+    m_Out.write(kMagic, sizeof(kMagic));
+}
+
+
+CAlnColumnarWriter::~CAlnColumnarWriter(void)
+{
+    if ( !m_Closed ) {
+        try {
+            Close();
+        }
+        catch ( exception& exc ) {
+            ERR_POST("CAlnColumnarWriter: " << exc.what());
+        }
+    }
+}
+
+
+void CAlnColumnarWriter::SetBlockSize(size_t block_size)
+{
+    m_BlockSize = max(block_size, size_t(1));
+}
+
+
+size_t CAlnColumnarWriter::GetBlockSize(void) const
+{
+    return m_BlockSize;
+}
+
+
+static bool s_IsColumnar(const CSeq_align& align)
+{
+    if ( !align.IsSetType() || !align.IsSetSegs() ||
+         !align.GetSegs().IsDenseg() ||
+         align.IsSetBounds() || align.IsSetId() || align.IsSetExt() ) {
+        return false;
+    }
+    if ( Uint4(align.GetType()) > 0xff ) {
+        return false;
+    }
+    if ( align.IsSetScore() ) {
+        ITERATE ( CSeq_align::TScore, it, align.GetScore() ) {
+            const CScore& score = **it;
+            if ( !score.IsSetValue() ||
+                 !(score.GetValue().IsInt() || score.GetValue().IsReal()) ) {
+                return false;
+            }
+            if ( score.IsSetId() &&
+                 !(score.GetId().IsId() || score.GetId().IsStr()) ) {
+                return false;
+            }
+        }
+    }
+    const CDense_seg& ds = align.GetSegs().GetDenseg();
+    if ( ds.IsSetScores() || !ds.IsSetNumseg() ||
+         ds.GetDim() < 0 || ds.GetNumseg() < 0 ) {
+        return false;
+    }
+    size_t dim = ds.GetDim();
+    size_t numseg = ds.GetNumseg();
+    if ( ds.GetIds().size() != dim ||
+         ds.GetStarts().size() != dim*numseg ||
+         ds.GetLens().size() != numseg ) {
+        return false;
+    }
+    if ( ds.IsSetStrands() ) {
+        if ( ds.GetStrands().size() != dim*numseg ) {
+            return false;
+        }
+        ITERATE ( CDense_seg::TStrands, it, ds.GetStrands() ) {
+            if ( Uint4(*it) > 0xff ) {
+                return false;
+            }
+        }
+    }
+    ITERATE ( CDense_seg::TIds, it, ds.GetIds() ) {
+        if ( !*it ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void CAlnColumnarWriter::Write(const CSeq_align& align)
+{
+    _ASSERT(!m_Closed);
+    if ( s_IsColumnar(align) ) {
+        x_WriteDenseSeg(align);
+    }
+    else {
+        x_WriteAsn(align);
+    }
+    if ( ++m_Block->m_AlignCount >= m_BlockSize ) {
+        Flush();
+    }
+}
+
+
+void CAlnColumnarWriter::Write(const CSeq_align_set& aligns)
+{
+    ITERATE ( CSeq_align_set::Tdata, it, aligns.Get() ) {
+        Write(**it);
+    }
+}
+
+
+void CAlnColumnarWriter::CopyFromAsn(CObjectIStream& in)
+{
+    TTypeInfo type = CSeq_align_set::GetTypeInfo();
+    in.SkipFileHeader(type);
+    for ( CIStreamContainerIterator it(in, CObjectTypeInfo(type)); it; ++it ) {
+        CRef<CSeq_align> align(new CSeq_align);
+        it >> *align;
+        Write(*align);
+    }
+    in.EndOfRead();
+}
+
+
+size_t CAlnColumnarWriter::x_GetIdIndex(const CSeq_id& id)
+{
+    SBlock& block = *m_Block;
+    string key = id.AsFastaString();
+    typedef multimap<string, size_t>::const_iterator TIter;
+    pair<TIter, TIter> range = block.m_IdIndex.equal_range(key);
+    for ( TIter it = range.first; it != range.second; ++it ) {
+        if ( block.m_Ids[it->second]->Equals(id) ) {
+            return it->second;
+        }
+    }
+    size_t index = block.m_Ids.size();
+    block.m_Ids.push_back(ConstRef(&id));
+    block.m_IdIndex.insert(make_pair(key, index));
+    return index;
+}
+
+
+size_t CAlnColumnarWriter::x_GetScoreIdIndex(const CObject_id* id)
+{
+    SBlock& block = *m_Block;
+    string entry;
+    if ( !id ) {
+        entry += char(eScoreId_None);
+    }
+    else if ( id->IsId() ) {
+        entry += char(eScoreId_Id);
+        s_PutInt(entry, id->GetId());
+    }
+    else {
+        entry += char(eScoreId_Str);
+        s_PutUint(entry, id->GetStr().size());
+        entry += id->GetStr();
+    }
+    pair<map<string, size_t>::iterator, bool> ins =
+        block.m_ScoreIdIndex.insert(make_pair(entry, block.m_ScoreIdIndex.size()));
+    if ( ins.second ) {
+        block.m_Columns[eColumn_ScoreIdDict] += entry;
+    }
+    return ins.first->second;
+}
+
+
+void CAlnColumnarWriter::x_WriteDenseSeg(const CSeq_align& align)
+{
+    string* columns = m_Block->m_Columns;
+    const CDense_seg& ds = align.GetSegs().GetDenseg();
+    size_t dim = ds.GetDim();
+    size_t numseg = ds.GetNumseg();
+
+    Uint1 flags = 0;
+    if ( align.IsSetDim() ) {
+        flags |= fAlignDim;
+    }
+    if ( ds.IsSetDim() ) {
+        flags |= fDenseDim;
+    }
+    if ( ds.IsSetStrands() ) {
+        flags |= fStrands;
+    }
+    if ( align.IsSetScore() ) {
+        flags |= fScore;
+    }
+    columns[eColumn_Kind] += char(eAlignKind_DenseSeg);
+    columns[eColumn_Flags] += char(flags);
+    columns[eColumn_Type] += char(align.GetType());
+    if ( flags & fAlignDim ) {
+        s_PutInt(columns[eColumn_AlignDim], align.GetDim());
+    }
+    s_PutUint(columns[eColumn_Dim], dim);
+    s_PutUint(columns[eColumn_Numseg], numseg);
+
+    ITERATE ( CDense_seg::TIds, it, ds.GetIds() ) {
+        s_PutUint(columns[eColumn_IdRefs], x_GetIdIndex(**it));
+    }
+    const CDense_seg::TStarts& starts = ds.GetStarts();
+    string& starts_column = columns[eColumn_Starts];
+    for ( size_t row = 0; row < dim; ++row ) {
+        Int8 prev = 0;
+        for ( size_t seg = 0; seg < numseg; ++seg ) {
+            TSignedSeqPos start = starts[seg*dim+row];
+            if ( start == -1 ) {
+                starts_column += '\0';
+            }
+            else {
+                s_PutUint(starts_column, s_EncodeInt(start-prev)+1);
+                prev = start;
+            }
+        }
+    }
+    ITERATE ( CDense_seg::TLens, it, ds.GetLens() ) {
+        s_PutUint(columns[eColumn_Lens], *it);
+    }
+    if ( flags & fStrands ) {
+        ITERATE ( CDense_seg::TStrands, it, ds.GetStrands() ) {
+            columns[eColumn_Strands] += char(*it);
+        }
+    }
+    if ( flags & fScore ) {
+        s_PutUint(columns[eColumn_ScoreCount], align.GetScore().size());
+        ITERATE ( CSeq_align::TScore, it, align.GetScore() ) {
+            const CScore& score = **it;
+            size_t ref = x_GetScoreIdIndex(score.IsSetId()? &score.GetId(): 0);
+            if ( score.GetValue().IsReal() ) {
+                s_PutUint(columns[eColumn_ScoreRefs], ref*2+1);
+                s_PutDouble(columns[eColumn_ScoreReals],
+                            score.GetValue().GetReal());
+            }
+            else {
+                s_PutUint(columns[eColumn_ScoreRefs], ref*2);
+                s_PutInt(columns[eColumn_ScoreInts],
+                         score.GetValue().GetInt());
+            }
+        }
+    }
+}
+
+
+void CAlnColumnarWriter::x_WriteAsn(const CSeq_align& align)
+{
+    string* columns = m_Block->m_Columns;
+    columns[eColumn_Kind] += char(eAlignKind_Asn);
+    size_t old_size = columns[eColumn_AsnAligns].size();
+    s_AppendAsn(columns[eColumn_AsnAligns], align);
+    s_PutUint(columns[eColumn_AsnSizes],
+              columns[eColumn_AsnAligns].size() - old_size);
+}
+
+
+void CAlnColumnarWriter::x_WriteColumn(int column, const string& data)
+{
+    Uint1 compression = eCompression_None;
+    string compressed;
+#if defined(HAVE_LIBZSTD)
+    if ( (m_Flags & fCompressZstd) && data.size() >= kMinCompressSize ) {
+        CZstdCompression zstd;
+        compressed.resize(zstd.EstimateCompressionBufferSize(data.size()));
+        size_t size = 0;
+        if ( zstd.CompressBuffer(data.data(), data.size(),
+                                 &compressed[0], compressed.size(), &size) &&
+             size < data.size() ) {
+            compressed.resize(size);
+            compression = eCompression_Zstd;
+        }
+    }
+#endif
+    const string& stored =
+        compression == eCompression_None? data: compressed;
+    s_WriteUint(m_Out, column);
+    m_Out.put(char(compression));
+    s_WriteUint(m_Out, data.size());
+    s_WriteUint(m_Out, stored.size());
+    m_Out.write(stored.data(), stored.size());
+}
+
+
+void CAlnColumnarWriter::Flush(void)
+{
+    SBlock& block = *m_Block;
+    if ( !block.m_AlignCount ) {
+        return;
+    }
+    string& id_dict = block.m_Columns[eColumn_IdDict];
+    s_PutUint(id_dict, block.m_Ids.size());
+    if ( !block.m_Ids.empty() ) {
+        CNcbiOstrstream str;
+        {{
+            unique_ptr<CObjectOStream> out
+                (CObjectOStream::Open(eSerial_AsnBinary, str));
+            ITERATE ( vector< CConstRef<CSeq_id> >, it, block.m_Ids ) {
+                *out << **it;
+            }
+        }}
+        id_dict += CNcbiOstrstreamToString(str);
+    }
+
+    size_t column_count = 0;
+    for ( int i = 0; i < eColumn_Count; ++i ) {
+        if ( !block.m_Columns[i].empty() ) {
+            ++column_count;
+        }
+    }
+    s_WriteUint(m_Out, block.m_AlignCount);
+    s_WriteUint(m_Out, column_count);
+    for ( int i = 0; i < eColumn_Count; ++i ) {
+        if ( !block.m_Columns[i].empty() ) {
+            x_WriteColumn(i, block.m_Columns[i]);
+        }
+    }
+    if ( !m_Out ) {
+        NCBI_THROW(CAlnColumnarException, eIOError,
+                   "failed to write columnar data");
+    }
+    m_Block.reset(new SBlock);
+}
+
+
+void CAlnColumnarWriter::Close(void)
+{
+    if ( m_Closed ) {
+        return;
+    }
+    Flush();
+    s_WriteUint(m_Out, 0);
+    m_Out.flush();
+    m_Closed = true;
+    if ( !m_Out ) {
+        NCBI_THROW(CAlnColumnarException, eIOError,
+                   "failed to write columnar data");
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// CAlnColumnarReader
+/////////////////////////////////////////////////////////////////////////////
+
+struct CAlnColumnarReader::SBlock
+{
+    struct SAlign {
+        Uint1  m_Kind;
+        Uint1  m_Flags;
+        Uint1  m_Type;
+        int    m_AlignDim;
+        size_t m_Dim;
+        size_t m_Numseg;
+        size_t m_IdPos;     // in m_IdRefs
+        size_t m_SegPos;    // in m_Starts
+        size_t m_LensPos;   // in m_Lens
+        size_t m_StrandPos; // in m_Strands
+        size_t m_ScorePos;  // in m_Scores
+        size_t m_ScoreCount;
+        size_t m_AsnPos;    // in ASN.1 column
+        size_t m_AsnSize;
+    };
+    struct SScore {
+        size_t m_Id;
+        bool   m_IsReal;
+        int    m_Int;
+        double m_Real;
+    };
+
+    string m_Columns[eColumn_Count];
+    vector<SAlign> m_Aligns;
+    vector< CRef<CSeq_align> > m_Created;
+    vector< CRef<CSeq_id> > m_Ids;
+    vector< CRef<CObject_id> > m_ScoreIds; // null if score has no id
+    vector<size_t> m_IdRefs;
+    vector<TSignedSeqPos> m_Starts;
+    vector<TSeqPos> m_Lens;
+    vector<Uint1> m_Strands;
+    vector<SScore> m_Scores;
+};
+
+
+CAlnColumnarReader::CAlnColumnarReader(CNcbiIstream& in)
+    : m_In(in),
+      m_EndOfData(false),
+      m_Block(new SBlock)
+{
+    char magic[sizeof(kMagic)];
+    if ( !m_In.read(magic, sizeof(magic)) ||
+         memcmp(magic, kMagic, sizeof(magic)) != 0 ) {
+        NCBI_THROW(CAlnColumnarException, eFormatError,
+                   "not a columnar alignment data");
+    }
+}
+
+
+CAlnColumnarReader::~CAlnColumnarReader(void)
+{
+}
+
+
+bool CAlnColumnarReader::ReadBlock(void)
+{
+    m_Block.reset(new SBlock);
+    if ( m_EndOfData ) {
+        return false;
+    }
+    Uint8 align_count = s_ReadUint(m_In);
+    if ( !align_count ) {
+        m_EndOfData = true;
+        return false;
+    }
+    SBlock& block = *m_Block;
+    for ( Uint8 column_count = s_ReadUint(m_In); column_count; --column_count ) {
+        Uint8 column = s_ReadUint(m_In);
+        int compression = m_In.get();
+        Uint8 raw_size = s_ReadUint(m_In);
+        Uint8 stored_size = s_ReadUint(m_In);
+        if ( raw_size > kMaxColumnSize || stored_size > kMaxColumnSize ) {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "column size is too big");
+        }
+        if ( compression == eCompression_None && stored_size != raw_size ) {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "wrong column size");
+        }
+        string stored;
+        while ( stored.size() < stored_size ) {
+            size_t pos = stored.size();
+            size_t size = min(size_t(stored_size-pos), kReadChunkSize);
+            stored.resize(pos+size);
+            if ( !m_In.read(&stored[pos], size) ) {
+                NCBI_THROW(CAlnColumnarException, eFormatError,
+                           "unexpected end of columnar data");
+            }
+        }
+        if ( column >= eColumn_Count ) {
+            // unknown column, written by newer version of the writer
+            continue;
+        }
+        string& data = block.m_Columns[column];
+        if ( compression == eCompression_None ) {
+            data.swap(stored);
+        }
+        else if ( compression == eCompression_Zstd ) {
+#if defined(HAVE_LIBZSTD)
+            CZstdCompression zstd;
+            data.resize(size_t(raw_size));
+            size_t size = 0;
+            if ( !zstd.DecompressBuffer(stored.data(), stored.size(),
+                                        &data[0], data.size(), &size) ||
+                 size != raw_size ) {
+                NCBI_THROW(CAlnColumnarException, eCompressionError,
+                           "failed to decompress zstd column");
+            }
+#else
+            NCBI_THROW(CAlnColumnarException, eCompressionError,
+                       "zstd compression is not supported");
+#endif
+        }
+        else {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "unknown column compression");
+        }
+        if ( data.size() != raw_size ) {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "wrong column size");
+        }
+    }
+    if ( align_count > block.m_Columns[eColumn_Kind].size() ) {
+        NCBI_THROW(CAlnColumnarException, eFormatError,
+                   "wrong alignment count");
+    }
+    block.m_Aligns.resize(size_t(align_count));
+    block.m_Created.resize(size_t(align_count));
+    x_DecodeColumns();
+    return true;
+}
+
+
+void CAlnColumnarReader::x_DecodeColumns(void)
+{
+    SBlock& block = *m_Block;
+    const string* columns = block.m_Columns;
+
+    // dictionaries
+    if ( !columns[eColumn_IdDict].empty() ) {
+        CAlnColumnReader dict(columns[eColumn_IdDict]);
+        Uint8 count = dict.GetUint();
+        dict.CheckCount(count);
+        if ( count ) {
+            size_t size = dict.GetRemaining();
+            unique_ptr<CObjectIStream> in
+                (CObjectIStream::CreateFromBuffer(eSerial_AsnBinary,
+                                                  dict.GetBytes(size), size));
+            block.m_Ids.reserve(size_t(count));
+            for ( ; count; --count ) {
+                CRef<CSeq_id> id(new CSeq_id);
+                *in >> *id;
+                block.m_Ids.push_back(id);
+            }
+        }
+    }
+    for ( CAlnColumnReader dict(columns[eColumn_ScoreIdDict]);
+          !dict.AtEnd(); ) {
+        CRef<CObject_id> id;
+        switch ( dict.GetByte() ) {
+        case eScoreId_None:
+            break;
+        case eScoreId_Id:
+            id = new CObject_id;
+            id->SetId(int(dict.GetInt()));
+            break;
+        case eScoreId_Str:
+        {
+            size_t size = size_t(dict.GetUint());
+            id = new CObject_id;
+            id->SetStr().assign(dict.GetBytes(size), size);
+            break;
+        }
+        default:
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "bad score id dictionary");
+        }
+        block.m_ScoreIds.push_back(id);
+    }
+
+    CAlnColumnReader kinds(columns[eColumn_Kind]);
+    CAlnColumnReader flags(columns[eColumn_Flags]);
+    CAlnColumnReader types(columns[eColumn_Type]);
+    CAlnColumnReader align_dims(columns[eColumn_AlignDim]);
+    CAlnColumnReader dims(columns[eColumn_Dim]);
+    CAlnColumnReader numsegs(columns[eColumn_Numseg]);
+    CAlnColumnReader id_refs(columns[eColumn_IdRefs]);
+    CAlnColumnReader starts(columns[eColumn_Starts]);
+    CAlnColumnReader lens(columns[eColumn_Lens]);
+    CAlnColumnReader strands(columns[eColumn_Strands]);
+    CAlnColumnReader score_counts(columns[eColumn_ScoreCount]);
+    CAlnColumnReader score_refs(columns[eColumn_ScoreRefs]);
+    CAlnColumnReader score_ints(columns[eColumn_ScoreInts]);
+    CAlnColumnReader score_reals(columns[eColumn_ScoreReals]);
+    CAlnColumnReader asn_sizes(columns[eColumn_AsnSizes]);
+    size_t asn_pos = 0;
+    NON_CONST_ITERATE ( vector<SBlock::SAlign>, it, block.m_Aligns ) {
+        SBlock::SAlign& align = *it;
+        align.m_Kind = kinds.GetByte();
+        if ( align.m_Kind == eAlignKind_Asn ) {
+            align.m_AsnPos = asn_pos;
+            align.m_AsnSize = size_t(asn_sizes.GetUint());
+            if ( align.m_AsnSize >
+                 columns[eColumn_AsnAligns].size() - asn_pos ) {
+                NCBI_THROW(CAlnColumnarException, eFormatError,
+                           "truncated ASN.1 alignments column");
+            }
+            asn_pos += align.m_AsnSize;
+            continue;
+        }
+        if ( align.m_Kind != eAlignKind_DenseSeg ) {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "unknown alignment kind");
+        }
+        align.m_Flags = flags.GetByte();
+        align.m_Type = types.GetByte();
+        align.m_AlignDim = 0;
+        if ( align.m_Flags & fAlignDim ) {
+            align.m_AlignDim = int(align_dims.GetInt());
+        }
+        Uint8 dim = dims.GetUint();
+        Uint8 numseg = numsegs.GetUint();
+        id_refs.CheckCount(dim);
+        lens.CheckCount(numseg);
+        if ( numseg && dim > starts.GetRemaining()/numseg ) {
+            NCBI_THROW(CAlnColumnarException, eFormatError,
+                       "truncated starts column");
+        }
+        align.m_Dim = size_t(dim);
+        align.m_Numseg = size_t(numseg);
+        size_t size = align.m_Dim*align.m_Numseg;
+
+        align.m_IdPos = block.m_IdRefs.size();
+        for ( size_t row = 0; row < align.m_Dim; ++row ) {
+            Uint8 ref = id_refs.GetUint();
+            if ( ref >= block.m_Ids.size() ) {
+                NCBI_THROW(CAlnColumnarException, eFormatError,
+                           "bad Seq-id reference");
+            }
+            block.m_IdRefs.push_back(size_t(ref));
+        }
+
+        align.m_SegPos = block.m_Starts.size();
+        block.m_Starts.resize(align.m_SegPos+size);
+        TSignedSeqPos* dst = &block.m_Starts[align.m_SegPos];
+        for ( size_t row = 0; row < align.m_Dim; ++row ) {
+            Int8 prev = 0;
+            for ( size_t seg = 0; seg < align.m_Numseg; ++seg ) {
+                Uint8 value = starts.GetUint();
+                if ( value == 0 ) {
+                    dst[seg*align.m_Dim+row] = -1;
+                }
+                else {
+                    prev += s_DecodeInt(value-1);
+                    dst[seg*align.m_Dim+row] = TSignedSeqPos(prev);
+                }
+            }
+        }
+
+        align.m_LensPos = block.m_Lens.size();
+        for ( size_t seg = 0; seg < align.m_Numseg; ++seg ) {
+            block.m_Lens.push_back(TSeqPos(lens.GetUint()));
+        }
+
+        align.m_StrandPos = block.m_Strands.size();
+        if ( align.m_Flags & fStrands ) {
+            const char* ptr = strands.GetBytes(size);
+            block.m_Strands.insert(block.m_Strands.end(), ptr, ptr+size);
+        }
+
+        align.m_ScorePos = block.m_Scores.size();
+        align.m_ScoreCount = 0;
+        if ( align.m_Flags & fScore ) {
+            Uint8 count = score_counts.GetUint();
+            score_refs.CheckCount(count);
+            align.m_ScoreCount = size_t(count);
+            for ( size_t i = 0; i < align.m_ScoreCount; ++i ) {
+                SBlock::SScore score;
+                Uint8 ref = score_refs.GetUint();
+                score.m_Id = size_t(ref >> 1);
+                if ( score.m_Id >= block.m_ScoreIds.size() ) {
+                    NCBI_THROW(CAlnColumnarException, eFormatError,
+                               "bad score id reference");
+                }
+                score.m_IsReal = (ref & 1) != 0;
+                score.m_Int = 0;
+                score.m_Real = 0;
+                if ( score.m_IsReal ) {
+                    score.m_Real = score_reals.GetDouble();
+                }
+                else {
+                    score.m_Int = int(score_ints.GetInt());
+                }
+                block.m_Scores.push_back(score);
+            }
+        }
+    }
+    if ( !kinds.AtEnd() || !flags.AtEnd() || !types.AtEnd() ||
+         !align_dims.AtEnd() || !dims.AtEnd() || !numsegs.AtEnd() ||
+         !id_refs.AtEnd() || !starts.AtEnd() || !lens.AtEnd() ||
+         !strands.AtEnd() || !score_counts.AtEnd() || !score_refs.AtEnd() ||
+         !score_ints.AtEnd() || !score_reals.AtEnd() || !asn_sizes.AtEnd() ||
+         asn_pos != columns[eColumn_AsnAligns].size() ) {
+        NCBI_THROW(CAlnColumnarException, eFormatError,
+                   "extra data in columns");
+    }
+}
+
+
+size_t CAlnColumnarReader::GetAlignCount(void) const
+{
+    return m_Block->m_Aligns.size();
+}
+
+
+bool CAlnColumnarReader::IsDenseSeg(size_t index) const
+{
+    return m_Block->m_Aligns.at(index).m_Kind == eAlignKind_DenseSeg;
+}
+
+
+size_t CAlnColumnarReader::GetDim(size_t index) const
+{
+    _ASSERT(IsDenseSeg(index));
+    return m_Block->m_Aligns.at(index).m_Dim;
+}
+
+
+size_t CAlnColumnarReader::GetNumseg(size_t index) const
+{
+    _ASSERT(IsDenseSeg(index));
+    return m_Block->m_Aligns.at(index).m_Numseg;
+}
+
+
+const CSeq_id& CAlnColumnarReader::GetSeq_id(size_t index, size_t row) const
+{
+    const SBlock::SAlign& align = m_Block->m_Aligns.at(index);
+    _ASSERT(IsDenseSeg(index));
+    _ASSERT(row < align.m_Dim);
+    return *m_Block->m_Ids[m_Block->m_IdRefs[align.m_IdPos+row]];
+}
+
+
+CRef<CSeq_align> CAlnColumnarReader::GetAlign(size_t index)
+{
+    CRef<CSeq_align>& ret = m_Block->m_Created.at(index);
+    if ( !ret ) {
+        ret = x_CreateAlign(index);
+    }
+    return ret;
+}
+
+
+CRef<CSeq_align> CAlnColumnarReader::x_CreateAlign(size_t index) const
+{
+    const SBlock& block = *m_Block;
+    const SBlock::SAlign& info = block.m_Aligns[index];
+    CRef<CSeq_align> align(new CSeq_align);
+    if ( info.m_Kind == eAlignKind_Asn ) {
+        unique_ptr<CObjectIStream> in
+            (CObjectIStream::CreateFromBuffer(eSerial_AsnBinary,
+                                              block.m_Columns[eColumn_AsnAligns].data()+info.m_AsnPos,
+                                              info.m_AsnSize));
+        *in >> *align;
+        return align;
+    }
+
+    align->SetType(CSeq_align::EType(info.m_Type));
+    if ( info.m_Flags & fAlignDim ) {
+        align->SetDim(info.m_AlignDim);
+    }
+    if ( info.m_Flags & fScore ) {
+        CSeq_align::TScore& scores = align->SetScore();
+        scores.reserve(info.m_ScoreCount);
+        for ( size_t i = 0; i < info.m_ScoreCount; ++i ) {
+            const SBlock::SScore& src = block.m_Scores[info.m_ScorePos+i];
+            CRef<CScore> score(new CScore);
+            if ( block.m_ScoreIds[src.m_Id] ) {
+                score->SetId(*block.m_ScoreIds[src.m_Id]);
+            }
+            if ( src.m_IsReal ) {
+                score->SetValue().SetReal(src.m_Real);
+            }
+            else {
+                score->SetValue().SetInt(src.m_Int);
+            }
+            scores.push_back(score);
+        }
+    }
+
+    CDense_seg& ds = align->SetSegs().SetDenseg();
+    if ( info.m_Flags & fDenseDim ) {
+        ds.SetDim(CDense_seg::TDim(info.m_Dim));
+    }
+    ds.SetNumseg(CDense_seg::TNumseg(info.m_Numseg));
+    CDense_seg::TIds& ids = ds.SetIds();
+    ids.reserve(info.m_Dim);
+    for ( size_t row = 0; row < info.m_Dim; ++row ) {
+        // own copy, so that the alignment can be modified safely
+        CRef<CSeq_id> id(new CSeq_id);
+        id->Assign(*block.m_Ids[block.m_IdRefs[info.m_IdPos+row]]);
+        ids.push_back(id);
+    }
+    size_t size = info.m_Dim*info.m_Numseg;
+    ds.SetStarts().assign(block.m_Starts.begin()+info.m_SegPos,
+                          block.m_Starts.begin()+info.m_SegPos+size);
+    ds.SetLens().assign(block.m_Lens.begin()+info.m_LensPos,
+                        block.m_Lens.begin()+info.m_LensPos+info.m_Numseg);
+    if ( info.m_Flags & fStrands ) {
+        CDense_seg::TStrands& strands = ds.SetStrands();
+        strands.reserve(size);
+        for ( size_t i = 0; i < size; ++i ) {
+            strands.push_back(ENa_strand(block.m_Strands[info.m_StrandPos+i]));
+        }
+    }
+    return align;
+}
+
+
+CRef<CSeq_align_set> CAlnColumnarReader::ReadAll(void)
+{
+    CRef<CSeq_align_set> aligns(new CSeq_align_set);
+    do {
+        for ( size_t i = 0; i < GetAlignCount(); ++i ) {
+            aligns->Set().push_back(GetAlign(i));
+        }
+    } while ( ReadBlock() );
+    return aligns;
+}
+
+
+void CAlnColumnarReader::CopyToAsn(CObjectOStream& out)
+{
+    TTypeInfo type = CSeq_align_set::GetTypeInfo();
+    out.WriteFileHeader(type);
+    {{
+        COStreamContainer container(out, CObjectTypeInfo(type));
+        do {
+            for ( size_t i = 0; i < GetAlignCount(); ++i ) {
+                container << *GetAlign(i);
+            }
+            // free alignments of the block as soon as they're written
+            m_Block->m_Created.clear();
+        } while ( ReadBlock() );
+    }}
+    out.EndOfWrite();
+}
+
+
+END_SCOPE(objects)
+END_NCBI_SCOPE
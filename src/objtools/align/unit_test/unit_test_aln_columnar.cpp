@@ -0,0 +1,291 @@
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Author:  agent
+*
+* File Description:
+*   Columnar Seq-align format unit test.
+*
+* ===========================================================================
+*/
+
+#include <ncbi_pch.hpp>
+
+#include <corelib/test_boost.hpp>
+
+#include <serial/serial.hpp>
+#include <serial/objistr.hpp>
+#include <serial/objostr.hpp>
+#include <objects/seqalign/Dense_seg.hpp>
+#include <objects/seqalign/Std_seg.hpp>
+#include <objects/seqalign/Score.hpp>
+#include <objects/seqloc/Seq_id.hpp>
+#include <objects/seqloc/Seq_loc.hpp>
+#include <objects/general/Object_id.hpp>
+
+#include <objtools/align/aln_columnar.hpp>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+
+USING_NCBI_SCOPE;
+USING_SCOPE(objects);
+
+
+static CRef<CSeq_align> s_MakeDenseSeg(int index)
+{
+    CRef<CSeq_align> align(new CSeq_align);
+    align->SetType(CSeq_align::eType_partial);
+    align->SetDim(2);
+    CDense_seg& ds = align->SetSegs().SetDenseg();
+    ds.SetDim(2);
+    ds.SetNumseg(3);
+    ds.SetIds().push_back(Ref(new CSeq_id("NC_000001.11")));
+    ds.SetIds().push_back(Ref(new CSeq_id(CSeq_id::e_Gi, GI_FROM(int, 1000+index%7))));
+    int starts[] = { 100+index, 5000-index, 120+index, -1, 130+index, 4900 };
+    ds.SetStarts().assign(starts, starts+6);
+    ds.SetLens().push_back(20);
+    ds.SetLens().push_back(10);
+    ds.SetLens().push_back(15+index);
+    if ( index % 2 ) {
+        for ( int i = 0; i < 3; ++i ) {
+            ds.SetStrands().push_back(eNa_strand_plus);
+            ds.SetStrands().push_back(eNa_strand_minus);
+        }
+    }
+    CRef<CScore> score(new CScore);
+    score->SetId().SetStr("score");
+    score->SetValue().SetInt(-index);
+    align->SetScore().push_back(score);
+    score.Reset(new CScore);
+    score->SetId().SetId(index%3);
+    score->SetValue().SetReal(index*0.5e-3);
+    align->SetScore().push_back(score);
+    score.Reset(new CScore);
+    score->SetValue().SetInt(index*1000);
+    align->SetScore().push_back(score);
+    return align;
+}
+
+
+static CRef<CSeq_align> s_MakeStdSeg(int index)
+{
+    CRef<CSeq_align> align(new CSeq_align);
+    align->SetType(CSeq_align::eType_diags);
+    CRef<CStd_seg> seg(new CStd_seg);
+    seg->SetDim(2);
+    CRef<CSeq_loc> loc(new CSeq_loc);
+    loc->SetInt().SetId().Set("NC_000002.12");
+    loc->SetInt().SetFrom(index);
+    loc->SetInt().SetTo(index+100);
+    seg->SetLoc().push_back(loc);
+    loc.Reset(new CSeq_loc);
+    loc->SetEmpty().Set("NC_000003.12");
+    seg->SetLoc().push_back(loc);
+    align->SetSegs().SetStd().push_back(seg);
+    return align;
+}
+
+
+static CRef<CSeq_align_set> s_MakeAligns(int count)
+{
+    CRef<CSeq_align_set> aligns(new CSeq_align_set);
+    for ( int i = 0; i < count; ++i ) {
+        if ( i % 10 == 9 ) {
+            aligns->Set().push_back(s_MakeStdSeg(i));
+        }
+        else {
+            aligns->Set().push_back(s_MakeDenseSeg(i));
+        }
+    }
+    return aligns;
+}
+
+
+static string s_Write(const CSeq_align_set& aligns,
+                      CAlnColumnarWriter::TFlags flags,
+                      size_t block_size)
+{
+    CNcbiOstrstream str;
+    {{
+        CAlnColumnarWriter writer(str, flags);
+        writer.SetBlockSize(block_size);
+        writer.Write(aligns);
+        writer.Close();
+    }}
+    return CNcbiOstrstreamToString(str);
+}
+
+
+static void s_CheckRoundTrip(CAlnColumnarWriter::TFlags flags)
+{
+    CRef<CSeq_align_set> aligns = s_MakeAligns(250);
+    string data = s_Write(*aligns, flags, 64);
+    CNcbiIstrstream str(data);
+    CAlnColumnarReader reader(str);
+    CRef<CSeq_align_set> result = reader.ReadAll();
+    BOOST_CHECK_EQUAL(result->Get().size(), aligns->Get().size());
+    BOOST_CHECK(result->Equals(*aligns));
+}
+
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    s_CheckRoundTrip(0);
+}
+
+
+BOOST_AUTO_TEST_CASE(RoundTripCompressed)
+{
+    s_CheckRoundTrip(CAlnColumnarWriter::fCompressZstd);
+}
+
+
+BOOST_AUTO_TEST_CASE(ColumnAccess)
+{
+    CRef<CSeq_align_set> aligns = s_MakeAligns(20);
+    string data = s_Write(*aligns, 0, 100);
+    CNcbiIstrstream str(data);
+    CAlnColumnarReader reader(str);
+    BOOST_CHECK_EQUAL(reader.GetAlignCount(), 0u);
+    BOOST_REQUIRE(reader.ReadBlock());
+    BOOST_REQUIRE_EQUAL(reader.GetAlignCount(), 20u);
+    BOOST_CHECK(reader.IsDenseSeg(0));
+    BOOST_CHECK(!reader.IsDenseSeg(9));
+    BOOST_CHECK_EQUAL(reader.GetDim(3), 2u);
+    BOOST_CHECK_EQUAL(reader.GetNumseg(3), 3u);
+    BOOST_CHECK_EQUAL(reader.GetSeq_id(3, 1).GetGi(), GI_CONST(1003));
+    // Seq-ids are shared between alignments of the block
+    BOOST_CHECK_EQUAL(&reader.GetSeq_id(1, 0), &reader.GetSeq_id(2, 0));
+    // but created Seq-aligns have their own copies
+    CRef<CSeq_align> align1 = reader.GetAlign(1);
+    CRef<CSeq_align> align2 = reader.GetAlign(2);
+    BOOST_CHECK(align1->GetSegs().GetDenseg().GetIds()[0] !=
+                align2->GetSegs().GetDenseg().GetIds()[0]);
+    BOOST_CHECK(&align1->GetSegs().GetDenseg().GetIds()[0].GetObject() !=
+                &reader.GetSeq_id(1, 0));
+    align1->SetSegs().SetDenseg().SetIds()[0]->SetLocal().SetId(1);
+    BOOST_CHECK(align2->Equals(*s_MakeDenseSeg(2)));
+    BOOST_CHECK(reader.GetSeq_id(2, 0).IsOther());
+    CRef<CSeq_align> align = reader.GetAlign(5);
+    BOOST_CHECK(align->Equals(*s_MakeDenseSeg(5)));
+    BOOST_CHECK_EQUAL(align, reader.GetAlign(5));
+    BOOST_CHECK(reader.GetAlign(9)->Equals(*s_MakeStdSeg(9)));
+    BOOST_CHECK(!reader.ReadBlock());
+    BOOST_CHECK_EQUAL(reader.GetAlignCount(), 0u);
+}
+
+
+BOOST_AUTO_TEST_CASE(AsnConversion)
+{
+    CRef<CSeq_align_set> aligns = s_MakeAligns(100);
+    string asn;
+    {{
+        CNcbiOstrstream str;
+        {{
+            unique_ptr<CObjectOStream> out
+                (CObjectOStream::Open(eSerial_AsnBinary, str));
+            *out << *aligns;
+        }}
+        asn = CNcbiOstrstreamToString(str);
+    }}
+
+    string data;
+    {{
+        CNcbiIstrstream in_str(asn);
+        unique_ptr<CObjectIStream> in
+            (CObjectIStream::Open(eSerial_AsnBinary, in_str));
+        CNcbiOstrstream str;
+        {{
+            CAlnColumnarWriter writer(str);
+            writer.SetBlockSize(30);
+            writer.CopyFromAsn(*in);
+        }}
+        data = CNcbiOstrstreamToString(str);
+    }}
+    BOOST_CHECK_LT(data.size(), asn.size());
+
+    CNcbiIstrstream str(data);
+    CAlnColumnarReader reader(str);
+    CNcbiOstrstream out_str;
+    {{
+        unique_ptr<CObjectOStream> out
+            (CObjectOStream::Open(eSerial_AsnBinary, out_str));
+        reader.CopyToAsn(*out);
+    }}
+    BOOST_CHECK(CNcbiOstrstreamToString(out_str) == asn);
+}
+
+
+BOOST_AUTO_TEST_CASE(FormatErrors)
+{
+    string data = s_Write(*s_MakeAligns(20), 0, 100);
+    {{
+        string bad = "NCBIALC0" + data.substr(8);
+        CNcbiIstrstream str(bad);
+        BOOST_CHECK_THROW(CAlnColumnarReader reader(str),
+                          CAlnColumnarException);
+    }}
+    {{
+        // missing end of data mark
+        string bad = data.substr(0, data.size()-1);
+        CNcbiIstrstream str(bad);
+        CAlnColumnarReader reader(str);
+        BOOST_CHECK(reader.ReadBlock());
+        BOOST_CHECK_THROW(reader.ReadBlock(), CAlnColumnarException);
+    }}
+    {{
+        string bad = data.substr(0, data.size()/2);
+        CNcbiIstrstream str(bad);
+        CAlnColumnarReader reader(str);
+        BOOST_CHECK_THROW(reader.ReadBlock(), CAlnColumnarException);
+    }}
+    {{
+        // huge column size in truncated data
+        string bad = data.substr(0, 8);
+        bad += char(1);  // align count
+        bad += char(1);  // column count
+        bad += char(0);  // column id
+        bad += char(0);  // no compression
+        bad += "\xff\xff\xff\xff\xff\xff\x0f"; // raw size
+        bad += "\xff\xff\xff\xff\xff\xff\x0f"; // stored size
+        CNcbiIstrstream str(bad);
+        CAlnColumnarReader reader(str);
+        BOOST_CHECK_THROW(reader.ReadBlock(), CAlnColumnarException);
+    }}
+    {{
+        // column size within limit, but no data
+        string bad = data.substr(0, 8);
+        bad += char(1);  // align count
+        bad += char(1);  // column count
+        bad += char(0);  // column id
+        bad += char(0);  // no compression
+        bad += "\x80\x80\x80\x01"; // raw size
+        bad += "\x80\x80\x80\x01"; // stored size
+        CNcbiIstrstream str(bad);
+        CAlnColumnarReader reader(str);
+        BOOST_CHECK_THROW(reader.ReadBlock(), CAlnColumnarException);
+    }}
+}
@@ -0,0 +1,232 @@
+/*  $Id$
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Authors:  agent
+*
+* File Description:
+*   Timing of Seq-submit Assign(), Equals() and cleanup
+*   with generic and datatool-generated Assign() and Equals()
+*
+* ===========================================================================
+*/
+#include <ncbi_pch.hpp>
+#include <corelib/ncbiapp.hpp>
+#include <corelib/ncbiargs.hpp>
+#include <corelib/ncbitime.hpp>
+#include <serial/serial.hpp>
+#include <serial/impl/classinfob.hpp>
+
+#include <objects/seqloc/Seq_id.hpp>
+#include <objects/seqloc/Seq_loc.hpp>
+#include <objects/seqloc/Seq_interval.hpp>
+#include <objects/seq/Bioseq.hpp>
+#include <objects/seq/Seq_inst.hpp>
+#include <objects/seq/Seq_annot.hpp>
+#include <objects/seqset/Seq_entry.hpp>
+#include <objects/seqset/Bioseq_set.hpp>
+#include <objects/seqfeat/Seq_feat.hpp>
+#include <objects/seqfeat/SeqFeatData.hpp>
+#include <objects/seqfeat/Gene_ref.hpp>
+#include <objects/seqfeat/Imp_feat.hpp>
+#include <objects/seqfeat/Gb_qual.hpp>
+#include <objects/submit/Seq_submit.hpp>
+#include <objects/submit/Submit_block.hpp>
+#include <objtools/cleanup/cleanup.hpp>
+
+#include <common/test_assert.h>  /* This header must go last */
+
+
+BEGIN_NCBI_SCOPE
+using namespace objects;
+
+
+// features with extra spaces for the cleanup to fix
+static CRef<CSeq_submit> s_CreateSubmit(unsigned seq_count)
+{
+    const unsigned kFeatCount = 50;
+    CRef<CSeq_submit> submit(new CSeq_submit);
+    submit->SetSub().SetTool("test_cleanup_assign_perf");
+    CRef<CSeq_entry> set_entry(new CSeq_entry);
+    set_entry->SetSet().SetClass(CBioseq_set::eClass_genbank);
+    for ( unsigned i = 0; i < seq_count; ++i ) {
+        CRef<CSeq_id> id(new CSeq_id);
+        id->SetLocal().SetStr("seq"+NStr::UIntToString(i+1));
+        CRef<CSeq_entry> entry(new CSeq_entry);
+        CBioseq& seq = entry->SetSeq();
+        seq.SetId().push_back(id);
+        seq.SetInst().SetRepr(CSeq_inst::eRepr_virtual);
+        seq.SetInst().SetMol(CSeq_inst::eMol_dna);
+        seq.SetInst().SetLength(kFeatCount*100);
+        CRef<CSeq_annot> annot(new CSeq_annot);
+        for ( unsigned j = 0; j < kFeatCount; ++j ) {
+            CRef<CSeq_feat> feat(new CSeq_feat);
+            string num = NStr::UIntToString(j);
+            if ( j % 2 ) {
+                feat->SetData().SetGene().SetLocus("gene"+num);
+                feat->SetData().SetGene().SetSyn().push_back(" syn  ");
+            }
+            else {
+                feat->SetData().SetImp().SetKey("misc_feature");
+                feat->SetQual().push_back(Ref(new CGb_qual("note", " note  "+num)));
+            }
+            feat->SetComment("feature "+num+"  ");
+            CSeq_interval& interval = feat->SetLocation().SetInt();
+            interval.SetId(*id);
+            interval.SetFrom(j*100);
+            interval.SetTo(j*100+49);
+            annot->SetData().SetFtable().push_back(feat);
+        }
+        seq.SetAnnot().push_back(annot);
+        set_entry->SetSet().SetSeq_set().push_back(entry);
+    }
+    submit->SetData().SetEntrys().push_back(set_entry);
+    return submit;
+}
+
+
+struct SResult
+{
+    double m_AssignTime;
+    double m_EqualsTime;
+    double m_CleanupTime;
+    bool m_Equal;
+    CRef<CSeq_submit> m_Copy;
+    CRef<CSeq_submit> m_Cleaned;
+};
+
+
+// best time of several runs for each operation
+static SResult s_Run(const CSeq_submit& submit, bool generated)
+{
+    const int kRuns = 3;
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(generated);
+    SResult result;
+    result.m_AssignTime = result.m_EqualsTime = result.m_CleanupTime = 0;
+    for ( int i = 0; i < kRuns; ++i ) {
+        result.m_Copy.Reset(new CSeq_submit);
+        CStopWatch sw(CStopWatch::eStart);
+        result.m_Copy->Assign(submit);
+        double assign_time = sw.Restart();
+        result.m_Equal = result.m_Copy->Equals(submit);
+        double equals_time = sw.Elapsed();
+
+        result.m_Cleaned.Reset(new CSeq_submit);
+        result.m_Cleaned->Assign(submit);
+        sw.Restart();
+        {
+            CCleanup cleanup;
+            cleanup.BasicCleanup(*result.m_Cleaned);
+            cleanup.ExtendedCleanup(*result.m_Cleaned);
+        }
+        double cleanup_time = sw.Elapsed();
+        if ( i == 0 || assign_time < result.m_AssignTime ) {
+            result.m_AssignTime = assign_time;
+        }
+        if ( i == 0 || equals_time < result.m_EqualsTime ) {
+            result.m_EqualsTime = equals_time;
+        }
+        if ( i == 0 || cleanup_time < result.m_CleanupTime ) {
+            result.m_CleanupTime = cleanup_time;
+        }
+    }
+    return result;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//  Test application
+//
+
+class CTestApp : public CNcbiApplication
+{
+public:
+    virtual void Init(void);
+    virtual int  Run(void);
+};
+
+
+void CTestApp::Init(void)
+{
+    unique_ptr<CArgDescriptions> arg_desc(new CArgDescriptions);
+    arg_desc->SetUsageContext(GetArguments().GetProgramBasename(),
+                              "Generated Assign/Equals timing in cleanup");
+    arg_desc->AddDefaultKey("seqs", "SeqCount",
+                            "Number of generated sequences",
+                            CArgDescriptions::eInteger, "1000");
+    SetupArgDescriptions(arg_desc.release());
+}
+
+
+int CTestApp::Run(void)
+{
+    CRef<CSeq_submit> submit = s_CreateSubmit(GetArgs()["seqs"].AsInteger());
+
+    bool enabled = CClassTypeInfoBase::GetGeneratedAssignEnabled();
+    SResult generic = s_Run(*submit, false);
+    SResult generated = s_Run(*submit, true);
+
+    NcbiCout << setprecision(3) << fixed
+             << "          generic generated speedup" << NcbiEndl;
+    NcbiCout << "Assign:  " << setw(8) << generic.m_AssignTime
+             << setw(10) << generated.m_AssignTime
+             << setw(8) << generic.m_AssignTime/generated.m_AssignTime
+             << NcbiEndl;
+    NcbiCout << "Equals:  " << setw(8) << generic.m_EqualsTime
+             << setw(10) << generated.m_EqualsTime
+             << setw(8) << generic.m_EqualsTime/generated.m_EqualsTime
+             << NcbiEndl;
+    NcbiCout << "Cleanup: " << setw(8) << generic.m_CleanupTime
+             << setw(10) << generated.m_CleanupTime
+             << setw(8) << generic.m_CleanupTime/generated.m_CleanupTime
+             << NcbiEndl;
+
+    // check the results by generic code only
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(false);
+    bool ok = generic.m_Equal && generated.m_Equal &&
+        generated.m_Copy->Equals(*generic.m_Copy) &&
+        generated.m_Cleaned->Equals(*generic.m_Cleaned);
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(enabled);
+    if ( !ok ) {
+        ERR_POST("Generated Assign/Equals give different results");
+        return 1;
+    }
+    NcbiCout << "Passed" << NcbiEndl;
+    return 0;
+}
+
+
+END_NCBI_SCOPE
+
+
+/////////////////////////////////////////////////////////////////////////////
+//  MAIN
+
+USING_NCBI_SCOPE;
+
+int main(int argc, const char* argv[])
+{
+    return CTestApp().AppMain(argc, argv);
+}
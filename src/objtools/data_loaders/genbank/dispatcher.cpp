@@ -2236,9 +2236,17 @@ void CReadDispatcher::LogStat(CReadDispatcherCommand& command,
 void CReadDispatcher::LogStat(CReadDispatcherCommand& command,
                               CReaderRequestResultRecursion& recursion,
                               double size)
+{
+    LogStat(command, recursion, size, recursion.GetCurrentRequestTime());
+}
+
+
+void CReadDispatcher::LogStat(CReadDispatcherCommand& command,
+                              CReaderRequestResultRecursion& recursion,
+                              double size,
+                              double time)
 {
     CReaderRequestResult& result = command.GetResult();
-    double time = recursion.GetCurrentRequestTime();
     CGBRequestStatistics& stat = sx_Statistics[command.GetStatistics()];
     stat.AddTimeSize(time, size);
     if ( CollectStatistics() >= 2 ) {
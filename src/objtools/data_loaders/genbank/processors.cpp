@@ -93,6 +93,26 @@ NCBI_PARAM_DEF_EX(bool, GENBANK, CACHE_RECOMPRESS, true,
                   eParam_NoThread, GENBANK_CACHE_RECOMPRESS);
 
 
+// approximate ratio of in-memory objects size to ASN.1 binary data size,
+// used for memory accounting of loaded blobs and chunks
+static const size_t kUsedMemoryPerDataByte = 4;
+
+
+// report memory used by the data just attached to the blob or its chunk
+static void s_AddUsedMemory(CLoadLockSetter& setter,
+                            int chunk_id,
+                            double data_size)
+{
+    size_t memory = size_t(data_size)*kUsedMemoryPerDataByte;
+    if ( chunk_id == kMain_ChunkId ) {
+        setter.GetTSE_LoadLock()->AddUsedMemory(memory);
+    }
+    else {
+        setter.GetTSE_Chunk_Info().x_AddUsedMemory(memory);
+    }
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // helper functions
 /////////////////////////////////////////////////////////////////////////////
@@ -359,17 +379,20 @@ void CProcessor::SetSeqEntryReadHooks(CObjectIStream& in)
         CObjectTypeInfo type;
 
         type = CObjectTypeInfo(CType<CObject_id>());
-        type.FindVariant("str").SetLocalReadHook(in, new CPackStringChoiceHook);
+        type.FindVariant("str")
+            .SetLocalReadHook(in, new CPackStringChoiceHook(CPackString::eShared));
 
         type = CObjectTypeInfo(CType<CImp_feat>());
         type.FindMember("key").SetLocalReadHook(in,
-                                                new CPackStringClassHook(32, 128));
+            new CPackStringClassHook(CPackString::eShared, 32));
 
         type = CObjectTypeInfo(CType<CDbtag>());
-        type.FindMember("db").SetLocalReadHook(in, new CPackStringClassHook);
+        type.FindMember("db")
+            .SetLocalReadHook(in, new CPackStringClassHook(CPackString::eShared));
 
         type = CType<CGb_qual>();
-        type.FindMember("qual").SetLocalReadHook(in, new CPackStringClassHook);
+        type.FindMember("qual")
+            .SetLocalReadHook(in, new CPackStringClassHook(CPackString::eShared));
     }
     if ( s_UseMemoryPool() ) {
         in.UseMemoryPool();
@@ -383,22 +406,26 @@ void CProcessor::SetSNPReadHooks(CObjectIStream& in)
         CObjectTypeInfo type;
 
         type = CType<CGb_qual>();
-        type.FindMember("qual").SetLocalReadHook(in, new CPackStringClassHook);
+        type.FindMember("qual")
+            .SetLocalReadHook(in, new CPackStringClassHook(CPackString::eShared));
         type.FindMember("val").SetLocalReadHook(in,
-                                                new CPackStringClassHook(4, 128));
+            new CPackStringClassHook(CPackString::eShared, 4));
 
         type = CObjectTypeInfo(CType<CImp_feat>());
         type.FindMember("key").SetLocalReadHook(in,
-                                                new CPackStringClassHook(32, 128));
+            new CPackStringClassHook(CPackString::eShared, 32));
 
         type = CObjectTypeInfo(CType<CObject_id>());
-        type.FindVariant("str").SetLocalReadHook(in, new CPackStringChoiceHook);
+        type.FindVariant("str")
+            .SetLocalReadHook(in, new CPackStringChoiceHook(CPackString::eShared));
 
         type = CObjectTypeInfo(CType<CDbtag>());
-        type.FindMember("db").SetLocalReadHook(in, new CPackStringClassHook);
+        type.FindMember("db")
+            .SetLocalReadHook(in, new CPackStringClassHook(CPackString::eShared));
 
         type = CObjectTypeInfo(CType<CSeq_feat>());
-        type.FindMember("comment").SetLocalReadHook(in, new CPackStringClassHook);
+        type.FindMember("comment")
+            .SetLocalReadHook(in, new CPackStringClassHook(CPackString::eShared));
     }
 }
 
@@ -707,6 +734,7 @@ void CProcessor_ID1::ProcessObjStream(CReaderRequestResult& result,
             CReaderRequestResultRecursion r(result);
             OffsetAllGisToOM(*entry.first);
             setter.SetSeq_entry(*entry.first);
+            s_AddUsedMemory(setter, chunk_id, data_size);
             LogStat(r, blob_id,
                     CGBRequestStatistics::eStat_AttachBlob,
                     "CProcessor_ID1: attached entry",
@@ -954,6 +982,7 @@ void CProcessor_ID1_SNP::ProcessObjStream(CReaderRequestResult& result,
             CReaderRequestResultRecursion r(result);
             OffsetAllGisToOM(*entry.first, set_info);
             setter.SetSeq_entry(*entry.first, set_info);
+            s_AddUsedMemory(setter, chunk_id, data_size);
             LogStat(r, blob_id,
                     CGBRequestStatistics::eStat_AttachBlob,
                     "CProcessor_ID1: attached entry",
@@ -1031,6 +1060,7 @@ void CProcessor_SE::ProcessObjStream(CReaderRequestResult& result,
             
             OffsetAllGisToOM(*seq_entry);
             setter.SetSeq_entry(*seq_entry);
+            s_AddUsedMemory(setter, chunk_id, data_size);
             
             LogStat(r, blob_id,
                     CGBRequestStatistics::eStat_AttachBlob,
@@ -1170,6 +1200,7 @@ void CProcessor_SE_SNP::ProcessObjStream(CReaderRequestResult& result,
             
         OffsetAllGisToOM(*seq_entry, set_info);
         setter.SetSeq_entry(*seq_entry, set_info);
+        s_AddUsedMemory(setter, chunk_id, data_size);
         
         LogStat(r, blob_id,
                 CGBRequestStatistics::eStat_AttachSNPBlob,
@@ -1459,6 +1490,7 @@ void CProcessor_St_SE_SNPT::ProcessStream(CReaderRequestResult& result,
         
         OffsetAllGisToOM(*seq_entry, set_info);
         setter.SetSeq_entry(*seq_entry, set_info);
+        s_AddUsedMemory(setter, chunk_id, data_size);
         
         LogStat(r, blob_id,
                 CGBRequestStatistics::eStat_AttachSNPBlob,
@@ -1552,7 +1584,8 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
                                  TChunkId chunk_id,
                                  const CID2_Reply_Data& data,
                                  int split_version,
-                                 const CID2_Reply_Data* skel) const
+                                 const CID2_Reply_Data* skel,
+                                 const CDecodedData* decoded) const
 {
     CLoadLockBlob blob(result, blob_id, chunk_id);
     if ( blob.IsLoadedChunk() ) {
@@ -1584,9 +1617,18 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
                        "CProcessor_ID2: "
                        "plain Seq-entry in chunk reply");
         }
-        CRef<CSeq_entry> entry(new CSeq_entry);
-
-        {{
+        CRef<CSeq_entry> entry;
+        if ( decoded ) {
+            entry = &dynamic_cast<CSeq_entry&>(decoded->m_Object.GetNCObject());
+            data_size = decoded->m_DataSize;
+            CReaderRequestResultRecursion r(result);
+            LogStat(r, blob_id,
+                    CGBRequestStatistics::eStat_ParseBlob,
+                    "CProcessor_ID2: parsed Seq-entry",
+                    double(data_size), decoded->m_ParseTime);
+        }
+        else {
+            entry = new CSeq_entry;
             CReaderRequestResultRecursion r(result);
             
             x_ReadData(data, Begin(*entry), data_size);
@@ -1595,7 +1637,7 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
                     CGBRequestStatistics::eStat_ParseBlob,
                     "CProcessor_ID2: parsed Seq-entry",
                     data_size);
-        }}
+        }
         
         result.SetAndSaveBlobState(blob_id, blob_state);
         CLoadLockSetter setter(blob);
@@ -1605,6 +1647,7 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
                 
                 OffsetAllGisToOM(*entry);
                 setter.SetSeq_entry(*entry);
+                s_AddUsedMemory(setter, chunk_id, data_size);
                 
                 if ( s_CanBeWGSBlob(blob_id) &&
                      result.GetAddWGSMasterDescr() ) {
@@ -1690,6 +1733,8 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
                 lock->GetSplitInfo().SetSplitVersion(split_version);
                 OffsetAllGisToOM(*split_info);
                 CSplitParser::Attach(*lock, *split_info);
+                // split info and skeleton
+                s_AddUsedMemory(setter, kMain_ChunkId, data_size);
                 if ( s_CanBeWGSBlob(blob_id) &&
                      result.GetAddWGSMasterDescr() ) {
                     CWGSMasterSupport::AddWGSMaster(setter.GetTSE_LoadLock());
@@ -1738,9 +1783,18 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
         if ( setter.IsLoaded() ) {
             break;
         }
-        CRef<CID2S_Chunk> chunk(new CID2S_Chunk);
-        
-        {{
+        CRef<CID2S_Chunk> chunk;
+        if ( decoded ) {
+            chunk = &dynamic_cast<CID2S_Chunk&>(decoded->m_Object.GetNCObject());
+            data_size = decoded->m_DataSize;
+            CReaderRequestResultRecursion r(result);
+            LogStat(r, blob_id, chunk_id,
+                    CGBRequestStatistics::eStat_ParseChunk,
+                    "CProcessor_ID2: parsed split chunk",
+                    double(data_size), decoded->m_ParseTime);
+        }
+        else {
+            chunk = new CID2S_Chunk;
             CReaderRequestResultRecursion r(result);
             
             x_ReadData(data, Begin(*chunk), data_size);
@@ -1748,13 +1802,14 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
                     CGBRequestStatistics::eStat_ParseChunk,
                     "CProcessor_ID2: parsed split chunk",
                     data_size);
-        }}
+        }
 
         {{
             CReaderRequestResultRecursion r(result);
             
             OffsetAllGisToOM(*chunk);
             CSplitParser::Load(setter.GetTSE_Chunk_Info(), *chunk);
+            s_AddUsedMemory(setter, chunk_id, data_size);
             
             LogStat(r, blob_id, chunk_id,
                     CGBRequestStatistics::eStat_AttachChunk,
@@ -1777,6 +1832,31 @@ void CProcessor_ID2::ProcessData(CReaderRequestResult& result,
 }
 
 
+CRef<CProcessor_ID2::CDecodedData>
+CProcessor_ID2::DecodeData(const CID2_Reply_Data& data)
+{
+    CRef<CDecodedData> decoded(new CDecodedData);
+    switch ( data.GetData_type() ) {
+    case CID2_Reply_Data::eData_type_seq_entry:
+        decoded->m_Object = new CSeq_entry;
+        break;
+    case CID2_Reply_Data::eData_type_id2s_chunk:
+        decoded->m_Object = new CID2S_Chunk;
+        break;
+    default:
+        return null;
+    }
+    decoded->m_DataSize = 0;
+    CStopWatch sw(CStopWatch::eStart);
+    x_ReadData(data,
+               CObjectInfo(decoded->m_Object.GetPointer(),
+                           decoded->m_Object->GetThisTypeInfo()),
+               decoded->m_DataSize);
+    decoded->m_ParseTime = sw.Elapsed();
+    return decoded;
+}
+
+
 void CProcessor_ID2::SaveData(CReaderRequestResult& result,
                               const TBlobId& blob_id,
                               TBlobState blob_state,
@@ -2501,5 +2581,32 @@ void CProcessor::LogStat(CReaderRequestResultRecursion& recursion,
 }
 
 
+void CProcessor::LogStat(CReaderRequestResultRecursion& recursion,
+                         const CBlob_id& blob_id,
+                         CGBRequestStatistics::EStatType stat_type,
+                         const char* descr,
+                         double size,
+                         double time)
+{
+    CCommandParseBlob cmd(recursion.GetResult(),
+                          stat_type, descr, blob_id);
+    CReadDispatcher::LogStat(cmd, recursion, size, time);
+}
+
+
+void CProcessor::LogStat(CReaderRequestResultRecursion& recursion,
+                         const CBlob_id& blob_id,
+                         int chunk_id,
+                         CGBRequestStatistics::EStatType stat_type,
+                         const char* descr,
+                         double size,
+                         double time)
+{
+    CCommandParseBlob cmd(recursion.GetResult(),
+                          stat_type, descr, blob_id, chunk_id);
+    CReadDispatcher::LogStat(cmd, recursion, size, time);
+}
+
+
 END_SCOPE(objects)
 END_NCBI_SCOPE
@@ -36,6 +36,7 @@
 #include <corelib/ncbi_param.hpp>
 #include <corelib/plugin_manager_store.hpp>
 #include <corelib/ncbi_url.hpp>
+#include <corelib/ncbifile.hpp>
 #include <objects/seqsplit/ID2S_Split_Info.hpp>
 #include <objects/seqsplit/ID2S_Chunk.hpp>
 #include <objects/seqsplit/ID2S_Feat_type_Info.hpp>
@@ -63,6 +64,10 @@
 
 #if defined(HAVE_PSG_LOADER)
 
+#if defined(HAVE_LIBLMDB)
+#  include <util/lmdbxx/lmdb++.h>
+#endif
+
 //#define LOCK4GET 1
 #define GLOBAL_CHUNKS 1
 
@@ -117,6 +122,15 @@ const size_t kDefaultMaxCacheSize = 10000;
 const unsigned int kDefaultRetryCount = 4;
 const unsigned int kDefaultBulkRetryCount = 8;
 
+// estimated memory used by the loaded objects per byte of decoded data,
+// same as in the GenBank reader processors
+const size_t kUsedMemoryPerDataByte = 4;
+
+static size_t s_GetUsedMemory(const CObjectIStream& in)
+{
+    return size_t(NcbiStreamposToInt8(in.GetStreamPos()))*kUsedMemoryPerDataByte;
+}
+
 #define DEFAULT_WAIT_TIME 1
 #define DEFAULT_WAIT_TIME_MULTIPLIER 1.5
 #define DEFAULT_WAIT_TIME_INCREMENT 1
@@ -621,6 +635,161 @@ public:
 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+// CPSGDiskCache
+/////////////////////////////////////////////////////////////////////////////
+
+// Persistent cache of the split chunks data shared by all processes on the
+// host. The chunks are addressed by id2_info which includes the split version,
+// so a cached chunk never becomes stale and needs no invalidation.
+// The data are stored as received from PSG (possibly compressed) and are
+// parsed the same way as the network data.
+class CPSGDiskCache
+{
+public:
+    struct SChunkData {
+        string format;
+        string compression;
+        string data;
+    };
+
+    CPSGDiskCache(const string& path, size_t max_size_mb);
+
+    bool Get(const string& id2_info, CTSE_Chunk_Info::TChunkId chunk_id, SChunkData& chunk_data);
+    void Put(const string& id2_info, CTSE_Chunk_Info::TChunkId chunk_id, const SChunkData& chunk_data);
+    void Remove(const string& id2_info, CTSE_Chunk_Info::TChunkId chunk_id);
+
+private:
+    static string x_MakeKey(const string& id2_info, CTSE_Chunk_Info::TChunkId chunk_id)
+    {
+        return id2_info + '/' + NStr::NumericToString(chunk_id);
+    }
+
+#if defined(HAVE_LIBLMDB)
+    lmdb::env m_Env;
+    lmdb::dbi m_Dbi;
+#endif
+};
+
+
+#if defined(HAVE_LIBLMDB)
+CPSGDiskCache::CPSGDiskCache(const string& path, size_t max_size_mb)
+    : m_Env(lmdb::env::create()),
+      m_Dbi(0)
+{
+    CDir(path).CreatePath();
+    m_Env.set_mapsize(max_size_mb*1024*1024);
+    // The loader threads share read transactions by the thread pool
+    m_Env.open(path.c_str(), MDB_NOTLS | MDB_NOSYNC | MDB_NOMETASYNC, 0664);
+    auto txn = lmdb::txn::begin(m_Env);
+    m_Dbi = lmdb::dbi::open(txn, nullptr, MDB_CREATE);
+    txn.commit();
+}
+
+
+bool CPSGDiskCache::Get(const string& id2_info, CTSE_Chunk_Info::TChunkId chunk_id, SChunkData& chunk_data)
+{
+    try {
+        auto txn = lmdb::txn::begin(m_Env, nullptr, MDB_RDONLY);
+        lmdb::val value;
+        if ( !m_Dbi.get(txn, lmdb::val(x_MakeKey(id2_info, chunk_id)), value) ) {
+            return false;
+        }
+        // format '\0' compression '\0' data
+        CTempString record(value.data(), value.size());
+        size_t format_end = record.find('\0');
+        if ( format_end == NPOS ) {
+            return false;
+        }
+        size_t compression_end = record.find('\0', format_end+1);
+        if ( compression_end == NPOS ) {
+            return false;
+        }
+        chunk_data.format = record.substr(0, format_end);
+        chunk_data.compression = record.substr(format_end+1, compression_end-format_end-1);
+        chunk_data.data = record.substr(compression_end+1);
+        return true;
+    }
+    catch ( lmdb::error& exc ) {
+        ERR_POST_ONCE(Warning<<"PSG loader: disk cache read failed: "<<exc.what());
+    }
+    return false;
+}
+
+
+void CPSGDiskCache::Put(const string& id2_info, CTSE_Chunk_Info::TChunkId chunk_id, const SChunkData& chunk_data)
+{
+    string record;
+    record.reserve(chunk_data.format.size()+chunk_data.compression.size()+chunk_data.data.size()+2);
+    record += chunk_data.format;
+    record += '\0';
+    record += chunk_data.compression;
+    record += '\0';
+    record += chunk_data.data;
+    string key = x_MakeKey(id2_info, chunk_id);
+    for ( int attempt = 0; attempt < 2; ++attempt ) {
+        try {
+            auto txn = lmdb::txn::begin(m_Env);
+            m_Dbi.put(txn, lmdb::val(key), lmdb::val(record));
+            txn.commit();
+            return;
+        }
+        catch ( lmdb::map_full_error& ) {
+            // The cache is full: start it over
+            try {
+                auto txn = lmdb::txn::begin(m_Env);
+                m_Dbi.drop(txn);
+                txn.commit();
+            }
+            catch ( lmdb::error& exc ) {
+                ERR_POST_ONCE(Warning<<"PSG loader: disk cache cleanup failed: "<<exc.what());
+                return;
+            }
+        }
+        catch ( lmdb::error& exc ) {
+            ERR_POST_ONCE(Warning<<"PSG loader: disk cache write failed: "<<exc.what());
+            return;
+        }
+    }
+}
+
+
+void CPSGDiskCache::Remove(const string& id2_info, CTSE_Chunk_Info::TChunkId chunk_id)
+{
+    try {
+        auto txn = lmdb::txn::begin(m_Env);
+        m_Dbi.del(txn, lmdb::val(x_MakeKey(id2_info, chunk_id)));
+        txn.commit();
+    }
+    catch ( lmdb::error& exc ) {
+        ERR_POST_ONCE(Warning<<"PSG loader: disk cache removal failed: "<<exc.what());
+    }
+}
+#else
+CPSGDiskCache::CPSGDiskCache(const string& /*path*/, size_t /*max_size_mb*/)
+{
+    NCBI_THROW(CLoaderException, eBadConfig,
+               "PSG loader disk cache requires LMDB support");
+}
+
+
+bool CPSGDiskCache::Get(const string&, CTSE_Chunk_Info::TChunkId, SChunkData&)
+{
+    return false;
+}
+
+
+void CPSGDiskCache::Put(const string&, CTSE_Chunk_Info::TChunkId, const SChunkData&)
+{
+}
+
+
+void CPSGDiskCache::Remove(const string&, CTSE_Chunk_Info::TChunkId)
+{
+}
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 // CPSG_Task
 /////////////////////////////////////////////////////////////////////////////
@@ -1086,6 +1255,14 @@ NCBI_PARAM_DECL(bool, PSG_LOADER, IPG_TAX_ID);
 NCBI_PARAM_DEF_EX(bool, PSG_LOADER, IPG_TAX_ID, false, eParam_NoThread, PSG_LOADER_IPG_TAX_ID);
 typedef NCBI_PARAM_TYPE(PSG_LOADER, IPG_TAX_ID) TPSG_IpgTaxIdEnabled;
 
+NCBI_PARAM_DECL(string, PSG_LOADER, DISK_CACHE_PATH);
+NCBI_PARAM_DEF_EX(string, PSG_LOADER, DISK_CACHE_PATH, "",
+    eParam_NoThread, PSG_LOADER_DISK_CACHE_PATH);
+
+NCBI_PARAM_DECL(unsigned int, PSG_LOADER, DISK_CACHE_SIZE_MB);
+NCBI_PARAM_DEF_EX(unsigned int, PSG_LOADER, DISK_CACHE_SIZE_MB, 4096,
+    eParam_NoThread, PSG_LOADER_DISK_CACHE_SIZE_MB);
+
 
 template<class TParamType>
 static void s_ConvertParamValue(TParamType& value, const string& str)
@@ -1101,6 +1278,13 @@ void s_ConvertParamValue<bool>(bool& value, const string& str)
 }
 
 
+template<>
+void s_ConvertParamValue<string>(string& value, const string& str)
+{
+    value = str;
+}
+
+
 static const TPluginManagerParamTree* s_FindSubNode(const TPluginManagerParamTree* params,
                                                     const string& name)
 {
@@ -1244,6 +1428,14 @@ CPSGDataLoader_Impl::CPSGDataLoader_Impl(const CGBLoaderParams& params)
         m_IpgTaxIdMap.reset(new CPSGIpgTaxIdMap(m_CacheLifespan, cache_max_size));
     }
 
+    string disk_cache_path =
+        s_GetParamValue<X_NCBI_PARAM_DECLNAME(PSG_LOADER, DISK_CACHE_PATH)>(psg_params);
+    if ( !disk_cache_path.empty() ) {
+        unsigned int disk_cache_size =
+            s_GetParamValue<X_NCBI_PARAM_DECLNAME(PSG_LOADER, DISK_CACHE_SIZE_MB)>(psg_params);
+        m_DiskCache.reset(new CPSGDiskCache(disk_cache_path, disk_cache_size));
+    }
+
     CUrlArgs args;
     if (params.IsSetEnableSNP()) {
         args.AddValue(params.GetEnableSNP() ? "enable_processor" : "disable_processor", "snp");
@@ -2196,6 +2388,7 @@ void CPSG_Blob_Task::CreateLoadedChunks(CTSE_LoadLock& load_lock)
         }
         
         CSplitParser::Load(*chunk, *id2_chunk);
+        chunk->x_AddUsedMemory(s_GetUsedMemory(*in));
         chunk->SetLoaded();
     }
     m_ChunkBlobMap.erase(blob_id->GetId2Info());
@@ -2436,8 +2629,9 @@ void CPSGDataLoader_Impl::LoadChunk(CDataSource* data_source,
 class CPSG_LoadChunk_Task : public CPSG_Task
 {
 public:
-    CPSG_LoadChunk_Task(TReply reply, CPSG_TaskGroup& group, CDataLoader::TChunk chunk)
-        : CPSG_Task(reply, group), m_Chunk(chunk) {}
+    CPSG_LoadChunk_Task(TReply reply, CPSG_TaskGroup& group, CDataLoader::TChunk chunk,
+                        CPSGDiskCache* disk_cache = nullptr)
+        : CPSG_Task(reply, group), m_Chunk(chunk), m_DiskCache(disk_cache) {}
 
     ~CPSG_LoadChunk_Task(void) override {}
 
@@ -2453,6 +2647,7 @@ protected:
 
 private:
     CDataLoader::TChunk m_Chunk;
+    CPSGDiskCache* m_DiskCache;
     shared_ptr<CPSG_BlobInfo> m_BlobInfo;
     shared_ptr<CPSG_BlobData> m_BlobData;
 };
@@ -2471,7 +2666,22 @@ void CPSG_LoadChunk_Task::DoExecute(void)
     }
 
     if (IsCancelled()) return;
-    unique_ptr<CObjectIStream> in(CPSGDataLoader_Impl::GetBlobDataStream(*m_BlobInfo, *m_BlobData));
+    // The data stored in the disk cache must outlive the object stream
+    CPSGDiskCache::SChunkData chunk_data;
+    unique_ptr<CNcbiIstream> chunk_data_stream;
+    unique_ptr<CObjectIStream> in;
+    if ( m_DiskCache ) {
+        chunk_data.format = m_BlobInfo->GetFormat();
+        chunk_data.compression = m_BlobInfo->GetCompression();
+        NcbiStreamToString(&chunk_data.data, m_BlobData->GetStream());
+        chunk_data_stream.reset(new CNcbiIstrstream(chunk_data.data));
+        in.reset(CPSGDataLoader_Impl::GetBlobDataStream(chunk_data.format,
+                                                        chunk_data.compression,
+                                                        *chunk_data_stream));
+    }
+    else {
+        in.reset(CPSGDataLoader_Impl::GetBlobDataStream(*m_BlobInfo, *m_BlobData));
+    }
     if (!in.get()) {
         _TRACE("Failed to open chunk data stream for blob-id " << m_BlobInfo->GetId()->Repr());
         m_Status = eFailed;
@@ -2485,7 +2695,13 @@ void CPSG_LoadChunk_Task::DoExecute(void)
                  " chunk "<<m_Chunk->GetChunkId()<<" "<<MSerial_AsnText<<*id2_chunk);
     }
     CSplitParser::Load(*m_Chunk, *id2_chunk);
+    m_Chunk->x_AddUsedMemory(s_GetUsedMemory(*in));
     m_Chunk->SetLoaded();
+    if ( m_DiskCache ) {
+        // Only the data which were parsed successfully are stored
+        const CPsgBlobId& blob_id = dynamic_cast<const CPsgBlobId&>(*m_Chunk->GetBlobId());
+        m_DiskCache->Put(blob_id.GetId2Info(), m_Chunk->GetChunkId(), chunk_data);
+    }
 
     m_Status = eCompleted;
 }
@@ -2733,6 +2949,7 @@ bool CPSGDataLoader_Impl::x_ReadCDDChunk(CDataSource* data_source,
         }
     }
     load_lock->SetSeq_entry(*entry);
+    chunk->x_AddUsedMemory(s_GetUsedMemory(*in));
     chunk->SetLoaded();
     return true;
 }
@@ -2871,11 +3088,15 @@ void CPSGDataLoader_Impl::LoadChunksOnce(CDataSource* data_source,
             group.AddTask(task);
         }
         else {
+            if ( m_DiskCache && x_LoadChunkFromDiskCache(*it) ) {
+                continue;
+            }
             const CPsgBlobId& blob_id = dynamic_cast<const CPsgBlobId&>(*chunk.GetBlobId());
             auto request = make_shared<CPSG_Request_Chunk>(CPSG_ChunkId(chunk.GetChunkId(),
                                                                         blob_id.GetId2Info()));
             auto reply = x_SendRequest(request);
-            CRef<CPSG_LoadChunk_Task> task(new CPSG_LoadChunk_Task(reply, group, *it));
+            CRef<CPSG_LoadChunk_Task> task(new CPSG_LoadChunk_Task(reply, group, *it,
+                                                                   m_DiskCache.get()));
             guards.push_back(make_shared<CPSG_Task_Guard>(*task));
             group.AddTask(task);
         }
@@ -2897,6 +3118,46 @@ void CPSGDataLoader_Impl::LoadChunksOnce(CDataSource* data_source,
 }
 
 
+bool CPSGDataLoader_Impl::x_LoadChunkFromDiskCache(CDataLoader::TChunk chunk)
+{
+    const CPsgBlobId& blob_id = dynamic_cast<const CPsgBlobId&>(*chunk->GetBlobId());
+    if ( blob_id.GetId2Info().empty() ) {
+        return false;
+    }
+    CPSGDiskCache::SChunkData chunk_data;
+    if ( !m_DiskCache->Get(blob_id.GetId2Info(), chunk->GetChunkId(), chunk_data) ) {
+        return false;
+    }
+    // The record is parsed completely before anything is attached to the
+    // chunk so a damaged record never leaves the chunk half-loaded
+    CRef<CID2S_Chunk> id2_chunk(new CID2S_Chunk);
+    try {
+        CNcbiIstrstream data_stream(chunk_data.data);
+        unique_ptr<CObjectIStream> in(GetBlobDataStream(chunk_data.format,
+                                                        chunk_data.compression,
+                                                        data_stream));
+        if ( !in ) {
+            m_DiskCache->Remove(blob_id.GetId2Info(), chunk->GetChunkId());
+            return false;
+        }
+        *in >> *id2_chunk;
+    }
+    catch ( CException& exc ) {
+        // A damaged record; the chunk will be loaded from PSG and re-cached
+        _TRACE("Failed to read chunk " << chunk->GetChunkId() << " from disk cache: " << exc.what());
+        m_DiskCache->Remove(blob_id.GetId2Info(), chunk->GetChunkId());
+        return false;
+    }
+    if ( s_GetDebugLevel() >= 8 ) {
+        LOG_POST(Info<<"PSG loader: TSE "<<chunk->GetBlobId().ToString()<<" "<<
+                 " chunk "<<chunk->GetChunkId()<<" from disk cache "<<MSerial_AsnText<<*id2_chunk);
+    }
+    CSplitParser::Load(*chunk, *id2_chunk);
+    chunk->SetLoaded();
+    return true;
+}
+
+
 class CPSG_AnnotRecordsNA_Task : public CPSG_Task
 {
 public:
@@ -3460,12 +3721,14 @@ void CPSGDataLoader_Impl::GetCDDAnnotsOnce(CDataSource* data_source,
                     AutoPtr<CInitGuard> chunk_load_lock = chunk.GetLoadInitGuard();
                     if ( chunk_load_lock.get() && *chunk_load_lock.get() ) {
                         load_lock->SetSeq_entry(*entry);
+                        chunk.x_AddUsedMemory(s_GetUsedMemory(*in));
                         chunk.SetLoaded();
                     }
                 }
             }
             else {
                 load_lock->SetSeq_entry(*entry);
+                load_lock->AddUsedMemory(s_GetUsedMemory(*in));
                 load_lock.SetLoaded();
             }
             if ( !x_IsEmptyCDD(*load_lock) ) {
@@ -4229,6 +4492,7 @@ void CPSGDataLoader_Impl::x_ReadBlobData(
         }
         load_lock->SetSeq_entry(*entry);
     }
+    load_lock->AddUsedMemory(s_GetUsedMemory(*in));
     if ( m_AddWGSMasterDescr ) {
         CWGSMasterSupport::AddWGSMaster(load_lock);
     }
@@ -4255,37 +4519,47 @@ CObjectIStream* CPSGDataLoader_Impl::GetBlobDataStream(
     const CPSG_BlobInfo& blob_info,
     const CPSG_BlobData& blob_data)
 {
-    istream& data_stream = blob_data.GetStream();
+    return GetBlobDataStream(blob_info.GetFormat(),
+                             blob_info.GetCompression(),
+                             blob_data.GetStream());
+}
+
+
+CObjectIStream* CPSGDataLoader_Impl::GetBlobDataStream(
+    const string& format,
+    const string& compression,
+    CNcbiIstream& data_stream)
+{
     CNcbiIstream* in = &data_stream;
     unique_ptr<CNcbiIstream> z_stream;
     CObjectIStream* ret = nullptr;
 
-    if (blob_info.GetCompression() == "gzip") {
+    if (compression == "gzip") {
         z_stream.reset(new CCompressionIStream(data_stream,
                                                new CZipStreamDecompressor(CZipCompression::fGZip),
                                                CCompressionIStream::fOwnProcessor));
         in = z_stream.get();
     }
-    else if (!blob_info.GetCompression().empty()) {
-        _TRACE("Unsupported data compression: '" << blob_info.GetCompression() << "'");
+    else if (!compression.empty()) {
+        _TRACE("Unsupported data compression: '" << compression << "'");
         return nullptr;
     }
 
     EOwnership own = z_stream.get() ? eTakeOwnership : eNoOwnership;
-    if (blob_info.GetFormat() == "asn.1") {
+    if (format == "asn.1") {
         ret = CObjectIStream::Open(eSerial_AsnBinary, *in, own);
     }
-    else if (blob_info.GetFormat() == "asn1-text") {
+    else if (format == "asn1-text") {
         ret = CObjectIStream::Open(eSerial_AsnText, *in, own);
     }
-    else if (blob_info.GetFormat() == "xml") {
+    else if (format == "xml") {
         ret = CObjectIStream::Open(eSerial_Xml, *in, own);
     }
-    else if (blob_info.GetFormat() == "json") {
+    else if (format == "json") {
         ret = CObjectIStream::Open(eSerial_Json, *in, own);
     }
     else {
-        _TRACE("Unsupported data format: '" << blob_info.GetFormat() << "'");
+        _TRACE("Unsupported data format: '" << format << "'");
         return nullptr;
     }
     _ASSERT(ret);
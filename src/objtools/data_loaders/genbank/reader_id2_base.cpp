@@ -64,8 +64,12 @@
 
 #include <corelib/plugin_manager_store.hpp>
 #include <corelib/ncbi_safe_static.hpp>
+#include <corelib/ncbi_limits.hpp>
+
+#include <util/thread_pool.hpp>
 
 #include <iomanip>
+#include <deque>
 
 
 #define NCBI_USE_ERRCODE_X   Objtools_Rd_Id2Base
@@ -98,6 +102,7 @@ NCBI_PARAM_DECL(string, GENBANK, ID2_PROCESSOR);
 NCBI_PARAM_DECL(bool, GENBANK, VDB_WGS);
 NCBI_PARAM_DECL(bool, GENBANK, VDB_SNP);
 NCBI_PARAM_DECL(bool, GENBANK, VDB_CDD);
+NCBI_PARAM_DECL(unsigned, GENBANK, ID2_DECODE_THREADS);
 
 #ifdef _DEBUG
 # define DEFAULT_DEBUG_LEVEL CId2ReaderBase::eTraceError
@@ -119,6 +124,8 @@ NCBI_PARAM_DEF_EX(bool, GENBANK, VDB_SNP, true,
                   eParam_NoThread, GENBANK_VDB_SNP);
 NCBI_PARAM_DEF_EX(bool, GENBANK, VDB_CDD, true,
     eParam_NoThread, GENBANK_VDB_CDD);
+NCBI_PARAM_DEF_EX(unsigned, GENBANK, ID2_DECODE_THREADS, 0,
+                  eParam_NoThread, GENBANK_ID2_DECODE_THREADS);
 
 typedef NCBI_PARAM_TYPE(GENBANK, VDB_WGS) TGenbankVdbWgsParam;
 typedef NCBI_PARAM_TYPE(GENBANK, VDB_SNP) TGenbankVdbSnpParam;
@@ -237,18 +244,25 @@ struct SId2LoadedSet
     typedef map<CSeq_id_Handle, TBlob_idsInfo> TBlob_idSet;
     typedef map<CBlob_id, CConstRef<CID2_Reply_Data> > TSkeletons;
     typedef map<CBlob_id, int> TBlobStates;
+    typedef map<const CID2_Reply_Data*,
+                CConstRef<CProcessor_ID2::CDecodedData> > TDecodedData;
 
     TSeq_idSeq_idsSet   m_Seq_ids;
     TBlob_idSet         m_Blob_ids;
     TSkeletons          m_Skeletons;
     TBlobStates         m_BlobStates;
+    TDecodedData        m_DecodedData; // of the reply being processed
 };
 
 
 CId2ReaderBase::CId2ReaderBase(void)
     : m_RequestSerialNumber(1),
-      m_AvoidRequest(0)
+      m_AvoidRequest(0),
+      m_DecodeThreads(NCBI_PARAM_TYPE(GENBANK, ID2_DECODE_THREADS)::GetDefault())
 {
+    if ( m_DecodeThreads ) {
+        m_DecodePool.reset(new CThreadPool(kMax_UInt, m_DecodeThreads, 1));
+    }
     vector<string> proc_list;
     string proc_param = NCBI_PARAM_TYPE(GENBANK, ID2_PROCESSOR)::GetDefault();
     NStr::Split(proc_param, ";", proc_list);
@@ -2296,6 +2310,108 @@ bool CId2ReaderBase::x_DoneReply(SId2PacketInfo& info,
 }
 
 
+// Decoding of blob or chunk data in a thread of the decode pool.
+// The data is attached to the data source later by the thread that
+// processes the replies, in the order the replies were received.
+class CId2DecodeTask : public CThreadPool_Task
+{
+public:
+    CId2DecodeTask(const CID2_Reply& reply, const CID2_Reply_Data& data)
+        : m_Reply(&reply),
+          m_Data(data),
+          m_Done(0, 1)
+        {
+        }
+
+    virtual EStatus Execute(void) override
+        {
+            try {
+                m_Decoded = CProcessor_ID2::DecodeData(m_Data);
+            }
+            catch ( exception& /*ignored*/ ) {
+                // the data will be decoded again by the processing thread
+                // so that the error is reported in the usual way
+                m_Decoded = null;
+            }
+            m_Done.Post();
+            return eCompleted;
+        }
+
+    CConstRef<CProcessor_ID2::CDecodedData> GetDecodedData(void)
+        {
+            m_Done.Wait();
+            return m_Decoded;
+        }
+
+private:
+    CConstRef<CID2_Reply> m_Reply; // keeps m_Data alive
+    const CID2_Reply_Data& m_Data;
+    CRef<CProcessor_ID2::CDecodedData> m_Decoded;
+    CSemaphore m_Done;
+};
+
+
+// Returns the reply data that can be decoded before the preceding replies
+// are processed, i.e. the data that is attached independently of the other
+// replies in the packet.
+static
+const CID2_Reply_Data* sx_GetDataToDecodeInAdvance(const CID2_Reply& reply)
+{
+    if ( !reply.IsSetReply() ) {
+        return 0;
+    }
+    const CID2_Reply_Data* data = 0;
+    const CID2_Reply::TReply& r = reply.GetReply();
+    if ( r.IsGet_chunk() ) {
+        if ( r.GetGet_chunk().IsSetData() ) {
+            data = &r.GetGet_chunk().GetData();
+            if ( data->GetData_type() != data->eData_type_id2s_chunk ) {
+                return 0;
+            }
+        }
+    }
+    else if ( r.IsGet_blob() ) {
+        const CID2_Reply_Get_Blob& get_blob = r.GetGet_blob();
+        if ( get_blob.IsSetData() &&
+             get_blob.GetSplit_version() == 0 &&
+             get_blob.GetBlob_id().GetSub_sat() != CID2_Blob_Id::eSub_sat_snp ) {
+            data = &get_blob.GetData();
+            if ( data->GetData_type() != data->eData_type_seq_entry ) {
+                return 0;
+            }
+        }
+    }
+    if ( data && data->GetData().empty() ) {
+        return 0;
+    }
+    return data;
+}
+
+
+static
+const CProcessor_ID2::CDecodedData*
+sx_GetDecodedData(const SId2LoadedSet& loaded_set,
+                  const CID2_Reply_Data& data)
+{
+    SId2LoadedSet::TDecodedData::const_iterator it =
+        loaded_set.m_DecodedData.find(&data);
+    if ( it != loaded_set.m_DecodedData.end() ) {
+        return it->second.GetPointer();
+    }
+    return 0;
+}
+
+
+struct SId2PendingReply
+{
+    int num;
+    CRef<CID2_Reply> reply;
+    const CID2_Request* request;
+    bool done;
+    CRef<CId2DecodeTask> task;
+};
+
+
 void CId2ReaderBase::x_ProcessPacket(CReaderRequestResult& result,
                                      CID2_Request_Packet& packet,
                                      const SAnnotSelector* sel)
@@ -2305,8 +2421,46 @@ void CId2ReaderBase::x_ProcessPacket(CReaderRequestResult& result,
 
     vector<SId2LoadedSet> loaded_sets(packet_info.request_count);
 
+    // replies received but not processed yet,
+    // their data is being decoded by the decode pool
+    deque<SId2PendingReply> pending;
+    const size_t max_pending = 2*m_DecodeThreads;
+
     SId2ProcessingState state;
     CRef<CID2_Reply> reply;
+    auto process_reply = [&](SId2PendingReply& p) {
+        SId2LoadedSet& loaded_set = loaded_sets[p.num];
+        if ( p.task ) {
+            const CID2_Reply_Data* data =
+                sx_GetDataToDecodeInAdvance(*p.reply);
+            if ( auto decoded = p.task->GetDecodedData() ) {
+                loaded_set.m_DecodedData[data] = decoded;
+            }
+        }
+        try {
+            x_ProcessReply(result, loaded_set, *p.reply, *p.request);
+        }
+        catch ( CLoaderException& /*rethrown*/ ) {
+            throw;
+        }
+        catch ( CException& exc ) {
+            NCBI_RETHROW(exc, CLoaderException, eOtherError,
+                         "CId2ReaderBase: failed to process reply: "+
+                         x_ConnDescription(state.GetConn()));
+        }
+        loaded_set.m_DecodedData.clear();
+        if ( p.done ) {
+            x_UpdateLoadedSet(result, loaded_set, sel);
+        }
+    };
+    auto process_pending = [&](size_t max_count) {
+        while ( pending.size() > max_count ) {
+            reply = pending.front().reply;
+            process_reply(pending.front());
+            pending.pop_front();
+            reply.Reset();
+        }
+    };
     try {
         // send request
         x_SendID2Packet(result, state, packet);
@@ -2316,23 +2470,30 @@ void CId2ReaderBase::x_ProcessPacket(CReaderRequestResult& result,
             reply = x_ReceiveID2Reply(state);
             int num = x_GetReplyIndex(result, state.conn.get(), packet_info, *reply);
             if ( num >= 0 ) {
-                try {
-                    x_ProcessReply(result, loaded_sets[num], *reply, *packet_info.requests[num]);
+                SId2PendingReply p;
+                p.num = num;
+                p.reply = reply;
+                p.request = packet_info.requests[num];
+                p.done = x_DoneReply(packet_info, num, *reply);
+                const CID2_Reply_Data* data = m_DecodePool?
+                    sx_GetDataToDecodeInAdvance(*reply): 0;
+                if ( data ) {
+                    p.task = new CId2DecodeTask(*reply, *data);
+                    m_DecodePool->AddTask(p.task);
+                    pending.push_back(p);
+                    reply.Reset();
+                    process_pending(max_pending);
                 }
-                catch ( CLoaderException& /*rethrown*/ ) {
-                    throw;
-                }
-                catch ( CException& exc ) {
-                    NCBI_RETHROW(exc, CLoaderException, eOtherError,
-                                 "CId2ReaderBase: failed to process reply: "+
-                                 x_ConnDescription(state.GetConn()));
-                }
-                if ( x_DoneReply(packet_info, num, *reply) ) {
-                    x_UpdateLoadedSet(result, loaded_sets[num], sel);
+                else {
+                    // this reply may depend on the preceding ones
+                    process_pending(0);
+                    reply = p.reply;
+                    process_reply(p);
                 }
             }
             reply.Reset();
         }
+        process_pending(0);
         if ( state.conn ) {
             x_EndOfPacket(*state.conn);
         }
@@ -3188,7 +3349,8 @@ void CId2ReaderBase::x_ProcessGetBlob(
     else {
         dynamic_cast<const CProcessor_ID2&>
             (m_Dispatcher->GetProcessor(CProcessor::eType_ID2))
-            .ProcessData(result, blob_id, blob_state, chunk_id, data);
+            .ProcessData(result, blob_id, blob_state, chunk_id, data, 0, 0,
+                         sx_GetDecodedData(loaded_set, data));
     }
     _ASSERT(blob.IsLoadedChunk());
 }
@@ -3276,7 +3438,7 @@ void CId2ReaderBase::x_ProcessGetSplitInfo(
 
 void CId2ReaderBase::x_ProcessGetChunk(
     CReaderRequestResult& result,
-    SId2LoadedSet& /*loaded_set*/,
+    SId2LoadedSet& loaded_set,
     const CID2_Reply& /*main_reply*/,
     const CID2S_Reply_Get_Chunk& reply)
 {
@@ -3295,7 +3457,8 @@ void CId2ReaderBase::x_ProcessGetChunk(
     
     dynamic_cast<const CProcessor_ID2&>
         (m_Dispatcher->GetProcessor(CProcessor::eType_ID2))
-        .ProcessData(result, blob_id, 0, reply.GetChunk_id(), reply.GetData());
+        .ProcessData(result, blob_id, 0, reply.GetChunk_id(), reply.GetData(),
+                     0, 0, sx_GetDecodedData(loaded_set, reply.GetData()));
 }
 
 
@@ -101,24 +101,58 @@ ERW_Result SPSG_BlobReader::x_Read(void* buf, size_t count, size_t* bytes_read)
 
         if (!count) return eRW_Success;
 
+        // Chunk has been read completely, it is not needed anymore
+        data = SPSG_Chunk();
         m_Index = 0;
     }
 
+    return x_GetEofStatus();
+}
+
+ERW_Result SPSG_BlobReader::x_ReadInPlace(const char** data, size_t* size)
+{
+    assert(data);
+    assert(size);
+
+    *size = 0;
+
+    CheckForNewChunks();
+
+    for (; m_Chunk < m_Data.size(); ++m_Chunk, m_Index = 0) {
+        auto& chunk = m_Data[m_Chunk];
+
+        // Chunk has not been received yet
+        if (chunk.empty()) return eRW_Success;
+
+        if (m_Index < chunk.size()) {
+            *data = chunk.data() + m_Index;
+            *size = chunk.size() - m_Index;
+            m_Index = chunk.size();
+            return eRW_Success;
+        }
+
+        // Chunk has been provided completely, it is not needed anymore
+        chunk = SPSG_Chunk();
+    }
+
+    return x_GetEofStatus();
+}
+
+ERW_Result SPSG_BlobReader::x_GetEofStatus()
+{
     auto src_locked = m_Src.GetLock();
     return src_locked->expected.Cmp<equal_to>(src_locked->received) ? eRW_Eof : eRW_Success;
 }
 
-ERW_Result SPSG_BlobReader::Read(void* buf, size_t count, size_t* bytes_read)
+template <class TRead>
+ERW_Result SPSG_BlobReader::x_Wait(TRead read)
 {
-    size_t read;
     const auto kSeconds = TPSG_ReaderTimeout::GetDefault();
     CDeadline deadline(kSeconds);
 
     do {
-        auto rv = x_Read(buf, count, &read);
-
-        if ((rv != eRW_Success) || (read != 0)) {
-            if (bytes_read) *bytes_read = read;
+        // Stop waiting if there is some data or an error/EOF
+        if (auto [rv, read_some] = read(); (rv != eRW_Success) || read_some) {
             return rv;
         }
     }
@@ -128,6 +162,21 @@ ERW_Result SPSG_BlobReader::Read(void* buf, size_t count, size_t* bytes_read)
     return eRW_Error;
 }
 
+ERW_Result SPSG_BlobReader::Read(void* buf, size_t count, size_t* bytes_read)
+{
+    size_t read;
+
+    auto rv = x_Wait([&]() { auto r = x_Read(buf, count, &read); return make_pair(r, read != 0); });
+
+    if (bytes_read) *bytes_read = read;
+    return rv;
+}
+
+ERW_Result SPSG_BlobReader::ReadInPlace(const char** data, size_t* size)
+{
+    return x_Wait([&]() { auto r = x_ReadInPlace(data, size); return make_pair(r, *size != 0); });
+}
+
 ERW_Result SPSG_BlobReader::PendingCount(size_t* count)
 {
     assert(count);
@@ -168,6 +217,42 @@ void SPSG_BlobReader::CheckForNewChunks()
 }
 
 
+SPSG_BlobStreambuf::int_type SPSG_BlobStreambuf::underflow()
+{
+    const char* data = nullptr;
+    size_t size = 0;
+
+    m_Position += egptr() - eback();
+
+    if (m_Reader.ReadInPlace(&data, &size) != eRW_Success) {
+        setg(nullptr, nullptr, nullptr);
+        return traits_type::eof();
+    }
+
+    // The get area is never written to
+    auto begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+    return traits_type::to_int_type(*begin);
+}
+
+streamsize SPSG_BlobStreambuf::showmanyc()
+{
+    size_t count = 0;
+    m_Reader.PendingCount(&count);
+    return static_cast<streamsize>(count);
+}
+
+SPSG_BlobStreambuf::pos_type SPSG_BlobStreambuf::seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which)
+{
+    // Only tellg() is supported
+    if ((off == 0) && (dir == ios_base::cur) && (which & ios_base::in)) {
+        return m_Position + (gptr() - eback());
+    }
+
+    return pos_type(off_type(-1));
+}
+
+
 const char* s_GetRequestTypeName(CPSG_Request::EType type)
 {
     switch (type) {
@@ -971,7 +1056,8 @@ shared_ptr<CPSG_Reply> CPSG_Queue::SImpl::SendRequestAndGetReply(shared_ptr<CPSG
 
     _ASSERT(request_context);
 
-    auto request = make_shared<SPSG_Request>(std::move(abs_path_ref), reply, request_context->Clone(), params);
+    const auto priority = params.prioritize_resolve && ((type == CPSG_Request::eResolve) || (type == CPSG_Request::eIpgResolve));
+    auto request = make_shared<SPSG_Request>(std::move(abs_path_ref), reply, request_context->Clone(), params, priority);
 
     if (ioc.AddRequest(request, queue->Stopped(), deadline)) {
         if (stats) stats->IncCounter(SPSG_Stats::eRequest, type);
@@ -45,8 +45,7 @@
 
 BEGIN_NCBI_SCOPE
 
-// ICC does not like this array to be a direct base of SPSG_RStream
-struct SPSG_BlobReader : IReader, protected array<char, 64 * 1024>
+struct SPSG_BlobReader : IReader
 {
     using TStats = pair<bool, weak_ptr<SPSG_Stats>>;
     SPSG_BlobReader(SPSG_Reply::SItem::TTS& src, TStats stats = TStats());
@@ -54,9 +53,18 @@ struct SPSG_BlobReader : IReader, protected array<char, 64 * 1024>
     ERW_Result Read(void* buf, size_t count, size_t* bytes_read = 0);
     ERW_Result PendingCount(size_t* count);
 
+    // Provides the next part of received data in place (without copying).
+    // The part remains valid until the next call, then its memory is released.
+    ERW_Result ReadInPlace(const char** data, size_t* size);
+
 private:
     void CheckForNewChunks();
     ERW_Result x_Read(void* buf, size_t count, size_t* bytes_read);
+    ERW_Result x_ReadInPlace(const char** data, size_t* size);
+    ERW_Result x_GetEofStatus();
+
+    template <class TRead>
+    ERW_Result x_Wait(TRead read);
 
     SPSG_Reply::SItem::TTS& m_Src;
     TStats m_Stats;
@@ -65,12 +73,29 @@ private:
     size_t m_Index = 0;
 };
 
-struct SPSG_RStream : private SPSG_BlobReader, public CRStream
+// Stream buffer using received data as its get area,
+// so data is copied only once (into the buffer provided by the stream user)
+struct SPSG_BlobStreambuf : streambuf
+{
+    SPSG_BlobStreambuf(SPSG_BlobReader& reader) : m_Reader(reader) {}
+
+protected:
+    int_type underflow() override;
+    streamsize showmanyc() override;
+    pos_type seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which) override;
+
+private:
+    SPSG_BlobReader& m_Reader;
+    streamsize m_Position = 0;
+};
+
+struct SPSG_RStream : private SPSG_BlobReader, private SPSG_BlobStreambuf, public CNcbiIstream
 {
     template <class... TArgs>
     SPSG_RStream(TArgs&&... args) :
         SPSG_BlobReader(std::forward<TArgs>(args)...),
-        CRStream(this, size(), data())
+        SPSG_BlobStreambuf(static_cast<SPSG_BlobReader&>(*this)),
+        CNcbiIstream(static_cast<SPSG_BlobStreambuf*>(this))
     {}
 };
 
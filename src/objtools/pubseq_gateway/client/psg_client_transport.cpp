@@ -68,6 +68,9 @@ PSG_PARAM_VALUE_DEF_MIN(double,         PSG, rebalance_time,                10.0
 PSG_PARAM_VALUE_DEF_MIN(size_t,         PSG, requests_per_io,               1,                  1       );
 PSG_PARAM_VALUE_DEF_MIN(double,         PSG, io_timer_period,               1.0,                0.1     );
 NCBI_PARAM_DEF(double,   PSG, request_timeout,        10.0);
+NCBI_PARAM_DEF(bool,     PSG, adaptive_concurrency,   false);
+NCBI_PARAM_DEF(double,   PSG, adaptive_concurrency_latency_ratio, 2.0);
+NCBI_PARAM_DEF(bool,     PSG, prioritize_resolve,     true);
 NCBI_PARAM_DEF(double,   PSG, competitive_after,      0.0);
 NCBI_PARAM_DEF(unsigned, PSG, request_retries,        2);
 NCBI_PARAM_DEF(unsigned, PSG, refused_stream_retries, 2);
@@ -608,7 +611,8 @@ void SPSG_Stats::Report()
 
     for (const auto& server : *servers_locked) {
         auto n = server.stats.load();
-        if (n) ERR_POST(Note << prefix << report << "\tserver\tname=" << server.address << "&requests_sent=" << n);
+        if (n) ERR_POST(Note << prefix << report << "\tserver\tname=" << server.address << "&requests_sent=" << n <<
+                "&concurrency_limit=" << server.concurrency.Get());
     }
 }
 
@@ -743,10 +747,11 @@ shared_ptr<void> SPSG_Request::SContext::Set()
     return guard;
 }
 
-SPSG_Request::SPSG_Request(string p, shared_ptr<SPSG_Reply> r, CRef<CRequestContext> c, const SPSG_Params& params) :
+SPSG_Request::SPSG_Request(string p, shared_ptr<SPSG_Reply> r, CRef<CRequestContext> c, const SPSG_Params& params, bool pr) :
     full_path(std::move(p)),
     reply(r),
     context(c),
+    priority(pr),
     m_State(&SPSG_Request::StatePrefix),
     m_Retries(params)
 {
@@ -822,6 +827,9 @@ SPSG_Request::EStateResult SPSG_Request::StateArgs(const char*& data, size_t& le
     if (size) {
         m_State = &SPSG_Request::StateData;
         m_Buffer.data_to_read = size;
+
+        // Data arrives in parts, allocate the whole chunk at once to avoid copying on reallocations
+        m_Buffer.chunk.reserve(size);
     } else {
         m_State = &SPSG_Request::StatePrefix;
         return Add();
@@ -1049,6 +1057,54 @@ SPSG_Request::EUpdateResult SPSG_Request::UpdateItem(SPSG_Args::EItemType item_t
 #define HTTP_STATUS_HEADER ":status"
 
 
+/** SPSG_ConcurrencyLimit */
+
+SPSG_ConcurrencyLimit::SData::SData(int max_limit) :
+    m_MaxLimit(max_limit),
+    m_MinLimit(min(max_limit, static_cast<int>(TPSG_MaxConcurrentStreams::GetDefault()))),
+    m_LatencyRatio(max(1.0, TPSG_AdaptiveConcurrencyLatencyRatio::GetDefault())),
+    m_Limit(max_limit)
+{
+}
+
+int SPSG_ConcurrencyLimit::SData::OnResponse(double latency)
+{
+    // The lowest latency slowly follows the current one, so a permanent change is eventually taken into account
+    if ((m_MinLatency <= 0.0) || (latency < m_MinLatency)) {
+        m_MinLatency = latency;
+    } else {
+        m_MinLatency += (latency - m_MinLatency) * 0.001;
+    }
+
+    m_SinceDecrease += 1.0;
+
+    if (latency > m_MinLatency * m_LatencyRatio) {
+        return Decrease(kLatencyFactor);
+    }
+
+    return Set(m_Limit + 1.0 / m_Limit);
+}
+
+int SPSG_ConcurrencyLimit::SData::Decrease(double factor)
+{
+    // Decrease not more than once per limit responses (as responses to the requests sent before the decrease
+    // are likely to be affected the same way)
+    if (m_SinceDecrease < m_Limit) {
+        return 0;
+    }
+
+    m_SinceDecrease = 0.0;
+    return Set(m_Limit * factor);
+}
+
+int SPSG_ConcurrencyLimit::SData::Set(double limit)
+{
+    const auto before = Get();
+    m_Limit = max(m_MinLimit, min(m_MaxLimit, limit));
+    return Get() - before;
+}
+
+
 /** SPSG_IoSession */
 
 template <class... TNgHttp2Cbs>
@@ -1173,6 +1229,10 @@ int SPSG_IoSession::OnStreamClose(nghttp2_session*, int32_t stream_id, uint32_t
             if (error_code) {
                 auto error(SUvNgHttp2_Error::FromNgHttp2(error_code, "on close"));
 
+                if (m_Params.adaptive_concurrency && (error_code == NGHTTP2_REFUSED_STREAM)) {
+                    AdjustConcurrency(server.concurrency.OnOverload());
+                }
+
                 if (RetryFail(processor_id, req, error, error_code == NGHTTP2_REFUSED_STREAM)) {
                     ERR_POST("Request for " << GetId() << " failed with " << error);
                 }
@@ -1209,6 +1269,14 @@ int SPSG_IoSession::OnHeader(nghttp2_session*, const nghttp2_frame* frame, const
             const auto request_status = static_cast<CRequestStatus::ECode>(atoi(status_str));
             const auto status = SPSG_Reply::SState::FromRequestStatus(request_status);
 
+            if (!m_Params.adaptive_concurrency) {
+                // Not adjusting the limit
+            } else if (request_status == CRequestStatus::e503_ServiceUnavailable) {
+                AdjustConcurrency(server.concurrency.OnOverload());
+            } else {
+                AdjustConcurrency(server.concurrency.OnResponse(it->second.GetLatency()));
+            }
+
             if (status != EPSG_Status::eSuccess) {
                 if (auto [processor_id, req] = it->second.Get(); req) {
                     const auto error = to_string(request_status) + ' ' + CRequestStatus::GetStdStatusMessage(request_status);
@@ -1248,7 +1316,11 @@ bool SPSG_IoSession::ProcessRequest(SPSG_TimedRequest timed_req, SPSG_Processor:
         --headers_size;
     }
 
-    auto stream_id = m_Session.Submit(m_Headers.data(), headers_size);
+    // Let the server send priority replies ahead of regular ones sharing the same connection
+    nghttp2_priority_spec pri_spec;
+    nghttp2_priority_spec_init(&pri_spec, 0, NGHTTP2_MAX_WEIGHT, 0);
+
+    auto stream_id = m_Session.Submit(m_Headers.data(), headers_size, nullptr, req->priority ? &pri_spec : nullptr);
 
     if (stream_id < 0) {
         auto error(SUvNgHttp2_Error::FromNgHttp2(stream_id, "on submit"));
@@ -1264,6 +1336,7 @@ bool SPSG_IoSession::ProcessRequest(SPSG_TimedRequest timed_req, SPSG_Processor:
     req->submitted_by.Set(GetInternalId());
     req->reply->debug_printout << server.address << path << session_id << sub_hit_id << client_ip << m_Tcp.GetLocalPort() << endl;
     PSG_IO_SESSION_TRACE(this << '/' << stream_id << " submitted");
+    if (m_Params.adaptive_concurrency) timed_req.SetSubmitTime();
     m_Requests.emplace(stream_id, std::move(timed_req));
     return Send();
 }
@@ -1300,9 +1373,10 @@ void SPSG_IoSession::CheckRequestExpiration()
 {
     SUvNgHttp2_Error error("Request timeout for ");
     error << GetId();
+    bool timed_out = false;
 
     auto on_retry = [&](auto req) { m_Queue.Emplace(req); m_Queue.Signal(); };
-    auto on_fail = [&](auto processor_id, auto req) { Fail(processor_id, req, error); };
+    auto on_fail = [&](auto processor_id, auto req) { Fail(processor_id, req, error); timed_out = true; };
 
     for (auto it = m_Requests.begin(); it != m_Requests.end(); ) {
         if (it->second.CheckExpiration(m_Params, error, on_retry, on_fail)) {
@@ -1311,6 +1385,10 @@ void SPSG_IoSession::CheckRequestExpiration()
             ++it;
         }
     }
+
+    if (timed_out && m_Params.adaptive_concurrency) {
+        AdjustConcurrency(server.concurrency.OnOverload());
+    }
 }
 
 void SPSG_IoSession::OnReset(SUvNgHttp2_Error error)
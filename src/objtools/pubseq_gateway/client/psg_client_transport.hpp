@@ -212,6 +212,8 @@ struct SPSG_Params
     TPSG_DebugPrintout debug_printout;
     TPSG_MaxConcurrentSubmits max_concurrent_submits;
     TPSG_MaxConcurrentRequestsPerServer max_concurrent_requests_per_server;
+    TPSG_AdaptiveConcurrency adaptive_concurrency;
+    TPSG_PrioritizeResolve prioritize_resolve;
     TPSG_RequestsPerIo requests_per_io;
     TPSG_IoTimerPeriod io_timer_period;
     const unsigned request_timeout;
@@ -230,6 +232,8 @@ struct SPSG_Params
         debug_printout(TPSG_DebugPrintout::eGetDefault),
         max_concurrent_submits(TPSG_MaxConcurrentSubmits::eGetDefault),
         max_concurrent_requests_per_server(TPSG_MaxConcurrentRequestsPerServer::eGetDefault),
+        adaptive_concurrency(TPSG_AdaptiveConcurrency::eGetDefault),
+        prioritize_resolve(TPSG_PrioritizeResolve::eGetDefault),
         requests_per_io(TPSG_RequestsPerIo::eGetDefault),
         io_timer_period(TPSG_IoTimerPeriod::eGetDefault),
         request_timeout(s_GetRequestTimeout(io_timer_period)),
@@ -515,7 +519,10 @@ struct SPSG_Request
     SPSG_Submitter submitted_by;
     SPSG_Processor processed_by;
 
-    SPSG_Request(string p, shared_ptr<SPSG_Reply> r, CRef<CRequestContext> c, const SPSG_Params& params);
+    // Priority requests (e.g. resolve) overtake regular ones (e.g. blob retrievals)
+    const bool priority;
+
+    SPSG_Request(string p, shared_ptr<SPSG_Reply> r, CRef<CRequestContext> c, const SPSG_Params& params, bool pr = false);
 
     enum EStateResult { eContinue, eStop, eRetry };
     EStateResult OnReplyData(SPSG_Processor::TId processor_id, const char* data, size_t len)
@@ -590,6 +597,12 @@ struct SPSG_TimedRequest
     unsigned AddTime() { return ++m_Time; }
     void ResetTime() { m_Time = 0; }
 
+    bool IsPriority() const { _ASSERT(m_Request); return m_Request->priority; }
+
+    // Time since the request was submitted to a server (used by adaptive concurrency)
+    void SetSubmitTime() { m_Submitted = chrono::steady_clock::now(); }
+    double GetLatency() const { return chrono::duration<double>(chrono::steady_clock::now() - m_Submitted).count(); }
+
     template <class TOnRetry, class TOnFail>
     bool CheckExpiration(const SPSG_Params& params, const SUvNgHttp2_Error& error, TOnRetry on_retry, TOnFail on_fail);
 
@@ -597,6 +610,7 @@ private:
     SPSG_Processor::TId m_Id;
     shared_ptr<SPSG_Request> m_Request;
     unsigned m_Time = 0;
+    chrono::steady_clock::time_point m_Submitted;
 };
 
 struct SPSG_AsyncQueue;
@@ -635,7 +649,16 @@ public:
     template <class... TArgs>
     void Emplace(TArgs&&... args)
     {
-        m_Queue.GetLock()->emplace_back(std::forward<TArgs>(args)...);
+        SPSG_TimedRequest timed_req(std::forward<TArgs>(args)...);
+        auto locked = m_Queue.GetLock();
+        auto it = locked->end();
+
+        // Priority requests are placed after other priority requests but before all regular ones
+        if (timed_req.IsPriority()) {
+            for (it = locked->begin(); (it != locked->end()) && it->IsPriority(); ++it);
+        }
+
+        locked->emplace(it, std::move(timed_req));
     }
 
     auto GetLockedQueue() { return m_Queue.GetLock(); }
@@ -727,6 +750,47 @@ private:
     SUv_Async m_Signal;
 };
 
+// AIMD limit of concurrent requests to a server.
+// The limit grows additively (by one per limit responses) while the latency of responses
+// stays within the configured ratio of the lowest latency observed recently.
+// It shrinks multiplicatively if the latency grows above that or if the server is overloaded
+// (refuses streams, replies with 503 or times out).
+struct SPSG_ConcurrencyLimit
+{
+    SPSG_ConcurrencyLimit(int max_limit) : m_Data(max_limit) {}
+
+    // All these return the change of the limit
+    int OnResponse(double latency) { return m_Data.GetLock()->OnResponse(latency); }
+    int OnOverload() { return m_Data.GetLock()->Decrease(SData::kOverloadFactor); }
+
+    int Get() const { return m_Data.GetLock()->Get(); }
+
+private:
+    struct SData
+    {
+        static constexpr double kLatencyFactor = 0.9;
+        static constexpr double kOverloadFactor = 0.5;
+
+        SData(int max_limit);
+
+        int OnResponse(double latency);
+        int Decrease(double factor);
+        int Get() const { return static_cast<int>(m_Limit); }
+
+    private:
+        int Set(double limit);
+
+        const double m_MaxLimit;
+        const double m_MinLimit;
+        const double m_LatencyRatio;
+        double m_Limit;
+        double m_MinLatency = 0.0;
+        double m_SinceDecrease = 0.0;
+    };
+
+    SThreadSafe<SData> m_Data;
+};
+
 struct SPSG_Server
 {
     const SSocketAddress address;
@@ -734,13 +798,15 @@ struct SPSG_Server
     atomic_int available_streams;
     atomic_uint stats;
     SPSG_Throttling throttling;
+    SPSG_ConcurrencyLimit concurrency;
 
     SPSG_Server(SSocketAddress a, double r, int as, SPSG_ThrottleParams p, uv_loop_t* l) :
         address(std::move(a)),
         rate(r),
         available_streams(as),
         stats(0),
-        throttling(address, std::move(p), l)
+        throttling(address, std::move(p), l),
+        concurrency(as)
     {}
 };
 
@@ -796,6 +862,14 @@ struct SPSG_IoSession : SUvNgHttp2_SessionBase
         }
     }
 
+    void AdjustConcurrency(int delta)
+    {
+        if (delta) {
+            PSG_IO_TRACE("Server '" << server.address << "' concurrency limit changed by " << delta);
+            AddStreams(delta);
+        }
+    }
+
     void AddStreams(int v)
     {
         if (auto before = server.available_streams.fetch_add(v); (before <= 0) && (before + v > 0) ) {
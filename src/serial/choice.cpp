@@ -207,6 +207,11 @@ bool CChoiceTypeInfo::Equals(TConstObjectPtr object1, TConstObjectPtr object2,
         }
     }
 
+    if ( TTypeEqualsFunction equals = GetEqualsFunction() ) {
+        // generated comparison
+        return equals(object1, object2, how);
+    }
+
     TMemberIndex index;
 
     index = GetVariants().FirstIndex();
@@ -253,6 +258,13 @@ void CChoiceTypeInfo::CallUserOp_Assign(TObjectPtr dst,
 void CChoiceTypeInfo::Assign(TObjectPtr dst, TConstObjectPtr src,
                              ESerialRecursionMode how) const
 {
+    if ( TTypeAssignFunction assign = GetAssignFunction() ) {
+        // generated assignment
+        assign(dst, src, how);
+        CallUserOp_Assign(dst, src);
+        return;
+    }
+
     TMemberIndex index;
 
     index = GetVariants().FirstIndex();
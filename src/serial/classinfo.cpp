@@ -37,6 +37,8 @@
 #include <serial/impl/classinfo.hpp>
 #include <serial/objistr.hpp>
 #include <serial/objostr.hpp>
+#include <serial/objistrasnb.hpp>
+#include <serial/objostrasnb.hpp>
 #include <serial/objcopy.hpp>
 #include <serial/delaybuf.hpp>
 #include <serial/impl/stdtypes.hpp>
@@ -84,6 +86,8 @@ void CClassTypeInfo::InitClassTypeInfo(void)
 {
     m_ClassType = eSequential;
     m_ParentClassInfo = 0;
+    m_DirectReadFunction = 0;
+    m_DirectWriteFunction = 0;
 
     UpdateFunctions();
 }
@@ -109,6 +113,26 @@ CClassTypeInfo* CClassTypeInfo::SetImplicit(void)
     return this;
 }
 
+CClassTypeInfo*
+CClassTypeInfo::SetDirectFunctions(TMemberDirectReadFunction read,
+                                   TMemberDirectWriteFunction write)
+{
+    m_DirectReadFunction = read;
+    m_DirectWriteFunction = write;
+    UpdateFunctions();
+    return this;
+}
+
+TMemberDirectReadFunction CClassTypeInfo::GetDirectReadFunction(void) const
+{
+    return m_DirectReadFunction;
+}
+
+TMemberDirectWriteFunction CClassTypeInfo::GetDirectWriteFunction(void) const
+{
+    return m_DirectWriteFunction;
+}
+
 bool CClassTypeInfo::IsImplicitNonEmpty(void) const
 {
     _ASSERT(Implicit());
@@ -246,8 +270,10 @@ void CClassTypeInfo::UpdateFunctions(void)
 {
     switch ( m_ClassType ) {
     case eSequential:
-        SetReadFunction(&ReadClassSequential);
-        SetWriteFunction(&WriteClassSequential);
+        SetReadFunction(m_DirectReadFunction?
+                        &ReadClassDirect: &ReadClassSequential);
+        SetWriteFunction(m_DirectWriteFunction?
+                         &WriteClassDirect: &WriteClassSequential);
         SetCopyFunction(&CopyClassSequential);
         SetSkipFunction(&SkipClassSequential);
         break;
@@ -286,6 +312,24 @@ void CClassTypeInfo::ReadClassRandom(CObjectIStream& in,
     in.ReadClassRandom(classType, objectPtr);
 }
 
+void CClassTypeInfo::ReadClassDirect(CObjectIStream& in,
+                                     TTypeInfo objectType,
+                                     TObjectPtr objectPtr)
+{
+    const CClassTypeInfo* classType =
+        CTypeConverter<CClassTypeInfo>::SafeCast(objectType);
+
+    if ( in.GetDataFormat() == eSerial_AsnBinary ) {
+        CObjectIStreamAsnBinary& bin_in =
+            static_cast<CObjectIStreamAsnBinary&>(in);
+        if ( bin_in.GetUseDirectCodecs() ) {
+            bin_in.ReadClassDirect(classType, objectPtr);
+            return;
+        }
+    }
+    in.ReadClassSequential(classType, objectPtr);
+}
+
 void CClassTypeInfo::ReadImplicitMember(CObjectIStream& in,
                                         TTypeInfo objectType,
                                         TObjectPtr objectPtr)
@@ -333,6 +377,24 @@ void CClassTypeInfo::WriteClassSequential(CObjectOStream& out,
     out.WriteClassSequential(classType, objectPtr);
 }
 
+void CClassTypeInfo::WriteClassDirect(CObjectOStream& out,
+                                      TTypeInfo objectType,
+                                      TConstObjectPtr objectPtr)
+{
+    const CClassTypeInfo* classType =
+        CTypeConverter<CClassTypeInfo>::SafeCast(objectType);
+
+    if ( out.GetDataFormat() == eSerial_AsnBinary ) {
+        CObjectOStreamAsnBinary& bin_out =
+            static_cast<CObjectOStreamAsnBinary&>(out);
+        if ( bin_out.GetUseDirectCodecs() ) {
+            bin_out.WriteClassDirect(classType, objectPtr);
+            return;
+        }
+    }
+    out.WriteClassSequential(classType, objectPtr);
+}
+
 void CClassTypeInfo::WriteImplicitMember(CObjectOStream& out,
                                          TTypeInfo objectType,
                                          TConstObjectPtr objectPtr)
@@ -456,7 +518,12 @@ void CClassTypeInfo::SetDefault(TObjectPtr dst) const
 bool CClassTypeInfo::Equals(TConstObjectPtr object1, TConstObjectPtr object2,
                             ESerialRecursionMode how) const
 {
-    for ( TMemberIndex i = GetMembers().FirstIndex(),
+    if ( TTypeEqualsFunction equals = GetEqualsFunction() ) {
+        // generated comparison
+        if ( !equals(object1, object2, how) )
+            return false;
+    }
+    else for ( TMemberIndex i = GetMembers().FirstIndex(),
               last = GetMembers().LastIndex();
           i <= last; ++i ) {
         const CMemberInfo* info = GetMemberInfo(i);
@@ -483,7 +550,11 @@ bool CClassTypeInfo::Equals(TConstObjectPtr object1, TConstObjectPtr object2,
 void CClassTypeInfo::Assign(TObjectPtr dst, TConstObjectPtr src,
                             ESerialRecursionMode how) const
 {
-    for ( TMemberIndex i = GetMembers().FirstIndex(),
+    if ( TTypeAssignFunction assign = GetAssignFunction() ) {
+        // generated assignment
+        assign(dst, src, how);
+    }
+    else for ( TMemberIndex i = GetMembers().FirstIndex(),
               last = GetMembers().LastIndex();
           i <= last; ++i ) {
         const CMemberInfo* info = GetMemberInfo(i);
@@ -32,6 +32,7 @@
 #include <ncbi_pch.hpp>
 #include <corelib/ncbistd.hpp>
 #include <corelib/ncbithr.hpp>
+#include <corelib/ncbi_param.hpp>
 #include <serial/impl/classinfob.hpp>
 #include <serial/objectinfo.hpp>
 #include <serial/objhook.hpp>
@@ -132,9 +133,53 @@ void CClassTypeInfoBase::DataSpec(EDataSpec spec)
 void CClassTypeInfoBase::InitClassTypeInfoBase(const type_info& id)
 {
     m_Id = &id;
+    m_AssignFunction = 0;
+    m_EqualsFunction = 0;
     Register();
 }
 
+NCBI_PARAM_DECL(bool, SERIAL, GENERATED_ASSIGN);
+NCBI_PARAM_DEF_EX(bool, SERIAL, GENERATED_ASSIGN, true,
+                  eParam_NoThread, SERIAL_GENERATED_ASSIGN);
+typedef NCBI_PARAM_TYPE(SERIAL, GENERATED_ASSIGN) TGeneratedAssign;
+
+// -1 - not initialized yet
+static atomic<int> s_GeneratedAssignEnabled(-1);
+
+void CClassTypeInfoBase::SetGeneratedAssignEnabled(bool enable)
+{
+    s_GeneratedAssignEnabled = enable;
+}
+
+bool CClassTypeInfoBase::GetGeneratedAssignEnabled(void)
+{
+    int enabled = s_GeneratedAssignEnabled;
+    if ( enabled < 0 ) {
+        enabled = TGeneratedAssign::GetDefault();
+        s_GeneratedAssignEnabled = enabled;
+    }
+    return enabled != 0;
+}
+
+void CClassTypeInfoBase::SetAssignFunctions(TTypeAssignFunction assign,
+                                            TTypeEqualsFunction equals)
+{
+    m_AssignFunction = assign;
+    m_EqualsFunction = equals;
+}
+
+TTypeAssignFunction CClassTypeInfoBase::GetAssignFunction(void) const
+{
+    return m_AssignFunction && GetGeneratedAssignEnabled()?
+        m_AssignFunction: 0;
+}
+
+TTypeEqualsFunction CClassTypeInfoBase::GetEqualsFunction(void) const
+{
+    return m_EqualsFunction && GetGeneratedAssignEnabled()?
+        m_EqualsFunction: 0;
+}
+
 CClassTypeInfoBase::TClasses* CClassTypeInfoBase::sm_Classes = 0;
 CClassTypeInfoBase::TClassesById* CClassTypeInfoBase::sm_ClassesById = 0;
 CClassTypeInfoBase::TClassesByName* CClassTypeInfoBase::sm_ClassesByName = 0;
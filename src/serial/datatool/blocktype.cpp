@@ -864,6 +864,9 @@ AutoPtr<CTypeStrings> CDataContainerType::AddMembers(
         }
 
         bool delayed = GetBoolVar((*i)->GetName()+"._delay");
+        // SEQUENCE OF and SET OF members can be delayed on request
+        bool lazy = !delayed && (*i)->GetType()->IsUniSeq() &&
+            GetBoolVar("_delay_containers");
         AutoPtr<CTypeStrings> memberType = (*i)->GetType()->GetFullCType();
         string external_name = (*i)->GetName();
         string member_name = (*i)->GetType()->DefClassMemberName();
@@ -872,11 +875,11 @@ AutoPtr<CTypeStrings> CDataContainerType::AddMembers(
         }
         code->AddMember(external_name, member_name, memberType,
                         (*i)->GetType()->GetVar("_pointer"),
-                        optional, defaultCode, delayed,
+                        optional, defaultCode, delayed || lazy,
                         (*i)->GetType()->GetTag(),
                         !IsASNDataSpec(), (*i)->Attlist(), (*i)->Notag(),
                         (*i)->SimpleType(),(*i)->GetType(),false,
-                        (*i)->Comments());
+                        (*i)->Comments(), lazy);
         (*i)->GetType()->SetTypeStr(&(*code));
     }
     SetTypeStr(&(*code));
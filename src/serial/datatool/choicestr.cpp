@@ -85,11 +85,11 @@ void CChoiceTypeStrings::AddVariant(const string& external_name,
                                     bool delayed, bool in_union, int tag,
                                     bool noPrefix, bool attlist, bool noTag,
                                     bool simple, const CDataType* dataType,
-                                    const CComments& comments)
+                                    const CComments& comments, bool lazy)
 {
     m_Variants.push_back(SVariantInfo(external_name, name, type, delayed, in_union, tag,
                                       noPrefix,attlist,noTag,simple,dataType,
-                                      comments));
+                                      comments, lazy));
 }
 
 CChoiceTypeStrings::SVariantInfo::SVariantInfo(const string& external_name,
@@ -99,9 +99,10 @@ CChoiceTypeStrings::SVariantInfo::SVariantInfo(const string& external_name,
                                                bool noPrefx, bool attlst,
                                                bool noTg,bool simpl,
                                                const CDataType* dataTp,
-                                               const CComments& commnts)
+                                               const CComments& commnts,
+                                               bool lzy)
     : externalName(external_name), cName(Identifier(name)),
-      type(t), delayed(del), in_union(in_un), memberTag(tag),
+      type(t), delayed(del), lazy(lzy), in_union(in_un), memberTag(tag),
       noPrefix(noPrefx), attlist(attlst), noTag(noTg), simple(simpl),
       dataType(dataTp), comments(commnts)
 {
@@ -1388,6 +1389,100 @@ void CChoiceTypeStrings::GenerateClassCode(CClassCode& code,
         }
     }
 
+    // generate type-specific Assign() and Equals()
+    // (only if all variants can be handled, otherwise generic code is used)
+    bool fastAssign = DataType() && DataType()->GetBoolVar("_fast_assign") &&
+        !delayed && !haveAttlist;
+    if ( fastAssign ) {
+        ITERATE ( TVariants, i, m_Variants ) {
+            string extname;
+            if ( x_IsNullWithAttlist(i, extname) ) {
+                fastAssign = false;
+                break;
+            }
+            if ( x_IsNullType(i) ) {
+                continue;
+            }
+            if ( i->type->GetKind() == eKindPointer ||
+                 i->type->GetKind() == eKindRef ||
+                 !i->type->CanGenerateAssign() ) {
+                fastAssign = false;
+                break;
+            }
+        }
+    }
+    if ( fastAssign ) {
+        code.ClassPrivate() <<
+            "\n"
+            "    // type-specific Assign() and Equals()\n"
+            "    static void sx_Assign("<<ncbiNamespace<<"TObjectPtr dstPtr,\n"
+            "                          "<<ncbiNamespace<<"TConstObjectPtr srcPtr,\n"
+            "                          "<<ncbiNamespace<<"ESerialRecursionMode how);\n"
+            "    static bool sx_Equals("<<ncbiNamespace<<"TConstObjectPtr ptr1,\n"
+            "                          "<<ncbiNamespace<<"TConstObjectPtr ptr2,\n"
+            "                          "<<ncbiNamespace<<"ESerialRecursionMode how);\n";
+        string userClass = classPrefix+GetClassNameDT();
+        string baseClass = code.GetClassNameDT();
+        string helper = ncbiNamespace+"CSerialAssignHelper::";
+        methods <<
+            "void "<<methodPrefix<<"sx_Assign("<<ncbiNamespace<<"TObjectPtr dstPtr,\n"
+            "    "<<ncbiNamespace<<"TConstObjectPtr srcPtr, "<<ncbiNamespace<<"ESerialRecursionMode how)\n"
+            "{\n"
+            "    "<<baseClass<<"& dst = *static_cast<"<<userClass<<"*>(dstPtr);\n"
+            "    const "<<baseClass<<"& src = *static_cast<const "<<userClass<<"*>(srcPtr);\n"
+            "    switch ( src.Which() ) {\n";
+        ITERATE ( TVariants, i, m_Variants ) {
+            methods <<
+                "    case " STATE_PREFIX<<i->cName<<":\n";
+            if ( x_IsNullType(i) ) {
+                methods <<
+                    "        dst.Set"<<i->cName<<"();\n";
+            }
+            else {
+                methods <<
+                    "        "<<helper<<
+                    (i->memberType == eObjectPointerMember? "AssignObject": "AssignMember")<<
+                    "(dst.Set"<<i->cName<<"(), src.Get"<<i->cName<<"(), how);\n";
+            }
+            methods <<
+                "        break;\n";
+        }
+        methods <<
+            "    default:\n"
+            "        if ( dst.Which() != " STATE_NOT_SET " ) {\n"
+            "            dst.ResetSelection();\n"
+            "        }\n"
+            "        break;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "bool "<<methodPrefix<<"sx_Equals("<<ncbiNamespace<<"TConstObjectPtr ptr1,\n"
+            "    "<<ncbiNamespace<<"TConstObjectPtr ptr2, "<<ncbiNamespace<<"ESerialRecursionMode how)\n"
+            "{\n"
+            "    const "<<baseClass<<"& obj1 = *static_cast<const "<<userClass<<"*>(ptr1);\n"
+            "    const "<<baseClass<<"& obj2 = *static_cast<const "<<userClass<<"*>(ptr2);\n"
+            "    if ( obj1.Which() != obj2.Which() ) {\n"
+            "        return false;\n"
+            "    }\n"
+            "    switch ( obj1.Which() ) {\n";
+        ITERATE ( TVariants, i, m_Variants ) {
+            if ( x_IsNullType(i) ) {
+                continue;
+            }
+            methods <<
+                "    case " STATE_PREFIX<<i->cName<<":\n"
+                "        return "<<helper<<
+                (i->memberType == eObjectPointerMember? "EqualsObject": "EqualsMember")<<
+                "(obj1.Get"<<i->cName<<"(), obj2.Get"<<i->cName<<"(), how);\n";
+        }
+        methods <<
+            "    default:\n"
+            "        return true;\n"
+            "    }\n"
+            "}\n"
+            "\n";
+    }
+
     // generate type info
     methods <<
         "// helper methods\n"
@@ -1562,7 +1657,8 @@ void CChoiceTypeStrings::GenerateClassCode(CClassCode& code,
             methods <<")";
             
             if ( i->delayed ) {
-                methods << "->SetDelayBuffer(MEMBER_PTR(m_delayBuffer))";
+                methods << (i->lazy? "->SetLazyDelayBuffer": "->SetDelayBuffer")
+                        << "(MEMBER_PTR(m_delayBuffer))";
             }
             if (i->dataType && i->dataType->GetDataMember() && i->dataType->GetDataMember()->Optional()) {
                 methods << "->SetOptional()";
@@ -1650,6 +1746,10 @@ void CChoiceTypeStrings::GenerateClassCode(CClassCode& code,
             methods << ";\n";
         }
     }
+    if ( fastAssign ) {
+        methods <<
+            "    info->SetAssignFunctions(&sx_Assign, &sx_Equals);\n";
+    }
     methods <<  "    info->CodeVersion(" << DATATOOL_VERSION << ");\n";
     methods <<  "    info->DataSpec(" << CDataType::GetSourceDataSpecString() << ");\n";
     methods <<
@@ -57,6 +57,7 @@ public:
         EMemberType memberType;
         AutoPtr<CTypeStrings> type;
         bool delayed;
+        bool lazy;      // delay buffer is used only on request
         bool in_union;
         int memberTag;
         bool noPrefix;
@@ -69,7 +70,8 @@ public:
         SVariantInfo(const string& external_name, const string& name, const AutoPtr<CTypeStrings>& type,
                      bool delayed, bool in_union,
                      int tag, bool noPrefx, bool attlst, bool noTg,
-                     bool simpl, const CDataType* dataTp, const CComments& commnts);
+                     bool simpl, const CDataType* dataTp, const CComments& commnts,
+                     bool lazy = false);
     };
     typedef list<SVariantInfo> TVariants;
 
@@ -89,7 +91,7 @@ public:
                     bool delayed, bool in_union, int tag,
                     bool noPrefix, bool attlist,
                     bool noTag, bool simple, const CDataType* dataType,
-                    const CComments& commnts);
+                    const CComments& commnts, bool lazy = false);
 
 protected:
     virtual void GenerateClassCode(CClassCode& code,
@@ -380,12 +380,16 @@ AutoPtr<CTypeStrings> CChoiceDataType::GetFullCType(void) const
                 member_name = external_name;
             }
             bool delayed = GetBoolVar((*i)->GetName()+"._delay");
+            // SEQUENCE OF and SET OF variants can be delayed on request
+            bool lazy = !delayed && (*i)->GetType()->IsUniSeq() &&
+                GetBoolVar("_delay_containers");
             bool in_union = GetBoolVar((*i)->GetName()+"._in_union", true);
-            code->AddVariant(external_name, member_name, varType, delayed, in_union,
+            code->AddVariant(external_name, member_name, varType,
+                             delayed || lazy, in_union,
                              (*i)->GetType()->GetTag(),
                              !IsASNDataSpec(), (*i)->Attlist(), (*i)->Notag(),
                              (*i)->SimpleType(),(*i)->GetType(),
-                             (*i)->Comments());
+                             (*i)->Comments(), lazy);
             (*i)->GetType()->SetTypeStr(&(*code));
         }
         SetTypeStr(&(*code));
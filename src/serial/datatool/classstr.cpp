@@ -118,13 +118,15 @@ void CClassTypeStrings::AddMember(const string& external_name,
                                   bool delayed, int tag,
                                   bool noPrefix, bool attlist, bool noTag,
                                   bool simple,const CDataType* dataType,
-                                  bool nonempty, const CComments& comments)
+                                  bool nonempty, const CComments& comments,
+                                  bool lazy)
 {
     m_Members.push_back(SMemberInfo(external_name, name, type,
                                     pointerType,
                                     optional, defaultValue,
                                     delayed, tag, noPrefix,attlist,noTag,
-                                    simple,dataType,nonempty, comments));
+                                    simple,dataType,nonempty, comments,
+                                    lazy));
 }
 
 CClassTypeStrings::SMemberInfo::SMemberInfo(const string& external_name,
@@ -135,11 +137,12 @@ CClassTypeStrings::SMemberInfo::SMemberInfo(const string& external_name,
                                             bool del, int tag, bool noPrefx,
                                             bool attlst, bool noTg, bool simpl,
                                             const CDataType* dataTp, bool nEmpty,
-                                            const CComments& commnts)
+                                            const CComments& commnts,
+                                            bool lzy)
     : externalName(external_name), cName(Identifier(name)),
       mName("m_"+cName), tName('T'+cName),
       type(t), ptrType(pType),
-      optional(opt), delayed(del), memberTag(tag),
+      optional(opt), delayed(del), lazy(lzy), memberTag(tag),
       defaultValue(defValue), noPrefix(noPrefx), attlist(attlst), noTag(noTg),
       simple(simpl),dataType(dataTp),nonEmpty(nEmpty), comments(commnts)
 {
@@ -1372,6 +1375,228 @@ mem_simple = false;
         }
     }
 
+    // generate direct ASN.1 binary member codecs
+    // (only simple members with set flag, the rest is left to generic code)
+    typedef list< pair<size_t, TMembers::const_iterator> > TDirectMembers;
+    TDirectMembers directMembers;
+    if ( DataType() && DataType()->GetBoolVar("_direct_codec") &&
+         CDataType::IsASNDataSpec() &&
+         !isSet && !wrapperClass && m_ParentClassName.empty() ) {
+        size_t member_index = (size_t)-1;
+        ITERATE ( TMembers, i, m_Members ) {
+            ++member_index;
+            if ( i->ref || !i->haveFlag || i->delayed ||
+                 !i->defaultValue.empty() || i->attlist || i->noTag ||
+                 x_IsNullType(i) ) {
+                continue;
+            }
+            if ( i->type->GetKind() != eKindStd &&
+                 i->type->GetKind() != eKindString ) {
+                continue;
+            }
+            if ( i->type->HaveSpecialRef() ||
+                 i->type->GetStorageType(code.GetNamespace()) != i->type->GetCType(code.GetNamespace()) ) {
+                continue;
+            }
+            if ( i->dataType && i->dataType->GetDataMember() &&
+                 (i->dataType->GetDataMember()->Nillable() ||
+                  !i->dataType->GetDataMember()->GetRestrictions().empty()) ) {
+                continue;
+            }
+            directMembers.push_back(make_pair(member_index, i));
+        }
+    }
+    if ( !directMembers.empty() ) {
+        code.CPPIncludes().insert("serial/objistrasnb");
+        code.CPPIncludes().insert("serial/objostrasnb");
+        code.AddForwardDeclaration("CObjectIStreamAsnBinary", CNamespace::KNCBINamespace);
+        code.AddForwardDeclaration("CObjectOStreamAsnBinary", CNamespace::KNCBINamespace);
+        code.AddForwardDeclaration("CMemberInfo", CNamespace::KNCBINamespace);
+        code.ClassPrivate() <<
+            "\n"
+            "    // direct ASN.1 binary member codecs\n"
+            "    static bool sx_DirectReadMember("<<ncbiNamespace<<"CObjectIStreamAsnBinary& in,\n"
+            "                                    const "<<ncbiNamespace<<"CMemberInfo* memberInfo,\n"
+            "                                    "<<ncbiNamespace<<"TObjectPtr classPtr);\n"
+            "    static bool sx_DirectWriteMember("<<ncbiNamespace<<"CObjectOStreamAsnBinary& out,\n"
+            "                                     const "<<ncbiNamespace<<"CMemberInfo* memberInfo,\n"
+            "                                     "<<ncbiNamespace<<"TConstObjectPtr classPtr);\n";
+        string userClass = classPrefix+GetClassNameDT();
+        string baseClass = code.GetClassNameDT();
+        methods <<
+            "bool "<<methodPrefix<<"sx_DirectReadMember("<<ncbiNamespace<<"CObjectIStreamAsnBinary& in,\n"
+            "    const "<<ncbiNamespace<<"CMemberInfo* memberInfo, "<<ncbiNamespace<<"TObjectPtr classPtr)\n"
+            "{\n"
+            "    "<<baseClass<<"& obj = *static_cast<"<<userClass<<"*>(classPtr);\n"
+            "    switch ( memberInfo->GetIndex() ) {\n";
+        ITERATE ( TDirectMembers, d, directMembers ) {
+            size_t set_index  = (2*d->first)/(8*sizeof(Uint4));
+            Uint4  set_mask   = (0x03 << ((2*d->first)%(8*sizeof(Uint4))));
+            methods <<
+                "    case "<<d->first+1<<":\n"
+                "        in.ReadStd(obj."<<d->second->mName<<");\n"
+                "        obj." SET_PREFIX "["<<set_index<<"] |= 0x"<<hex<<set_mask<<dec<<";\n"
+                "        return true;\n";
+        }
+        methods <<
+            "    default:\n"
+            "        return false;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "bool "<<methodPrefix<<"sx_DirectWriteMember("<<ncbiNamespace<<"CObjectOStreamAsnBinary& out,\n"
+            "    const "<<ncbiNamespace<<"CMemberInfo* memberInfo, "<<ncbiNamespace<<"TConstObjectPtr classPtr)\n"
+            "{\n"
+            "    const "<<baseClass<<"& obj = *static_cast<const "<<userClass<<"*>(classPtr);\n"
+            "    switch ( memberInfo->GetIndex() ) {\n";
+        ITERATE ( TDirectMembers, d, directMembers ) {
+            size_t set_index  = (2*d->first)/(8*sizeof(Uint4));
+            Uint4  set_mask   = (0x03 << ((2*d->first)%(8*sizeof(Uint4))));
+            methods <<
+                "    case "<<d->first+1<<":\n"
+                "        if ( !(obj." SET_PREFIX "["<<set_index<<"] & 0x"<<hex<<set_mask<<dec<<") ) {\n"
+                "            return false;\n"
+                "        }\n"
+                "        out.BeginDirectMember();\n"
+                "        out.WriteStd(obj."<<d->second->mName<<");\n"
+                "        out.EndDirectMember();\n"
+                "        return true;\n";
+        }
+        methods <<
+            "    default:\n"
+            "        return false;\n"
+            "    }\n"
+            "}\n"
+            "\n";
+    }
+
+    // generate type-specific Assign() and Equals()
+    // (only if all members can be handled, otherwise generic code is used)
+    bool fastAssign = DataType() && DataType()->GetBoolVar("_fast_assign") &&
+        m_ParentClassName.empty() && !m_Members.empty();
+    if ( fastAssign ) {
+        bool haveData = false;
+        ITERATE ( TMembers, i, m_Members ) {
+            string extname;
+            if ( i->delayed || i->attlist || x_IsNullWithAttlist(i, extname) ) {
+                fastAssign = false;
+                break;
+            }
+            if ( i->ref ) {
+                fastAssign = i->type->GetKind() == eKindObject &&
+                    i->type->CanGenerateAssign();
+            }
+            else if ( !x_IsNullType(i) ) {
+                fastAssign = i->type->CanGenerateAssign() &&
+                    i->type->GetStorageType(code.GetNamespace()) ==
+                    i->type->GetCType(code.GetNamespace());
+            }
+            else {
+                continue;
+            }
+            if ( !fastAssign ) {
+                break;
+            }
+            haveData = true;
+        }
+        fastAssign = fastAssign && haveData;
+    }
+    if ( fastAssign ) {
+        code.ClassPrivate() <<
+            "\n"
+            "    // type-specific Assign() and Equals()\n"
+            "    static void sx_Assign("<<ncbiNamespace<<"TObjectPtr dstPtr,\n"
+            "                          "<<ncbiNamespace<<"TConstObjectPtr srcPtr,\n"
+            "                          "<<ncbiNamespace<<"ESerialRecursionMode how);\n"
+            "    static bool sx_Equals("<<ncbiNamespace<<"TConstObjectPtr ptr1,\n"
+            "                          "<<ncbiNamespace<<"TConstObjectPtr ptr2,\n"
+            "                          "<<ncbiNamespace<<"ESerialRecursionMode how);\n";
+        string userClass = classPrefix+GetClassNameDT();
+        string baseClass = code.GetClassNameDT();
+        string helper = ncbiNamespace+"CSerialAssignHelper::";
+
+        // set flag bits of all members with flag, by word
+        typedef map<size_t, Uint4> TSetMasks;
+        TSetMasks setMasks;
+        size_t member_index = (size_t)-1;
+        ITERATE ( TMembers, i, m_Members ) {
+            ++member_index;
+            if ( i->haveFlag ) {
+                size_t set_index  = (2*member_index)/(8*sizeof(Uint4));
+                Uint4  set_mask   = (0x03 << ((2*member_index)%(8*sizeof(Uint4))));
+                setMasks[set_index] |= set_mask;
+            }
+        }
+
+        methods <<
+            "void "<<methodPrefix<<"sx_Assign("<<ncbiNamespace<<"TObjectPtr dstPtr,\n"
+            "    "<<ncbiNamespace<<"TConstObjectPtr srcPtr, "<<ncbiNamespace<<"ESerialRecursionMode how)\n"
+            "{\n"
+            "    "<<baseClass<<"& dst = *static_cast<"<<userClass<<"*>(dstPtr);\n"
+            "    const "<<baseClass<<"& src = *static_cast<const "<<userClass<<"*>(srcPtr);\n";
+        ITERATE ( TMembers, i, m_Members ) {
+            if ( !i->ref && x_IsNullType(i) ) {
+                continue;
+            }
+            methods << "    "<<helper;
+            if ( !i->ref && i->type->GetKind() == eKindObject ) {
+                methods << "AssignObject";
+            }
+            else {
+                methods << "AssignMember";
+            }
+            methods << "(dst."<<i->mName<<", src."<<i->mName<<", how);\n";
+        }
+        ITERATE ( TSetMasks, m, setMasks ) {
+            if ( m->second == 0xffffffff ) {
+                methods <<
+                    "    dst." SET_PREFIX "["<<m->first<<"] = src." SET_PREFIX "["<<m->first<<"];\n";
+            }
+            else {
+                methods <<
+                    "    dst." SET_PREFIX "["<<m->first<<"] = (dst." SET_PREFIX "["<<m->first<<"] & ~0x"<<hex<<m->second<<dec<<") |\n"
+                    "        (src." SET_PREFIX "["<<m->first<<"] & 0x"<<hex<<m->second<<dec<<");\n";
+            }
+        }
+        methods <<
+            "}\n"
+            "\n"
+            "bool "<<methodPrefix<<"sx_Equals("<<ncbiNamespace<<"TConstObjectPtr ptr1,\n"
+            "    "<<ncbiNamespace<<"TConstObjectPtr ptr2, "<<ncbiNamespace<<"ESerialRecursionMode how)\n"
+            "{\n"
+            "    const "<<baseClass<<"& obj1 = *static_cast<const "<<userClass<<"*>(ptr1);\n"
+            "    const "<<baseClass<<"& obj2 = *static_cast<const "<<userClass<<"*>(ptr2);\n";
+        member_index = (size_t)-1;
+        ITERATE ( TMembers, i, m_Members ) {
+            ++member_index;
+            if ( i->ref || !x_IsNullType(i) ) {
+                methods << "    if ( !"<<helper;
+                if ( !i->ref && i->type->GetKind() == eKindObject ) {
+                    methods << "EqualsObject";
+                }
+                else {
+                    methods << "EqualsMember";
+                }
+                methods << "(obj1."<<i->mName<<", obj2."<<i->mName<<", how) ) {\n"
+                    "        return false;\n"
+                    "    }\n";
+            }
+            if ( i->haveFlag ) {
+                size_t set_index  = (2*member_index)/(8*sizeof(Uint4));
+                Uint4  set_mask   = (0x03 << ((2*member_index)%(8*sizeof(Uint4))));
+                methods <<
+                    "    if ( ((obj1." SET_PREFIX "["<<set_index<<"] & 0x"<<hex<<set_mask<<dec<<") == 0) !=\n"
+                    "         ((obj2." SET_PREFIX "["<<set_index<<"] & 0x"<<hex<<set_mask<<dec<<") == 0) ) {\n"
+                    "        return false;\n"
+                    "    }\n";
+            }
+        }
+        methods <<
+            "    return true;\n"
+            "}\n"
+            "\n";
+    }
+
     // generate type info
     methods << "BEGIN_NAMED_";
     if ( haveUserClass )
@@ -1530,7 +1755,8 @@ mem_simple = false;
             }
             if ( i->delayed ) {
                 methods <<
-                    "->SetDelayBuffer(MEMBER_PTR(" DELAY_PREFIX<<
+                    (i->lazy? "->SetLazyDelayBuffer": "->SetDelayBuffer") <<
+                    "(MEMBER_PTR(" DELAY_PREFIX<<
                     i->cName<<"))";
             }
             if ( i->optional ) {
@@ -1630,6 +1856,14 @@ mem_simple = false;
             }
             methods << ";\n";
         }
+        if ( !directMembers.empty() ) {
+            methods <<
+                "    info->SetDirectFunctions(&sx_DirectReadMember, &sx_DirectWriteMember);\n";
+        }
+        if ( fastAssign ) {
+            methods <<
+                "    info->SetAssignFunctions(&sx_Assign, &sx_Equals);\n";
+        }
         if ( isSet ) {
             // Tagged class is not sequential
             methods << "    info->SetRandomOrder(true);\n";
@@ -60,6 +60,7 @@ public:
         bool haveFlag;  // need additional boolean flag 'isSet'
         bool canBeNull; // pointer type can be NULL pointer
         bool delayed;
+        bool lazy;      // delay buffer is used only on request
         int memberTag;
         string defaultValue; // DEFAULT value code
         bool noPrefix;
@@ -77,7 +78,7 @@ public:
                     bool delayed, int tag,
                     bool noPrefx, bool attlst, bool noTg, bool simpl,
                     const CDataType* dataTp, bool nEmpty,
-                    const CComments& comments);
+                    const CComments& comments, bool lazy = false);
     };
     typedef list<SMemberInfo> TMembers;
 
@@ -110,7 +111,8 @@ public:
                    bool optional, const string& defaultValue,
                    bool delayed, int tag,
                    bool noPrefix, bool attlist, bool noTag, bool simple,
-                   const CDataType* dataType, bool nonEmpty, const CComments& comments);
+                   const CDataType* dataType, bool nonEmpty, const CComments& comments,
+                   bool lazy = false);
     void AddMember(const AutoPtr<CTypeStrings>& type, int tag, bool nonEmpty, bool noPrefix)
         {
             AddMember(NcbiEmptyString, NcbiEmptyString, type, NcbiEmptyString,
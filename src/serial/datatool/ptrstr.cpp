@@ -120,6 +120,12 @@ CTypeStrings::EKind CRefTypeStrings::GetKind(void) const
     return eKindRef;
 }
 
+bool CRefTypeStrings::CanGenerateAssign(void) const
+{
+    return GetDataTypeStr()->GetKind() == eKindObject &&
+        GetDataTypeStr()->CanGenerateAssign();
+}
+
 string CRefTypeStrings::GetCType(const CNamespace& ns) const
 {
     return ns.GetNamespaceRef(CNamespace::KNCBINamespace)+"CRef< "+GetDataTypeStr()->GetCType(ns)+" >";
@@ -78,6 +78,7 @@ public:
     ~CRefTypeStrings(void);
 
     virtual EKind GetKind(void) const override;
+    virtual bool CanGenerateAssign(void) const override;
 
     virtual string GetCType(const CNamespace& ns) const override;
     virtual string GetPrefixedCType(const CNamespace& ns,
@@ -186,6 +186,11 @@ CTypeStrings::EKind CAnyContentTypeStrings::GetKind(void) const
     return eKindObject;
 }
 
+bool CAnyContentTypeStrings::CanGenerateAssign(void) const
+{
+    return false;
+}
+
 string CAnyContentTypeStrings::GetInitializer(void) const
 {
     return string();
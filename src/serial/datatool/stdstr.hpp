@@ -111,6 +111,7 @@ public:
     CAnyContentTypeStrings(const string& type, const CComments& comments, bool full_ns_name);
 
     virtual EKind GetKind(void) const override;
+    virtual bool CanGenerateAssign(void) const override;
 
     virtual string GetInitializer(void) const override;
     virtual string GetResetCode(const string& var) const override;
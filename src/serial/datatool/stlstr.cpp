@@ -258,6 +258,14 @@ CListTypeStrings::~CListTypeStrings(void)
 {
 }
 
+bool CListTypeStrings::CanGenerateAssign(void) const
+{
+    // only containers supported by CSerialAssignHelper
+    return (GetTemplateName() == "list" || GetTemplateName() == "vector") &&
+        GetTemplateExtraParam().empty() &&
+        GetArg1Type()->CanGenerateAssign();
+}
+
 string CListTypeStrings::GetRefTemplate(void) const
 {
     string templ = CParent::GetRefTemplate();
@@ -366,6 +374,11 @@ CTypeStrings::EKind CVectorTypeStrings::GetKind(void) const
     return eKindOther;
 }
 
+bool CVectorTypeStrings::CanGenerateAssign(void) const
+{
+    return true;
+}
+
 void CVectorTypeStrings::GenerateTypeCode(CClassContext& ctx) const
 {
     ctx.HPPIncludes().insert("<vector>");
@@ -119,6 +119,8 @@ public:
                      bool externalSet = false);
     ~CListTypeStrings(void);
 
+    virtual bool CanGenerateAssign(void) const override;
+
     virtual string GetDestructionCode(const string& expr) const override;
     virtual string GetResetCode(const string& var) const override;
 
@@ -182,6 +184,7 @@ public:
     ~CVectorTypeStrings(void);
 
     virtual EKind GetKind(void) const override;
+    virtual bool CanGenerateAssign(void) const override;
 
     virtual string GetCType(const CNamespace& ns) const override;
     virtual string GetPrefixedCType(const CNamespace& ns,
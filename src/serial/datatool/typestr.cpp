@@ -162,6 +162,19 @@ bool CTypeStrings::CanBeCopied(void) const
     }
 }
 
+bool CTypeStrings::CanGenerateAssign(void) const
+{
+    switch ( GetKind() ) {
+    case eKindStd:
+    case eKindEnum:
+    case eKindString:
+    case eKindObject:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool CTypeStrings::NeedSetFlag(void) const
 {
     switch ( GetKind() ) {
@@ -104,6 +104,8 @@ public:
     virtual bool CanBeKey(void) const;
     virtual bool CanBeCopied(void) const;
     virtual bool NeedSetFlag(void) const;
+    // can be handled by generated Assign() and Equals()
+    virtual bool CanGenerateAssign(void) const;
 
     static void AdaptForSTL(AutoPtr<CTypeStrings>& type);
 
@@ -172,7 +172,7 @@ CMemberInfo::CMemberInfo(const CClassTypeInfoBase* classType,
     : CParent(id, offset, type),
       m_ClassType(classType), m_Default(0),
       m_SetFlagOffset(eNoOffset), m_BitSetMask(0),
-      m_DelayOffset(eNoOffset),
+      m_DelayOffset(eNoOffset), m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstSimpleMember),
       m_GetFunction(&TFunc::GetSimpleMember),
       m_ReadHookData(make_pair(&TFunc::ReadSimpleMember,
@@ -197,7 +197,7 @@ CMemberInfo::CMemberInfo(const CClassTypeInfoBase* classType,
     : CParent(id, offset, type),
       m_ClassType(classType), m_Default(0),
       m_SetFlagOffset(eNoOffset), m_BitSetMask(0),
-      m_DelayOffset(eNoOffset),
+      m_DelayOffset(eNoOffset), m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstSimpleMember),
       m_GetFunction(&TFunc::GetSimpleMember),
       m_ReadHookData(make_pair(&TFunc::ReadSimpleMember,
@@ -222,7 +222,7 @@ CMemberInfo::CMemberInfo(const CClassTypeInfoBase* classType,
     : CParent(id, offset, type),
       m_ClassType(classType), m_Default(0),
       m_SetFlagOffset(eNoOffset), m_BitSetMask(0),
-      m_DelayOffset(eNoOffset),
+      m_DelayOffset(eNoOffset), m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstSimpleMember),
       m_GetFunction(&TFunc::GetSimpleMember),
       m_ReadHookData(make_pair(&TFunc::ReadSimpleMember,
@@ -247,7 +247,7 @@ CMemberInfo::CMemberInfo(const CClassTypeInfoBase* classType,
     : CParent(id, offset, type),
       m_ClassType(classType), m_Default(0),
       m_SetFlagOffset(eNoOffset), m_BitSetMask(0),
-      m_DelayOffset(eNoOffset),
+      m_DelayOffset(eNoOffset), m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstSimpleMember),
       m_GetFunction(&TFunc::GetSimpleMember),
       m_ReadHookData(make_pair(&TFunc::ReadSimpleMember,
@@ -319,6 +319,12 @@ CMemberInfo* CMemberInfo::SetDelayBuffer(CDelayBuffer* buffer)
     return this;
 }
 
+CMemberInfo* CMemberInfo::SetLazyDelayBuffer(CDelayBuffer* buffer)
+{
+    m_LazyDelay = true;
+    return SetDelayBuffer(buffer);
+}
+
 CMemberInfo* CMemberInfo::SetOptional(void)
 {
     m_Optional = true;
@@ -852,7 +858,11 @@ void CMemberInfoFunctions::ReadLongMember(CObjectIStream& in,
     if ( memberInfo->CanBeDelayed() ) {
         CDelayBuffer& buffer = memberInfo->GetDelayBuffer(classPtr);
         if ( !buffer ) {
-            if (!in.ShouldParseDelayBuffer()) {
+            bool delay = memberInfo->LazyDelay()?
+                in.GetDelayBufferParsingPolicy() ==
+                CObjectIStream::eDelayBufferPolicyNeverParse:
+                !in.ShouldParseDelayBuffer();
+            if ( delay ) {
                 memberInfo->UpdateSetFlagYes(classPtr);
                 in.StartDelayBuffer();
                 memberInfo->GetTypeInfo()->SkipData(in);
@@ -113,23 +113,135 @@ void CItemsInfo::DataSpec(EDataSpec spec)
 
 DEFINE_STATIC_FAST_MUTEX(s_ItemsMapMutex);
 
-const CItemsInfo::TItemsByName& CItemsInfo::GetItemsByName(void) const
+static inline
+Uint8 s_HashName(const CTempString& name)
 {
-    TItemsByName* items = m_ItemsByName.load(memory_order_acquire);
+    // FNV-1a
+    Uint8 hash = NCBI_CONST_UINT8(14695981039346656037);
+    for ( char c : name ) {
+        hash ^= (unsigned char)c;
+        hash *= NCBI_CONST_UINT8(1099511628211);
+    }
+    return hash;
+}
+
+static inline
+size_t s_GetNameBucket(Uint8 hash, size_t mask)
+{
+    return size_t(hash >> 32) & mask;
+}
+
+static inline
+size_t s_GetNameSlot(Uint8 hash, Uint4 displacement, size_t mask)
+{
+    Uint8 h = hash ^ (displacement * NCBI_CONST_UINT8(0x9E3779B97F4A7C15));
+    h ^= h >> 33;
+    h *= NCBI_CONST_UINT8(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    return size_t(h) & mask;
+}
+
+typedef vector< pair<Uint8, TMemberIndex> > TNameHashes;
+
+// Choose slot displacement for every bucket of names so that all names get
+// different slots (hash and displace).
+// Return false if the table of slots is too small.
+static
+bool s_PlaceNames(const TNameHashes& hashes,
+                  size_t bucket_mask, size_t slot_mask,
+                  vector<Uint4>& displacements,
+                  vector<TMemberIndex>& slots)
+{
+    const Uint4 kMaxDisplacement = 1 << 16;
+    vector< vector<size_t> > buckets(bucket_mask + 1);
+    for ( size_t i = 0; i < hashes.size(); ++i ) {
+        buckets[s_GetNameBucket(hashes[i].first, bucket_mask)].push_back(i);
+    }
+    // place large buckets first, while there are many free slots
+    vector<size_t> order(buckets.size());
+    for ( size_t b = 0; b < order.size(); ++b ) {
+        order[b] = b;
+    }
+    stable_sort(order.begin(), order.end(), [&](size_t b1, size_t b2) {
+            return buckets[b1].size() > buckets[b2].size();
+        });
+    displacements.assign(buckets.size(), 0);
+    slots.assign(slot_mask + 1, kInvalidMember);
+    vector<size_t> bucket_slots;
+    for ( size_t b : order ) {
+        const vector<size_t>& bucket = buckets[b];
+        if ( bucket.empty() ) {
+            break;
+        }
+        Uint4 d = 0;
+        for ( ; d < kMaxDisplacement; ++d ) {
+            bucket_slots.clear();
+            for ( size_t i : bucket ) {
+                size_t slot = s_GetNameSlot(hashes[i].first, d, slot_mask);
+                if ( slots[slot] != kInvalidMember ||
+                     find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+                     bucket_slots.end() ) {
+                    break;
+                }
+                bucket_slots.push_back(slot);
+            }
+            if ( bucket_slots.size() == bucket.size() ) {
+                break;
+            }
+        }
+        if ( d == kMaxDisplacement ) {
+            return false;
+        }
+        displacements[b] = d;
+        for ( size_t k = 0; k < bucket.size(); ++k ) {
+            slots[bucket_slots[k]] = hashes[bucket[k]].second;
+        }
+    }
+    return true;
+}
+
+const CItemsInfo::SItemsByName& CItemsInfo::GetItemsByName(void) const
+{
+    SItemsByName* items = m_ItemsByName.load(memory_order_acquire);
     if ( !items ) {
         CFastMutexGuard GUARD(s_ItemsMapMutex);
         items = m_ItemsByName.load(memory_order_acquire);
         if ( !items ) {
-            unique_ptr<TItemsByName> keep = make_unique<TItemsByName>();
+            TNameHashes hashes;
+            {{
+                set<CTempString, PQuickStringLess> names;
+                for ( CIterator i(*this); i.Valid(); ++i ) {
+                    const CItemInfo* itemInfo = GetItemInfo(i);
+                    const string& name = itemInfo->GetId().GetName();
+                    if ( !names.insert(name).second ) {
+                        if ( !name.empty() )
+                            NCBI_THROW(CSerialException,eInvalidData,
+                                string("duplicate member name: ")+name);
+                        // only the first unnamed item is found by name
+                        continue;
+                    }
+                    hashes.push_back(make_pair(s_HashName(name), *i));
+                }
+            }}
+            unique_ptr<SItemsByName> keep = make_unique<SItemsByName>();
             items = keep.get();
-            for ( CIterator i(*this); i.Valid(); ++i ) {
-                const CItemInfo* itemInfo = GetItemInfo(i);
-                const string& name = itemInfo->GetId().GetName();
-                if ( !items->insert(TItemsByName::value_type(name, *i)).second ) {
-                    if ( !name.empty() )
-                        NCBI_THROW(CSerialException,eInvalidData,
-                            string("duplicate member name: ")+name);
+            // about two names per bucket, and at most half of slots used
+            items->m_BucketMask = 0;
+            while ( items->m_BucketMask + 1 < hashes.size() / 2 ) {
+                items->m_BucketMask = items->m_BucketMask * 2 + 1;
+            }
+            items->m_SlotMask = 3;
+            while ( items->m_SlotMask + 1 < hashes.size() * 2 ) {
+                items->m_SlotMask = items->m_SlotMask * 2 + 1;
+            }
+            while ( !s_PlaceNames(hashes,
+                                  items->m_BucketMask, items->m_SlotMask,
+                                  items->m_Displacements, items->m_Slots) ) {
+                if ( items->m_SlotMask > hashes.size() * 64 ) {
+                    NCBI_THROW(CSerialException,eInvalidData,
+                               "cannot index member names");
                 }
+                items->m_SlotMask = items->m_SlotMask * 2 + 1;
             }
             m_ItemsByName.store(items, memory_order_release);
             keep.release();
@@ -255,11 +367,14 @@ CItemsInfo::GetItemsByTagInfo(void) const
 
 TMemberIndex CItemsInfo::Find(const CTempString& name) const
 {
-    const TItemsByName& items = GetItemsByName();
-    TItemsByName::const_iterator i = items.find(name);
-    if ( i == items.end() )
+    const SItemsByName& items = GetItemsByName();
+    Uint8 hash = s_HashName(name);
+    Uint4 d = items.m_Displacements[s_GetNameBucket(hash, items.m_BucketMask)];
+    TMemberIndex index = items.m_Slots[s_GetNameSlot(hash, d, items.m_SlotMask)];
+    if ( index == kInvalidMember ||
+         GetItemInfo(index)->GetId().GetName() != name )
         return kInvalidMember;
-    return i->second;
+    return index;
 }
 
 TMemberIndex CItemsInfo::FindDeep(const CTempString& name, bool search_attlist,
@@ -428,6 +543,11 @@ TMemberIndex CItemsInfo::FindEmpty(void) const
 
 TMemberIndex CItemsInfo::Find(const CTempString& name, TMemberIndex pos) const
 {
+    if ( !name.empty() ) {
+        // non-empty names are unique
+        TMemberIndex index = Find(name);
+        return index >= pos ? index : kInvalidMember;
+    }
     for ( CIterator i(*this, pos); i.Valid(); ++i ) {
         if ( name == GetItemInfo(i)->GetId().GetName() )
             return *i;
@@ -85,6 +85,12 @@ NCBI_PARAM_DECL(bool, SERIAL, READ_MMAPBYTESOURCE);
 NCBI_PARAM_DEF_EX(bool, SERIAL, READ_MMAPBYTESOURCE, false,
                   eParam_NoThread, SERIAL_READ_MMAPBYTESOURCE);
 
+NCBI_PARAM_DECL(bool, SERIAL, READ_MEMORY_POOL);
+NCBI_PARAM_DEF_EX(bool, SERIAL, READ_MEMORY_POOL, false,
+                  eParam_NoThread, SERIAL_READ_MEMORY_POOL);
+typedef NCBI_PARAM_TYPE(SERIAL, READ_MEMORY_POOL) TReadMemoryPool;
+static CSafeStatic<TReadMemoryPool> s_ReadMemoryPool;
+
 CRef<CByteSource> CObjectIStream::GetSource(ESerialDataFormat format,
                                             const string& fileName,
                                             TSerialOpenFlags openFlags)
@@ -470,6 +476,9 @@ CObjectIStream::CObjectIStream(ESerialDataFormat format)
       m_MonitorType(0),
       m_MemberDefault(0), m_SpecialCaseToExpect(0), m_SpecialCaseUsed(eReadAsNormal)
 {
+    if ( s_ReadMemoryPool->Get() ) {
+        UseMemoryPool();
+    }
 }
 
 CObjectIStream::~CObjectIStream(void)
@@ -46,9 +46,70 @@
 #if !defined(DBL_MAX_10_EXP) || !defined(FLT_MAX)
 # include <float.h>
 #endif
+#include <charconv>
+#if NCBI_SSE >= 20
+#  include <emmintrin.h>
+#endif
 
 BEGIN_NCBI_SCOPE
 
+
+// Find first quote or end of line char in [pos, end).
+static inline
+const char* s_FindStringSpecialChar(const char* pos, const char* end)
+{
+#if NCBI_SSE >= 20
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    for ( ; end - pos >= 16; pos += 16 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                       _mm_or_si128(_mm_cmpeq_epi8(v, cr),
+                                                    _mm_cmpeq_epi8(v, lf)));
+        if ( _mm_movemask_epi8(special) ) {
+            // exact position is found by the loop below
+            break;
+        }
+    }
+#endif
+    for ( ; pos < end; ++pos ) {
+        char c = *pos;
+        if ( c == '"' || c == '\r' || c == '\n' ) {
+            break;
+        }
+    }
+    return pos;
+}
+
+
+// Find first char in [pos, end) which is not GoodVisibleChar().
+static inline
+const char* s_FindNonVisibleChar(const char* pos, const char* end)
+{
+#if NCBI_SSE >= 20
+    const __m128i low = _mm_set1_epi8(' ');
+    const __m128i high = _mm_set1_epi8('~');
+    for ( ; end - pos >= 16; pos += 16 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        // signed comparison also catches chars >= 0x80
+        __m128i bad = _mm_or_si128(_mm_cmplt_epi8(v, low),
+                                   _mm_cmpgt_epi8(v, high));
+        if ( _mm_movemask_epi8(bad) ) {
+            // exact position is found by the loop below
+            break;
+        }
+    }
+#endif
+    for ( ; pos < end; ++pos ) {
+        if ( !GoodVisibleChar(*pos) ) {
+            break;
+        }
+    }
+    return pos;
+}
+
+
 CObjectIStream* CObjectIStream::CreateObjectIStreamAsn(void)
 {
     return new CObjectIStreamAsn();
@@ -117,13 +178,15 @@ void CObjectIStreamAsn::Location(string& loc_type, size_t& loc) const
 inline
 bool CObjectIStreamAsn::FirstIdChar(char c)
 {
-    return isalpha((unsigned char) c) || c == '_';
+    // ASN.1 identifiers are ASCII, avoid locale dependent isalpha()
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
 }
 
 inline
 bool CObjectIStreamAsn::IdChar(char c)
 {
-    return isalnum((unsigned char) c) || c == '_' || c == '.';
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9') || c == '_' || c == '.';
 }
 
 inline
@@ -277,6 +340,12 @@ CTempString CObjectIStreamAsn::ScanEndOfId(bool isId)
 {
     if ( isId ) {
         for ( size_t i = 1; ; ++i ) {
+            // scan chars which are already in buffer without per-char calls
+            const char* data = m_Input.GetCurrentPos();
+            size_t count = m_Input.PeekAvailableChars();
+            while ( i < count && IdChar(data[i]) ) {
+                ++i;
+            }
             char c = m_Input.PeekCharNoEOF(i);
             if ( !IdChar(c) &&
                  (c != '-' || !IdChar(m_Input.PeekChar(i + 1))) ) {
@@ -810,6 +879,17 @@ double CObjectIStreamAsn::ReadDouble(void)
         } else if (NStr::strncasecmp(tmp.data(),"NOT-A-NUMBER", 12) == 0) {
 	    return HUGE_VAL/HUGE_VAL; /* NCBI_FAKE_WARNING */
         }
+#if defined(__cpp_lib_to_chars)
+        {
+            // locale independent and correctly rounded conversion
+            double value = 0;
+            auto res = std::from_chars(tmp.data(), tmp.data() + tmp.size(), value);
+            if ( res.ec == std::errc() && res.ptr == tmp.data() + tmp.size() &&
+                 finite(value) ) {
+                return value;
+            }
+        }
+#endif
         char* endptr;
         return NStr::StringToDoublePosix( string(tmp).c_str(), &endptr, NStr::fDecimalPosixFinite );
     }
@@ -882,6 +962,13 @@ void CObjectIStreamAsn::AppendStringData(string& s,
     if ( fix_method != eFNP_Allow ) {
         size_t done = 0, valid = 0;
         for ( size_t i = 0; i < count; ++i ) {
+            if ( valid == 0 ) {
+                // skip good chars in bulk
+                i = s_FindNonVisibleChar(data + i, data + count) - data;
+                if ( i == count ) {
+                    break;
+                }
+            }
             char c = data[i];
             if ( !GoodVisibleChar(c) ) {
 #if SERIAL_ALLOW_UTF8_IN_VISIBLESTRING_ON_READING
@@ -939,22 +1026,32 @@ void CObjectIStreamAsn::ReadStringValue(string& s, EFixNonPrint fix_method)
 {
     Expect('\"', true);
     size_t startLine = m_Input.GetLine();
-    size_t i = 0;
     s.erase();
     try {
         for (;;) {
-            char c = m_Input.PeekChar(i);
+            // locate closing quote or end of line in buffered data
+            size_t count = m_Input.PeekAvailableChars();
+            if ( count == 0 ) {
+                m_Input.PeekChar(); // throws CEofException
+            }
+            const char* data = m_Input.GetCurrentPos();
+            size_t i = s_FindStringSpecialChar(data, data + count) - data;
+            if ( i == count ) {
+                // flush whole buffer
+                AppendLongStringData(s, i, fix_method, startLine);
+                continue;
+            }
+            char c = data[i];
             switch ( c ) {
             case '\r':
             case '\n':
                 // flush string
                 AppendLongStringData(s, i, fix_method, startLine);
                 m_Input.SkipChar(); // '\r' or '\n'
-                i = 0;
                 // skip end of line
                 SkipEndOfLine(c);
                 break;
-            case '\"':
+            default: // '\"'
                 s.reserve(s.size() + i);
                 AppendStringData(s, i, fix_method, startLine);
                 m_Input.SkipChar(); // quote
@@ -962,18 +1059,9 @@ void CObjectIStreamAsn::ReadStringValue(string& s, EFixNonPrint fix_method)
                     // end of string
                     return;
                 }
-                else {
-                    // double quote -> one quote
-                    i = 1;
-                }
-                break;
-            default:
-                // ok: append char
-                if ( ++i == 128 ) {
-                    // too long string -> flush it
-                    AppendLongStringData(s, i, fix_method, startLine);
-                    i = 0;
-                }
+                // double quote -> one quote
+                s += c;
+                m_Input.SkipChar();
                 break;
             }
         }
@@ -64,8 +64,15 @@ CObjectIStream* CObjectIStream::CreateObjectIStreamAsnBinary(void)
 }
 
 
+NCBI_PARAM_DECL(bool, SERIAL, READ_DIRECT_CODECS);
+NCBI_PARAM_DEF_EX(bool, SERIAL, READ_DIRECT_CODECS, true,
+                  eParam_NoThread, SERIAL_READ_DIRECT_CODECS);
+typedef NCBI_PARAM_TYPE(SERIAL, READ_DIRECT_CODECS) TReadDirectCodecs;
+static CSafeStatic<TReadDirectCodecs> s_ReadDirectCodecs;
+
 CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(EFixNonPrint how)
-    : CObjectIStream(eSerial_AsnBinary)
+    : CObjectIStream(eSerial_AsnBinary),
+      m_UseDirectCodecs(s_ReadDirectCodecs->Get())
 {
     FixNonPrint(how);
     ResetThisState();
@@ -73,7 +80,8 @@ CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(EFixNonPrint how)
 
 CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CNcbiIstream& in,
                                                  EFixNonPrint how)
-    : CObjectIStream(eSerial_AsnBinary)
+    : CObjectIStream(eSerial_AsnBinary),
+      m_UseDirectCodecs(s_ReadDirectCodecs->Get())
 {
     FixNonPrint(how);
     ResetThisState();
@@ -83,7 +91,8 @@ CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CNcbiIstream& in,
 CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CNcbiIstream& in,
                                                  bool deleteIn,
                                                  EFixNonPrint how)
-    : CObjectIStream(eSerial_AsnBinary)
+    : CObjectIStream(eSerial_AsnBinary),
+      m_UseDirectCodecs(s_ReadDirectCodecs->Get())
 {
     FixNonPrint(how);
     ResetThisState();
@@ -93,7 +102,8 @@ CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CNcbiIstream& in,
 CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CNcbiIstream& in,
                                                  EOwnership deleteIn,
                                                  EFixNonPrint how)
-    : CObjectIStream(eSerial_AsnBinary)
+    : CObjectIStream(eSerial_AsnBinary),
+      m_UseDirectCodecs(s_ReadDirectCodecs->Get())
 {
     FixNonPrint(how);
     ResetThisState();
@@ -102,7 +112,8 @@ CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CNcbiIstream& in,
 
 CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CByteSourceReader& reader,
                                                  EFixNonPrint how)
-    : CObjectIStream(eSerial_AsnBinary)
+    : CObjectIStream(eSerial_AsnBinary),
+      m_UseDirectCodecs(s_ReadDirectCodecs->Get())
 {
     FixNonPrint(how);
     ResetThisState();
@@ -112,7 +123,8 @@ CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(CByteSourceReader& reader,
 CObjectIStreamAsnBinary::CObjectIStreamAsnBinary(const char* buffer,
                                                  size_t size,
                                                  EFixNonPrint how)
-    : CObjectIStream(eSerial_AsnBinary)
+    : CObjectIStream(eSerial_AsnBinary),
+      m_UseDirectCodecs(s_ReadDirectCodecs->Get())
 {
     FixNonPrint(how);
     ResetThisState();
@@ -764,6 +776,14 @@ void CObjectIStreamAsnBinary::ReadPackedString(string& s,
     else {
         ReadBytes(buffer, length);
         EndOfTag();
+        if ( pack_string.IsShared() ) {
+            if ( type == eStringTypeVisible &&
+                 x_FixCharsMethod() != eFNP_Allow ) {
+                FixVisibleChars(buffer, length, x_FixCharsMethod());
+            }
+            pack_string.Pack(s, buffer, length);
+            return;
+        }
         pair<CPackString::iterator, bool> found =
             pack_string.Locate(buffer, length);
         if ( found.second ) {
@@ -1181,6 +1201,38 @@ void CObjectIStreamAsnBinary::EndClassMember(void)
     }
 }
 
+void
+CObjectIStreamAsnBinary::ReadClassDirect(const CClassTypeInfo* classType,
+                                         TObjectPtr classPtr)
+{
+    TMemberDirectReadFunction func = classType->GetDirectReadFunction();
+    _ASSERT(func);
+    BEGIN_OBJECT_FRAME3(eFrameClass, classType, classPtr);
+    CObjectIStreamAsnBinary::BeginClass(classType);
+    ReadClassSequentialContentsBegin(classType);
+
+    TMemberIndex index;
+    while ( (index = CObjectIStreamAsnBinary::BeginClassMember(classType,*pos)) != kInvalidMember ) {
+        const CMemberInfo* memberInfo = classType->GetMemberInfo(index);
+        SetTopMemberId(memberInfo->GetId());
+        for ( TMemberIndex i = *pos; i < index; ++i ) {
+            classType->GetMemberInfo(i)->ReadMissingMember(*this, classPtr);
+        }
+        // hooks on the member or on its type need the generic code
+        if ( memberInfo->HaveReadHooks() ||
+             memberInfo->GetTypeInfo()->HaveReadHooks() ||
+             !func(*this, memberInfo, classPtr) ) {
+            memberInfo->ReadMember(*this, classPtr);
+        }
+        pos.SetIndex(index + 1);
+        CObjectIStreamAsnBinary::EndClassMember();
+    }
+
+    ReadClassSequentialContentsEnd(classPtr);
+    CObjectIStreamAsnBinary::EndClass();
+    END_OBJECT_FRAME();
+}
+
 #ifdef VIRTUAL_MID_LEVEL_IO
 void CObjectIStreamAsnBinary::ReadClassRandom(const CClassTypeInfo* classType,
                                               TObjectPtr classPtr)
@@ -35,6 +35,11 @@
 #include <corelib/ncbi_limits.h>
 
 #include <serial/objistrjson.hpp>
+#include <serial/impl/objstrjson.hpp>
+
+#include <math.h>
+#include <cmath>
+#include <charconv>
 
 #define NCBI_USE_ERRCODE_X   Serial_OStream
 
@@ -245,6 +250,14 @@ int CObjectIStreamJson::ReadEscapedChar(bool* encoded /*=0*/)
             }
             return v;
         }
+        switch (c) {
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        default:  break;
+        }
     } else {
         if (encoded) {
             *encoded = false;
@@ -310,12 +323,37 @@ TUnicodeSymbol CObjectIStreamJson::ReadUtf8Char(char c)
     return chU;
 }
 
+bool CObjectIStreamJson::x_ReadPlainChars(string& str, EStringType type)
+{
+    if ( !m_Utf8Buf.empty() ) {
+        return false;
+    }
+    size_t count = m_Input.PeekAvailableChars();
+    if ( !count ) {
+        return false;
+    }
+    // non-ASCII chars are copied as is unless they need recoding
+    EEncoding enc_out( type == eStringTypeUTF8 ? eEncoding_UTF8 : m_StringEncoding);
+    bool stop_on_8bit = enc_out != eEncoding_UTF8 && enc_out != eEncoding_Unknown;
+    const char* pos = m_Input.GetCurrentPos();
+    count = CJsonDefs::FindSpecialChar(pos, pos+count, stop_on_8bit) - pos;
+    if ( !count ) {
+        return false;
+    }
+    str.append(pos, count);
+    m_Input.SkipChars(count);
+    return true;
+}
+
 string CObjectIStreamJson::x_ReadString(EStringType type)
 {
     m_ExpectValue = false;
     Expect('\"',true);
     string str;
     for (;;) {
+        if ( x_ReadPlainChars(str, type) ) {
+            continue;
+        }
         bool encoded = false;
         char c = ReadEncodedChar(type, encoded);
         if (!encoded) {
@@ -368,11 +406,39 @@ bool CObjectIStreamJson::x_ReadDataAndCheck(string& str, EStringType type)
     return true;
 }
 
+bool CObjectIStreamJson::x_PeekNumber(CTempString& str, bool allow_minus)
+{
+    // number which is already in the input buffer is parsed in place
+    char c = SkipWhiteSpace();
+    if ( !(isdigit((unsigned char)c) || (allow_minus && c == '-')) ) {
+        return false;
+    }
+    size_t count = m_Input.PeekAvailableChars();
+    const char* pos = m_Input.GetCurrentPos();
+    for ( size_t i = 1; i < count; ++i ) {
+        switch ( pos[i] ) {
+        case ',': case ']': case '}': case ' ': case '\r': case '\n':
+            str.assign(pos, i);
+            return true;
+        case '\\':
+            return false;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
 void  CObjectIStreamJson::x_SkipData(void)
 {
     m_ExpectValue = false;
     char to = GetChar(true);
     for (;;) {
+        if ( to == '\"'  &&  m_Utf8Buf.empty() ) {
+            size_t count = m_Input.PeekAvailableChars();
+            const char* pos = m_Input.GetCurrentPos();
+            m_Input.SkipChars(CJsonDefs::FindSpecialChar(pos, pos+count, false) - pos);
+        }
         bool encoded = false;
         char c = ReadEncodedChar(eStringTypeUTF8, encoded);
         if (!encoded) {
@@ -516,6 +582,12 @@ void CObjectIStreamJson::SkipChar(void)
 
 Int8 CObjectIStreamJson::ReadInt8(void)
 {
+    CTempString data;
+    if ( x_PeekNumber(data, true) ) {
+        Int8 value = NStr::StringToInt8(data);
+        m_Input.SkipChars(data.size());
+        return value;
+    }
     string str;
     if (x_ReadDataAndCheck(str)) {
         if (str.empty() || !(isdigit(str[0]) || str[0] == '+' || str[0] == '-')) {
@@ -528,6 +600,12 @@ Int8 CObjectIStreamJson::ReadInt8(void)
 
 Uint8 CObjectIStreamJson::ReadUint8(void)
 {
+    CTempString data;
+    if ( x_PeekNumber(data, false) ) {
+        Uint8 value = NStr::StringToUInt8(data);
+        m_Input.SkipChars(data.size());
+        return value;
+    }
     string str;
     if (x_ReadDataAndCheck(str)) {
         if (str.empty() || !(isdigit(str[0]) || str[0] == '+')) {
@@ -548,16 +626,39 @@ void CObjectIStreamJson::SkipUNumber(void)
     x_SkipData();
 }
 
+double CObjectIStreamJson::x_ParseDouble(const CTempString& str)
+{
+#if defined(__cpp_lib_to_chars)
+    // correctly rounded conversion, so that shortest representation
+    // written by CObjectOStreamJson is read back exactly
+    {
+        double result = 0;
+        auto res = std::from_chars(str.data(), str.data()+str.size(), result);
+        if ( res.ec == std::errc() && res.ptr == str.data()+str.size() &&
+             std::isfinite(result) ) {
+            return result;
+        }
+    }
+#endif
+    char* endptr = nullptr;
+    double result = NStr::StringToDoublePosix( str.data(), &endptr, NStr::fDecimalPosixFinite);
+    if ( endptr != str.data()+str.size() ) {
+        ThrowError(fFormatError, string("invalid number: ") + string(str));
+    }
+    return result;
+}
+
 double CObjectIStreamJson::ReadDouble(void)
 {
+    CTempString data;
+    if ( x_PeekNumber(data, true) ) {
+        double value = x_ParseDouble(data);
+        m_Input.SkipChars(data.size());
+        return value;
+    }
     string str;
     if (x_ReadDataAndCheck(str)) {
-        char* endptr = nullptr;
-        double result = NStr::StringToDoublePosix( str.c_str(), &endptr, NStr::fDecimalPosixFinite);
-        if ( *endptr != 0 ) {
-            ThrowError(fFormatError, string("invalid number: ") + str);
-        }
-        return result;
+        return x_ParseDouble(str);
     }
     return x_UseMemberDefault<double>();
 }
@@ -43,6 +43,9 @@
 #include <serial/impl/aliasinfo.hpp>
 #include <serial/impl/memberlist.hpp>
 #include <serial/impl/memberid.hpp>
+#if NCBI_SSE >= 20
+#  include <emmintrin.h>
+#endif
 
 BEGIN_NCBI_SCOPE
 
@@ -220,6 +223,58 @@ bool IsEndOfTagChar(char c)
     return c == '>' || c == '/';
 }
 
+// Check if the char in tag data is copied as is: printable ASCII, except
+// markup and entity start, or tab and new line outside of attributes.
+// Chars >= 0x80 may need encoding conversion, and CR - end of line handling.
+static inline
+bool IsPlainTagDataChar(char c, bool attlist)
+{
+    unsigned char uc = (unsigned char)c;
+    if ( uc >= 0x20 && uc < 0x7F ) {
+        return c != '<' && c != '&' && (c != '"' || !attlist);
+    }
+    return !attlist && (c == '\n' || c == '\t');
+}
+
+// Find first char in [pos, end) which is not IsPlainTagDataChar().
+static inline
+const char* s_FindTagDataSpecialChar(const char* pos, const char* end,
+                                     bool attlist)
+{
+#if NCBI_SSE >= 20
+    const __m128i low = _mm_set1_epi8(' ');
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i quot = _mm_set1_epi8(attlist ? '"' : '<');
+    const __m128i del = _mm_set1_epi8(0x7F);
+    while ( end - pos >= 16 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        // signed comparison also catches chars >= 0x80
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmplt_epi8(v, low), _mm_cmpeq_epi8(v, lt)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, amp), _mm_cmpeq_epi8(v, quot)));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(v, del));
+        if ( _mm_movemask_epi8(special) ) {
+            // tabs and new lines are plain, check the block char by char
+            for ( const char* block_end = pos + 16; pos < block_end; ++pos ) {
+                if ( !IsPlainTagDataChar(*pos, attlist) ) {
+                    return pos;
+                }
+            }
+        }
+        else {
+            pos += 16;
+        }
+    }
+#endif
+    for ( ; pos < end; ++pos ) {
+        if ( !IsPlainTagDataChar(*pos, attlist) ) {
+            break;
+        }
+    }
+    return pos;
+}
+
 char CObjectIStreamXml::SkipWS(void)
 {
 //    _ASSERT(InsideTag());
@@ -439,16 +494,27 @@ CTempString CObjectIStreamXml::ReadName(char c)
 
     // find end of tag name
     size_t i = 1, iColon = 0;
-    while ( IsNameChar(c = m_Input.PeekChar(i)) ) {
+    for ( ;; ) {
+        // scan chars which are already in buffer without per-char calls
+        size_t count = m_Input.PeekAvailableChars();
+        const char* data = m_Input.GetCurrentPos();
+        for ( ; i < count && IsNameChar(c = data[i]); ++i ) {
+            if (!m_Doctype_found && c == ':') {
+                iColon = i+1;
+            }
+        }
+        if ( !IsNameChar(c = m_Input.PeekChar(i)) ) {
+            break;
+        }
         if (!m_Doctype_found && c == ':') {
             iColon = i+1;
         }
         ++i;
     }
 
-    // save beginning of tag name
+    // save beginning of tag name, reusing the tag buffer
     const char* ptr = m_Input.GetCurrentPos();
-    m_LastTag = string(ptr+iColon, i-iColon);
+    m_LastTag.assign(ptr+iColon, i-iColon);
     string ns_prefix;
     if (iColon > 1) {
         ns_prefix = string(ptr, iColon-1);
@@ -1323,6 +1389,18 @@ void CObjectIStreamXml::ReadTagData(string& str, EStringType type)
     bool CR = false;
     try {
         for ( ;; ) {
+            if ( !CR && m_Utf8Buf.empty() ) {
+                // copy plain ASCII text which is already in buffer at once
+                size_t count = m_Input.PeekAvailableChars();
+                const char* data = m_Input.GetCurrentPos();
+                size_t plain = s_FindTagDataSpecialChar(data, data + count,
+                                                        m_Attlist) - data;
+                if ( plain ) {
+                    str.append(data, plain);
+                    m_Input.SkipChars(plain);
+                    continue;
+                }
+            }
             int c = ReadEncodedChar(m_Attlist ? '\"' : '<', type, encoded);
             if ( c < 0 ) {
                 if (m_Attlist || !ReadCDSection(str)) {
@@ -449,6 +449,69 @@ void CObjectOStream::x_SetPathHooks(bool set)
     }
 }
 
+static bool s_HaveWriteHooks(TTypeInfo type, set<TTypeInfo>& visited)
+{
+    if ( !visited.insert(type).second ) {
+        return false;
+    }
+    if ( type->HaveWriteHooks() ) {
+        return true;
+    }
+    switch ( type->GetTypeFamily() ) {
+    case eTypeFamilyClass:
+    {
+        const CClassTypeInfo* classType =
+            CTypeConverter<CClassTypeInfo>::SafeCast(type);
+        for ( CClassTypeInfo::CIterator i(classType); i.Valid(); ++i ) {
+            const CMemberInfo* memberInfo = classType->GetMemberInfo(i);
+            if ( memberInfo->HaveWriteHooks() ||
+                 s_HaveWriteHooks(memberInfo->GetTypeInfo(), visited) ) {
+                return true;
+            }
+        }
+        break;
+    }
+    case eTypeFamilyChoice:
+    {
+        const CChoiceTypeInfo* choiceType =
+            CTypeConverter<CChoiceTypeInfo>::SafeCast(type);
+        for ( CChoiceTypeInfo::CIterator i(choiceType); i.Valid(); ++i ) {
+            const CVariantInfo* variantInfo = choiceType->GetVariantInfo(i);
+            if ( variantInfo->HaveWriteHooks() ||
+                 s_HaveWriteHooks(variantInfo->GetTypeInfo(), visited) ) {
+                return true;
+            }
+        }
+        break;
+    }
+    case eTypeFamilyContainer:
+        return s_HaveWriteHooks(
+            CTypeConverter<CContainerTypeInfo>::SafeCast(type)
+            ->GetElementType(), visited);
+    case eTypeFamilyPointer:
+        return s_HaveWriteHooks(
+            CTypeConverter<CPointerTypeInfo>::SafeCast(type)
+            ->GetPointedType(), visited);
+    default:
+        break;
+    }
+    return false;
+}
+
+bool CObjectOStream::HaveWriteHooks(TTypeInfo type) const
+{
+    if ( !m_ObjectHookKey.IsEmpty() ||
+         !m_ClassMemberHookKey.IsEmpty() ||
+         !m_ChoiceVariantHookKey.IsEmpty() ||
+         !m_PathWriteObjectHooks.IsEmpty() ||
+         !m_PathWriteMemberHooks.IsEmpty() ||
+         !m_PathWriteVariantHooks.IsEmpty() ) {
+        return true;
+    }
+    set<TTypeInfo> visited;
+    return s_HaveWriteHooks(type, visited);
+}
+
 void CObjectOStream::SetPathWriteObjectHook(const string& path,
                                             CWriteObjectHook*   hook)
 {
@@ -69,10 +69,17 @@ CObjectOStream* CObjectOStream::OpenObjectOStreamAsnBinary(CNcbiOstream& out,
     return new CObjectOStreamAsnBinary(out, deleteOut);
 }
 
+NCBI_PARAM_DECL(bool, SERIAL, WRITE_DIRECT_CODECS);
+NCBI_PARAM_DEF_EX(bool, SERIAL, WRITE_DIRECT_CODECS, true,
+                  eParam_NoThread, SERIAL_WRITE_DIRECT_CODECS);
+typedef NCBI_PARAM_TYPE(SERIAL, WRITE_DIRECT_CODECS) TWriteDirectCodecs;
+static CSafeStatic<TWriteDirectCodecs> s_WriteDirectCodecs;
+
 CObjectOStreamAsnBinary::CObjectOStreamAsnBinary(CNcbiOstream& out,
                                                  EFixNonPrint how)
     : CObjectOStream(eSerial_AsnBinary, out),
-      m_CStyleBigInt(false), m_SkipNextTag(false), m_AutomaticTagging(true)
+      m_CStyleBigInt(false), m_SkipNextTag(false), m_AutomaticTagging(true),
+      m_UseDirectCodecs(s_WriteDirectCodecs->Get())
 {
     FixNonPrint(how);
 #if CHECK_OUTSTREAM_INTEGRITY
@@ -86,7 +93,8 @@ CObjectOStreamAsnBinary::CObjectOStreamAsnBinary(CNcbiOstream& out,
                                                  bool deleteOut,
                                                  EFixNonPrint how)
     : CObjectOStream(eSerial_AsnBinary, out, deleteOut ? eTakeOwnership : eNoOwnership),
-      m_CStyleBigInt(false), m_SkipNextTag(false), m_AutomaticTagging(true)
+      m_CStyleBigInt(false), m_SkipNextTag(false), m_AutomaticTagging(true),
+      m_UseDirectCodecs(s_WriteDirectCodecs->Get())
 {
     FixNonPrint(how);
 #if CHECK_OUTSTREAM_INTEGRITY
@@ -100,7 +108,8 @@ CObjectOStreamAsnBinary::CObjectOStreamAsnBinary(CNcbiOstream& out,
                                                  EOwnership deleteOut,
                                                  EFixNonPrint how)
     : CObjectOStream(eSerial_AsnBinary, out, deleteOut),
-      m_CStyleBigInt(false), m_SkipNextTag(false), m_AutomaticTagging(true)
+      m_CStyleBigInt(false), m_SkipNextTag(false), m_AutomaticTagging(true),
+      m_UseDirectCodecs(s_WriteDirectCodecs->Get())
 {
     FixNonPrint(how);
 #if CHECK_OUTSTREAM_INTEGRITY
@@ -1377,6 +1386,44 @@ void CObjectOStreamAsnBinary::EndClassMember(void)
 #endif
 }
 
+void CObjectOStreamAsnBinary::BeginDirectMember(void)
+{
+    CObjectOStreamAsnBinary::BeginClassMember(TopFrame().GetMemberId());
+}
+
+void CObjectOStreamAsnBinary::EndDirectMember(void)
+{
+    CObjectOStreamAsnBinary::EndClassMember();
+}
+
+void CObjectOStreamAsnBinary::WriteClassDirect(const CClassTypeInfo* classType,
+                                               TConstObjectPtr classPtr)
+{
+    TMemberDirectWriteFunction func = classType->GetDirectWriteFunction();
+    _ASSERT(func);
+    BEGIN_OBJECT_FRAME2(eFrameClass, classType);
+    CObjectOStreamAsnBinary::BeginClass(classType);
+
+    for ( CClassTypeInfo::CIterator i(classType); i.Valid(); ++i ) {
+        const CMemberInfo* memberInfo = classType->GetMemberInfo(i);
+        // hooks on the member or on its type need the generic code
+        if ( !memberInfo->HaveWriteHooks() &&
+             !memberInfo->GetTypeInfo()->HaveWriteHooks() ) {
+            bool done = false;
+            BEGIN_OBJECT_FRAME2(eFrameClassMember, memberInfo->GetId());
+            done = func(*this, memberInfo, classPtr);
+            END_OBJECT_FRAME();
+            if ( done ) {
+                continue;
+            }
+        }
+        memberInfo->WriteMember(*this, classPtr);
+    }
+
+    CObjectOStreamAsnBinary::EndClass();
+    END_OBJECT_FRAME();
+}
+
 #ifdef VIRTUAL_MID_LEVEL_IO
 void CObjectOStreamAsnBinary::WriteClass(const CClassTypeInfo* classType,
                                          TConstObjectPtr classPtr)
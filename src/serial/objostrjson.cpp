@@ -47,9 +47,12 @@
 #include <serial/delaybuf.hpp>
 #include <serial/impl/ptrinfo.hpp>
 #include <serial/error_codes.hpp>
+#include <serial/impl/objstrjson.hpp>
 
 #include <stdio.h>
 #include <math.h>
+#include <cmath>
+#include <charconv>
 
 
 #define NCBI_USE_ERRCODE_X   Serial_OStream
@@ -199,11 +202,29 @@ void CObjectOStreamJson::WriteUint8(Uint8 data)
 
 void CObjectOStreamJson::WriteFloat(float data)
 {
+#if defined(__cpp_lib_to_chars)
+    if (m_FastWriteDouble  &&  std::isfinite(data)) {
+        // shortest representation which reads back to the same value
+        char buffer[64];
+        auto res = std::to_chars(buffer, buffer + sizeof(buffer), data);
+        WriteKeywordValue(CTempString(buffer, res.ptr - buffer));
+        return;
+    }
+#endif
     WriteDouble2(data,FLT_DIG);
 }
 
 void CObjectOStreamJson::WriteDouble(double data)
 {
+#if defined(__cpp_lib_to_chars)
+    if (m_FastWriteDouble  &&  std::isfinite(data)) {
+        // shortest representation which reads back to the same value
+        char buffer[64];
+        auto res = std::to_chars(buffer, buffer + sizeof(buffer), data);
+        WriteKeywordValue(CTempString(buffer, res.ptr - buffer));
+        return;
+    }
+#endif
     WriteDouble2(data,DBL_DIG);
 }
 
@@ -212,12 +233,12 @@ void CObjectOStreamJson::WriteDouble2(double data, unsigned digits)
     if (isnan(data)) {
         ThrowError(fInvalidData, "invalid double: not a number");
     }
-    if (!finite(data)) {
+    if (!std::isfinite(data)) {
         ThrowError(fInvalidData, "invalid double: infinite");
     }
     if (m_FastWriteDouble) {
         char buffer[64];
-        WriteKeywordValue( string(buffer,
+        WriteKeywordValue( CTempString(buffer,
             NStr::DoubleToStringPosix(data, digits, buffer, sizeof(buffer))));
     } else {
         WriteKeywordValue(NStr::DoubleToString(data,digits, NStr::fDoublePosix));
@@ -770,8 +791,20 @@ void CObjectOStreamJson::WriteEncodedChar(const char*& src, EStringType type)
 
 void CObjectOStreamJson::x_WriteString(const string& value, EStringType type)
 {
+    EEncoding enc_in( type == eStringTypeUTF8 ? eEncoding_UTF8 : m_StringEncoding);
+    bool stop_on_8bit = enc_in != eEncoding_UTF8;
+    const char* end = value.data() + value.size();
     m_Output.PutChar('\"');
-    for (const char* src = value.c_str(); *src; ++src) {
+    for (const char* src = value.c_str(); ; ++src) {
+        // chars which need no escaping are written in one piece
+        const char* plain = CJsonDefs::FindSpecialChar(src, end, stop_on_8bit);
+        if (plain != src) {
+            m_Output.PutString(src, plain - src);
+            src = plain;
+        }
+        if (!*src) {
+            break;
+        }
         WriteEncodedChar(src,type);
     }
     m_Output.PutChar('\"');
@@ -779,11 +812,13 @@ void CObjectOStreamJson::x_WriteString(const string& value, EStringType type)
 
 void CObjectOStreamJson::WriteKey(const string& key)
 {
-    string s(key);
-    if (!m_PreserveKeys) {
+    if (m_PreserveKeys  ||  key.find('-') == NPOS) {
+        x_WriteString(key);
+    } else {
+        string s(key);
         NStr::ReplaceInPlace(s,"-","_");
+        x_WriteString(s);
     }
-    x_WriteString(s);
     NameSeparator();
 }
 
@@ -801,10 +836,10 @@ void CObjectOStreamJson::WriteValue(const string& value, EStringType type)
     m_ExpectValue = false;
 }
 
-void CObjectOStreamJson::WriteKeywordValue(const string& value)
+void CObjectOStreamJson::WriteKeywordValue(const CTempString& value)
 {
     BeginValue();
-    m_Output.PutString(value);
+    m_Output.PutString(value.data(), value.size());
     m_ExpectValue = false;
 }
 
@@ -32,6 +32,7 @@
 #include <serial/pack_string.hpp>
 #include <serial/objistr.hpp>
 #include <serial/objectiter.hpp>
+#include <corelib/ncbi_param.hpp>
 
 BEGIN_NCBI_SCOPE
 
@@ -41,8 +42,136 @@ static const char* const ENV_YES = "YES";
 static const size_t kDefaultLengthLimit = 32;
 static const size_t kDefaultCountLimit = 32;
 
+NCBI_PARAM_DECL(unsigned, SERIAL, PACK_STRINGS_TABLE_SIZE);
+NCBI_PARAM_DEF_EX(unsigned, SERIAL, PACK_STRINGS_TABLE_SIZE, 64*1024,
+                  eParam_NoThread, SERIAL_PACK_STRINGS_TABLE_SIZE);
+typedef NCBI_PARAM_TYPE(SERIAL, PACK_STRINGS_TABLE_SIZE) TPackStringsTableSize;
+
+
+CPackStringTable::CPackStringTable(size_t capacity)
+{
+    // keep shards at most half full so that probe sequences stay short
+    size_t shard_slots = 16;
+    while ( shard_slots*kShardCount < 2*capacity ) {
+        shard_slots *= 2;
+    }
+    m_SlotMask = shard_slots - 1;
+    m_ShardLimit = shard_slots / 2;
+    for ( size_t i = 0; i < kShardCount; ++i ) {
+        SShard& shard = m_Shards[i];
+        shard.m_Slots.reset(new atomic<SEntry*>[shard_slots]);
+        for ( size_t j = 0; j < shard_slots; ++j ) {
+            shard.m_Slots[j].store(0, memory_order_relaxed);
+        }
+    }
+}
+
+
+CPackStringTable::~CPackStringTable(void)
+{
+    for ( size_t i = 0; i < kShardCount; ++i ) {
+        SShard& shard = m_Shards[i];
+        for ( size_t j = 0; j <= m_SlotMask; ++j ) {
+            delete shard.m_Slots[j].load(memory_order_relaxed);
+        }
+    }
+}
+
+
+CPackStringTable& CPackStringTable::GetInstance(void)
+{
+    // the table is never deleted, so that the strings shared with it
+    // stay valid during static objects destruction
+    static CPackStringTable* s_Table =
+        new CPackStringTable(TPackStringsTableSize::GetDefault());
+    return *s_Table;
+}
+
+
+size_t CPackStringTable::x_Hash(const char* data, size_t size)
+{
+    // FNV-1a
+    Uint8 hash = NCBI_CONST_UINT8(14695981039346656037);
+    for ( size_t i = 0; i < size; ++i ) {
+        hash = (hash ^ Uint1(data[i])) * NCBI_CONST_UINT8(1099511628211);
+    }
+    return size_t(hash ^ (hash >> 32));
+}
+
+
+const string* CPackStringTable::Find(const char* data, size_t size) const
+{
+    size_t hash = x_Hash(data, size);
+    const SShard& shard = m_Shards[hash & (kShardCount-1)];
+    size_t index = hash >> kShardBits;
+    for ( size_t probe = 0; probe < kMaxProbes; ++probe, ++index ) {
+        const SEntry* entry =
+            shard.m_Slots[index & m_SlotMask].load(memory_order_acquire);
+        if ( !entry ) {
+            break;
+        }
+        if ( entry->Equals(hash, data, size) ) {
+            return &entry->m_String;
+        }
+    }
+    return 0;
+}
+
+
+pair<const string*, bool>
+CPackStringTable::Intern(const char* data, size_t size)
+{
+    size_t hash = x_Hash(data, size);
+    SShard& shard = m_Shards[hash & (kShardCount-1)];
+    size_t index = hash >> kShardBits;
+    unique_ptr<SEntry> new_entry;
+    for ( size_t probe = 0; probe < kMaxProbes; ++probe, ++index ) {
+        atomic<SEntry*>& slot = shard.m_Slots[index & m_SlotMask];
+        SEntry* entry = slot.load(memory_order_acquire);
+        if ( !entry ) {
+            if ( shard.m_Count.load(memory_order_relaxed) >= m_ShardLimit ) {
+                break;
+            }
+            if ( !new_entry ) {
+                new_entry.reset(new SEntry(hash, data, size));
+            }
+            if ( slot.compare_exchange_strong(entry, new_entry.get(),
+                                              memory_order_acq_rel,
+                                              memory_order_acquire) ) {
+                shard.m_Count.fetch_add(1, memory_order_relaxed);
+                return make_pair(&new_entry.release()->m_String, true);
+            }
+            // another thread has filled the slot, check its string
+        }
+        if ( entry->Equals(hash, data, size) ) {
+            return make_pair(&entry->m_String, false);
+        }
+    }
+    return make_pair((const string*)0, false);
+}
+
+
+size_t CPackStringTable::GetCount(void) const
+{
+    size_t count = 0;
+    for ( size_t i = 0; i < kShardCount; ++i ) {
+        count += m_Shards[i].m_Count.load(memory_order_relaxed);
+    }
+    return count;
+}
+
+
+CNcbiOstream& CPackStringTable::DumpStatistics(CNcbiOstream& out) const
+{
+    out << setw(10) << GetCount() << " of " << GetCapacity()
+        << " shared strings\n";
+    return out;
+}
+
+
 CPackString::CPackString(void)
-    : m_LengthLimit(kDefaultLengthLimit), m_CountLimit(kDefaultCountLimit),
+    : m_SharedTable(0),
+      m_LengthLimit(kDefaultLengthLimit), m_CountLimit(kDefaultCountLimit),
       m_Skipped(0), m_CompressedIn(0),
       m_CompressedOut(0)
 {
@@ -50,7 +179,28 @@ CPackString::CPackString(void)
 
 
 CPackString::CPackString(size_t length_limit, size_t count_limit)
-    : m_LengthLimit(length_limit), m_CountLimit(count_limit),
+    : m_SharedTable(0),
+      m_LengthLimit(length_limit), m_CountLimit(count_limit),
+      m_Skipped(0), m_CompressedIn(0),
+      m_CompressedOut(0)
+{
+}
+
+
+CPackString::CPackString(EShared /*shared*/)
+    : m_SharedTable(&CPackStringTable::GetInstance()),
+      m_LengthLimit(kDefaultLengthLimit),
+      m_CountLimit(m_SharedTable->GetCapacity()),
+      m_Skipped(0), m_CompressedIn(0),
+      m_CompressedOut(0)
+{
+}
+
+
+CPackString::CPackString(EShared /*shared*/, size_t length_limit)
+    : m_SharedTable(&CPackStringTable::GetInstance()),
+      m_LengthLimit(length_limit),
+      m_CountLimit(m_SharedTable->GetCapacity()),
       m_Skipped(0), m_CompressedIn(0),
       m_CompressedOut(0)
 {
@@ -76,6 +226,9 @@ CNcbiOstream& CPackString::DumpStatistics(CNcbiOstream& out) const
     }
     out << setw(10) << total << " = " << m_CompressedIn << " -> " << m_CompressedOut << " strings\n";
     out << setw(10) << m_Skipped << " skipped\n";
+    if ( m_SharedTable ) {
+        m_SharedTable->DumpStatistics(out);
+    }
     return out;
 }
 
@@ -138,8 +291,34 @@ bool CPackString::x_Assign(string& s, const string& src)
 }
 
 
+bool CPackString::x_PackShared(string& s, const char* data, size_t size)
+{
+    if ( size <= GetLengthLimit() ) {
+        pair<const string*, bool> ret = m_SharedTable->Intern(data, size);
+        if ( ret.first ) {
+            ++m_CompressedIn;
+            if ( ret.second ) {
+                ++m_CompressedOut;
+            }
+            // plain copy: the shared string must not be modified,
+            // it may be used by other threads at the same time
+            s = *ret.first;
+            return ret.second;
+        }
+    }
+    Skipped();
+    if ( s.data() != data ) {
+        s.assign(data, size);
+    }
+    return false;
+}
+
+
 bool CPackString::Pack(string& s)
 {
+    if ( m_SharedTable ) {
+        return x_PackShared(s, s.data(), s.size());
+    }
     if ( s.size() <= GetLengthLimit() ) {
         SNode key(s);
         iterator iter = m_Strings.lower_bound(key);
@@ -163,6 +342,9 @@ bool CPackString::Pack(string& s)
 
 bool CPackString::Pack(string& s, const char* data, size_t size)
 {
+    if ( m_SharedTable ) {
+        return x_PackShared(s, data, size);
+    }
     if ( size <= GetLengthLimit() ) {
         SNode key(data, size);
         iterator iter = m_Strings.lower_bound(key);
@@ -189,6 +371,7 @@ bool CPackString::AddNew(string& s, const char* data, size_t size,
                          iterator iter)
 {
     SNode key(data, size);
+    _ASSERT(!IsShared());
     _ASSERT(size <= GetLengthLimit());
     _ASSERT(iter == m_Strings.lower_bound(key));
     _ASSERT(!(iter != m_Strings.end() && *iter == key));
@@ -217,6 +400,19 @@ CPackStringClassHook::CPackStringClassHook(size_t length_limit,
 }
 
 
+CPackStringClassHook::CPackStringClassHook(CPackString::EShared shared)
+    : m_PackString(shared)
+{
+}
+
+
+CPackStringClassHook::CPackStringClassHook(CPackString::EShared shared,
+                                           size_t length_limit)
+    : m_PackString(shared, length_limit)
+{
+}
+
+
 CPackStringClassHook::~CPackStringClassHook(void)
 {
 #if 0
@@ -238,6 +434,19 @@ CPackStringChoiceHook::CPackStringChoiceHook(size_t length_limit,
 }
 
 
+CPackStringChoiceHook::CPackStringChoiceHook(CPackString::EShared shared)
+    : m_PackString(shared)
+{
+}
+
+
+CPackStringChoiceHook::CPackStringChoiceHook(CPackString::EShared shared,
+                                             size_t length_limit)
+    : m_PackString(shared, length_limit)
+{
+}
+
+
 CPackStringChoiceHook::~CPackStringChoiceHook(void)
 {
 #if 0
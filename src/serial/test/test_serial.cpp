@@ -32,7 +32,22 @@
 
 #include <ncbi_pch.hpp>
 #include "test_serial.hpp"
+#include <serial/objistrasnb.hpp>
+#include <serial/objostrasnb.hpp>
+#include <serial/objistrjson.hpp>
+#include <serial/objostrjson.hpp>
+#include <serial/objistrxml.hpp>
+#include <serial/objostrxml.hpp>
+#include <serial/impl/stdtypes.hpp>
+#include <serial/pack_string.hpp>
+#include <objects/seqset/Seq_entry.hpp>
+#include <objects/seq/Bioseq.hpp>
+#include <objects/seq/Seq_inst.hpp>
+#include <objects/seq/Seq_annot.hpp>
+#include <objects/seqfeat/Seq_feat.hpp>
+#include <thread>
 #ifndef HAVE_NCBI_C
+#include <serial/test/Query_Search.hpp>
 
 /////////////////////////////////////////////////////////////////////////////
 // Test ASN serialization
@@ -619,6 +634,152 @@ BOOST_AUTO_TEST_CASE(s_TestSerialFilter)
 }
 #endif    
 
+/////////////////////////////////////////////////////////////////////////////
+// TestAsyncWriter
+
+#if defined(NCBI_THREADS) && !defined(HAVE_NCBI_C)
+BOOST_AUTO_TEST_CASE(s_TestAsyncWriter)
+{
+    CRef<CWeb_Env> env(new CWeb_Env);
+    {
+        unique_ptr<CObjectIStream> in(
+            CObjectIStream::Open("webenv.bin", eSerial_AsnBinary));
+        *in >> *env;
+    }
+    // make a longer list of queries
+    CWeb_Env::TQueries queries;
+    for (int i = 0; i < 50; ++i) {
+        ITERATE(CWeb_Env::TQueries, q, env->GetQueries()) {
+            CRef<CQuery_History> query(SerialClone(**q));
+            query->SetSeqNumber(int(queries.size()));
+            queries.push_back(query);
+        }
+    }
+    CObjectTypeInfo containerType =
+        CObjectTypeInfo(CType<CWeb_Env>()).FindMember("queries").GetMemberType();
+
+    ESerialDataFormat formats[] = {
+        eSerial_AsnBinary, eSerial_AsnText, eSerial_Xml, eSerial_Json
+    };
+    for (ESerialDataFormat format : formats) {
+        // expected data: processed objects written synchronously
+        string expected;
+        {
+            CNcbiOstrstream ostrs;
+            {
+                unique_ptr<CObjectOStream> out(
+                    CObjectOStream::Open(format, ostrs));
+                COStreamContainer o(*out, containerType);
+                ITERATE(CWeb_Env::TQueries, q, queries) {
+                    CRef<CQuery_History> query(SerialClone(**q));
+                    query->SetSeqNumber(query->GetSeqNumber() + 1000);
+                    o << *query;
+                }
+            }
+            expected = CNcbiOstrstreamToString(ostrs);
+        }
+        for (size_t per_task = 1; per_task <= 8; per_task *= 2) {
+            atomic<size_t> processed(0);
+            CObjectOStreamAsyncWriter<CQuery_History>::CParams params;
+            params.MaxEncoderThreads(4).ObjectsPerTask(per_task)
+                .Process([&processed](CQuery_History& query) {
+                    query.SetSeqNumber(query.GetSeqNumber() + 1000);
+                    ++processed;
+                });
+            CNcbiOstrstream ostrs;
+            {
+                unique_ptr<CObjectOStream> out(
+                    CObjectOStream::Open(format, ostrs));
+                CObjectOStreamAsyncWriter<CQuery_History> writer(
+                    *out, containerType, params);
+                BOOST_CHECK_EQUAL(writer.IsParallelEncoding(),
+                                  format == eSerial_AsnBinary);
+                ITERATE(CWeb_Env::TQueries, q, queries) {
+                    writer.Write(Ref(SerialClone(**q)));
+                }
+                writer.Flush();
+            }
+            BOOST_CHECK_EQUAL(processed.load(), queries.size());
+            BOOST_CHECK(CNcbiOstrstreamToString(ostrs) == expected);
+        }
+    }
+}
+
+class CCountQueryWriteHook : public CWriteObjectHook
+{
+public:
+    CCountQueryWriteHook(size_t& count) : m_Count(count) {}
+    virtual void WriteObject(CObjectOStream& out,
+                             const CConstObjectInfo& object)
+        {
+            ++m_Count;
+            DefaultWrite(out, object);
+        }
+private:
+    size_t& m_Count;
+};
+
+// async writer keeps the stream settings and hooks
+BOOST_AUTO_TEST_CASE(s_TestAsyncWriterHooks)
+{
+    CRef<CWeb_Env> env(new CWeb_Env);
+    {
+        unique_ptr<CObjectIStream> in(
+            CObjectIStream::Open("webenv.bin", eSerial_AsnBinary));
+        *in >> *env;
+    }
+    CWeb_Env::TQueries queries;
+    for (int i = 0; i < 10; ++i) {
+        ITERATE(CWeb_Env::TQueries, q, env->GetQueries()) {
+            CRef<CQuery_History> query(SerialClone(**q));
+            query->SetName("query\x01name");
+            queries.push_back(query);
+        }
+    }
+    CObjectTypeInfo containerType =
+        CObjectTypeInfo(CType<CWeb_Env>()).FindMember("queries").GetMemberType();
+
+    for (int hook = 0; hook < 2; ++hook) {
+        string data[2];
+        size_t count[2] = { 0, 0 };
+        for (int async = 0; async < 2; ++async) {
+            CNcbiOstrstream ostrs;
+            {
+                CObjectOStreamAsnBinary out(ostrs);
+                out.FixNonPrint(eFNP_Replace);
+                out.FixNonPrintSubst('*');
+                if (hook) {
+                    CObjectTypeInfo(CType<CQuery_History>()).SetLocalWriteHook(
+                        out, new CCountQueryWriteHook(count[async]));
+                }
+                if (async) {
+                    CObjectOStreamAsyncWriter<CQuery_History>::CParams params;
+                    params.MaxEncoderThreads(4).ObjectsPerTask(3);
+                    CObjectOStreamAsyncWriter<CQuery_History> writer(
+                        out, containerType, params);
+                    BOOST_CHECK_EQUAL(writer.IsParallelEncoding(), !hook);
+                    ITERATE(CWeb_Env::TQueries, q, queries) {
+                        writer.Write(*q);
+                    }
+                    writer.Flush();
+                }
+                else {
+                    COStreamContainer o(out, containerType);
+                    ITERATE(CWeb_Env::TQueries, q, queries) {
+                        o << **q;
+                    }
+                }
+            }
+            data[async] = CNcbiOstrstreamToString(ostrs);
+        }
+        BOOST_CHECK(data[0].find("query*name") != NPOS);
+        BOOST_CHECK(data[1] == data[0]);
+        BOOST_CHECK_EQUAL(count[0], hook? queries.size(): 0u);
+        BOOST_CHECK_EQUAL(count[1], count[0]);
+    }
+}
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 // TestMemberHooks
 
@@ -1001,4 +1162,679 @@ BOOST_AUTO_TEST_CASE(s_TestPrintAsn)
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// TestDirectCodecTypeHooks
+
+class CCountStringReadHook : public CReadObjectHook
+{
+public:
+    CCountStringReadHook(size_t& count) : m_Count(count) {}
+    virtual void ReadObject(CObjectIStream& in, const CObjectInfo& object)
+        {
+            ++m_Count;
+            DefaultRead(in, object);
+        }
+private:
+    size_t& m_Count;
+};
+
+class CCountStringWriteHook : public CWriteObjectHook
+{
+public:
+    CCountStringWriteHook(size_t& count) : m_Count(count) {}
+    virtual void WriteObject(CObjectOStream& out,
+                             const CConstObjectInfo& object)
+        {
+            ++m_Count;
+            DefaultWrite(out, object);
+        }
+private:
+    size_t& m_Count;
+};
+
+// generated ASN.1 binary member codecs must not bypass hooks
+// installed on the member type
+BOOST_AUTO_TEST_CASE(s_TestDirectCodecTypeHooks)
+{
+    CRef<CWeb_Env> env(new CWeb_Env);
+    {
+        unique_ptr<CObjectIStream> in(
+            CObjectIStream::Open("webenv.ent", eSerial_AsnText));
+        *in >> *env;
+    }
+    CObjectTypeInfo string_type(CStdTypeInfo<string>::GetTypeInfo());
+    size_t write_count[2] = { 0, 0 };
+    size_t read_count[2] = { 0, 0 };
+    string data[2];
+    for ( int direct = 0; direct < 2; ++direct ) {
+        CNcbiOstrstream ostrs;
+        {
+            CObjectOStreamAsnBinary out(ostrs);
+            out.SetUseDirectCodecs(direct != 0);
+            string_type.SetLocalWriteHook(
+                out, new CCountStringWriteHook(write_count[direct]));
+            out << *env;
+        }
+        data[direct] = CNcbiOstrstreamToString(ostrs);
+
+        CWeb_Env env_copy;
+        {
+            CObjectIStreamAsnBinary in(data[direct].data(),
+                                       data[direct].size());
+            in.SetUseDirectCodecs(direct != 0);
+            string_type.SetLocalReadHook(
+                in, new CCountStringReadHook(read_count[direct]));
+            in >> env_copy;
+        }
+        BOOST_CHECK(env_copy.Equals(*env));
+    }
+    BOOST_CHECK(write_count[0] > 0);
+    BOOST_CHECK_EQUAL(write_count[1], write_count[0]);
+    BOOST_CHECK_EQUAL(read_count[0], write_count[0]);
+    BOOST_CHECK_EQUAL(read_count[1], write_count[0]);
+    BOOST_CHECK(data[1] == data[0]);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// TestJsonData
+
+class CJsonTestData : public CSerialObject
+{
+public:
+    DECLARE_INTERNAL_TYPE_INFO();
+
+    vector<string> m_Strings;
+    vector<double> m_Doubles;
+    vector<Int8> m_Ints;
+};
+
+BEGIN_NAMED_CLASS_INFO("JsonTestData", CJsonTestData)
+{
+    ADD_NAMED_MEMBER("strings", m_Strings, STL_vector, (STD, (string)));
+    ADD_NAMED_MEMBER("doubles", m_Doubles, STL_vector, (STD, (double)));
+    ADD_NAMED_MEMBER("ints", m_Ints, STL_vector, (STD, (Int8)));
+}
+END_CLASS_INFO
+
+static void s_ReadJson(const string& json, CJsonTestData& data)
+{
+    CObjectIStreamJson in;
+    in.OpenFromBuffer(json.data(), json.size());
+    in >> data;
+}
+
+// string escapes, in-place number parsing and shortest doubles
+BOOST_AUTO_TEST_CASE(s_TestJsonData)
+{
+    CJsonTestData data;
+    data.m_Strings.push_back("");
+    data.m_Strings.push_back("plain text");
+    data.m_Strings.push_back("quote\" backslash\\ slash/ tab\t nl\n ctrl\x01");
+    data.m_Strings.push_back(string(100, 'x') + "\"" + string(100, 'y'));
+    data.m_Strings.push_back("caf\xC3\xA9");
+    double doubles[] = {
+        0, -1, 0.1, 1./3, 2./3, 1e300, -2.5e-310, 5e-324,
+        123456789.125, 1.7976931348623157e308, 4.35, 0.3
+    };
+    data.m_Doubles.assign(begin(doubles), end(doubles));
+    data.m_Ints.push_back(0);
+    data.m_Ints.push_back(-1);
+    data.m_Ints.push_back(numeric_limits<Int8>::max());
+    data.m_Ints.push_back(numeric_limits<Int8>::min());
+
+    string json;
+    {
+        CNcbiOstrstream ostrs;
+        {
+            CObjectOStreamJson out(ostrs, eNoOwnership);
+            out << data;
+        }
+        json = CNcbiOstrstreamToString(ostrs);
+    }
+    BOOST_CHECK(json.find("\"quote\\\" backslash\\\\ slash/") != NPOS);
+    BOOST_CHECK(json.find("ctrl\\u0001\"") != NPOS);
+    // shortest form which reads back exactly
+    BOOST_CHECK(json.find(" 0.1,") != NPOS);
+    BOOST_CHECK(json.find(" 4.35,") != NPOS);
+
+    CJsonTestData copy;
+    s_ReadJson(json, copy);
+    BOOST_CHECK(copy.m_Strings == data.m_Strings);
+    BOOST_CHECK(copy.m_Ints == data.m_Ints);
+    BOOST_REQUIRE_EQUAL(copy.m_Doubles.size(), data.m_Doubles.size());
+    for ( size_t i = 0; i < data.m_Doubles.size(); ++i ) {
+        // exact comparison
+        BOOST_CHECK_EQUAL(memcmp(&copy.m_Doubles[i], &data.m_Doubles[i],
+                                 sizeof(double)), 0);
+    }
+
+    CJsonTestData parsed;
+    s_ReadJson("{\"JsonTestData\":{"
+               "\"strings\":[\"a\\u0041\\n\\\"\\\\\\/\\t\", \"\\u00e9\"],"
+               "\"doubles\":[1E2, -0.5e-3, 7],"
+               "\"ints\":[12,-34]}}", parsed);
+    BOOST_REQUIRE_EQUAL(parsed.m_Strings.size(), 2u);
+    BOOST_CHECK_EQUAL(parsed.m_Strings[0], "aA\n\"\\/\t");
+    BOOST_CHECK_EQUAL(parsed.m_Strings[1], "\xC3\xA9");
+    BOOST_REQUIRE_EQUAL(parsed.m_Doubles.size(), 3u);
+    BOOST_CHECK_EQUAL(parsed.m_Doubles[0], 100.);
+    BOOST_CHECK_EQUAL(parsed.m_Doubles[1], -0.0005);
+    BOOST_CHECK_EQUAL(parsed.m_Doubles[2], 7.);
+    BOOST_REQUIRE_EQUAL(parsed.m_Ints.size(), 2u);
+    BOOST_CHECK_EQUAL(parsed.m_Ints[0], 12);
+    BOOST_CHECK_EQUAL(parsed.m_Ints[1], -34);
+
+    CJsonTestData bad;
+    BOOST_CHECK_THROW(s_ReadJson("{\"JsonTestData\":{\"ints\":[1x]}}", bad),
+                      CException);
+    BOOST_CHECK_THROW(s_ReadJson("{\"JsonTestData\":{\"doubles\":[1.5q]}}",
+                                 bad), CException);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// TestXmlEncoding
+
+class CXmlTestData : public CSerialObject
+{
+public:
+    DECLARE_INTERNAL_TYPE_INFO();
+
+    vector<string> m_Strings;
+};
+
+BEGIN_NAMED_CLASS_INFO("XmlTestData", CXmlTestData)
+{
+    ADD_NAMED_MEMBER("strings", m_Strings, STL_vector, (STD, (string)));
+}
+END_CLASS_INFO
+
+static void s_ReadXml(const string& xml, CXmlTestData& data)
+{
+    CObjectIStreamXml in;
+    in.OpenFromBuffer(xml.data(), xml.size());
+    in.SetDefaultStringEncoding(eEncoding_UTF8);
+    in >> data;
+}
+
+// non-ASCII and DEL chars in plain runs of tag data are not plain ASCII
+BOOST_AUTO_TEST_CASE(s_TestXmlEncoding)
+{
+    CXmlTestData data;
+    data.m_Strings.push_back("caf\xC3\xA9");
+    data.m_Strings.push_back(string(20, 'a') + "\xC3\xA9" + string(20, 'b') +
+                             "<&>" + string(17, 'c') + "\xC3\xA9");
+    data.m_Strings.push_back(string(20, 'a') + "\x7F" + string(20, 'b'));
+    data.m_Strings.push_back(string(15, 'a') + "\xC3\xBF" + string(15, 'b'));
+
+    EEncoding encodings[] = {
+        eEncoding_UTF8, eEncoding_ISO8859_1, eEncoding_Windows_1252
+    };
+    for ( EEncoding enc : encodings ) {
+        string xml;
+        {
+            CNcbiOstrstream ostrs;
+            {
+                CObjectOStreamXml out(ostrs, eNoOwnership);
+                out.SetEncoding(enc);
+                out.SetDefaultStringEncoding(eEncoding_UTF8);
+                out << data;
+            }
+            xml = CNcbiOstrstreamToString(ostrs);
+        }
+        if ( enc != eEncoding_UTF8 ) {
+            // single byte chars in the document
+            BOOST_CHECK(xml.find("caf\xE9<") != NPOS);
+        }
+        CXmlTestData copy;
+        s_ReadXml(xml, copy);
+        BOOST_CHECK(copy.m_Strings == data.m_Strings);
+    }
+
+    CXmlTestData parsed;
+    s_ReadXml("<?xml version=\"1.0\" encoding=\"Windows-1252\"?>\n"
+              "<XmlTestData><XmlTestData_strings>"
+              "<XmlTestData_strings_E>" + string(16, 'x') + "\x80" +
+              string(16, 'y') + "\xE9</XmlTestData_strings_E>"
+              "</XmlTestData_strings></XmlTestData>", parsed);
+    BOOST_REQUIRE_EQUAL(parsed.m_Strings.size(), 1u);
+    BOOST_CHECK_EQUAL(parsed.m_Strings[0],
+                      string(16, 'x') + "\xE2\x82\xAC" +
+                      string(16, 'y') + "\xC3\xA9");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// TestDelayContainers
+
+// '_delay_containers' members are delayed only with NeverParse policy
+BOOST_AUTO_TEST_CASE(s_TestDelayContainers)
+{
+    CRef<CWeb_Env> env(new CWeb_Env);
+    {
+        unique_ptr<CObjectIStream> in(
+            CObjectIStream::Open("webenv.ent", eSerial_AsnText));
+        *in >> *env;
+    }
+    BOOST_REQUIRE(env->IsSetQueries());
+    string data;
+    {
+        CNcbiOstrstream ostrs;
+        {
+            CObjectOStreamAsnBinary out(ostrs);
+            out << *env;
+        }
+        data = CNcbiOstrstreamToString(ostrs);
+    }
+    const CMemberInfo* queries_info =
+        CObjectTypeInfo(CType<CWeb_Env>()).FindMember("queries")
+        .GetMemberInfo();
+    BOOST_REQUIRE(queries_info->LazyDelay());
+
+    {{
+        // default policy parses everything
+        CWeb_Env parsed;
+        CObjectIStreamAsnBinary in(data.data(), data.size());
+        in >> parsed;
+        BOOST_CHECK(!queries_info->GetDelayBuffer(&parsed).Delayed());
+        BOOST_CHECK(parsed.Equals(*env));
+    }}
+
+    CWeb_Env delayed;
+    {
+        CObjectIStreamAsnBinary in(data.data(), data.size());
+        in.SetDelayBufferParsingPolicy(
+            CObjectIStream::eDelayBufferPolicyNeverParse);
+        in >> delayed;
+    }
+    BOOST_CHECK(queries_info->GetDelayBuffer(&delayed).Delayed());
+
+    // writing in the same format copies the raw data
+    {
+        CNcbiOstrstream ostrs;
+        {
+            CObjectOStreamAsnBinary out(ostrs);
+            out << delayed;
+        }
+        BOOST_CHECK(CNcbiOstrstreamToString(ostrs) == data);
+    }
+    BOOST_CHECK(queries_info->GetDelayBuffer(&delayed).Delayed());
+
+    // access parses the member
+    BOOST_CHECK_EQUAL(delayed.GetQueries().size(),
+                      env->GetQueries().size());
+    BOOST_CHECK(!queries_info->GetDelayBuffer(&delayed).Delayed());
+    BOOST_CHECK(delayed.Equals(*env));
+    {
+        CNcbiOstrstream ostrs;
+        {
+            CObjectOStreamAsnBinary out(ostrs);
+            out << delayed;
+        }
+        BOOST_CHECK(CNcbiOstrstreamToString(ostrs) == data);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// TestPackStringTable
+
+BOOST_AUTO_TEST_CASE(s_TestPackStringTable)
+{
+    const size_t kThreads = 8;
+    const size_t kStrings = 300;
+    CPackStringTable table(8000);
+    BOOST_REQUIRE(table.GetCapacity() >= 8000);
+
+    // the same strings from all threads: one copy, inserted once
+    vector<vector<const string*> > same(kThreads);
+    vector<size_t> inserted(kThreads);
+    // different strings in each thread
+    vector<size_t> own_failed(kThreads);
+    vector<thread> threads;
+    for ( size_t t = 0; t < kThreads; ++t ) {
+        threads.push_back(thread([&, t]() {
+                    for ( size_t i = 0; i < kStrings; ++i ) {
+                        string s = "same" + NStr::SizetToString(i);
+                        pair<const string*, bool> ret =
+                            table.Intern(s.data(), s.size());
+                        same[t].push_back(ret.first);
+                        if ( ret.second ) {
+                            ++inserted[t];
+                        }
+                        s = "own" + NStr::SizetToString(t) + "_" +
+                            NStr::SizetToString(i);
+                        ret = table.Intern(s.data(), s.size());
+                        if ( !ret.first || !ret.second || *ret.first != s ) {
+                            ++own_failed[t];
+                        }
+                    }
+                }));
+    }
+    for ( auto& th : threads ) {
+        th.join();
+    }
+    size_t total_inserted = 0;
+    for ( size_t t = 0; t < kThreads; ++t ) {
+        total_inserted += inserted[t];
+        BOOST_CHECK_EQUAL(own_failed[t], 0u);
+        BOOST_REQUIRE_EQUAL(same[t].size(), kStrings);
+        for ( size_t i = 0; i < kStrings; ++i ) {
+            BOOST_REQUIRE(same[t][i]);
+            BOOST_CHECK_EQUAL(same[t][i], same[0][i]);
+            BOOST_CHECK_EQUAL(*same[t][i], "same" + NStr::SizetToString(i));
+        }
+    }
+    BOOST_CHECK_EQUAL(total_inserted, kStrings);
+    BOOST_CHECK_EQUAL(table.GetCount(), kStrings*(kThreads+1));
+
+    // the table refuses new strings when full, but keeps old ones
+    size_t refused = 0;
+    for ( size_t i = 0; i < 2*table.GetCapacity(); ++i ) {
+        string s = "more" + NStr::SizetToString(i);
+        if ( !table.Intern(s.data(), s.size()).first ) {
+            ++refused;
+            BOOST_CHECK(!table.Find(s.data(), s.size()));
+        }
+    }
+    BOOST_CHECK(refused >= table.GetCapacity());
+    BOOST_CHECK(table.GetCount() <= table.GetCapacity());
+    for ( size_t i = 0; i < kStrings; ++i ) {
+        string s = "same" + NStr::SizetToString(i);
+        BOOST_CHECK_EQUAL(table.Find(s.data(), s.size()), same[0][i]);
+        BOOST_CHECK_EQUAL(table.Intern(s.data(), s.size()).first, same[0][i]);
+    }
+}
+
+// reading strings with shared CPackString, from several threads
+BOOST_AUTO_TEST_CASE(s_TestPackStringShared)
+{
+    CRef<CWeb_Env> env(new CWeb_Env);
+    {
+        unique_ptr<CObjectIStream> in(
+            CObjectIStream::Open("webenv.ent", eSerial_AsnText));
+        *in >> *env;
+    }
+    string data;
+    {
+        CNcbiOstrstream ostrs;
+        {
+            CObjectOStreamAsnBinary out(ostrs);
+            out << *env;
+        }
+        data = CNcbiOstrstreamToString(ostrs);
+    }
+    CObjectTypeInfoMI db_member =
+        CObjectTypeInfo(CType<CQuery_Search>()).FindMember("db");
+
+    const size_t kThreads = 4;
+    vector<CRef<CWeb_Env> > copies(kThreads);
+    vector<thread> threads;
+    for ( size_t t = 0; t < kThreads; ++t ) {
+        threads.push_back(thread([&, t]() {
+                    copies[t] = new CWeb_Env;
+                    CObjectIStreamAsnBinary in(data.data(), data.size());
+                    db_member.SetLocalReadHook(in,
+                        new CPackStringClassHook(CPackString::eShared));
+                    in >> *copies[t];
+                }));
+    }
+    for ( auto& th : threads ) {
+        th.join();
+    }
+    size_t db_count = 0;
+    for ( CTypeConstIterator<CQuery_Search> it(Begin(*env)); it; ++it ) {
+        const string& db = it->GetDb();
+        BOOST_CHECK(CPackStringTable::GetInstance().Find(db.data(),
+                                                         db.size()));
+        ++db_count;
+    }
+    BOOST_CHECK(db_count > 0);
+    for ( size_t t = 0; t < kThreads; ++t ) {
+        BOOST_CHECK(copies[t]->Equals(*env));
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// TestGeneratedAssign
+
+template<class C>
+static string s_AssignResult(const C& src, ESerialRecursionMode how)
+{
+    C dst;
+    dst.Assign(src, how);
+    CNcbiOstrstream ostrs;
+    ostrs << "equals: " << dst.Equals(src, how) << "\n";
+    if ( how != eShallowChildless ) {
+        ostrs << MSerial_AsnText << dst;
+    }
+    return CNcbiOstrstreamToString(ostrs);
+}
+
+// generated and generic Assign(), Equals() and SerialClone() agree
+BOOST_AUTO_TEST_CASE(s_TestGeneratedAssign)
+{
+    CRef<CWeb_Env> env(new CWeb_Env);
+    {
+        unique_ptr<CObjectIStream> in(
+            CObjectIStream::Open("webenv.ent", eSerial_AsnText));
+        *in >> *env;
+    }
+    BOOST_REQUIRE(env->IsSetQueries());
+    const CQuery_History& query = *env->GetQueries().front();
+
+    bool saved = CClassTypeInfoBase::GetGeneratedAssignEnabled();
+    ESerialRecursionMode modes[] = {
+        eRecursive, eShallow, eShallowChildless
+    };
+    for ( ESerialRecursionMode how : modes ) {
+        string env_result[2], query_result[2];
+        for ( int generated = 0; generated < 2; ++generated ) {
+            CClassTypeInfoBase::SetGeneratedAssignEnabled(generated != 0);
+            env_result[generated] = s_AssignResult(*env, how);
+            query_result[generated] = s_AssignResult(query, how);
+        }
+        BOOST_CHECK_EQUAL(env_result[1], env_result[0]);
+        BOOST_CHECK_EQUAL(query_result[1], query_result[0]);
+    }
+    for ( int generated = 0; generated < 2; ++generated ) {
+        CClassTypeInfoBase::SetGeneratedAssignEnabled(generated != 0);
+        CQuery_History copy;
+        copy.Assign(query, eShallow);
+        BOOST_CHECK_EQUAL(&copy.GetCommand(), &query.GetCommand());
+        copy.Assign(query, eRecursive);
+        BOOST_CHECK_NE(&copy.GetCommand(), &query.GetCommand());
+        BOOST_CHECK(copy.Equals(query));
+    }
+
+    CRef<CWeb_Env> clones[2];
+    for ( int generated = 0; generated < 2; ++generated ) {
+        CClassTypeInfoBase::SetGeneratedAssignEnabled(generated != 0);
+        clones[generated] = SerialClone(*env);
+        BOOST_CHECK(clones[generated]->Equals(*env));
+        BOOST_CHECK(clones[generated]->GetQueries().front() !=
+                    env->GetQueries().front());
+    }
+    // compare results of each implementation with the other one
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(false);
+    BOOST_CHECK(clones[1]->Equals(*env));
+    clones[1]->SetQueries().front()->SetSeqNumber(-1);
+    BOOST_CHECK(!clones[1]->Equals(*env));
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(true);
+    BOOST_CHECK(clones[0]->Equals(*env));
+    BOOST_CHECK(!clones[1]->Equals(*env));
+    BOOST_CHECK(!clones[1]->Equals(*clones[0]));
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(saved);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// TestSeqEntry
+
+static CRef<objects::CSeq_entry> s_ReadSeqEntry(void)
+{
+    CRef<objects::CSeq_entry> entry(new objects::CSeq_entry);
+    unique_ptr<CObjectIStream> in(
+        CObjectIStream::Open("seqentry.ent", eSerial_AsnText));
+    *in >> *entry;
+    return entry;
+}
+
+static string s_AsnText(const objects::CSeq_entry& entry)
+{
+    CNcbiOstrstream ostrs;
+    ostrs << MSerial_AsnText << entry;
+    return CNcbiOstrstreamToString(ostrs);
+}
+
+// generated ASN.1 binary codecs read and write a real Seq-entry
+// exactly as the generic type info based code does
+BOOST_AUTO_TEST_CASE(s_TestSeqEntryDirectCodec)
+{
+    CRef<objects::CSeq_entry> entry = s_ReadSeqEntry();
+    BOOST_REQUIRE(entry->IsSeq() && entry->GetSeq().IsSetAnnot());
+    string text = s_AsnText(*entry);
+
+    string data[2];
+    for ( int direct = 0; direct < 2; ++direct ) {
+        CNcbiOstrstream ostrs;
+        {
+            CObjectOStreamAsnBinary out(ostrs);
+            out.SetUseDirectCodecs(direct != 0);
+            out << *entry;
+        }
+        data[direct] = CNcbiOstrstreamToString(ostrs);
+    }
+    BOOST_CHECK(!data[0].empty());
+    BOOST_CHECK(data[1] == data[0]);
+
+    for ( int direct = 0; direct < 2; ++direct ) {
+        objects::CSeq_entry copy;
+        {
+            CObjectIStreamAsnBinary in(data[0].data(), data[0].size());
+            in.SetUseDirectCodecs(direct != 0);
+            in >> copy;
+        }
+        BOOST_CHECK(copy.Equals(*entry));
+        BOOST_CHECK(s_AsnText(copy) == text);
+    }
+}
+
+// generated Assign() and Equals() of a real Seq-entry give the same
+// results as CTypeInfo::Assign() and CTypeInfo::Equals()
+BOOST_AUTO_TEST_CASE(s_TestSeqEntryGeneratedAssign)
+{
+    CRef<objects::CSeq_entry> entry = s_ReadSeqEntry();
+    string text = s_AsnText(*entry);
+    TTypeInfo type = objects::CSeq_entry::GetTypeInfo();
+
+    bool saved = CClassTypeInfoBase::GetGeneratedAssignEnabled();
+    // generic copy
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(false);
+    objects::CSeq_entry generic;
+    type->Assign(&generic, entry.GetPointer());
+    BOOST_CHECK(type->Equals(&generic, entry.GetPointer()));
+    // generated copy
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(true);
+    objects::CSeq_entry generated;
+    generated.Assign(*entry);
+    BOOST_CHECK(generated.Equals(*entry));
+    CRef<objects::CSeq_entry> clone(SerialClone(*entry));
+    BOOST_CHECK(clone->Equals(*entry));
+    BOOST_CHECK(s_AsnText(generic) == text);
+    BOOST_CHECK(s_AsnText(generated) == text);
+    BOOST_CHECK(s_AsnText(*clone) == text);
+
+    // change deep values and compare with both implementations
+    objects::CBioseq& seq = generated.SetSeq();
+    seq.SetInst().SetLength(seq.GetInst().GetLength() + 1);
+    objects::CSeq_annot& annot = *clone->SetSeq().SetAnnot().front();
+    BOOST_REQUIRE(annot.IsFtable() && !annot.GetData().GetFtable().empty());
+    annot.SetData().SetFtable().back()->SetComment("changed");
+    for ( int generated_assign = 0; generated_assign < 2; ++generated_assign ) {
+        CClassTypeInfoBase::SetGeneratedAssignEnabled(generated_assign != 0);
+        BOOST_CHECK(generic.Equals(*entry));
+        BOOST_CHECK(!generated.Equals(*entry));
+        BOOST_CHECK(!clone->Equals(*entry));
+        BOOST_CHECK(!type->Equals(&generated, entry.GetPointer()));
+        BOOST_CHECK(!type->Equals(clone.GetPointer(), entry.GetPointer()));
+        BOOST_CHECK(!clone->Equals(generated));
+    }
+    CClassTypeInfoBase::SetGeneratedAssignEnabled(saved);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// TestMemberNames
+
+// many names, names sharing prefixes, lengths and chars
+static vector<string> s_GetManyMemberNames(void)
+{
+    vector<string> names;
+    for ( int i = 0; i < 300; ++i ) {
+        names.push_back("m" + NStr::IntToString(i));
+    }
+    for ( size_t len = 1; len <= 40; ++len ) {
+        names.push_back(string(len, 'a'));
+    }
+    names.push_back("ab");
+    names.push_back("ba");
+    names.push_back("m-0");
+    names.push_back("M0");
+    return names;
+}
+
+class CManyMembers : public CSerialObject
+{
+public:
+    DECLARE_INTERNAL_TYPE_INFO();
+
+    int m_Values[400];
+};
+
+BEGIN_NAMED_CLASS_INFO("ManyMembers", CManyMembers)
+{
+    vector<string> names = s_GetManyMemberNames();
+    for ( size_t i = 0; i < names.size(); ++i ) {
+        ADD_NAMED_STD_MEMBER(names[i].c_str(), m_Values[i]);
+    }
+}
+END_CLASS_INFO
+
+class CDuplicateMembers : public CSerialObject
+{
+public:
+    DECLARE_INTERNAL_TYPE_INFO();
+
+    int m_First;
+    int m_Second;
+};
+
+BEGIN_NAMED_CLASS_INFO("DuplicateMembers", CDuplicateMembers)
+{
+    ADD_NAMED_STD_MEMBER("x", m_First);
+    ADD_NAMED_STD_MEMBER("x", m_Second);
+}
+END_CLASS_INFO
+
+// about two names share every hash bucket of the member name index
+BOOST_AUTO_TEST_CASE(s_TestMemberNames)
+{
+    const CClassTypeInfo* info =
+        dynamic_cast<const CClassTypeInfo*>(CManyMembers::GetTypeInfo());
+    BOOST_REQUIRE(info);
+    const CItemsInfo& members = info->GetMembers();
+    vector<string> names = s_GetManyMemberNames();
+    BOOST_REQUIRE_EQUAL(members.LastIndex(), TMemberIndex(names.size()));
+    for ( size_t i = 0; i < names.size(); ++i ) {
+        BOOST_CHECK_EQUAL(members.Find(names[i]),
+                          TMemberIndex(kFirstMemberIndex + i));
+    }
+    const char* absent[] = { "", "m300", "m-1", "M1", "b", "aab", "m" };
+    for ( const char* name : absent ) {
+        BOOST_CHECK_EQUAL(members.Find(name), kInvalidMember);
+    }
+    BOOST_CHECK_EQUAL(members.Find(string(41, 'a')), kInvalidMember);
+
+    const CClassTypeInfo* dup_info =
+        dynamic_cast<const CClassTypeInfo*>(CDuplicateMembers::GetTypeInfo());
+    BOOST_REQUIRE(dup_info);
+    BOOST_CHECK_THROW(dup_info->GetMembers().Find("x"), CSerialException);
+}
+
 #endif
@@ -21,6 +21,7 @@
 # include "twebenv.h"
 #else
 # include <serial/test/Web_Env.hpp>
+# include <serial/test/Query_History.hpp>
 #endif
 
 #include <corelib/ncbifile.hpp>
@@ -130,6 +130,7 @@ CVariantInfo::CVariantInfo(const CChoiceTypeInfo* choiceType,
                            const CTypeRef& type)
     : CParent(id, offset, type), m_ChoiceType(choiceType),
       m_VariantType(eInlineVariant), m_DelayOffset(eNoOffset),
+      m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstInlineVariant),
       m_GetFunction(&TFunc::GetInlineVariant),
       m_ReadHookData(&TFunc::ReadInlineVariant, &TFunc::ReadHookedVariant),
@@ -144,6 +145,7 @@ CVariantInfo::CVariantInfo(const CChoiceTypeInfo* choiceType,
                            TTypeInfo type)
     : CParent(id, offset, type), m_ChoiceType(choiceType),
       m_VariantType(eInlineVariant), m_DelayOffset(eNoOffset),
+      m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstInlineVariant),
       m_GetFunction(&TFunc::GetInlineVariant),
       m_ReadHookData(&TFunc::ReadInlineVariant, &TFunc::ReadHookedVariant),
@@ -158,6 +160,7 @@ CVariantInfo::CVariantInfo(const CChoiceTypeInfo* choiceType,
                            const CTypeRef& type)
     : CParent(id, offset, type), m_ChoiceType(choiceType),
       m_VariantType(eInlineVariant), m_DelayOffset(eNoOffset),
+      m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstInlineVariant),
       m_GetFunction(&TFunc::GetInlineVariant),
       m_ReadHookData(&TFunc::ReadInlineVariant, &TFunc::ReadHookedVariant),
@@ -172,6 +175,7 @@ CVariantInfo::CVariantInfo(const CChoiceTypeInfo* choiceType,
                            TTypeInfo type)
     : CParent(id, offset, type), m_ChoiceType(choiceType),
       m_VariantType(eInlineVariant), m_DelayOffset(eNoOffset),
+      m_LazyDelay(false),
       m_GetConstFunction(&TFunc::GetConstInlineVariant),
       m_GetFunction(&TFunc::GetInlineVariant),
       m_ReadHookData(&TFunc::ReadInlineVariant, &TFunc::ReadHookedVariant),
@@ -233,6 +237,12 @@ CVariantInfo* CVariantInfo::SetDelayBuffer(CDelayBuffer* buffer)
     return this;
 }
 
+CVariantInfo* CVariantInfo::SetLazyDelayBuffer(CDelayBuffer* buffer)
+{
+    m_LazyDelay = true;
+    return SetDelayBuffer(buffer);
+}
+
 void CVariantInfo::UpdateFunctions(void)
 {
     // determine function pointers
@@ -534,7 +544,10 @@ void CVariantInfoFunctions::ReadDelayedVariant(CObjectIStream& in,
         // index is differnet from current -> first, reset choice
         choiceType->ResetIndex(choicePtr);
         CDelayBuffer& buffer = variantInfo->GetDelayBuffer(choicePtr);
-        if ( !buffer ) {
+        if ( !buffer &&
+             (!variantInfo->LazyDelay() ||
+              in.GetDelayBufferParsingPolicy() ==
+              CObjectIStream::eDelayBufferPolicyNeverParse) ) {
             in.StartDelayBuffer();
             if ( variantInfo->IsObjectPointer() )
                 in.SkipExternalObject(variantType);
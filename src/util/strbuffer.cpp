@@ -649,18 +649,31 @@ Int4 CIStreamBuffer::GetInt4(void)
     const Uint4 kMaxBeforeMul = kMax_I4/10;
     const Uint1 kMaxLimitAdd = Uint1(kMax_I4%10 + sign);
     
+    // scan digits directly in buffer, refilling it only at its end
+    const char* pos = m_CurrentPos;
+    const char* end = m_DataEndPos;
     for ( ;; ) {
-        Uint1 d = (Uint1)(PeekCharNoEOF() - '0');
+        if ( pos >= end ) {
+            m_CurrentPos = pos;
+            if ( !TryToFillBuffer() )
+                break;
+            pos = m_CurrentPos;
+            end = m_DataEndPos;
+        }
+        Uint1 d = (Uint1)(*pos - '0');
         if ( d > 9 )
             break;
-        SkipChar();
-        
+        ++pos;
+
         // check multiplication overflow
-        if ( n > kMaxBeforeMul || (n == kMaxBeforeMul && d > kMaxLimitAdd) )
+        if ( n > kMaxBeforeMul || (n == kMaxBeforeMul && d > kMaxLimitAdd) ) {
+            m_CurrentPos = pos;
             NumberOverflow();
-        
+        }
+
         n = n * 10 + d;
     }
+    m_CurrentPos = pos;
     if ( sign )
         return -Int4(n);
     else
@@ -683,18 +696,31 @@ Uint4 CIStreamBuffer::GetUint4(void)
     const Uint4 kMaxBeforeMul = kMax_UI4/10;
     const Uint1 kMaxLimitAdd = Uint1(kMax_UI4%10);
     
+    // scan digits directly in buffer, refilling it only at its end
+    const char* pos = m_CurrentPos;
+    const char* end = m_DataEndPos;
     for ( ;; ) {
-        Uint1 d = (Uint1)(PeekCharNoEOF() - '0');
-        if  ( d > 9 )
+        if ( pos >= end ) {
+            m_CurrentPos = pos;
+            if ( !TryToFillBuffer() )
+                break;
+            pos = m_CurrentPos;
+            end = m_DataEndPos;
+        }
+        Uint1 d = (Uint1)(*pos - '0');
+        if ( d > 9 )
             break;
-        SkipChar();
+        ++pos;
 
         // check multiplication overflow
-        if ( n > kMaxBeforeMul || (n == kMaxBeforeMul && d > kMaxLimitAdd) )
+        if ( n > kMaxBeforeMul || (n == kMaxBeforeMul && d > kMaxLimitAdd) ) {
+            m_CurrentPos = pos;
             NumberOverflow();
+        }
 
         n = n * 10 + d;
     }
+    m_CurrentPos = pos;
     return n;
 }
 
@@ -726,18 +752,31 @@ Int8 CIStreamBuffer::GetInt8(void)
     const Uint8 kMaxBeforeMul = kMax_I8/10;
     const Uint1 kMaxLimitAdd = Uint1(kMax_I8%10 + sign);
 
+    // scan digits directly in buffer, refilling it only at its end
+    const char* pos = m_CurrentPos;
+    const char* end = m_DataEndPos;
     for ( ;; ) {
-        Uint1 d = (Uint1)(PeekCharNoEOF() - '0');
+        if ( pos >= end ) {
+            m_CurrentPos = pos;
+            if ( !TryToFillBuffer() )
+                break;
+            pos = m_CurrentPos;
+            end = m_DataEndPos;
+        }
+        Uint1 d = (Uint1)(*pos - '0');
         if ( d > 9 )
             break;
-        SkipChar();
+        ++pos;
 
         // check multiplication overflow
-        if ( n > kMaxBeforeMul || (n == kMaxBeforeMul && d > kMaxLimitAdd) )
+        if ( n > kMaxBeforeMul || (n == kMaxBeforeMul && d > kMaxLimitAdd) ) {
+            m_CurrentPos = pos;
             NumberOverflow();
+        }
 
         n = n * 10 + d;
     }
+    m_CurrentPos = pos;
     if ( sign )
         return -Int8(n);
     else
@@ -760,21 +799,36 @@ Uint8 CIStreamBuffer::GetUint8(void)
     // overflow limits
     const Uint8 kMaxBeforeMul = kMax_UI8/10;
     
+    // scan digits directly in buffer, refilling it only at its end
+    const char* pos = m_CurrentPos;
+    const char* end = m_DataEndPos;
     for ( ;; ) {
-        d = (Uint1)(PeekCharNoEOF() - '0');
+        if ( pos >= end ) {
+            m_CurrentPos = pos;
+            if ( !TryToFillBuffer() )
+                break;
+            pos = m_CurrentPos;
+            end = m_DataEndPos;
+        }
+        d = (Uint1)(*pos - '0');
         if ( d > 9 )
             break;
-        SkipChar();
+        ++pos;
 
         // check multiplication overflow
-        if ( n > kMaxBeforeMul )
+        if ( n > kMaxBeforeMul ) {
+            m_CurrentPos = pos;
             NumberOverflow();
-        
+        }
+
         n = n * 10 + d;
-        
-        if ( n < d )
+
+        if ( n < d ) {
+            m_CurrentPos = pos;
             NumberOverflow();
+        }
     }
+    m_CurrentPos = pos;
     return n;
 }
 